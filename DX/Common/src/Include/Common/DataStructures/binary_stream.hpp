@@ -0,0 +1,157 @@
+#pragma once
+
+/**********************************************************************
+    class: BinaryWriter + BinaryReader (binary_stream.hpp)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Helpers to serialize plain data into a byte buffer and read it back
+    in the same order. Arrays are written with their size in front.
+    Array elements are aligned to their type relative to the beginning
+    of the buffer. The reader never copies, it only hands out pointers
+    into the buffer, so it can be used directly on memory mapped files.
+**********************************************************************/
+
+namespace Common {
+
+    //**********************************************************************
+    class BinaryWriter
+    {
+    public:
+        BinaryWriter() = default;
+
+        //----------------------------------------------------------------------
+        // Write a single trivially copyable value.
+        //----------------------------------------------------------------------
+        template <typename T>
+        void write(const T& value)
+        {
+            static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written." );
+            writeBytes( &value, sizeof( T ) );
+        }
+
+        //----------------------------------------------------------------------
+        // Write the element count followed by the elements.
+        //----------------------------------------------------------------------
+        template <typename T>
+        void writeArray(const T* data, U32 count)
+        {
+            static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written." );
+            write( count );
+            align( alignof( T ) );
+            writeBytes( data, count * sizeof( T ) );
+        }
+        template <typename T>
+        void writeArray(const ArrayList<T>& data) { writeArray( data.data(), static_cast<U32>( data.size() ) ); }
+
+        //----------------------------------------------------------------------
+        void writeString(const String& str) { writeArray( str.data(), static_cast<U32>( str.size() ) ); }
+
+        //----------------------------------------------------------------------
+        void writeBytes(const void* data, Size amountOfBytes)
+        {
+            auto bytes = reinterpret_cast<const Byte*>( data );
+            m_buffer.insert( m_buffer.end(), bytes, bytes + amountOfBytes );
+        }
+
+        //----------------------------------------------------------------------
+        // Pads the buffer with zeros until its size is a multiple of the given alignment.
+        //----------------------------------------------------------------------
+        void align(Size alignment) { m_buffer.resize( (m_buffer.size() + alignment - 1) / alignment * alignment, 0 ); }
+
+        //----------------------------------------------------------------------
+        const ArrayList<Byte>&  getBuffer() const { return m_buffer; }
+        Size                    size()      const { return m_buffer.size(); }
+
+    private:
+        ArrayList<Byte> m_buffer;
+
+        NULL_COPY_AND_ASSIGN(BinaryWriter)
+    };
+
+    //**********************************************************************
+    // Reads data written by a BinaryWriter. Reading past the end does not
+    // touch the buffer but marks the reader as invalid, so truncated files
+    // can be detected by checking isValid() once at the end.
+    //**********************************************************************
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const Byte* data, Size size) : m_begin( data ), m_cursor( data ), m_end( data + size ) {}
+
+        //----------------------------------------------------------------------
+        template <typename T>
+        T read()
+        {
+            T value{};
+            if ( auto bytes = readBytes( sizeof( T ) ) )
+                memcpy( &value, bytes, sizeof( T ) );
+            return value;
+        }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Pointer to the elements of an array written with writeArray(). Nullptr if the array is empty.
+        //----------------------------------------------------------------------
+        template <typename T>
+        const T* readArray(U32* count)
+        {
+            *count = read<U32>();
+            skipToAlignment( alignof( T ) );
+            auto data = readBytes( *count * sizeof( T ) );
+            if (not data)
+                *count = 0;
+            return reinterpret_cast<const T*>( data );
+        }
+        template <typename T>
+        ArrayList<T> readArray()
+        {
+            U32 count;
+            auto data = readArray<T>( &count );
+            return count > 0 ? ArrayList<T>( data, data + count ) : ArrayList<T>();
+        }
+
+        //----------------------------------------------------------------------
+        String readString()
+        {
+            U32 count;
+            auto data = readArray<char>( &count );
+            return String( data ? data : "", count );
+        }
+
+        //----------------------------------------------------------------------
+        const Byte* readBytes(Size amountOfBytes)
+        {
+            if ( not m_valid || static_cast<Size>( m_end - m_cursor ) < amountOfBytes )
+            {
+                m_valid = false;
+                return nullptr;
+            }
+
+            auto bytes = m_cursor;
+            m_cursor += amountOfBytes;
+            return amountOfBytes > 0 ? bytes : nullptr;
+        }
+
+        //----------------------------------------------------------------------
+        // Skips the padding written by BinaryWriter::align().
+        //----------------------------------------------------------------------
+        void skipToAlignment(Size alignment)
+        {
+            Size offset = static_cast<Size>( m_cursor - m_begin );
+            readBytes( (offset + alignment - 1) / alignment * alignment - offset );
+        }
+
+        //----------------------------------------------------------------------
+        bool isValid()  const { return m_valid; }
+        bool eof()      const { return m_cursor == m_end; }
+
+    private:
+        const Byte* m_begin;
+        const Byte* m_cursor;
+        const Byte* m_end;
+        bool        m_valid = true;
+    };
+
+} // end namespaces
@@ -18,9 +18,11 @@
 #include <codecvt>
 #include <locale>
 #include "macros.hpp"
+#include <mutex>
 
-// Table which maps [HASH <-> STRING]
+// Table which maps [HASH <-> STRING]. Guarded by the mutex, because assets are read on worker threads.
 HashMap<U32, const char*> gStringIdTable;
+std::mutex gStringIdTableMutex;
 
 
 //----------------------------------------------------------------------
@@ -57,6 +59,7 @@ U32 internString( const char* str, bool addToTable )
 
     if (addToTable)
     {
+        std::lock_guard<std::mutex> lock( gStringIdTableMutex );
         auto it = gStringIdTable.find( sid );
         if (it == gStringIdTable.end())
         {
@@ -74,10 +77,11 @@ U32 internString( const char* str, bool addToTable )
 //----------------------------------------------------------------------
 const char* externString( StringID sid )
 {
+    std::lock_guard<std::mutex> lock( gStringIdTableMutex );
     auto it = gStringIdTable.find( sid.id );
     if ( it != gStringIdTable.end() )
     {
-        return gStringIdTable[sid.id];
+        return it->second;
     }
     ASSERT( false && "Given StringID does not exist.");
     return "";
@@ -25,4 +25,79 @@ namespace Math
         return corners;
     }
 
+    //----------------------------------------------------------------------
+    F32 AABB::getSurfaceArea() const
+    {
+        Math::Vec3 d = m_bounds[1] - m_bounds[0];
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    //----------------------------------------------------------------------
+    bool AABB::contains( const AABB& other ) const
+    {
+        return m_bounds[0].x <= other.m_bounds[0].x && m_bounds[0].y <= other.m_bounds[0].y && m_bounds[0].z <= other.m_bounds[0].z
+            && m_bounds[1].x >= other.m_bounds[1].x && m_bounds[1].y >= other.m_bounds[1].y && m_bounds[1].z >= other.m_bounds[1].z;
+    }
+
+    //----------------------------------------------------------------------
+    bool AABB::overlaps( const AABB& other ) const
+    {
+        return m_bounds[0].x <= other.m_bounds[1].x && m_bounds[1].x >= other.m_bounds[0].x
+            && m_bounds[0].y <= other.m_bounds[1].y && m_bounds[1].y >= other.m_bounds[0].y
+            && m_bounds[0].z <= other.m_bounds[1].z && m_bounds[1].z >= other.m_bounds[0].z;
+    }
+
+    //----------------------------------------------------------------------
+    bool AABB::overlaps( const Math::Vec3& center, F32 radius ) const
+    {
+        F32 distSqr = 0.0f;
+        for (I32 i = 0; i < 3; i++)
+        {
+            F32 v = center[i];
+            if (v < m_bounds[0][i]) distSqr += (m_bounds[0][i] - v) * (m_bounds[0][i] - v);
+            if (v > m_bounds[1][i]) distSqr += (v - m_bounds[1][i]) * (v - m_bounds[1][i]);
+        }
+        return distSqr <= radius * radius;
+    }
+
+    //----------------------------------------------------------------------
+    AABB AABB::expanded( F32 margin ) const
+    {
+        Math::Vec3 m( margin );
+        return AABB( m_bounds[0] - m, m_bounds[1] + m );
+    }
+
+    //----------------------------------------------------------------------
+    AABB AABB::transform( const DirectX::XMMATRIX& matrix ) const
+    {
+        // Transform center and project the extents onto the world axes (J. Arvo, Graphics Gems 1990)
+        Math::Vec3 c = getCenter();
+        Math::Vec3 e = getExtents();
+
+        auto center  = DirectX::XMVector3Transform( DirectX::XMLoadFloat3( &c ), matrix );
+        auto extents = DirectX::XMVectorAdd( DirectX::XMVectorAdd(
+                            DirectX::XMVectorScale( DirectX::XMVectorAbs( matrix.r[0] ), e.x ),
+                            DirectX::XMVectorScale( DirectX::XMVectorAbs( matrix.r[1] ), e.y ) ),
+                            DirectX::XMVectorScale( DirectX::XMVectorAbs( matrix.r[2] ), e.z ) );
+
+        Math::Vec3 min, max;
+        DirectX::XMStoreFloat3( &min, DirectX::XMVectorSubtract( center, extents ) );
+        DirectX::XMStoreFloat3( &max, DirectX::XMVectorAdd( center, extents ) );
+
+        return AABB( min, max );
+    }
+
+    //----------------------------------------------------------------------
+    AABB AABB::Combine( const AABB& a, const AABB& b )
+    {
+        return AABB( a.getMin().minVec( b.getMin() ), a.getMax().maxVec( b.getMax() ) );
+    }
+
+    //----------------------------------------------------------------------
+    AABB AABB::FromSphere( const Math::Vec3& center, F32 radius )
+    {
+        Math::Vec3 r( radius );
+        return AABB( center - r, center + r );
+    }
+
 }
\ No newline at end of file
@@ -36,11 +36,44 @@ namespace Math
 
         F32 getHeight() const { return getMax().y - getMin().y; }
 
+        Math::Vec3 getCenter()  const { return (getMin() + getMax()) * 0.5f; }
+        Math::Vec3 getExtents() const { return (getMax() - getMin()) * 0.5f; }
+
         std::array<Math::Vec3, 8> getCorners() const;
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Surface area of this box. Used as the cost metric in bounding volume hierarchies.
+        //----------------------------------------------------------------------
+        F32 getSurfaceArea() const;
+
+        //----------------------------------------------------------------------
+        bool contains(const AABB& other) const;
+        bool overlaps(const AABB& other) const;
+        bool overlaps(const Math::Vec3& center, F32 radius) const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  A copy of this box grown in every direction by the given margin.
+        //----------------------------------------------------------------------
+        AABB expanded(F32 margin) const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The axis aligned box which encloses this box transformed by the given matrix.
+        //----------------------------------------------------------------------
+        AABB transform(const DirectX::XMMATRIX& matrix) const;
+
+        //----------------------------------------------------------------------
+        static AABB Combine(const AABB& a, const AABB& b);
+        static AABB FromSphere(const Math::Vec3& center, F32 radius);
+
         const Math::Vec3&   operator[] (I32 index) const    { ASSERT( index < 2 ); return m_bounds[index]; }
         Math::Vec3&         operator[] (I32 index)          { ASSERT( index < 2 ); return m_bounds[index]; }
 
+        bool operator == (const AABB& other) const { return getMin() == other.getMin() && getMax() == other.getMax(); }
+        bool operator != (const AABB& other) const { return not (*this == other); }
+
         String toString() { return "Min: " + getMin().toString() + " Max: " + getMax().toString(); }
     };
 
@@ -0,0 +1,289 @@
+#include "dynamic_aabb_tree.h"
+/**********************************************************************
+    class: DynamicAABBTree (dynamic_aabb_tree.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+namespace Math {
+
+    //----------------------------------------------------------------------
+    DynamicAABBTree::DynamicAABBTree( F32 fatMargin )
+        : m_fatMargin( fatMargin )
+    {
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    I32 DynamicAABBTree::createProxy( const AABB& aabb, void* userData )
+    {
+        I32 proxyID = _AllocateNode();
+
+        m_nodes[proxyID].aabb       = aabb.expanded( m_fatMargin );
+        m_nodes[proxyID].userData   = userData;
+        m_nodes[proxyID].height     = 0;
+
+        _InsertLeaf( proxyID );
+        m_proxyCount++;
+
+        return proxyID;
+    }
+
+    //----------------------------------------------------------------------
+    void DynamicAABBTree::destroyProxy( I32 proxyID )
+    {
+        ASSERT( proxyID >= 0 && proxyID < (I32)m_nodes.size() );
+        ASSERT( m_nodes[proxyID].isLeaf() );
+
+        _RemoveLeaf( proxyID );
+        _FreeNode( proxyID );
+        m_proxyCount--;
+    }
+
+    //----------------------------------------------------------------------
+    bool DynamicAABBTree::moveProxy( I32 proxyID, const AABB& aabb )
+    {
+        ASSERT( proxyID >= 0 && proxyID < (I32)m_nodes.size() );
+        ASSERT( m_nodes[proxyID].isLeaf() );
+
+        if ( m_nodes[proxyID].aabb.contains( aabb ) )
+            return false;
+
+        _RemoveLeaf( proxyID );
+        m_nodes[proxyID].aabb = aabb.expanded( m_fatMargin );
+        _InsertLeaf( proxyID );
+
+        return true;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    I32 DynamicAABBTree::_AllocateNode()
+    {
+        if (m_freeList == NULL_NODE)
+        {
+            m_nodes.emplace_back();
+            return static_cast<I32>( m_nodes.size() - 1 );
+        }
+
+        I32 nodeID = m_freeList;
+        m_freeList = m_nodes[nodeID].parent;
+
+        m_nodes[nodeID] = Node();
+        return nodeID;
+    }
+
+    //----------------------------------------------------------------------
+    void DynamicAABBTree::_FreeNode( I32 nodeID )
+    {
+        m_nodes[nodeID].parent   = m_freeList;
+        m_nodes[nodeID].userData = nullptr;
+        m_nodes[nodeID].height   = -1;
+        m_freeList = nodeID;
+    }
+
+    //----------------------------------------------------------------------
+    void DynamicAABBTree::_InsertLeaf( I32 leaf )
+    {
+        if (m_root == NULL_NODE)
+        {
+            m_root = leaf;
+            m_nodes[m_root].parent = NULL_NODE;
+            return;
+        }
+
+        // Find the best sibling by descending the tree with the surface area heuristic
+        AABB leafAABB = m_nodes[leaf].aabb;
+        I32 index = m_root;
+        while ( not m_nodes[index].isLeaf() )
+        {
+            I32 child1 = m_nodes[index].child1;
+            I32 child2 = m_nodes[index].child2;
+
+            F32 area = m_nodes[index].aabb.getSurfaceArea();
+            F32 combinedArea = AABB::Combine( m_nodes[index].aabb, leafAABB ).getSurfaceArea();
+
+            // Cost of creating a new parent for this node and the new leaf
+            F32 cost = 2.0f * combinedArea;
+
+            // Minimum cost of pushing the leaf further down the tree
+            F32 inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](I32 child) {
+                F32 newArea = AABB::Combine( leafAABB, m_nodes[child].aabb ).getSurfaceArea();
+                if ( m_nodes[child].isLeaf() )
+                    return newArea + inheritanceCost;
+                return (newArea - m_nodes[child].aabb.getSurfaceArea()) + inheritanceCost;
+            };
+
+            F32 cost1 = descendCost( child1 );
+            F32 cost2 = descendCost( child2 );
+
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = (cost1 < cost2) ? child1 : child2;
+        }
+
+        I32 sibling = index;
+
+        // Create a new parent
+        I32 oldParent = m_nodes[sibling].parent;
+        I32 newParent = _AllocateNode();
+        m_nodes[newParent].parent   = oldParent;
+        m_nodes[newParent].aabb     = AABB::Combine( leafAABB, m_nodes[sibling].aabb );
+        m_nodes[newParent].height   = m_nodes[sibling].height + 1;
+        m_nodes[newParent].child1   = sibling;
+        m_nodes[newParent].child2   = leaf;
+        m_nodes[sibling].parent     = newParent;
+        m_nodes[leaf].parent        = newParent;
+
+        if (oldParent != NULL_NODE)
+        {
+            if (m_nodes[oldParent].child1 == sibling)
+                m_nodes[oldParent].child1 = newParent;
+            else
+                m_nodes[oldParent].child2 = newParent;
+        }
+        else
+        {
+            m_root = newParent;
+        }
+
+        _RefitAncestors( m_nodes[leaf].parent );
+    }
+
+    //----------------------------------------------------------------------
+    void DynamicAABBTree::_RemoveLeaf( I32 leaf )
+    {
+        if (leaf == m_root)
+        {
+            m_root = NULL_NODE;
+            return;
+        }
+
+        I32 parent      = m_nodes[leaf].parent;
+        I32 grandParent = m_nodes[parent].parent;
+        I32 sibling     = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        if (grandParent != NULL_NODE)
+        {
+            // Destroy parent and connect sibling to grandparent
+            if (m_nodes[grandParent].child1 == parent)
+                m_nodes[grandParent].child1 = sibling;
+            else
+                m_nodes[grandParent].child2 = sibling;
+            m_nodes[sibling].parent = grandParent;
+            _FreeNode( parent );
+
+            _RefitAncestors( grandParent );
+        }
+        else
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = NULL_NODE;
+            _FreeNode( parent );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void DynamicAABBTree::_RefitAncestors( I32 index )
+    {
+        while (index != NULL_NODE)
+        {
+            index = _Balance( index );
+
+            I32 child1 = m_nodes[index].child1;
+            I32 child2 = m_nodes[index].child2;
+
+            m_nodes[index].height = 1 + std::max( m_nodes[child1].height, m_nodes[child2].height );
+            m_nodes[index].aabb   = AABB::Combine( m_nodes[child1].aabb, m_nodes[child2].aabb );
+
+            index = m_nodes[index].parent;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    I32 DynamicAABBTree::_Balance( I32 iA )
+    {
+        // Performs a left or right rotation if node A is imbalanced.
+        // @Return:
+        //  The new root index of the subtree.
+        Node& A = m_nodes[iA];
+        if (A.isLeaf() || A.height < 2)
+            return iA;
+
+        I32 iB = A.child1;
+        I32 iC = A.child2;
+        Node& B = m_nodes[iB];
+        Node& C = m_nodes[iC];
+
+        I32 balance = C.height - B.height;
+
+        auto rotateUp = [&](I32 iUp, I32 iOther, bool upIsChild2) {
+            Node& up    = m_nodes[iUp];
+            Node& other = m_nodes[iOther];
+
+            I32 iF = up.child1;
+            I32 iG = up.child2;
+            Node& F = m_nodes[iF];
+            Node& G = m_nodes[iG];
+
+            // Swap A and the rising node
+            up.child1 = iA;
+            up.parent = A.parent;
+            A.parent  = iUp;
+
+            // A's old parent should point to the rising node
+            if (up.parent != NULL_NODE)
+            {
+                if (m_nodes[up.parent].child1 == iA)
+                    m_nodes[up.parent].child1 = iUp;
+                else
+                    m_nodes[up.parent].child2 = iUp;
+            }
+            else
+            {
+                m_root = iUp;
+            }
+
+            // Keep the higher grandchild at the rising node, move the other one down to A
+            I32 iKeep = (F.height > G.height) ? iF : iG;
+            I32 iMove = (F.height > G.height) ? iG : iF;
+            Node& keep = m_nodes[iKeep];
+            Node& move = m_nodes[iMove];
+
+            up.child2 = iKeep;
+            if (upIsChild2)
+                A.child2 = iMove;
+            else
+                A.child1 = iMove;
+            move.parent = iA;
+
+            A.aabb      = AABB::Combine( other.aabb, move.aabb );
+            up.aabb     = AABB::Combine( A.aabb, keep.aabb );
+            A.height    = 1 + std::max( other.height, move.height );
+            up.height   = 1 + std::max( A.height, keep.height );
+
+            return iUp;
+        };
+
+        // Rotate C up
+        if (balance > 1)
+            return rotateUp( iC, iB, true );
+
+        // Rotate B up
+        if (balance < -1)
+            return rotateUp( iB, iC, false );
+
+        return iA;
+    }
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+/**********************************************************************
+    class: DynamicAABBTree (dynamic_aabb_tree.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Bounding volume hierarchy of axis aligned boxes, which can be
+    updated incrementally. Each leaf stores a "fat" aabb which is
+    larger than the real bounds by a margin, so small movements do
+    not require a reinsertion into the tree. Insertion uses the
+    surface area heuristic and the tree is balanced with rotations.
+    @Considerations:
+      - Predict the movement of a proxy and extend the fat aabb
+        in the direction of movement.
+**********************************************************************/
+
+#include "aabb.h"
+
+namespace Math {
+
+    //**********************************************************************
+    class DynamicAABBTree
+    {
+    public:
+        static const I32 NULL_NODE = -1;
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "fatMargin": Margin by which the bounds of every proxy are enlarged.
+        //----------------------------------------------------------------------
+        DynamicAABBTree(F32 fatMargin = 0.1f);
+        ~DynamicAABBTree() = default;
+
+        //----------------------------------------------------------------------
+        // Insert a new proxy into the tree.
+        // @Return:
+        //  The id of the proxy, which is stable until the proxy gets destroyed.
+        //----------------------------------------------------------------------
+        I32 createProxy(const AABB& aabb, void* userData);
+
+        //----------------------------------------------------------------------
+        void destroyProxy(I32 proxyID);
+
+        //----------------------------------------------------------------------
+        // Update the bounds of the given proxy.
+        // @Return:
+        //  True, if the proxy moved out of his fat aabb and was reinserted.
+        //----------------------------------------------------------------------
+        bool moveProxy(I32 proxyID, const AABB& aabb);
+
+        //----------------------------------------------------------------------
+        void*       getUserData(I32 proxyID)    const { ASSERT( proxyID >= 0 && proxyID < (I32)m_nodes.size() ); return m_nodes[proxyID].userData; }
+        const AABB& getFatAABB(I32 proxyID)     const { ASSERT( proxyID >= 0 && proxyID < (I32)m_nodes.size() ); return m_nodes[proxyID].aabb; }
+        I32         getHeight()                 const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+        I32         getProxyCount()             const { return m_proxyCount; }
+
+        //----------------------------------------------------------------------
+        // Traverse the tree and report every proxy which passes the given test.
+        // @Params:
+        //  "test": bool(const AABB&). Called for inner nodes and leafs. If it
+        //          returns false the whole subtree is skipped.
+        //  "visit": bool(I32 proxyID, void* userData). Called for every leaf which
+        //           passed the test. Return false to stop the traversal.
+        //----------------------------------------------------------------------
+        template <typename TestFunc, typename VisitFunc>
+        void query(TestFunc test, VisitFunc visit) const;
+
+    private:
+        struct Node
+        {
+            AABB    aabb;
+            void*   userData = nullptr;
+            I32     parent   = NULL_NODE; // Index of the next free node if the node is not used
+            I32     child1   = NULL_NODE;
+            I32     child2   = NULL_NODE;
+            I32     height   = -1;        // Leafs have height 0, free nodes -1
+
+            bool isLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        ArrayList<Node> m_nodes;
+        I32             m_root          = NULL_NODE;
+        I32             m_freeList      = NULL_NODE;
+        I32             m_proxyCount    = 0;
+        F32             m_fatMargin;
+
+        //----------------------------------------------------------------------
+        I32     _AllocateNode();
+        void    _FreeNode(I32 node);
+        void    _InsertLeaf(I32 leaf);
+        void    _RemoveLeaf(I32 leaf);
+        I32     _Balance(I32 node);
+        void    _RefitAncestors(I32 node);
+
+        NULL_COPY_AND_ASSIGN(DynamicAABBTree)
+    };
+
+    //**********************************************************************
+    // TEMPLATE - PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename TestFunc, typename VisitFunc>
+    void DynamicAABBTree::query( TestFunc test, VisitFunc visit ) const
+    {
+        if (m_root == NULL_NODE)
+            return;
+
+        // Explicit stack, the tree is balanced so 64 entries are enough for any realistic proxy count
+        I32 stack[64];
+        I32 stackSize = 0;
+        stack[stackSize++] = m_root;
+
+        while (stackSize > 0)
+        {
+            I32 nodeID = stack[--stackSize];
+            const Node& node = m_nodes[nodeID];
+
+            if ( not test( node.aabb ) )
+                continue;
+
+            if ( node.isLeaf() )
+            {
+                if ( not visit( nodeID, node.userData ) )
+                    return;
+            }
+            else
+            {
+                ASSERT( stackSize + 2 <= 64 );
+                stack[stackSize++] = node.child1;
+                stack[stackSize++] = node.child2;
+            }
+        }
+    }
+
+}
@@ -6,7 +6,7 @@
     date: March 7, 2018
 **********************************************************************/
 
-#include "dxmath_wrapper.h"
+#include "math_utils.h"
 
 namespace Math {
 
@@ -63,4 +63,42 @@ namespace Math {
         return CalculateFrustumCorners( pos, rot.getUp(), rot.getRight(), rot.getForward(), fovAngleYDeg, zNear, zFar, aspectRatio );
     }
 
+    //----------------------------------------------------------------------
+    void ComposeAffineTransformations( const Transform4& t, DirectX::XMMATRIX* matrices )
+    {
+        const __m128 one = _mm_set1_ps( 1.0f );
+        const __m128 two = _mm_set1_ps( 2.0f );
+
+        __m128 xx = _mm_mul_ps( t.rotationX, t.rotationX ), yy = _mm_mul_ps( t.rotationY, t.rotationY ), zz = _mm_mul_ps( t.rotationZ, t.rotationZ );
+        __m128 xy = _mm_mul_ps( t.rotationX, t.rotationY ), xz = _mm_mul_ps( t.rotationX, t.rotationZ ), yz = _mm_mul_ps( t.rotationY, t.rotationZ );
+        __m128 wx = _mm_mul_ps( t.rotationW, t.rotationX ), wy = _mm_mul_ps( t.rotationW, t.rotationY ), wz = _mm_mul_ps( t.rotationW, t.rotationZ );
+
+        // Rotation matrix scaled by the scale of each axis
+        __m128 m00 = _mm_mul_ps( t.scaleX, _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( yy, zz ) ) ) );
+        __m128 m01 = _mm_mul_ps( t.scaleX, _mm_mul_ps( two, _mm_add_ps( xy, wz ) ) );
+        __m128 m02 = _mm_mul_ps( t.scaleX, _mm_mul_ps( two, _mm_sub_ps( xz, wy ) ) );
+
+        __m128 m10 = _mm_mul_ps( t.scaleY, _mm_mul_ps( two, _mm_sub_ps( xy, wz ) ) );
+        __m128 m11 = _mm_mul_ps( t.scaleY, _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, zz ) ) ) );
+        __m128 m12 = _mm_mul_ps( t.scaleY, _mm_mul_ps( two, _mm_add_ps( yz, wx ) ) );
+
+        __m128 m20 = _mm_mul_ps( t.scaleZ, _mm_mul_ps( two, _mm_add_ps( xz, wy ) ) );
+        __m128 m21 = _mm_mul_ps( t.scaleZ, _mm_mul_ps( two, _mm_sub_ps( yz, wx ) ) );
+        __m128 m22 = _mm_mul_ps( t.scaleZ, _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, yy ) ) ) );
+        __m128 m03 = _mm_setzero_ps(), m13 = _mm_setzero_ps(), m23 = _mm_setzero_ps();
+
+        __m128 px = t.positionX, py = t.positionY, pz = t.positionZ, pw = one;
+
+        // Each vector holds one element of four matrices, transposing turns them into one row of each matrix
+        _MM_TRANSPOSE4_PS( m00, m01, m02, m03 );
+        _MM_TRANSPOSE4_PS( m10, m11, m12, m13 );
+        _MM_TRANSPOSE4_PS( m20, m21, m22, m23 );
+        _MM_TRANSPOSE4_PS( px, py, pz, pw );
+
+        matrices[0] = DirectX::XMMATRIX( m00, m10, m20, px );
+        matrices[1] = DirectX::XMMATRIX( m01, m11, m21, py );
+        matrices[2] = DirectX::XMMATRIX( m02, m12, m22, pz );
+        matrices[3] = DirectX::XMMATRIX( m03, m13, m23, pw );
+    }
+
 }
\ No newline at end of file
@@ -32,6 +32,25 @@ namespace Math {
                                                 F32 fovAngleYDeg, F32 zNear, F32 zFar, F32 aspectRatio);
     std::array<Vec3, 8> CalculateFrustumCorners(const Vec3& pos, const Quat& rot, F32 fovAngleYDeg, F32 zNear, F32 zFar, F32 aspectRatio);
 
+    //----------------------------------------------------------------------
+    // Four transformations, each vector holds the same component of all four.
+    //----------------------------------------------------------------------
+    struct Transform4
+    {
+        __m128 positionX, positionY, positionZ;
+        __m128 rotationX, rotationY, rotationZ, rotationW;
+        __m128 scaleX, scaleY, scaleZ;
+    };
+
+    //----------------------------------------------------------------------
+    // Builds four matrices at once, same as DirectX::XMMatrixAffineTransformation() without a rotation origin.
+    // The rotations must be normalized.
+    // @Params:
+    //  "transforms": One lane per transformation.
+    //  "matrices": Receives four matrices.
+    //----------------------------------------------------------------------
+    void ComposeAffineTransformations(const Transform4& transforms, DirectX::XMMATRIX* matrices);
+
     //----------------------------------------------------------------------
     template <typename T, typename T2, typename T3> inline
     T Clamp( T val, T2 min, T3 max )
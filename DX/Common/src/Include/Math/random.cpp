@@ -11,5 +11,6 @@ namespace Math
 
     //---------------------------------------------------------------------------
     std::default_random_engine Random::engine{ std::random_device{}() };
+    thread_local std::default_random_engine* Random::s_threadEngine = nullptr;
 
 }
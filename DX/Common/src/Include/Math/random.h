@@ -20,8 +20,28 @@ namespace Math
     {
     private:
         static std::default_random_engine engine; 
+        static thread_local std::default_random_engine* s_threadEngine;
+
+        static std::default_random_engine& _GetEngine() { return s_threadEngine ? *s_threadEngine : engine; }
 
     public:
+        //---------------------------------------------------------------------------
+        // Redirects all functions of this class called on the current thread to the given
+        // engine, as long as this object lives. Gives each object its own deterministic
+        // random stream, even if objects are updated in parallel jobs.
+        //---------------------------------------------------------------------------
+        class ScopedEngine
+        {
+        public:
+            ScopedEngine(std::default_random_engine& engine) : m_previous{ s_threadEngine } { s_threadEngine = &engine; }
+            ~ScopedEngine() { s_threadEngine = m_previous; }
+
+        private:
+            std::default_random_engine* m_previous;
+
+            NULL_COPY_AND_ASSIGN(ScopedEngine)
+        };
+
         // Returns an random Integer between [min,max].
         static  I32         Int(I32 min, I32 max);
 
@@ -66,7 +86,7 @@ namespace Math
     //---------------------------------------------------------------------------
     inline I32 Random::Int( I32 min, I32 max )
     {
-        return std::uniform_int_distribution<I32>{ min, max }( engine );
+        return std::uniform_int_distribution<I32>{ min, max }( _GetEngine() );
     }
 
     //---------------------------------------------------------------------------
@@ -78,7 +98,7 @@ namespace Math
     //---------------------------------------------------------------------------
     inline F32 Random::Float( F32 min, F32 max )
     {
-        return std::uniform_real_distribution<F32>{ min, max }( engine );
+        return std::uniform_real_distribution<F32>{ min, max }( _GetEngine() );
     }
 
     //---------------------------------------------------------------------------
@@ -90,7 +110,7 @@ namespace Math
     //---------------------------------------------------------------------------
     inline F64 Random::Double( F64 min, F64 max )
     {
-        return std::uniform_real_distribution<F64>{ min, max }( engine );
+        return std::uniform_real_distribution<F64>{ min, max }( _GetEngine() );
     }
 
     //---------------------------------------------------------------------------
@@ -103,7 +123,7 @@ namespace Math
     inline Math::Vec3 Random::Vec3( F32 min, F32 max )
     {
         auto distribution = std::uniform_real_distribution<F32>{ min, max };
-        return Math::Vec3( distribution( engine ), distribution( engine ), distribution( engine ) );
+        return Math::Vec3( distribution( _GetEngine() ), distribution( _GetEngine() ), distribution( _GetEngine() ) );
     }
 
     //---------------------------------------------------------------------------
@@ -112,35 +132,35 @@ namespace Math
         auto xDistribution = std::uniform_real_distribution<F32>{ std::min( min.x, max.x ), std::max( min.x, max.x ) };
         auto yDistribution = std::uniform_real_distribution<F32>{ std::min( min.y, max.y ), std::max( min.y, max.y ) };
         auto zDistribution = std::uniform_real_distribution<F32>{ std::min( min.z, max.z ), std::max( min.z, max.z ) };
-        return Math::Vec3( xDistribution( engine ), yDistribution( engine ), zDistribution( engine ) );
+        return Math::Vec3( xDistribution( _GetEngine() ), yDistribution( _GetEngine() ), zDistribution( _GetEngine() ) );
     }
 
     //---------------------------------------------------------------------------
     inline Math::Quat Random::Quat()
     {
         auto distribution = std::uniform_real_distribution<F32>{ 0, 1 };
-        return Math::Quat( distribution( engine ), distribution( engine ), distribution( engine ), distribution( engine ) ).normalized();
+        return Math::Quat( distribution( _GetEngine() ), distribution( _GetEngine() ), distribution( _GetEngine() ), distribution( _GetEngine() ) ).normalized();
     }
 
     //---------------------------------------------------------------------------
     template <typename T> inline
     T Random::value()
     {
-        return std::uniform_real_distribution<T>{ 0, 1 }(engine);
+        return std::uniform_real_distribution<T>{ 0, 1 }(_GetEngine());
     }
 
     //---------------------------------------------------------------------------
     template <> inline
     I32 Random::value()
     {
-        return std::uniform_int_distribution<I32>{ 0, 1 }(engine);
+        return std::uniform_int_distribution<I32>{ 0, 1 }(_GetEngine());
     }
 
     //---------------------------------------------------------------------------
     template <typename T> inline
     T Random::value( T min, T max )
     {
-        return std::uniform_real_distribution<T>{ min, max }(engine);
+        return std::uniform_real_distribution<T>{ min, max }(_GetEngine());
     }
 
     //---------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+#pragma once
+/**********************************************************************
+    class: MappedFile (mapped_file.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Read-only view of a whole file mapped into memory. Pages are
+    loaded by the OS on first access, so opening is cheap regardless
+    of the file size and no intermediate copy is made.
+**********************************************************************/
+
+#include "path.h"
+
+namespace OS {
+
+    //*********************************************************************
+    class MappedFile
+    {
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "path": Virtual path or Physical path on disk.
+        // @Throws:
+        //  std::runtime_error() if the file could not be mapped.
+        //----------------------------------------------------------------------
+        explicit MappedFile(const Path& path);
+        ~MappedFile();
+
+        //----------------------------------------------------------------------
+        const Byte* data()          const { return m_data; }
+        Size        size()          const { return m_size; }
+        const Path& getFilePath()   const { return m_filePath; }
+
+    private:
+        Path        m_filePath;
+        const Byte* m_data          = nullptr;
+        Size        m_size          = 0;
+        void*       m_fileHandle    = nullptr;
+        void*       m_mappingHandle = nullptr;
+
+        NULL_COPY_AND_ASSIGN(MappedFile)
+    };
+
+} // end namespaces
@@ -0,0 +1,64 @@
+#include "mapped_file.h"
+/**********************************************************************
+    class: MappedFile (mapped_file_win.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Windows dependant implementations.
+**********************************************************************/
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+namespace OS {
+
+    //----------------------------------------------------------------------
+    MappedFile::MappedFile( const Path& path )
+        : m_filePath( path )
+    {
+        HANDLE hFile = CreateFile( path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+        if (hFile == INVALID_HANDLE_VALUE)
+            throw std::runtime_error( "MappedFile-Windows: Could not open file '" + path.toString() + "'" );
+
+        LARGE_INTEGER fileSize;
+        if ( not GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart == 0 )
+        {
+            CloseHandle( hFile );
+            throw std::runtime_error( "MappedFile-Windows: File '" + path.toString() + "' is empty or its size could not be read" );
+        }
+
+        HANDLE hMapping = CreateFileMapping( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+        if (hMapping == NULL)
+        {
+            CloseHandle( hFile );
+            throw std::runtime_error( "MappedFile-Windows: Could not create a file mapping for '" + path.toString() + "'" );
+        }
+
+        auto view = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+        if (view == NULL)
+        {
+            CloseHandle( hMapping );
+            CloseHandle( hFile );
+            throw std::runtime_error( "MappedFile-Windows: Could not map a view of '" + path.toString() + "'" );
+        }
+
+        m_fileHandle    = hFile;
+        m_mappingHandle = hMapping;
+        m_data          = reinterpret_cast<const Byte*>( view );
+        m_size          = static_cast<Size>( fileSize.QuadPart );
+    }
+
+    //----------------------------------------------------------------------
+    MappedFile::~MappedFile()
+    {
+        UnmapViewOfFile( m_data );
+        CloseHandle( m_mappingHandle );
+        CloseHandle( m_fileHandle );
+    }
+
+} // end namespaces
+
+#endif
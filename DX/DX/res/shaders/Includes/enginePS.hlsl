@@ -4,7 +4,7 @@
 // "camera": Per camera constant buffer.
 // "light": Per light constant buffer.
 
-#define MAX_LIGHTS 					16
+#define MAX_LIGHTS 					128
 #define MAX_SHADOWMAPS_2D			4
 #define MAX_SHADOWMAPS_3D 			1
 #define DIRECTIONAL_LIGHT 			0
@@ -68,6 +68,7 @@ cbuffer cbBufferLights : register(b3)
 	float4x4 	_LightViewProj[MAX_SHADOWMAPS_2D];
 	CSMSplit	_CSMSplits[MAX_CSM_SPLITS];
 	int 		_LightCount; // 4 bytes
+	int4		_ClusterCount; // numX, numY, numZ, numGlobalLights. Zero if no clusters are set.
 };
 
 Texture2D shadowMap0 : register(t9);
@@ -88,6 +89,9 @@ SamplerState shadowMapCubeSampler0 : register(s13);
 Texture2DArray shadowMapCascades : register(t14);
 SamplerState shadowMapCascadesSampler : register(s14);
 
+// Clusters (offset, count) followed by the global light indices and the light indices of all clusters (index, 0)
+Texture2D<float2> _LightClusters : register(t15);
+
 //**********************************************************************
 // 2D SHADOWS (Dirlight + Spotlight)
 //**********************************************************************
@@ -412,6 +416,35 @@ float4 VISUALIZE_CASCADES( float3 P )
 	return float4(1,1,1,1);
 }
 
+//**********************************************************************
+// LIGHT CLUSTERS
+//**********************************************************************
+
+//-----------------------------------------------
+float2 LOAD_LIGHT_CLUSTER_TEXEL( int index )
+{
+	uint width, height;
+	_LightClusters.GetDimensions( width, height );
+	return _LightClusters.Load( int3( index % width, index / width, 0 ) );
+}
+
+//-----------------------------------------------
+// @Return: Index of the cluster containing the given world position (see LightClusters::getClusterIndex())
+//-----------------------------------------------
+int GET_LIGHT_CLUSTER( float3 P )
+{
+	float4 viewPos = mul( _View, float4( P, 1 ) );
+	float4 clipPos = mul( _Proj, viewPos );
+	float2 ndc = clipPos.xy / clipPos.w;
+
+	int x = clamp( int( (ndc.x * 0.5 + 0.5) * _ClusterCount.x ), 0, _ClusterCount.x - 1 );
+	int y = clamp( int( (0.5 - ndc.y * 0.5) * _ClusterCount.y ), 0, _ClusterCount.y - 1 );
+	float slice = log( max( viewPos.z, _zNear ) / _zNear ) / log( _zFar / _zNear ) * _ClusterCount.z;
+	int z = clamp( int( slice ), 0, _ClusterCount.z - 1 );
+
+	return x + y * _ClusterCount.x + z * _ClusterCount.x * _ClusterCount.y;
+}
+
 //**********************************************************************
 // MISC FUNCTIONS
 //**********************************************************************
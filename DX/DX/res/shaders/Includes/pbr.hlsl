@@ -218,6 +218,23 @@ float3 getIBL( float3 albedo, float3 V, float3 P, float3 N, float roughness, flo
 	return ibl;
 }
 
+//----------------------------------------------------------------------
+// @Return: Radiance of the light with the given index
+//----------------------------------------------------------------------
+float3 DoLight( int index, float3 albedo, float3 V, float3 P, float3 N, float roughness, float metallic )
+{
+	switch( _Lights[index].lightType )
+	{
+	case DIRECTIONAL_LIGHT:
+		return DoDirectionalLight( _Lights[index], albedo, V, P, N, roughness, metallic );
+	case POINT_LIGHT:
+		return DoPointLight( _Lights[index], albedo, V, P, N, roughness, metallic );
+	case SPOT_LIGHT:
+		return DoSpotLight( _Lights[index], albedo, V, P, N, roughness, metallic );
+	}
+	return float3( 0, 0, 0 );
+}
+
 //----------------------------------------------------------------------
 // Applies lighting to a given fragment.
 // @Params:
@@ -234,21 +251,24 @@ float4 APPLY_LIGHTING( float4 fragColor, float3 P, float3 normal, float roughnes
 	
 	float3 Lo = { 0, 0, 0 };
 	
-    [unroll]
-	for (int i = 0; i < _LightCount; i++)
+	if ( _ClusterCount.x > 0 )
+	{
+		// Only lights in the cluster of this fragment. Global lights are stored right after the clusters.
+		int numClusters = _ClusterCount.x * _ClusterCount.y * _ClusterCount.z;
+		[loop]
+		for (int i = 0; i < _ClusterCount.w; i++)
+			Lo += DoLight( (int)LOAD_LIGHT_CLUSTER_TEXEL( numClusters + i ).x, fragColor.rgb, V, P, N, roughness, metallic );
+
+		float2 cluster = LOAD_LIGHT_CLUSTER_TEXEL( GET_LIGHT_CLUSTER( P ) );
+		[loop]
+		for (int j = 0; j < (int)cluster.y; j++)
+			Lo += DoLight( (int)LOAD_LIGHT_CLUSTER_TEXEL( (int)cluster.x + j ).x, fragColor.rgb, V, P, N, roughness, metallic );
+	}
+	else
 	{
-        switch( _Lights[i].lightType )
-        {
-        case DIRECTIONAL_LIGHT:
-            Lo += DoDirectionalLight( _Lights[i], fragColor.rgb, V, P, N, roughness, metallic );
-            break;
-		case POINT_LIGHT:		
-            Lo += DoPointLight( _Lights[i], fragColor.rgb, V, P, N, roughness, metallic );
-            break;
-		case SPOT_LIGHT:
-			Lo += DoSpotLight( _Lights[i], fragColor.rgb, V, P, N, roughness, metallic );
-            break;
-        }
+		[loop]
+		for (int k = 0; k < _LightCount; k++)
+			Lo += DoLight( k, fragColor.rgb, V, P, N, roughness, metallic );
 	}
 	
 	float3 lighting = fragColor.rgb * Lo;	
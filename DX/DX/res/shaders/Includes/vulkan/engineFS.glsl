@@ -2,7 +2,7 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-#define MAX_LIGHTS 					16
+#define MAX_LIGHTS 					128
 #define ALPHA_THRESHOLD 			0.1
 #define SET_FIRST                   1
 
@@ -80,6 +80,7 @@ layout (set = 0, binding = 2) uniform LIGHTS
 	mat4 	 viewProj[MAX_SHADOWMAPS_2D];
 	CSMSplit CSMSplits[MAX_CSM_SPLITS];
 	int 	 count; // 4 bytes
+	ivec4 	 clusterCount; // numX, numY, numZ, numGlobalLights. Zero if no clusters are set.
 } _Lights;
 
 layout (set = 0, binding = 3) uniform sampler2D shadowMap0;
@@ -89,6 +90,9 @@ layout (set = 0, binding = 6) uniform sampler2D shadowMap3;
 layout (set = 0, binding = 7) uniform samplerCube shadowMapCube0;
 layout (set = 0, binding = 8) uniform sampler2DArray shadowMapCascades;
 
+// Clusters (offset, count) followed by the global light indices and the light indices of all clusters (index, 0)
+layout (set = 0, binding = 9) uniform sampler2D lightClusters;
+
 //-----------------------------------------------
 float saturate( float val )
 {
@@ -414,6 +418,35 @@ vec4 VISUALIZE_CASCADES( vec3 P )
 	return vec4(1,1,1,1);
 }
 
+//**********************************************************************
+// LIGHT CLUSTERS
+//**********************************************************************
+
+//-----------------------------------------------
+vec2 LOAD_LIGHT_CLUSTER_TEXEL( int index )
+{
+	int width = textureSize( lightClusters, 0 ).x;
+	return texelFetch( lightClusters, ivec2( index % width, index / width ), 0 ).rg;
+}
+
+//-----------------------------------------------
+// @Return: Index of the cluster containing the given world position (see LightClusters::getClusterIndex())
+//-----------------------------------------------
+int GET_LIGHT_CLUSTER( vec3 P )
+{
+	ivec4 count = _Lights.clusterCount;
+	vec4 viewPos = _Camera.view * vec4( P, 1 );
+	vec4 clipPos = _Camera.proj * viewPos;
+	vec2 ndc = clipPos.xy / clipPos.w;
+
+	int x = clamp( int( (ndc.x * 0.5 + 0.5) * count.x ), 0, count.x - 1 );
+	int y = clamp( int( (0.5 - ndc.y * 0.5) * count.y ), 0, count.y - 1 );
+	float slice = log( max( viewPos.z, _Camera.zNear ) / _Camera.zNear ) / log( _Camera.zFar / _Camera.zNear ) * count.z;
+	int z = clamp( int( slice ), 0, count.z - 1 );
+
+	return x + y * count.x + z * count.x * count.y;
+}
+
 //**********************************************************************
 // MISC FUNCTIONS
 //**********************************************************************
@@ -211,6 +211,23 @@ vec3 getIBL( vec3 albedo, vec3 V, vec3 P, vec3 N, float roughness, float metalli
 	return ibl;
 }
 
+//----------------------------------------------------------------------
+// @Return: Radiance of the light with the given index
+//----------------------------------------------------------------------
+vec3 DoLight( int index, vec3 albedo, vec3 V, vec3 P, vec3 N, float roughness, float metallic )
+{
+	switch( _Lights.lights[index].lightType )
+	{
+	case DIRECTIONAL_LIGHT:
+		return DoDirectionalLight( _Lights.lights[index], albedo, V, P, N, roughness, metallic );
+	case POINT_LIGHT:
+		return DoPointLight( _Lights.lights[index], albedo, V, P, N, roughness, metallic );
+	case SPOT_LIGHT:
+		return DoSpotLight( _Lights.lights[index], albedo, V, P, N, roughness, metallic );
+	}
+	return vec3( 0, 0, 0 );
+}
+
 //----------------------------------------------------------------------
 // Applies lighting to a given fragment.
 // @Params:
@@ -227,20 +244,22 @@ vec4 APPLY_LIGHTING( vec4 fragColor, vec3 P, vec3 normal, float roughness, float
 	
 	vec3 Lo = { 0, 0, 0 };
 
-	for (int i = 0; i < _Lights.count; i++)
+	ivec4 clusterCount = _Lights.clusterCount;
+	if ( clusterCount.x > 0 )
+	{
+		// Only lights in the cluster of this fragment. Global lights are stored right after the clusters.
+		int numClusters = clusterCount.x * clusterCount.y * clusterCount.z;
+		for (int i = 0; i < clusterCount.w; i++)
+			Lo += DoLight( int( LOAD_LIGHT_CLUSTER_TEXEL( numClusters + i ).x ), fragColor.rgb, V, P, N, roughness, metallic );
+
+		vec2 cluster = LOAD_LIGHT_CLUSTER_TEXEL( GET_LIGHT_CLUSTER( P ) );
+		for (int i = 0; i < int( cluster.y ); i++)
+			Lo += DoLight( int( LOAD_LIGHT_CLUSTER_TEXEL( int( cluster.x ) + i ).x ), fragColor.rgb, V, P, N, roughness, metallic );
+	}
+	else
 	{
-        switch( _Lights.lights[i].lightType )
-        {
-        case DIRECTIONAL_LIGHT:
-            Lo += DoDirectionalLight( _Lights.lights[i], fragColor.rgb, V, P, N, roughness, metallic );
-            break;
-		case POINT_LIGHT:		
-            Lo += DoPointLight( _Lights.lights[i], fragColor.rgb, V, P, N, roughness, metallic );
-            break;
-		case SPOT_LIGHT:
-			Lo += DoSpotLight( _Lights.lights[i], fragColor.rgb, V, P, N, roughness, metallic );
-            break;
-        }
+		for (int i = 0; i < _Lights.count; i++)
+			Lo += DoLight( i, fragColor.rgb, V, P, N, roughness, metallic );
 	}
 	
 	vec3 lighting = fragColor.rgb * Lo;	
@@ -100,8 +100,11 @@ float getMetallic( float2 uv )
 //----------------------------------------------------------------------
 float3 getNormal( float3x3 TBN, float2 uv )
 {
-	float3 normal = normalMap.Sample( samplerNormalMap, uv ).rgb; 
-	normal = normalize( normal * 2.0 - 1.0 ); 
+	// Z is reconstructed, because compressed normal maps (BC5) store only x and y
+	float3 normal;
+	normal.xy = normalMap.Sample( samplerNormalMap, uv ).rg * 2.0 - 1.0;
+	normal.z = sqrt( saturate( 1.0 - dot( normal.xy, normal.xy ) ) );
+	normal = normalize( normal ); 
 	return mul( TBN, normal );  
 }
  
@@ -192,8 +195,11 @@ float getMetallic( vec2 uv )
 //----------------------------------------------------------------------
 vec3 getNormal( mat3 TBN, vec2 uv )
 {
-	vec3 normal = texture( normalMap, uv ).rgb; 
-	normal = normalize( normal * 2.0 - 1.0 ); 
+	// Z is reconstructed, because compressed normal maps (BC5) store only x and y
+	vec3 normal;
+	normal.xy = texture( normalMap, uv ).rg * 2.0 - 1.0;
+	normal.z = sqrt( clamp( 1.0 - dot( normal.xy, normal.xy ), 0.0, 1.0 ) );
+	normal = normalize( normal ); 
 	return TBN * normal;  
 }
  
@@ -0,0 +1,273 @@
+#include "animation_clip.h"
+/**********************************************************************
+    class: AnimationClip (animation_clip.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Math/math_utils.h"
+
+namespace Animation { 
+
+    // Amount of joints which are sampled at once from the packed keys
+    static constexpr U32 SIMD_WIDTH = 4;
+
+    // Translation xyz, rotation xyzw, scale xyz
+    static constexpr U32 NUM_PACKED_COMPONENTS = 10;
+
+    //----------------------------------------------------------------------
+    static U32 AlignToSimdWidth( U32 count ) { return (count + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1); }
+
+    //----------------------------------------------------------------------
+    // Moves the cursor to the key at or before the given time. Keys must contain at least two elements.
+    // @Return:
+    //  Lerp factor between the key at the cursor and the next one.
+    //----------------------------------------------------------------------
+    template <typename TKey>
+    static F32 SeekKey( const ArrayList<TKey>& keys, Time::Seconds time, U32& cursor )
+    {
+        U32 lastBegin = static_cast<U32>( keys.size() ) - 2;
+
+        // Clip was restarted or looped, so search from the beginning again
+        if (cursor > lastBegin || time < keys[cursor].time)
+            cursor = 0;
+
+        while (cursor < lastBegin && time > keys[cursor + 1].time)
+            cursor++;
+
+        F64 span = (keys[cursor + 1].time - keys[cursor].time).value;
+        F64 lerp = span > 0.0 ? (time - keys[cursor].time).value / span : 0.0;
+        return static_cast<F32>( std::clamp( lerp, 0.0, 1.0 ) );
+    }
+
+    //----------------------------------------------------------------------
+    static DirectX::XMVECTOR SampleTranslation( const ArrayList<TranslationKey>& keys, U32 key, F32 lerp )
+    {
+        if (keys.size() == 1)
+            return DirectX::XMLoadFloat3( &keys.front().translation );
+
+        key = std::min( key, static_cast<U32>( keys.size() ) - 2 );
+        return DirectX::XMVectorLerp( DirectX::XMLoadFloat3( &keys[key].translation ), DirectX::XMLoadFloat3( &keys[key + 1].translation ), lerp );
+    }
+
+    //----------------------------------------------------------------------
+    static DirectX::XMVECTOR SampleRotation( const ArrayList<RotationKey>& keys, U32 key, F32 lerp )
+    {
+        if (keys.size() == 1)
+            return DirectX::XMLoadFloat4( &keys.front().rotation );
+
+        key = std::min( key, static_cast<U32>( keys.size() ) - 2 );
+        return DirectX::XMQuaternionSlerp( DirectX::XMLoadFloat4( &keys[key].rotation ), DirectX::XMLoadFloat4( &keys[key + 1].rotation ), lerp );
+    }
+
+    //----------------------------------------------------------------------
+    static DirectX::XMVECTOR SampleScale( const ArrayList<ScalingKey>& keys, U32 key, F32 lerp )
+    {
+        if (keys.size() == 1)
+            return DirectX::XMLoadFloat3( &keys.front().scale );
+
+        key = std::min( key, static_cast<U32>( keys.size() ) - 2 );
+        return DirectX::XMVectorLerp( DirectX::XMLoadFloat3( &keys[key].scale ), DirectX::XMLoadFloat3( &keys[key + 1].scale ), lerp );
+    }
+
+    //----------------------------------------------------------------------
+    // Samples the given channel at the given time from the cursor. Channels must not be empty.
+    //----------------------------------------------------------------------
+    static DirectX::XMVECTOR SampleChannel( const ArrayList<TranslationKey>& keys, Time::Seconds time, U32& cursor )
+    {
+        F32 lerp = keys.size() > 1 ? SeekKey( keys, time, cursor ) : 0.0f;
+        return SampleTranslation( keys, cursor, lerp );
+    }
+
+    static DirectX::XMVECTOR SampleChannel( const ArrayList<RotationKey>& keys, Time::Seconds time, U32& cursor )
+    {
+        F32 lerp = keys.size() > 1 ? SeekKey( keys, time, cursor ) : 0.0f;
+        return SampleRotation( keys, cursor, lerp );
+    }
+
+    static DirectX::XMVECTOR SampleChannel( const ArrayList<ScalingKey>& keys, Time::Seconds time, U32& cursor )
+    {
+        F32 lerp = keys.size() > 1 ? SeekKey( keys, time, cursor ) : 0.0f;
+        return SampleScale( keys, cursor, lerp );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void AnimationClip::resample( F32 samplesPerSecond )
+    {
+        ASSERT( samplesPerSecond > 0.0f );
+        if (duration <= 0.0)
+            return;
+
+        U32 numKeys = std::max( static_cast<U32>( std::ceil( duration.value * samplesPerSecond ) ) + 1, 2u );
+
+        for (auto& joint : jointSamples)
+        {
+            JointCursor cursor;
+            ArrayList<TranslationKey>   translationKeys;
+            ArrayList<RotationKey>      rotationKeys;
+            ArrayList<ScalingKey>       scalingKeys;
+
+            for (U32 i = 0; i < numKeys; i++)
+            {
+                Time::Seconds time = std::min( i / static_cast<F64>( samplesPerSecond ), duration.value );
+
+                if (joint.translationKeys.size() > 1)
+                {
+                    TranslationKey key{ {}, time };
+                    DirectX::XMStoreFloat3( &key.translation, SampleChannel( joint.translationKeys, time, cursor.translation ) );
+                    translationKeys.push_back( key );
+                }
+
+                if (joint.rotationKeys.size() > 1)
+                {
+                    RotationKey key{ {}, time };
+                    DirectX::XMStoreFloat4( &key.rotation, SampleChannel( joint.rotationKeys, time, cursor.rotation ) );
+                    rotationKeys.push_back( key );
+                }
+
+                if (joint.scalingKeys.size() > 1)
+                {
+                    ScalingKey key{ {}, time };
+                    DirectX::XMStoreFloat3( &key.scale, SampleChannel( joint.scalingKeys, time, cursor.scale ) );
+                    scalingKeys.push_back( key );
+                }
+            }
+
+            if (joint.translationKeys.size() > 1) joint.translationKeys = std::move( translationKeys );
+            if (joint.rotationKeys.size() > 1)    joint.rotationKeys    = std::move( rotationKeys );
+            if (joint.scalingKeys.size() > 1)     joint.scalingKeys     = std::move( scalingKeys );
+        }
+
+        sampleRate = samplesPerSecond;
+        _PackKeys( numKeys );
+    }
+
+    //----------------------------------------------------------------------
+    void AnimationClip::samplePose( Time::Seconds time, ArrayList<JointCursor>& cursors, DirectX::XMMATRIX* localPoses ) const
+    {
+        if ( isUniformlySampled() )
+        {
+            // Every channel has keys at the same times, so the key index + lerp factor is the same for all joints
+            // The last key sits at the end of the clip, so the last interval can be shorter than the others
+            U32 numIntervals = std::max( static_cast<U32>( std::ceil( duration.value * sampleRate ) ), 1u );
+            U32 key = std::min( static_cast<U32>( std::max( time.value, 0.0 ) * sampleRate ), numIntervals - 1 );
+
+            F64 keyTime = key / static_cast<F64>( sampleRate );
+            F64 span    = std::min( (key + 1) / static_cast<F64>( sampleRate ), duration.value ) - keyTime;
+            F32 lerp    = span > 0.0 ? static_cast<F32>( std::clamp( (time.value - keyTime) / span, 0.0, 1.0 ) ) : 0.0f;
+
+            _SamplePackedPose( key, lerp, localPoses );
+            return;
+        }
+
+        cursors.resize( jointSamples.size() );
+        for (U32 i = 0; i < jointSamples.size(); i++)
+        {
+            auto& joint = jointSamples[i];
+            auto p = SampleChannel( joint.translationKeys, time, cursors[i].translation );
+            auto r = SampleChannel( joint.rotationKeys, time, cursors[i].rotation );
+            auto s = SampleChannel( joint.scalingKeys, time, cursors[i].scale );
+            localPoses[i] = DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
+        }
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void AnimationClip::_PackKeys( U32 numKeys )
+    {
+        U32 numJoints = getJointCount();
+        U32 stride = AlignToSimdWidth( numJoints );
+
+        // Padding joints get an identity transformation, so the unused lanes stay finite
+        packedKeys.assign( numKeys * NUM_PACKED_COMPONENTS * stride, 0.0f );
+        for (U32 k = 0; k < numKeys; k++)
+        {
+            F32* keyBegin = packedKeys.data() + k * NUM_PACKED_COMPONENTS * stride;
+            for (U32 j = numJoints; j < stride; j++)
+                for (U32 c : { 6, 7, 8, 9 }) // Rotation w + scale
+                    keyBegin[c * stride + j] = 1.0f;
+
+            for (U32 j = 0; j < numJoints; j++)
+            {
+                // Channels with a single key are constant
+                auto& joint = jointSamples[j];
+                auto& p = joint.translationKeys[std::min( k, static_cast<U32>( joint.translationKeys.size() ) - 1 )].translation;
+                auto& r = joint.rotationKeys[std::min( k, static_cast<U32>( joint.rotationKeys.size() ) - 1 )].rotation;
+                auto& s = joint.scalingKeys[std::min( k, static_cast<U32>( joint.scalingKeys.size() ) - 1 )].scale;
+
+                F32 components[NUM_PACKED_COMPONENTS] = { p.x, p.y, p.z, r.x, r.y, r.z, r.w, s.x, s.y, s.z };
+                for (U32 c = 0; c < NUM_PACKED_COMPONENTS; c++)
+                    keyBegin[c * stride + j] = components[c];
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void AnimationClip::_SamplePackedPose( U32 key, F32 lerp, DirectX::XMMATRIX* localPoses ) const
+    {
+        U32 numJoints = getJointCount();
+        U32 stride = AlignToSimdWidth( numJoints );
+        const F32* keyA = packedKeys.data() + key * NUM_PACKED_COMPONENTS * stride;
+        const F32* keyB = keyA + NUM_PACKED_COMPONENTS * stride;
+
+        const __m128 t        = _mm_set1_ps( lerp );
+        const __m128 signMask = _mm_set1_ps( -0.0f );
+
+        for (U32 j = 0; j < stride; j += SIMD_WIDTH)
+        {
+            auto lerpComponent = [&]( U32 c ) {
+                __m128 a = _mm_loadu_ps( keyA + c * stride + j );
+                __m128 b = _mm_loadu_ps( keyB + c * stride + j );
+                return _mm_add_ps( a, _mm_mul_ps( _mm_sub_ps( b, a ), t ) );
+            };
+
+            Math::Transform4 transforms;
+            transforms.positionX = lerpComponent( 0 );
+            transforms.positionY = lerpComponent( 1 );
+            transforms.positionZ = lerpComponent( 2 );
+            transforms.scaleX    = lerpComponent( 7 );
+            transforms.scaleY    = lerpComponent( 8 );
+            transforms.scaleZ    = lerpComponent( 9 );
+
+            // Take the shortest path between the rotations by flipping the second one if they point in opposite directions
+            __m128 ax = _mm_loadu_ps( keyA + 3 * stride + j ), bx = _mm_loadu_ps( keyB + 3 * stride + j );
+            __m128 ay = _mm_loadu_ps( keyA + 4 * stride + j ), by = _mm_loadu_ps( keyB + 4 * stride + j );
+            __m128 az = _mm_loadu_ps( keyA + 5 * stride + j ), bz = _mm_loadu_ps( keyB + 5 * stride + j );
+            __m128 aw = _mm_loadu_ps( keyA + 6 * stride + j ), bw = _mm_loadu_ps( keyB + 6 * stride + j );
+            __m128 dot = _mm_add_ps( _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) ), _mm_add_ps( _mm_mul_ps( az, bz ), _mm_mul_ps( aw, bw ) ) );
+            __m128 flip = _mm_and_ps( _mm_cmplt_ps( dot, _mm_setzero_ps() ), signMask );
+            bx = _mm_xor_ps( bx, flip ); by = _mm_xor_ps( by, flip ); bz = _mm_xor_ps( bz, flip ); bw = _mm_xor_ps( bw, flip );
+
+            __m128 qx = _mm_add_ps( ax, _mm_mul_ps( _mm_sub_ps( bx, ax ), t ) );
+            __m128 qy = _mm_add_ps( ay, _mm_mul_ps( _mm_sub_ps( by, ay ), t ) );
+            __m128 qz = _mm_add_ps( az, _mm_mul_ps( _mm_sub_ps( bz, az ), t ) );
+            __m128 qw = _mm_add_ps( aw, _mm_mul_ps( _mm_sub_ps( bw, aw ), t ) );
+            __m128 length = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( qx, qx ), _mm_mul_ps( qy, qy ) ), _mm_add_ps( _mm_mul_ps( qz, qz ), _mm_mul_ps( qw, qw ) ) ) );
+            transforms.rotationX = _mm_div_ps( qx, length );
+            transforms.rotationY = _mm_div_ps( qy, length );
+            transforms.rotationZ = _mm_div_ps( qz, length );
+            transforms.rotationW = _mm_div_ps( qw, length );
+
+            // The last group may contain padding joints, which must not be written to the output
+            if (j + SIMD_WIDTH <= numJoints)
+            {
+                Math::ComposeAffineTransformations( transforms, localPoses + j );
+            }
+            else
+            {
+                DirectX::XMMATRIX matrices[SIMD_WIDTH];
+                Math::ComposeAffineTransformations( transforms, matrices );
+                std::copy( matrices, matrices + (numJoints - j), localPoses + j );
+            }
+        }
+    }
+
+} // End namespaces
\ No newline at end of file
@@ -1,9 +1,23 @@
 #pragma once
 /**********************************************************************
-    class: Skeleton 
+    class: AnimationClip (animation_clip.h)
 
     author: S. Hau
     date: October 29, 2018
+
+    Keys of a clip can either have arbitrary times or be resampled to a
+    uniform rate. Sampling a resampled clip finds the keys in O(1) and
+    shares the keyframe index + lerp factor between all joints. The keys
+    of a resampled clip are also packed by component across all joints,
+    so four joints are interpolated at once with SSE. Rotations are
+    normalized lerped there, which is close to a slerp for keys which are
+    that close to each other. Keys of
+    clips with arbitrary times are searched from a cursor per joint,
+    which is kept by the caller between frames, so the cost does not
+    grow with the length of the clip while it is played forward.
+    Clips are immutable after import and shared via AnimationClipPtr.
+    Other clip representations (e.g. compressed clips) implement the
+    same IAnimationClip interface, so they can be played in the same way.
 **********************************************************************/
 
 #include "Time/durations.h"
@@ -40,12 +54,75 @@ namespace Animation {
         ArrayList<ScalingKey>       scalingKeys;
     };
 
+    //----------------------------------------------------------------------
+    // Index of the last used key per channel of a joint
+    //----------------------------------------------------------------------
+    struct JointCursor
+    {
+        U32 translation = 0;
+        U32 rotation    = 0;
+        U32 scale       = 0;
+    };
+
+    //*********************************************************************
+    // Interface for a clip which can be played by a skinned mesh renderer.
     //*********************************************************************
-    struct AnimationClip
+    class IAnimationClip
+    {
+    public:
+        virtual ~IAnimationClip() = default;
+
+        //----------------------------------------------------------------------
+        virtual StringID        getName()       const = 0;
+        virtual Time::Seconds   getDuration()   const = 0;
+        virtual U32             getJointCount() const = 0;
+
+        //----------------------------------------------------------------------
+        // Samples the local transform of every joint at the given time.
+        // @Params:
+        //  "time": Time in [0, duration].
+        //  "cursors": Keeps the key positions per joint between calls. Resized if necessary.
+        //  "localPoses": Receives one matrix per joint.
+        //----------------------------------------------------------------------
+        virtual void samplePose(Time::Seconds time, ArrayList<JointCursor>& cursors, DirectX::XMMATRIX* localPoses) const = 0;
+    };
+
+    //*********************************************************************
+    struct AnimationClip : public IAnimationClip
     {
         StringID name;
         Time::Seconds duration;
         ArrayList<JointSamples> jointSamples;
+        F32 sampleRate = 0.0f; // Keys per second if resampled, 0 if keys have arbitrary times
+
+        // Keys of a resampled clip, one array of all joints per key and component (translation xyz, rotation xyzw, scale xyz).
+        // The joint count is padded to a multiple of four.
+        ArrayList<F32> packedKeys;
+
+        //----------------------------------------------------------------------
+        StringID        getName()       const override { return name; }
+        Time::Seconds   getDuration()   const override { return duration; }
+        U32             getJointCount() const override { return static_cast<U32>( jointSamples.size() ); }
+        bool            isUniformlySampled() const { return sampleRate > 0.0f; }
+
+        //----------------------------------------------------------------------
+        // Replaces the keys of every joint by keys with a fixed distance, beginning at time zero.
+        // Channels with a single key are kept as they are.
+        // @Params:
+        //  "samplesPerSecond": Amount of keys per second.
+        //----------------------------------------------------------------------
+        void resample(F32 samplesPerSecond);
+
+        //----------------------------------------------------------------------
+        // Cursors are only used if the clip is not uniformly sampled.
+        //----------------------------------------------------------------------
+        void samplePose(Time::Seconds time, ArrayList<JointCursor>& cursors, DirectX::XMMATRIX* localPoses) const override;
+
+    private:
+        void _PackKeys(U32 numKeys);
+        void _SamplePackedPose(U32 key, F32 lerp, DirectX::XMMATRIX* localPoses) const;
     };
 
-} // End namespaces
\ No newline at end of file
+    using AnimationClipPtr = std::shared_ptr<const IAnimationClip>;
+
+} // End namespaces
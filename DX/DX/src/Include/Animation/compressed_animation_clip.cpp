@@ -0,0 +1,400 @@
+#include "compressed_animation_clip.h"
+/**********************************************************************
+    class: CompressedAnimationClip (compressed_animation_clip.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+namespace Animation { 
+
+    static const F32 SQRT2           = 1.41421356f;
+    static const F32 MAX_U15         = 32767.0f;
+    static const F32 MAX_U16         = 65535.0f;
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  The value of the given keys at every frame. Keys must either be uniformly sampled or contain a single key.
+    //----------------------------------------------------------------------
+    template <typename TKey, typename LoadFunc>
+    static ArrayList<DirectX::XMVECTOR> GatherValues( const ArrayList<TKey>& keys, U32 numFrames, DirectX::FXMVECTOR defaultValue, LoadFunc load )
+    {
+        ArrayList<DirectX::XMVECTOR> values( numFrames, defaultValue );
+        if ( not keys.empty() )
+            for (U32 f = 0; f < numFrames; f++)
+                values[f] = load( keys[std::min<Size>( f, keys.size() - 1 )] );
+        return values;
+    }
+
+    static DirectX::XMVECTOR LoadTranslation( const TranslationKey& key ) { return DirectX::XMLoadFloat3( &key.translation ); }
+    static DirectX::XMVECTOR LoadRotation( const RotationKey& key )       { return DirectX::XMQuaternionNormalize( DirectX::XMLoadFloat4( &key.rotation ) ); }
+    static DirectX::XMVECTOR LoadScale( const ScalingKey& key )           { return DirectX::XMLoadFloat3( &key.scale ); }
+
+    //----------------------------------------------------------------------
+    static F32 VectorError( DirectX::FXMVECTOR a, DirectX::FXMVECTOR b )
+    {
+        return DirectX::XMVectorGetX( DirectX::XMVector3Length( DirectX::XMVectorSubtract( a, b ) ) );
+    }
+
+    //----------------------------------------------------------------------
+    static F32 RotationError( DirectX::FXMVECTOR a, DirectX::FXMVECTOR b )
+    {
+        F32 dot = std::min( std::abs( DirectX::XMVectorGetX( DirectX::XMQuaternionDot( a, b ) ) ), 1.0f );
+        return DirectX::XMConvertToDegrees( 2.0f * std::acos( dot ) );
+    }
+
+    //----------------------------------------------------------------------
+    // Removes every key which can be reconstructed by interpolating between the surrounding kept keys.
+    // @Return:
+    //  Indices of the kept keys. A single index if the whole track is constant.
+    //----------------------------------------------------------------------
+    template <typename LerpFunc, typename ErrorFunc>
+    static ArrayList<U32> ReduceKeys( const ArrayList<DirectX::XMVECTOR>& values, F32 tolerance, LerpFunc lerp, ErrorFunc error )
+    {
+        bool isConstant = true;
+        for (auto& value : values)
+            isConstant = isConstant && error( value, values.front() ) <= tolerance;
+        if (isConstant)
+            return { 0 };
+
+        // Extend the current segment as long as all keys in between can be interpolated
+        ArrayList<U32> kept{ 0 };
+        U32 begin = 0;
+        for (U32 end = 2; end < values.size(); end++)
+        {
+            for (U32 i = begin + 1; i < end; i++)
+            {
+                F32 t = static_cast<F32>( i - begin ) / (end - begin);
+                if ( error( lerp( values[begin], values[end], t ), values[i] ) > tolerance )
+                {
+                    begin = end - 1;
+                    kept.push_back( begin );
+                    break;
+                }
+            }
+        }
+        kept.push_back( static_cast<U32>( values.size() ) - 1 );
+
+        return kept;
+    }
+
+    //----------------------------------------------------------------------
+    // Moves the cursor to the key at or before the given frame. Requires at least two keys.
+    // @Return:
+    //  Lerp factor between the key at the cursor and the next one.
+    //----------------------------------------------------------------------
+    static F32 SeekFrame( const U16* frames, U32 numKeys, F32 frame, U32& cursor )
+    {
+        U32 lastBegin = numKeys - 2;
+        if (cursor > lastBegin || frame < frames[cursor])
+            cursor = 0;
+
+        while (cursor < lastBegin && frame > frames[cursor + 1])
+            cursor++;
+
+        F32 span = static_cast<F32>( frames[cursor + 1] - frames[cursor] );
+        return std::clamp( (frame - frames[cursor]) / span, 0.0f, 1.0f );
+    }
+
+    //----------------------------------------------------------------------
+    CompressedAnimationClip::CompressedAnimationClip( const AnimationClip& clip, const CompressionSettings& settings )
+        : m_name( clip.name ), m_duration( clip.duration )
+    {
+        // Key reduction works on frames with a fixed distance
+        AnimationClip resampled;
+        const AnimationClip* source = &clip;
+        if ( not clip.isUniformlySampled() )
+        {
+            resampled = clip;
+            resampled.resample( settings.sampleRate );
+            source = &resampled;
+        }
+
+        // Clips without a duration can't be resampled, so only the first key of every track is used
+        if ( source->isUniformlySampled() )
+        {
+            m_sampleRate = source->sampleRate;
+            m_numFrames  = std::max( static_cast<U32>( std::ceil( m_duration.value * m_sampleRate ) ), 1u ) + 1;
+        }
+        ASSERT( m_numFrames <= std::numeric_limits<U16>::max() );
+
+        auto vectorLerp   = [](DirectX::FXMVECTOR a, DirectX::FXMVECTOR b, F32 t) { return DirectX::XMVectorLerp( a, b, t ); };
+        auto rotationLerp = [](DirectX::FXMVECTOR a, DirectX::FXMVECTOR b, F32 t) { return DirectX::XMQuaternionSlerp( a, b, t ); };
+
+        for (auto& joint : source->jointSamples)
+        {
+            JointTracks tracks;
+
+            auto translations = GatherValues( joint.translationKeys, m_numFrames, DirectX::XMVectorZero(), LoadTranslation );
+            tracks.translation = _AddVectorTrack( translations, ReduceKeys( translations, settings.translationTolerance, vectorLerp, VectorError ),
+                                                  m_translationFrames, m_translationKeys );
+
+            // Keep neighbouring rotations in the same hemisphere, so interpolating between them takes the short way
+            auto rotations = GatherValues( joint.rotationKeys, m_numFrames, DirectX::XMQuaternionIdentity(), LoadRotation );
+            for (U32 f = 1; f < rotations.size(); f++)
+                if (DirectX::XMVectorGetX( DirectX::XMQuaternionDot( rotations[f - 1], rotations[f] ) ) < 0.0f)
+                    rotations[f] = DirectX::XMVectorNegate( rotations[f] );
+            tracks.rotation = _AddRotationTrack( rotations, ReduceKeys( rotations, settings.rotationTolerance, rotationLerp, RotationError ) );
+
+            auto scales = GatherValues( joint.scalingKeys, m_numFrames, DirectX::XMVectorSplatOne(), LoadScale );
+            tracks.scale = _AddVectorTrack( scales, ReduceKeys( scales, settings.scaleTolerance, vectorLerp, VectorError ), m_scaleFrames, m_scaleKeys );
+
+            for (auto track : { &tracks.translation, &tracks.rotation, &tracks.scale })
+            {
+                if (track->numKeys == 1)
+                    m_stats.numConstantTracks++;
+                else
+                    m_stats.numKeysRemoved += m_numFrames - track->numKeys;
+            }
+            m_joints.push_back( tracks );
+        }
+
+        // Memory of the key data before and after
+        for (auto& joint : clip.jointSamples)
+        {
+            m_stats.rawBytes += static_cast<U32>( joint.translationKeys.size() * sizeof( TranslationKey ) );
+            m_stats.rawBytes += static_cast<U32>( joint.rotationKeys.size() * sizeof( RotationKey ) );
+            m_stats.rawBytes += static_cast<U32>( joint.scalingKeys.size() * sizeof( ScalingKey ) );
+        }
+        m_stats.numTracks       = static_cast<U32>( m_joints.size() * 3 );
+        m_stats.compressedBytes = static_cast<U32>( m_joints.size() * sizeof( JointTracks )
+                                  + (m_translationFrames.size() + m_rotationFrames.size() + m_scaleFrames.size()) * sizeof( U16 )
+                                  + (m_translationKeys.size() + m_scaleKeys.size()) * sizeof( QuantizedVec3 )
+                                  + m_rotationKeys.size() * sizeof( QuantizedQuat ) );
+
+        _MeasureError( *source );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void CompressedAnimationClip::samplePose( Time::Seconds time, ArrayList<JointCursor>& cursors, DirectX::XMMATRIX* localPoses ) const
+    {
+        cursors.resize( m_joints.size() );
+
+        F32 frame = _GetFrame( time );
+        for (U32 i = 0; i < m_joints.size(); i++)
+        {
+            auto& joint = m_joints[i];
+            auto p = _SampleTranslation( joint.translation, frame, cursors[i].translation );
+            auto r = _SampleRotation( joint.rotation, frame, cursors[i].rotation );
+            auto s = _SampleScale( joint.scale, frame, cursors[i].scale );
+            localPoses[i] = DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void CompressedAnimationClip::serialize( Common::BinaryWriter& writer ) const
+    {
+        writer.writeString( m_name.toString() );
+        writer.write( m_duration.value );
+        writer.write( m_sampleRate );
+        writer.write( m_numFrames );
+        writer.write( m_stats );
+        writer.writeArray( m_joints );
+        writer.writeArray( m_translationFrames );
+        writer.writeArray( m_translationKeys );
+        writer.writeArray( m_rotationFrames );
+        writer.writeArray( m_rotationKeys );
+        writer.writeArray( m_scaleFrames );
+        writer.writeArray( m_scaleKeys );
+    }
+
+    //----------------------------------------------------------------------
+    std::shared_ptr<CompressedAnimationClip> CompressedAnimationClip::Deserialize( Common::BinaryReader& reader )
+    {
+        std::shared_ptr<CompressedAnimationClip> clip( new CompressedAnimationClip );
+        clip->m_name                = SID( reader.readString().c_str() );
+        clip->m_duration            = reader.read<F64>();
+        clip->m_sampleRate          = reader.read<F32>();
+        clip->m_numFrames           = reader.read<U32>();
+        clip->m_stats               = reader.read<CompressionStats>();
+        clip->m_joints              = reader.readArray<JointTracks>();
+        clip->m_translationFrames   = reader.readArray<U16>();
+        clip->m_translationKeys     = reader.readArray<QuantizedVec3>();
+        clip->m_rotationFrames      = reader.readArray<U16>();
+        clip->m_rotationKeys        = reader.readArray<QuantizedQuat>();
+        clip->m_scaleFrames         = reader.readArray<U16>();
+        clip->m_scaleKeys           = reader.readArray<QuantizedVec3>();
+
+        return reader.isValid() ? clip : nullptr;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    CompressedAnimationClip::Track CompressedAnimationClip::_AddVectorTrack( const ArrayList<DirectX::XMVECTOR>& values, const ArrayList<U32>& keys,
+                                                                            ArrayList<U16>& frames, ArrayList<QuantizedVec3>& quantized )
+    {
+        Track track;
+        track.firstKey = static_cast<U32>( quantized.size() );
+        track.numKeys  = static_cast<U32>( keys.size() );
+
+        // Quantize within the range of the kept keys. Constant tracks have no range and decode exactly to "rangeMin".
+        DirectX::XMVECTOR min = values[keys.front()];
+        DirectX::XMVECTOR max = min;
+        for (U32 key : keys)
+        {
+            min = DirectX::XMVectorMin( min, values[key] );
+            max = DirectX::XMVectorMax( max, values[key] );
+        }
+        DirectX::XMVECTOR scale = DirectX::XMVectorScale( DirectX::XMVectorSubtract( max, min ), 1.0f / MAX_U16 );
+        DirectX::XMVECTOR invScale = DirectX::XMVectorSelect( DirectX::XMVectorReciprocal( scale ), DirectX::XMVectorZero(),
+                                                              DirectX::XMVectorEqual( scale, DirectX::XMVectorZero() ) );
+        DirectX::XMStoreFloat3( &track.rangeMin, min );
+        DirectX::XMStoreFloat3( &track.rangeScale, scale );
+
+        for (U32 key : keys)
+        {
+            auto q = DirectX::XMVectorRound( DirectX::XMVectorMultiply( DirectX::XMVectorSubtract( values[key], min ), invScale ) );
+            q = DirectX::XMVectorClamp( q, DirectX::XMVectorZero(), DirectX::XMVectorReplicate( MAX_U16 ) );
+
+            Math::Vec3 v;
+            DirectX::XMStoreFloat3( &v, q );
+            quantized.push_back({ static_cast<U16>( v.x ), static_cast<U16>( v.y ), static_cast<U16>( v.z ) });
+            frames.push_back( static_cast<U16>( key ) );
+        }
+
+        return track;
+    }
+
+    //----------------------------------------------------------------------
+    CompressedAnimationClip::Track CompressedAnimationClip::_AddRotationTrack( const ArrayList<DirectX::XMVECTOR>& values, const ArrayList<U32>& keys )
+    {
+        Track track;
+        track.firstKey = static_cast<U32>( m_rotationKeys.size() );
+        track.numKeys  = static_cast<U32>( keys.size() );
+
+        for (U32 key : keys)
+        {
+            Math::Quat q;
+            DirectX::XMStoreFloat4( &q, values[key] );
+            F32 components[4] = { q.x, q.y, q.z, q.w };
+
+            // Drop the largest component, it can be reconstructed from the others because the quaternion is normalized.
+            // Its sign is made positive, because q and -q represent the same rotation.
+            U32 largest = 0;
+            for (U32 i = 1; i < 4; i++)
+                if (std::abs( components[i] ) > std::abs( components[largest] ))
+                    largest = i;
+            F32 sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+            // Remaining components are in [-1/sqrt(2), 1/sqrt(2)]
+            U16 quantized[3];
+            U32 n = 0;
+            for (U32 i = 0; i < 4; i++)
+                if (i != largest)
+                    quantized[n++] = static_cast<U16>( std::lround( std::clamp( (components[i] * sign * SQRT2 + 1.0f) * 0.5f, 0.0f, 1.0f ) * MAX_U15 ) );
+
+            m_rotationKeys.push_back({ static_cast<U16>( quantized[0] | ((largest & 1) << 15) ),
+                                       static_cast<U16>( quantized[1] | ((largest >> 1) << 15) ),
+                                       quantized[2] });
+            m_rotationFrames.push_back( static_cast<U16>( key ) );
+        }
+
+        return track;
+    }
+
+    //----------------------------------------------------------------------
+    F32 CompressedAnimationClip::_GetFrame( Time::Seconds time ) const
+    {
+        if (m_numFrames < 2)
+            return 0.0f;
+
+        // The last frame sits at the end of the clip, so the last interval can be shorter than the others
+        U32 numIntervals = m_numFrames - 1;
+        F64 t       = std::clamp( time.value, 0.0, m_duration.value );
+        U32 frame   = std::min( static_cast<U32>( t * m_sampleRate ), numIntervals - 1 );
+        F64 begin   = frame / static_cast<F64>( m_sampleRate );
+        F64 span    = std::min( (frame + 1) / static_cast<F64>( m_sampleRate ), m_duration.value ) - begin;
+
+        return frame + (span > 0.0 ? static_cast<F32>( std::clamp( (t - begin) / span, 0.0, 1.0 ) ) : 0.0f);
+    }
+
+    //----------------------------------------------------------------------
+    DirectX::XMVECTOR CompressedAnimationClip::_SampleTranslation( const Track& track, F32 frame, U32& cursor ) const
+    {
+        if (track.numKeys == 1)
+            return _Decode( track, m_translationKeys[track.firstKey] );
+
+        F32 lerp = SeekFrame( &m_translationFrames[track.firstKey], track.numKeys, frame, cursor );
+        U32 key = track.firstKey + cursor;
+        return DirectX::XMVectorLerp( _Decode( track, m_translationKeys[key] ), _Decode( track, m_translationKeys[key + 1] ), lerp );
+    }
+
+    //----------------------------------------------------------------------
+    DirectX::XMVECTOR CompressedAnimationClip::_SampleRotation( const Track& track, F32 frame, U32& cursor ) const
+    {
+        if (track.numKeys == 1)
+            return _Decode( m_rotationKeys[track.firstKey] );
+
+        F32 lerp = SeekFrame( &m_rotationFrames[track.firstKey], track.numKeys, frame, cursor );
+        U32 key = track.firstKey + cursor;
+        return DirectX::XMQuaternionSlerp( _Decode( m_rotationKeys[key] ), _Decode( m_rotationKeys[key + 1] ), lerp );
+    }
+
+    //----------------------------------------------------------------------
+    DirectX::XMVECTOR CompressedAnimationClip::_SampleScale( const Track& track, F32 frame, U32& cursor ) const
+    {
+        if (track.numKeys == 1)
+            return _Decode( track, m_scaleKeys[track.firstKey] );
+
+        F32 lerp = SeekFrame( &m_scaleFrames[track.firstKey], track.numKeys, frame, cursor );
+        U32 key = track.firstKey + cursor;
+        return DirectX::XMVectorLerp( _Decode( track, m_scaleKeys[key] ), _Decode( track, m_scaleKeys[key + 1] ), lerp );
+    }
+
+    //----------------------------------------------------------------------
+    void CompressedAnimationClip::_MeasureError( const AnimationClip& source )
+    {
+        for (U32 j = 0; j < m_joints.size(); j++)
+        {
+            auto& joint = source.jointSamples[j];
+            auto translations = GatherValues( joint.translationKeys, m_numFrames, DirectX::XMVectorZero(), LoadTranslation );
+            auto rotations    = GatherValues( joint.rotationKeys, m_numFrames, DirectX::XMQuaternionIdentity(), LoadRotation );
+            auto scales       = GatherValues( joint.scalingKeys, m_numFrames, DirectX::XMVectorSplatOne(), LoadScale );
+
+            JointCursor cursor;
+            for (U32 f = 0; f < m_numFrames; f++)
+            {
+                F32 frame = static_cast<F32>( f );
+                m_stats.maxTranslationError = std::max( m_stats.maxTranslationError, VectorError( translations[f], _SampleTranslation( m_joints[j].translation, frame, cursor.translation ) ) );
+                m_stats.maxRotationError    = std::max( m_stats.maxRotationError, RotationError( rotations[f], _SampleRotation( m_joints[j].rotation, frame, cursor.rotation ) ) );
+                m_stats.maxScaleError       = std::max( m_stats.maxScaleError, VectorError( scales[f], _SampleScale( m_joints[j].scale, frame, cursor.scale ) ) );
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    DirectX::XMVECTOR CompressedAnimationClip::_Decode( const Track& track, const QuantizedVec3& key )
+    {
+        auto q = DirectX::XMVectorSet( static_cast<F32>( key.x ), static_cast<F32>( key.y ), static_cast<F32>( key.z ), 0.0f );
+        return DirectX::XMVectorMultiplyAdd( q, DirectX::XMLoadFloat3( &track.rangeScale ), DirectX::XMLoadFloat3( &track.rangeMin ) );
+    }
+
+    //----------------------------------------------------------------------
+    DirectX::XMVECTOR CompressedAnimationClip::_Decode( const QuantizedQuat& key )
+    {
+        static const DirectX::XMVECTOR scale  = DirectX::XMVectorReplicate( 2.0f / (MAX_U15 * SQRT2) );
+        static const DirectX::XMVECTOR offset = DirectX::XMVectorReplicate( -1.0f / SQRT2 );
+
+        U32 largest = (key.a >> 15) | ((key.b >> 15) << 1);
+        auto abc = DirectX::XMVectorMultiplyAdd( DirectX::XMVectorSet( static_cast<F32>( key.a & 0x7FFF ), static_cast<F32>( key.b & 0x7FFF ), static_cast<F32>( key.c ), 0.0f ), scale, offset );
+        F32 w = std::sqrt( std::max( 1.0f - DirectX::XMVectorGetX( DirectX::XMVector3Dot( abc, abc ) ), 0.0f ) );
+
+        Math::Vec3 v;
+        DirectX::XMStoreFloat3( &v, abc );
+        switch (largest)
+        {
+        case 0:  return DirectX::XMVectorSet( w, v.x, v.y, v.z );
+        case 1:  return DirectX::XMVectorSet( v.x, w, v.y, v.z );
+        case 2:  return DirectX::XMVectorSet( v.x, v.y, w, v.z );
+        default: return DirectX::XMVectorSet( v.x, v.y, v.z, w );
+        }
+    }
+
+} // End namespaces
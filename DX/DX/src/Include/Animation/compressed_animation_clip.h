@@ -0,0 +1,132 @@
+#pragma once
+/**********************************************************************
+    class: CompressedAnimationClip (compressed_animation_clip.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Memory efficient, read-only version of an animation clip.
+    - Tracks which do not change are stored with a single key
+    - Keys which can be reconstructed by interpolating their neighbours
+      within the given tolerance are removed
+    - Rotations are stored as "smallest three" with 15 bit per component
+    - Translations + scales are quantized to 16 bit per component within
+      the range of their track
+    Keys are decoded with a single multiply-add per key, so sampling
+    costs about the same as sampling an uncompressed clip.
+**********************************************************************/
+
+#include "animation_clip.h"
+#include "Common/DataStructures/binary_stream.hpp"
+
+namespace Animation { 
+
+    //----------------------------------------------------------------------
+    struct CompressionSettings
+    {
+        F32 sampleRate              = 30.0f;    // Used to resample clips whose keys have arbitrary times
+        F32 translationTolerance    = 0.0005f;  // Max distance
+        F32 rotationTolerance       = 0.05f;    // Max angle in degrees
+        F32 scaleTolerance          = 0.0005f;  // Max distance
+    };
+
+    //----------------------------------------------------------------------
+    struct CompressionStats
+    {
+        U32 rawBytes            = 0;    // Key data of the source clip
+        U32 compressedBytes     = 0;
+        U32 numConstantTracks   = 0;
+        U32 numTracks           = 0;
+        U32 numKeysRemoved      = 0;    // By key reduction
+        F32 maxTranslationError = 0.0f; // Max distance from the source at any frame
+        F32 maxRotationError    = 0.0f; // Max angle in degrees
+        F32 maxScaleError       = 0.0f;
+
+        F32 getRatio() const { return compressedBytes > 0 ? static_cast<F32>( rawBytes ) / compressedBytes : 0.0f; }
+    };
+
+    //*********************************************************************
+    class CompressedAnimationClip : public IAnimationClip
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Compresses the given clip. Error + memory savings are measured afterwards and stored in the stats.
+        //----------------------------------------------------------------------
+        CompressedAnimationClip(const AnimationClip& clip, const CompressionSettings& settings = CompressionSettings());
+        ~CompressedAnimationClip() = default;
+
+        //----------------------------------------------------------------------
+        StringID                getName()       const override { return m_name; }
+        Time::Seconds           getDuration()   const override { return m_duration; }
+        U32                     getJointCount() const override { return static_cast<U32>( m_joints.size() ); }
+        const CompressionStats& getStats()      const { return m_stats; }
+
+        //----------------------------------------------------------------------
+        void samplePose(Time::Seconds time, ArrayList<JointCursor>& cursors, DirectX::XMMATRIX* localPoses) const override;
+
+        //----------------------------------------------------------------------
+        // Writes the compressed keys, so the clip can be restored later without compressing it again.
+        //----------------------------------------------------------------------
+        void serialize(Common::BinaryWriter& writer) const;
+
+        //----------------------------------------------------------------------
+        // Restores a clip written by serialize().
+        // @Return:
+        //  Nullptr if the data is truncated.
+        //----------------------------------------------------------------------
+        static std::shared_ptr<CompressedAnimationClip> Deserialize(Common::BinaryReader& reader);
+
+    private:
+        CompressedAnimationClip() = default;
+
+        struct QuantizedVec3 { U16 x, y, z; };
+        struct QuantizedQuat { U16 a, b, c; }; // Highest bit of a + b: Index of the dropped component
+
+        //----------------------------------------------------------------------
+        struct Track
+        {
+            U32         firstKey = 0;
+            U32         numKeys  = 0;
+            Math::Vec3  rangeMin;       // Decoded value = rangeMin + quantized * rangeScale
+            Math::Vec3  rangeScale;
+        };
+
+        struct JointTracks
+        {
+            Track translation;
+            Track rotation;
+            Track scale;
+        };
+
+        StringID                    m_name;
+        Time::Seconds               m_duration;
+        F32                         m_sampleRate = 0.0f;
+        U32                         m_numFrames  = 1;
+        ArrayList<JointTracks>      m_joints;
+        CompressionStats            m_stats;
+
+        // Keys of all tracks. Frames store the index of the source frame of each key.
+        ArrayList<U16>              m_translationFrames;
+        ArrayList<QuantizedVec3>    m_translationKeys;
+        ArrayList<U16>              m_rotationFrames;
+        ArrayList<QuantizedQuat>    m_rotationKeys;
+        ArrayList<U16>              m_scaleFrames;
+        ArrayList<QuantizedVec3>    m_scaleKeys;
+
+        //----------------------------------------------------------------------
+        Track               _AddVectorTrack(const ArrayList<DirectX::XMVECTOR>& values, const ArrayList<U32>& keys, ArrayList<U16>& frames, ArrayList<QuantizedVec3>& quantized);
+        Track               _AddRotationTrack(const ArrayList<DirectX::XMVECTOR>& values, const ArrayList<U32>& keys);
+        F32                 _GetFrame(Time::Seconds time) const;
+        DirectX::XMVECTOR   _SampleTranslation(const Track& track, F32 frame, U32& cursor) const;
+        DirectX::XMVECTOR   _SampleRotation(const Track& track, F32 frame, U32& cursor) const;
+        DirectX::XMVECTOR   _SampleScale(const Track& track, F32 frame, U32& cursor) const;
+        void                _MeasureError(const AnimationClip& source);
+
+        //----------------------------------------------------------------------
+        static DirectX::XMVECTOR _Decode(const Track& track, const QuantizedVec3& key);
+        static DirectX::XMVECTOR _Decode(const QuantizedQuat& key);
+
+        NULL_COPY_AND_ASSIGN(CompressedAnimationClip)
+    };
+
+} // End namespaces
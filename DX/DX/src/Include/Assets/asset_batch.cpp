@@ -0,0 +1,433 @@
+#include "asset_batch.h"
+/**********************************************************************
+    class: AssetBatch (asset_batch.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "shader_parser.hpp"
+#include "material_parser.hpp"
+#include <thread>
+
+namespace Assets {
+
+    //----------------------------------------------------------------------
+    static StringID PathID( const OS::Path& path )
+    {
+        return SID( StringUtils::toLower( path.toString() ).c_str() );
+    }
+
+    //----------------------------------------------------------------------
+    static TextureUsage ParseTextureUsage( const String& usage )
+    {
+        String name = StringUtils::toLower( usage );
+        if (name == "albedo")       return TextureUsage::Albedo;
+        if (name == "highquality")  return TextureUsage::HighQuality;
+        if (name == "normal")       return TextureUsage::Normal;
+        if (name == "mask")         return TextureUsage::Mask;
+        if (name == "uncompressed") return TextureUsage::Uncompressed;
+        throw std::runtime_error( "Unknown texture usage '" + usage + "'" );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    static T FindAsset( const HashMap<StringID, T>& assets, const OS::Path& path )
+    {
+        auto it = assets.find( PathID( path ) );
+        return it != assets.end() ? it->second : nullptr;
+    }
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Whether the asset with the given id is in the cache of the asset manager and still alive.
+    //----------------------------------------------------------------------
+    template <typename AssetInfo, typename T>
+    static bool IsCached( const HashMap<StringID, AssetInfo>& cache, StringID id, std::weak_ptr<T> AssetInfo::* asset )
+    {
+        auto it = cache.find( id );
+        return it != cache.end() && not (it->second.*asset).expired();
+    }
+
+    //**********************************************************************
+    // ASSET MANIFEST
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    AssetManifest AssetManifest::Load( const OS::Path& path )
+    {
+        OS::File file( path, OS::EFileMode::READ );
+
+        AssetManifest manifest;
+        try
+        {
+            JSON json = JSON::parse( file.readAll() );
+
+            auto readPaths = [&json](const char* name, ArrayList<OS::Path>* paths) {
+                auto it = json.find( name );
+                if ( it != json.end() )
+                    for (auto& assetPath : *it)
+                        paths->emplace_back( assetPath.get<String>() );
+            };
+            readPaths( "meshes",    &manifest.meshes );
+            readPaths( "materials", &manifest.materials );
+            readPaths( "shaders",   &manifest.shaders );
+            readPaths( "audio",     &manifest.audioClips );
+
+            auto textures = json.find( "textures" );
+            if ( textures != json.end() )
+            {
+                for (auto& texture : *textures)
+                {
+                    TextureEntry entry;
+                    if ( texture.is_string() )
+                    {
+                        entry.path = texture.get<String>();
+                    }
+                    else
+                    {
+                        entry.path = texture.at( "path" ).get<String>();
+                        if ( texture.find( "usage" ) != texture.end() )
+                            entry.usage = ParseTextureUsage( texture["usage"].get<String>() );
+                        if ( texture.find( "mips" ) != texture.end() )
+                            entry.generateMips = texture["mips"].get<bool>();
+                    }
+                    manifest.textures.push_back( entry );
+                }
+            }
+        }
+        catch (const JSON::exception& e)
+        {
+            throw std::runtime_error( "Failed to parse manifest '" + path.toString() + "'. Reason: " + e.what() );
+        }
+
+        return manifest;
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void AssetBatch::wait()
+    {
+        while ( not isDone() )
+        {
+            _Update();
+            std::this_thread::yield();
+        }
+    }
+
+    //----------------------------------------------------------------------
+    Texture2DPtr AssetBatch::getTexture2D( const OS::Path& path ) const
+    {
+        return FindAsset( m_textures, path );
+    }
+
+    //----------------------------------------------------------------------
+    ShaderPtr AssetBatch::getShader( const OS::Path& path ) const
+    {
+        return FindAsset( m_shaders, path );
+    }
+
+    //----------------------------------------------------------------------
+    MaterialPtr AssetBatch::getMaterial( const OS::Path& path ) const
+    {
+        return FindAsset( m_materials, path );
+    }
+
+    //----------------------------------------------------------------------
+    MeshPtr AssetBatch::getMesh( const OS::Path& path ) const
+    {
+        return FindAsset( m_meshes, path );
+    }
+
+    //----------------------------------------------------------------------
+    AudioClipPtr AssetBatch::getAudioClip( const OS::Path& path ) const
+    {
+        return FindAsset( m_audioClips, path );
+    }
+
+    //----------------------------------------------------------------------
+    const MeshMaterialInfo* AssetBatch::getMeshMaterialInfo( const OS::Path& path ) const
+    {
+        auto it = m_meshMaterials.find( PathID( path ) );
+        return it != m_meshMaterials.end() ? &it->second : nullptr;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void AssetBatch::_Start( const AssetManifest& manifest )
+    {
+        // Leaves first, so their reads are issued before the ones of the assets depending on them
+        for (auto& texture : manifest.textures)
+            _Add( { AssetType::Texture2D, texture.path, texture.generateMips, texture.usage }, nullptr );
+        for (auto& path : manifest.shaders)
+            _Add( { AssetType::Shader, path }, nullptr );
+        for (auto& path : manifest.audioClips)
+            _Add( { AssetType::AudioClip, path }, nullptr );
+        for (auto& path : manifest.materials)
+            _Add( { AssetType::Material, path }, nullptr );
+        for (auto& path : manifest.meshes)
+            _Add( { AssetType::Mesh, path }, nullptr );
+    }
+
+    //----------------------------------------------------------------------
+    void AssetBatch::_Update()
+    {
+        ArrayList<Node*> readNodes;
+        {
+            std::lock_guard<std::mutex> lock( m_readMutex );
+            readNodes.swap( m_readNodes );
+        }
+
+        for (auto node : readNodes)
+        {
+            node->isRead = true;
+            for (auto& dependency : node->dependencies)
+                _Add( dependency, node );
+            node->dependencies.clear();
+
+            if (node->numPendingDependencies == 0)
+                _Create( node );
+        }
+
+        // Progress is reported once per update at most, and always once when the batch is done
+        bool done = isDone();
+        if ( m_callback && (m_numLoaded != m_numReported || (done && not m_doneReported)) )
+        {
+            m_numReported  = m_numLoaded;
+            m_doneReported = done;
+            m_callback( *this );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    AssetBatch::Node* AssetBatch::_Add( const AssetRef& asset, Node* dependent )
+    {
+        StringID id = PathID( asset.path );
+        auto it = m_nodeMap.find( id );
+        Node* node = (it != m_nodeMap.end()) ? it->second : nullptr;
+        if ( not node )
+        {
+            node = m_nodes.emplace_back( std::make_unique<Node>() ).get();
+            node->asset = asset;
+            m_nodeMap[id] = node;
+
+            if ( _IsInMemory( asset ) )
+            {
+                std::lock_guard<std::mutex> lock( m_readMutex );
+                m_readNodes.push_back( node );
+            }
+            else
+            {
+                auto self = shared_from_this();
+                ASYNC_JOB([self, node] { self->_Read( node ); });
+            }
+        }
+
+        if ( dependent && not node->isLoaded )
+        {
+            node->dependents.push_back( dependent );
+            dependent->numPendingDependencies++;
+        }
+
+        return node;
+    }
+
+    //----------------------------------------------------------------------
+    void AssetBatch::_Read( Node* node )
+    {
+        const AssetRef& asset = node->asset;
+        try
+        {
+            switch (asset.type)
+            {
+            case AssetType::Texture2D:
+            {
+                auto data = std::make_shared<AssetManager::TextureData>( ASSETS._ReadTexture2D( asset.path, asset.generateMips, asset.usage ) );
+                node->create = [this, node, data] {
+                    m_textures[PathID( node->asset.path )] = ASSETS._CreateTexture2D( node->asset.path, *data );
+                };
+                break;
+            }
+            case AssetType::Shader:
+            {
+                // The shader is created from the bytecode in the shader cache
+                ShaderParser::PrecompileShader( asset.path );
+                node->create = [this, node] {
+                    m_shaders[PathID( node->asset.path )] = ASSETS.getShader( node->asset.path );
+                };
+                break;
+            }
+            case AssetType::Material:
+            {
+                // The material is created from its file again, which finds its shader and textures in the cache
+                String shaderPath;
+                ArrayList<MaterialParser::TextureDependency> candidates;
+                MaterialParser::GetDependencies( asset.path, &shaderPath, &candidates );
+
+                // Which parameters are textures is known only once the shader exists. Without one the error shader is used.
+                if ( not shaderPath.empty() )
+                {
+                    node->dependencies.push_back( { AssetType::Shader, shaderPath } );
+                    node->resolve = [this, node, shaderPath, candidates] {
+                        auto it = m_shaders.find( PathID( shaderPath ) );
+                        if ( it == m_shaders.end() || it->second == nullptr )
+                            return;
+
+                        for (auto& texture : MaterialParser::GetTextureDependencies( it->second, candidates ))
+                            node->dependencies.push_back( { AssetType::Texture2D, texture.path, true, texture.usage } );
+                    };
+                }
+
+                node->create = [this, node] {
+                    m_materials[PathID( node->asset.path )] = ASSETS.getMaterial( node->asset.path );
+                };
+                break;
+            }
+            case AssetType::Mesh:
+            {
+                // Only cached meshes are read here. The importer creates the mesh itself, so it runs on the main thread.
+                auto data = std::make_shared<MeshCacheData>();
+                if ( MeshCache::Read( asset.path, false, data.get() ) )
+                {
+                    node->create = [this, node, data] {
+                        _CreateMesh( node, data.get() );
+                    };
+                }
+                break;
+            }
+            case AssetType::AudioClip:
+            {
+                auto wav = std::make_shared<Core::Audio::WAVClip>();
+                if ( wav->load( asset.path ) )
+                {
+                    node->create = [this, node, wav] {
+                        m_audioClips[PathID( node->asset.path )] = ASSETS._CreateAudioClip( node->asset.path, wav );
+                    };
+                }
+                break;
+            }
+            default:
+                ASSERT( false && "Asset can't be read on a worker thread" );
+            }
+        }
+        catch (...)
+        {
+            // The asset is loaded synchronously on the main thread instead, which reports the error
+            node->create = nullptr;
+            node->resolve = nullptr;
+            node->dependencies.clear();
+        }
+
+        std::lock_guard<std::mutex> lock( m_readMutex );
+        m_readNodes.push_back( node );
+    }
+
+    //----------------------------------------------------------------------
+    void AssetBatch::_Create( Node* node )
+    {
+        if (node->resolve)
+        {
+            auto resolve = std::move( node->resolve );
+            node->resolve = nullptr;
+            resolve();
+
+            for (auto& dependency : node->dependencies)
+                _Add( dependency, node );
+            node->dependencies.clear();
+
+            // The last of the new dependencies creates this node when it is loaded
+            if (node->numPendingDependencies > 0)
+                return;
+        }
+
+        if (node->create)
+            node->create();
+        else
+            _LoadSynchronously( node );
+
+        // Releases the data read by the worker
+        node->create = nullptr;
+        node->isLoaded = true;
+        m_numLoaded++;
+
+        for (auto dependent : node->dependents)
+            if ( --dependent->numPendingDependencies == 0 && dependent->isRead )
+                _Create( dependent );
+        node->dependents.clear();
+    }
+
+    //----------------------------------------------------------------------
+    void AssetBatch::_CreateMesh( Node* node, MeshCacheData* data )
+    {
+        const OS::Path& path = node->asset.path;
+        StringID id = PathID( path );
+
+        // Requesting the materials loads the mesh from its file again, so meshes in memory are taken as they are
+        if ( not data && _IsInMemory( node->asset ) )
+        {
+            m_meshes[id] = ASSETS.getMesh( path );
+            return;
+        }
+
+        // Meshes which were not read by a worker are imported (or loaded from the cache) here
+        MeshMaterialInfo materials;
+        auto mesh = data ? ASSETS._CreateMesh( path, *data, &materials ) : ASSETS.getMesh( path, &materials );
+        m_meshes[id] = mesh;
+        if ( not materials.isValid() )
+            return;
+
+        // The textures are known only now, so they are read in parallel after the mesh was created
+        for (I32 i = 0; i < mesh->getSubMeshCount(); i++)
+        {
+            for (auto& texture : materials[i].textures)
+            {
+                if (texture.type == MaterialTextureType::Albedo)
+                    _Add( { AssetType::Texture2D, texture.filePath }, nullptr );
+                else if (texture.type == MaterialTextureType::Normal)
+                    _Add( { AssetType::Texture2D, texture.filePath, true, TextureUsage::Normal }, nullptr );
+            }
+        }
+        m_meshMaterials[id] = std::move( materials );
+    }
+
+    //----------------------------------------------------------------------
+    void AssetBatch::_LoadSynchronously( Node* node )
+    {
+        const AssetRef& asset = node->asset;
+        StringID id = PathID( asset.path );
+        switch (asset.type)
+        {
+        case AssetType::Texture2D:  m_textures[id]   = ASSETS.getTexture2D( asset.path, asset.generateMips, asset.usage ); break;
+        case AssetType::Shader:     m_shaders[id]    = ASSETS.getShader( asset.path ); break;
+        case AssetType::Material:   m_materials[id]  = ASSETS.getMaterial( asset.path ); break;
+        case AssetType::AudioClip:  m_audioClips[id] = ASSETS.getAudioClip( asset.path ); break;
+        case AssetType::Mesh:       _CreateMesh( node, nullptr ); break;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    bool AssetBatch::_IsInMemory( const AssetRef& asset ) const
+    {
+        auto& assets = ASSETS;
+        std::lock_guard<std::recursive_mutex> lock( assets.m_cacheMutex );
+
+        StringID id = PathID( asset.path );
+        switch (asset.type)
+        {
+        case AssetType::Texture2D:  return IsCached( assets.m_textureCache,  id, &AssetManager::TextureAssetInfo::texture );
+        case AssetType::Shader:     return IsCached( assets.m_shaderCache,   id, &AssetManager::ShaderAssetInfo::shader );
+        case AssetType::Material:   return IsCached( assets.m_materialCache, id, &AssetManager::MaterialAssetInfo::material );
+        case AssetType::Mesh:       return IsCached( assets.m_meshCache,     id, &AssetManager::MeshAssetInfo::mesh );
+        case AssetType::AudioClip:  return IsCached( assets.m_audioCache,    id, &AssetManager::AudioClipAssetInfo::wavClip );
+        }
+        return false;
+    }
+
+} // End namespaces
@@ -0,0 +1,172 @@
+#pragma once
+/**********************************************************************
+    class: AssetBatch (asset_batch.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Loads a list of assets (see AssetManifest) in parallel. Every asset
+    is read and decoded on a worker thread, which also discovers the
+    assets it references, e.g. the shader and textures of a material.
+    Those are loaded as part of the batch. The objects of an asset are
+    created on the main thread once all of its dependencies exist, see
+    AssetManager::loadBatch(). Meshes are read from the mesh cache on
+    a worker as well, only their buffers are created on the main thread.
+    Meshes without an up to date cache are imported on the main thread.
+    Their textures are read in parallel afterwards. A batch keeps its
+    assets alive.
+**********************************************************************/
+
+#include "OS/FileSystem/path.h"
+#include "Graphics/i_texture2d.hpp"
+#include "Graphics/i_shader.h"
+#include "Graphics/i_material.h"
+#include "Graphics/i_mesh.h"
+#include "Core/Audio/audio_clip.h"
+#include "mesh_material_info.hpp"
+#include "texture_cache.h"
+#include "mesh_cache.h"
+#include <mutex>
+
+namespace Assets {
+
+    //----------------------------------------------------------------------
+    // Assets which should be loaded together, e.g. everything a level needs.
+    //----------------------------------------------------------------------
+    struct AssetManifest
+    {
+        struct TextureEntry
+        {
+            OS::Path        path;
+            bool            generateMips = true;
+            TextureUsage    usage = TextureUsage::Albedo;
+        };
+
+        ArrayList<OS::Path>     meshes;
+        ArrayList<OS::Path>     materials;
+        ArrayList<OS::Path>     shaders;
+        ArrayList<TextureEntry> textures;
+        ArrayList<OS::Path>     audioClips;
+
+        //----------------------------------------------------------------------
+        // Reads a manifest from a json file. Textures are either paths or objects:
+        //  { "meshes" : [ "/models/tree.obj" ], "materials" : [ ... ], "shaders" : [ ... ], "audio" : [ ... ],
+        //    "textures" : [ "/textures/bark.png", { "path" : "/textures/bark_n.png", "usage" : "normal", "mips" : true } ] }
+        // @Throws:
+        //  std::runtime_error if the file could not be read or parsed.
+        //----------------------------------------------------------------------
+        static AssetManifest Load(const OS::Path& path);
+    };
+
+    class AssetBatch;
+    using AssetBatchPtr         = std::shared_ptr<AssetBatch>;
+    using AssetBatchCallback    = std::function<void(const AssetBatch&)>;
+
+    //**********************************************************************
+    class AssetBatch : public std::enable_shared_from_this<AssetBatch>
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Number of assets in this batch including the discovered dependencies. May grow while loading.
+        //----------------------------------------------------------------------
+        U32     getNumAssets()  const { return static_cast<U32>( m_nodes.size() ); }
+        U32     getNumLoaded()  const { return m_numLoaded; }
+        F32     getProgress()   const { return m_nodes.empty() ? 1.0f : static_cast<F32>( m_numLoaded ) / m_nodes.size(); }
+        bool    isDone()        const { return m_numLoaded == m_nodes.size(); }
+
+        //----------------------------------------------------------------------
+        // Blocks until every asset is loaded. Creates the assets on the calling thread, so this must be the main thread.
+        //----------------------------------------------------------------------
+        void wait();
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The loaded asset or nullptr if it is not loaded (yet) or not part of this batch.
+        //  Assets which failed to load are replaced by the defaults of the asset manager.
+        //----------------------------------------------------------------------
+        Texture2DPtr            getTexture2D(const OS::Path& path)          const;
+        ShaderPtr               getShader(const OS::Path& path)             const;
+        MaterialPtr             getMaterial(const OS::Path& path)           const;
+        MeshPtr                 getMesh(const OS::Path& path)               const;
+        AudioClipPtr            getAudioClip(const OS::Path& path)          const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Materials of a mesh in this batch or nullptr. Only present if the mesh was not in memory before.
+        //----------------------------------------------------------------------
+        const MeshMaterialInfo* getMeshMaterialInfo(const OS::Path& path)   const;
+
+    private:
+        friend class AssetManager;
+
+        enum class AssetType
+        {
+            Texture2D,
+            Shader,
+            Material,
+            Mesh,
+            AudioClip
+        };
+
+        struct AssetRef
+        {
+            AssetType       type;
+            OS::Path        path;
+            bool            generateMips = true;
+            TextureUsage    usage = TextureUsage::Albedo;
+        };
+
+        struct Node
+        {
+            AssetRef                asset;
+            ArrayList<Node*>        dependents;                 // Nodes which can't be created before this one
+            U32                     numPendingDependencies = 0;
+            bool                    isRead = false;
+            bool                    isLoaded = false;
+
+            // Set by the worker thread which read the asset
+            std::function<void()>   create;                     // Creates the asset. Empty if reading failed.
+            std::function<void()>   resolve;                    // Adds dependencies which are known only once the others
+                                                                // were created, e.g. the textures of a material need its shader
+            ArrayList<AssetRef>     dependencies;
+        };
+
+        AssetBatchCallback                  m_callback;
+        ArrayList<std::unique_ptr<Node>>    m_nodes;
+        HashMap<StringID, Node*>            m_nodeMap;
+        U32                                 m_numLoaded = 0;
+        U32                                 m_numReported = 0;
+        bool                                m_doneReported = false;
+
+        // Nodes which were read by a worker thread, but not yet processed by the main thread
+        std::mutex                          m_readMutex;
+        ArrayList<Node*>                    m_readNodes;
+
+        HashMap<StringID, Texture2DPtr>     m_textures;
+        HashMap<StringID, ShaderPtr>        m_shaders;
+        HashMap<StringID, MaterialPtr>      m_materials;
+        HashMap<StringID, MeshPtr>          m_meshes;
+        HashMap<StringID, AudioClipPtr>     m_audioClips;
+        HashMap<StringID, MeshMaterialInfo> m_meshMaterials;
+
+        //----------------------------------------------------------------------
+        AssetBatch(const AssetBatchCallback& callback) : m_callback( callback ) {}
+
+        //----------------------------------------------------------------------
+        // Called by the asset manager on the main thread
+        //----------------------------------------------------------------------
+        void _Start(const AssetManifest& manifest);
+        void _Update();
+
+        //----------------------------------------------------------------------
+        Node*   _Add(const AssetRef& asset, Node* dependent);
+        void    _Read(Node* node);
+        void    _Create(Node* node);
+        void    _CreateMesh(Node* node, MeshCacheData* data);
+        void    _LoadSynchronously(Node* node);
+        bool    _IsInMemory(const AssetRef& asset) const;
+
+        NULL_COPY_AND_ASSIGN(AssetBatch)
+    };
+
+} // End namespaces
@@ -11,22 +11,52 @@
 #include "shader_parser.hpp"
 #include "material_parser.hpp"
 #include "assimp_loader.h"
+#include "mesh_cache.h"
+#include "texture_cache.h"
+#include "Graphics/Utils/mip_generator.h"
+#include "OS/PlatformTimer/platform_timer.h"
 #include "Core/mesh_generator.h"
+#include "Core/texture_streamer.h"
 
 namespace Assets {
 
     #define HOT_RELOAD_INTERVAL_MILLIS  500
     #define LOG_COLOR                   Color::GREEN
+
+    // Shaders loaded in the last run, which are compiled into the shader cache on startup
+    #define SHADER_WARM_UP_LIST         "/engine/shaders/bin/shader_warm_up_list.txt"
     
     //----------------------------------------------------------------------
     void AssetManager::init()
     {
+        _PrewarmShaders();
         _CreateDefaultAssets();
+
+        Locator::getCoreEngine().subscribe( this );
     }
 
     //----------------------------------------------------------------------
     void AssetManager::shutdown()
     {
+        // The worker threads were shut down already, so nothing can be read anymore
+        m_batches.clear();
+
+        _SaveShaderWarmUpList();
+    }
+
+    //----------------------------------------------------------------------
+    void AssetManager::OnUpdate( Time::Seconds delta )
+    {
+        // Create the assets read by worker threads in the meantime. Callbacks might start new batches.
+        for (I32 i = 0; i < m_batches.size();)
+        {
+            auto batch = m_batches[i];
+            batch->_Update();
+            if ( batch->isDone() )
+                m_batches.erase( m_batches.begin() + i );
+            else
+                i++;
+        }
     }
 
     //**********************************************************************
@@ -34,31 +64,25 @@ namespace Assets {
     //**********************************************************************
 
     //----------------------------------------------------------------------
-    Texture2DPtr AssetManager::getTexture2D( const OS::Path& filePath, bool generateMips )
+    Texture2DPtr AssetManager::getTexture2D( const OS::Path& filePath, bool generateMips, TextureUsage usage )
     {
         // Check if texture was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
-        if ( m_textureCache.find( pathAsID ) != m_textureCache.end() )
         {
-            auto weakPtr = m_textureCache[pathAsID].texture;
-            if ( not weakPtr.expired() )
-                return Texture2DPtr( weakPtr );
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_textureCache.find( pathAsID ) != m_textureCache.end() )
+            {
+                auto weakPtr = m_textureCache[pathAsID].texture;
+                if ( not weakPtr.expired() )
+                    return Texture2DPtr( weakPtr );
+            }
         }
 
         // Try loading texture
         LOG( "AssetManager: Loading Texture '" + filePath.toString() + "'", LOG_COLOR );
         try
         {
-            auto texture = _LoadTexture2D( filePath, generateMips );
-
-            TextureAssetInfo texInfo;
-            texInfo.texture     = texture;
-            texInfo.path        = filePath;
-            texInfo.timeAtLoad  = filePath.getLastWrittenFileTime();
-
-            m_textureCache[pathAsID] = texInfo;
-
-            return texture;
+            return _CreateTexture2D( filePath, _ReadTexture2D( filePath, generateMips, usage ) );
         }
         catch (const std::runtime_error& e)
         {
@@ -69,12 +93,15 @@ namespace Assets {
     }
 
     //----------------------------------------------------------------------
-    void AssetManager::getTexture2DAsync( const OS::Path& filePath, bool genMips, const std::function<void(Texture2DPtr)>& callback )
+    void AssetManager::getTexture2DAsync( const OS::Path& filePath, bool genMips, const std::function<void(Texture2DPtr)>& callback, TextureUsage usage )
     {
-        ASYNC_JOB([=] {
-            auto tex = getTexture2D( filePath, genMips );
-            callback( tex );
-        });
+        AssetManifest manifest;
+        manifest.textures.push_back( { filePath, genMips, usage } );
+
+        loadBatch( manifest, [filePath, callback](const AssetBatch& batch) {
+            if ( batch.isDone() )
+                callback( batch.getTexture2D( filePath ) );
+        } );
     }
 
     //----------------------------------------------------------------------
@@ -84,11 +111,14 @@ namespace Assets {
     {
         // Check if cubemap was already loaded (checks only first path)
         StringID pathAsID = SID( StringUtils::toLower( posX.toString() ).c_str() );
-        if ( m_cubemapCache.find( pathAsID ) != m_cubemapCache.end() )
         {
-            auto weakPtr = m_cubemapCache[pathAsID].cubemap;
-            if ( not weakPtr.expired() )
-                return CubemapPtr( weakPtr );
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_cubemapCache.find( pathAsID ) != m_cubemapCache.end() )
+            {
+                auto weakPtr = m_cubemapCache[pathAsID].cubemap;
+                if ( not weakPtr.expired() )
+                    return CubemapPtr( weakPtr );
+            }
         }
 
         // Try loading cubemap
@@ -102,6 +132,7 @@ namespace Assets {
             texInfo.path        = posX;
             texInfo.timeAtLoad  = posX.getLastWrittenFileTime();
 
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
             m_cubemapCache[pathAsID] = texInfo;
 
             return cubemap;
@@ -119,11 +150,14 @@ namespace Assets {
     {
         // Check if cubemap was already loaded (checks only first path)
         StringID pathAsID = SID( StringUtils::toLower( path.toString() ).c_str() );
-        if ( m_cubemapCache.find( pathAsID ) != m_cubemapCache.end() )
         {
-            auto weakPtr = m_cubemapCache[pathAsID].cubemap;
-            if ( not weakPtr.expired() )
-                return CubemapPtr( weakPtr );
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_cubemapCache.find( pathAsID ) != m_cubemapCache.end() )
+            {
+                auto weakPtr = m_cubemapCache[pathAsID].cubemap;
+                if ( not weakPtr.expired() )
+                    return CubemapPtr( weakPtr );
+            }
         }
 
         // Try loading cubemap
@@ -137,6 +171,7 @@ namespace Assets {
             texInfo.path        = path;
             texInfo.timeAtLoad  = path.getLastWrittenFileTime();
 
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
             m_cubemapCache[pathAsID] = texInfo;
 
             return cubemap;
@@ -154,14 +189,17 @@ namespace Assets {
     {
         // Check if audio was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
-        if ( m_audioCache.find( pathAsID ) != m_audioCache.end() )
         {
-            auto weakPtr = m_audioCache[pathAsID].wavClip;
-            if ( not weakPtr.expired() )
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_audioCache.find( pathAsID ) != m_audioCache.end() )
             {
-                auto audioClip = RESOURCES.createAudioClip();
-                audioClip->setWAVClip( Core::Audio::WAVClipPtr( weakPtr ) );
-                return audioClip;
+                auto weakPtr = m_audioCache[pathAsID].wavClip;
+                if ( not weakPtr.expired() )
+                {
+                    auto audioClip = RESOURCES.createAudioClip();
+                    audioClip->setWAVClip( Core::Audio::WAVClipPtr( weakPtr ) );
+                    return audioClip;
+                }
             }
         }
 
@@ -175,18 +213,7 @@ namespace Assets {
             return nullptr;
         }
 
-        auto audioClip = RESOURCES.createAudioClip();
-        audioClip->setWAVClip( wav );
-
-        // Cache loaded audio
-        AudioClipAssetInfo info;
-        info.wavClip    = wav;
-        info.path       = filePath;
-        info.timeAtLoad = filePath.getLastWrittenFileTime();
-
-        m_audioCache[pathAsID] = info;
-
-        return audioClip;
+        return _CreateAudioClip( filePath, wav );
     }
 
     //----------------------------------------------------------------------
@@ -194,11 +221,14 @@ namespace Assets {
     {
         // Check if shader was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
-        if ( m_shaderCache.find( pathAsID ) != m_shaderCache.end() )
         {
-            auto weakPtr = m_shaderCache[pathAsID].shader;
-            if ( not weakPtr.expired() )
-                return ShaderPtr( weakPtr );
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_shaderCache.find( pathAsID ) != m_shaderCache.end() )
+            {
+                auto weakPtr = m_shaderCache[pathAsID].shader;
+                if ( not weakPtr.expired() )
+                    return ShaderPtr( weakPtr );
+            }
         }
 
         // Try loading shader
@@ -212,6 +242,7 @@ namespace Assets {
             shaderInfo.path        = filePath;
             shaderInfo.timeAtLoad  = filePath.getLastWrittenFileTime();
 
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
             m_shaderCache[pathAsID] = shaderInfo;
 
             return shader;
@@ -229,11 +260,14 @@ namespace Assets {
     {
         // Check if material was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
-        if ( m_materialCache.find( pathAsID ) != m_materialCache.end() )
         {
-            auto weakPtr = m_materialCache[pathAsID].material;
-            if ( not weakPtr.expired() )
-                return MaterialPtr( weakPtr );
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_materialCache.find( pathAsID ) != m_materialCache.end() )
+            {
+                auto weakPtr = m_materialCache[pathAsID].material;
+                if ( not weakPtr.expired() )
+                    return MaterialPtr( weakPtr );
+            }
         }
 
         // Try loading material
@@ -247,6 +281,7 @@ namespace Assets {
             materialInfo.path        = filePath;
             materialInfo.timeAtLoad  = filePath.getLastWrittenFileTime();
 
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
             m_materialCache[pathAsID] = materialInfo;
 
             return material;
@@ -261,28 +296,61 @@ namespace Assets {
 
     //----------------------------------------------------------------------
     MeshPtr AssetManager::getMesh( const OS::Path& filePath, MeshMaterialInfo* materials,
-                                   Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClip>* animations )
+                                   Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClipPtr>* animations )
     {
         // Check if mesh was already loaded (only if "materials" and "skeleton" is null)
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
-        if ( m_meshCache.find( pathAsID ) != m_meshCache.end() && (materials == nullptr) && (skeleton == nullptr))
+        if ( (materials == nullptr) && (skeleton == nullptr) )
         {
-            auto weakPtr = m_meshCache[pathAsID].mesh;
-            if ( not weakPtr.expired() )
-                return MeshPtr( weakPtr );
-        } 
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_meshCache.find( pathAsID ) != m_meshCache.end() )
+            {
+                auto weakPtr = m_meshCache[pathAsID].mesh;
+                if ( not weakPtr.expired() )
+                    return MeshPtr( weakPtr );
+            }
+        }
 
-        // Try loading mesh
-        LOG( "AssetManager: Loading Mesh '" + filePath.toString() + "'", LOG_COLOR );
+        // Try loading mesh. The binary cache is used if it is up to date, otherwise the source file is imported and the cache written.
         try 
         {
-            MeshPtr mesh = AssimpLoader::LoadMesh( filePath, materials, skeleton, animations );
+            U64 beginTicks = OS::PlatformTimer::getTicks();
+            F64 importMs = 0.0;
+            MeshPtr mesh = MeshCache::Load( filePath, materials, skeleton, animations, nullptr, &importMs );
+            if (mesh)
+            {
+                F64 ms = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+                LOG( "AssetManager: Loaded Mesh '" + filePath.toString() + "' from cache in " + TS( ms ) + "ms (import took " + TS( importMs ) + "ms)", LOG_COLOR );
+            }
+            else
+            {
+                // Import everything, so the cache can serve any later request for this file
+                MeshMaterialInfo importedMaterials;
+                Animation::Skeleton importedSkeleton;
+                ArrayList<Animation::AnimationClipPtr> importedAnimations;
+                mesh = AssimpLoader::LoadMesh( filePath, &importedMaterials, &importedSkeleton, &importedAnimations );
+
+                importMs = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+                LOG( "AssetManager: Imported Mesh '" + filePath.toString() + "' in " + TS( importMs ) + "ms", LOG_COLOR );
+
+                MeshCache::Save( filePath, importMs, mesh, importedMaterials, importedSkeleton, importedAnimations );
+
+                if (materials)
+                    *materials = std::move( importedMaterials );
+                if (skeleton)
+                    *skeleton = std::move( importedSkeleton );
+                if (animations)
+                    animations->insert( animations->end(), importedAnimations.begin(), importedAnimations.end() );
+            }
+
+            _PackMesh( filePath, mesh );
 
             MeshAssetInfo materialInfo;
             materialInfo.mesh        = mesh;
             materialInfo.path        = filePath;
             materialInfo.timeAtLoad  = filePath.getLastWrittenFileTime();
 
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
             m_meshCache[pathAsID] = materialInfo;
 
             return mesh;
@@ -296,11 +364,108 @@ namespace Assets {
     }
 
     //----------------------------------------------------------------------
-    MeshPtr AssetManager::getMesh( const OS::Path& filePath, Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClip>* animations )
+    MeshPtr AssetManager::getMesh( const OS::Path& filePath, Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClipPtr>* animations )
     {
         return getMesh( filePath, nullptr, skeleton, animations );
     }
 
+    //----------------------------------------------------------------------
+    ArrayList<Components::LODGroup::LOD> AssetManager::getMeshLODs( const OS::Path& filePath, const ArrayList<F32>& screenRelativeHeights, F32 reductionPerLevel )
+    {
+        ArrayList<Components::LODGroup::LOD> levels;
+        if ( screenRelativeHeights.empty() )
+            return levels;
+
+        U32 numSimplified = static_cast<U32>( screenRelativeHeights.size() ) - 1;
+        auto makeLevels = [&](const MeshPtr& mesh, const ArrayList<MeshPtr>& simplified) {
+            for (U32 i = 0; i < screenRelativeHeights.size(); i++)
+                levels.push_back( { i == 0 ? mesh : simplified[i - 1], screenRelativeHeights[i] } );
+            return levels;
+        };
+
+        // Check if the mesh and enough levels are still in memory
+        StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
+        {
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            auto it = m_meshCache.find( pathAsID );
+            if ( it != m_meshCache.end() && it->second.lodReductionPerLevel == reductionPerLevel && it->second.lods.size() >= numSimplified )
+            {
+                MeshPtr mesh = it->second.mesh.lock();
+                ArrayList<MeshPtr> simplified;
+                for (U32 i = 0; i < numSimplified; i++)
+                    simplified.push_back( it->second.lods[i].lock() );
+
+                if ( mesh && std::none_of( simplified.begin(), simplified.end(), [](const MeshPtr& lod) { return lod == nullptr; } ) )
+                    return makeLevels( mesh, simplified );
+            }
+        }
+
+        try
+        {
+            MeshMaterialInfo materials;
+            Animation::Skeleton skeleton;
+            ArrayList<Animation::AnimationClipPtr> animations;
+            MeshLODs lods;
+            F64 importMs = 0.0;
+            MeshPtr mesh = MeshCache::Load( filePath, &materials, &skeleton, &animations, &lods, &importMs );
+
+            // Levels are only generated if the cache has not enough of them. Any additional cached level is kept.
+            if ( mesh == nullptr || lods.reductionPerLevel != reductionPerLevel || lods.meshes.size() < numSimplified )
+            {
+                if (mesh == nullptr)
+                {
+                    U64 importTicks = OS::PlatformTimer::getTicks();
+                    mesh = AssimpLoader::LoadMesh( filePath, &materials, &skeleton, &animations );
+                    importMs = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - importTicks );
+                }
+
+                U64 beginTicks = OS::PlatformTimer::getTicks();
+                ArrayList<F32> thresholds( numSimplified + 1, 0.0f );
+                auto generated = Components::LODGroup::GenerateLODs( mesh, thresholds, reductionPerLevel );
+
+                lods.reductionPerLevel = reductionPerLevel;
+                lods.meshes.clear();
+                for (U32 i = 1; i < generated.size(); i++)
+                    lods.meshes.push_back( generated[i].mesh );
+
+                F64 ms = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+                LOG( "AssetManager: Generated " + TS( numSimplified ) + " levels of detail for Mesh '" + filePath.toString() + "' in " + TS( ms ) + "ms", LOG_COLOR );
+
+                MeshCache::Save( filePath, importMs, mesh, materials, skeleton, animations, lods );
+            }
+
+            _PackMesh( filePath, mesh );
+            for (auto& lod : lods.meshes)
+                _PackMesh( filePath, lod );
+
+            MeshAssetInfo meshInfo;
+            meshInfo.mesh                   = mesh;
+            meshInfo.path                   = filePath;
+            meshInfo.timeAtLoad             = filePath.getLastWrittenFileTime();
+            meshInfo.lodReductionPerLevel   = reductionPerLevel;
+            meshInfo.lods.assign( lods.meshes.begin(), lods.meshes.end() );
+
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            m_meshCache[pathAsID] = meshInfo;
+
+            return makeLevels( mesh, lods.meshes );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            LOG_WARN( "AssetManager::getMeshLODs(): Mesh '" + filePath.toString() + "' could not be loaded. Reason: " + e.what() );
+            return levels;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    AssetBatchPtr AssetManager::loadBatch( const AssetManifest& manifest, const AssetBatchCallback& callback )
+    {
+        AssetBatchPtr batch( new AssetBatch( callback ) );
+        batch->_Start( manifest );
+        m_batches.push_back( batch );
+        return batch;
+    }
+
     //----------------------------------------------------------------------
     void AssetManager::setHotReloading( bool enabled ) 
     { 
@@ -316,11 +481,42 @@ namespace Assets {
     //**********************************************************************
 
     //----------------------------------------------------------------------
-    Texture2DPtr AssetManager::_LoadTexture2D( const OS::Path& filePath, bool generateMips )
+    AssetManager::TextureData AssetManager::_ReadTexture2D( const OS::Path& filePath, bool generateMips, TextureUsage usage ) const
     {
+        TextureData data;
+
+        // Compressed textures are loaded from the cache if it is up to date, otherwise the source file is compressed and the cache written
+        if (usage != TextureUsage::Uncompressed && m_textureCompression && not m_hotReloading)
+        {
+            // Streamed textures are created with their smallest mips only, the larger ones are loaded when they are visible
+            auto& textureStreamer = Core::TextureStreamer::Instance();
+            U32 maxResidentSize = (textureStreamer.isEnabled() && generateMips) ? Core::TextureStreamer::RESIDENT_SIZE_ON_LOAD : 0;
+            data.isCompressed = true;
+            data.isStreamed = maxResidentSize > 0;
+
+            U64 beginTicks = OS::PlatformTimer::getTicks();
+            if ( TextureCache::Load( filePath, usage, generateMips, maxResidentSize, &data.image ) )
+            {
+                F64 ms = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+                data.message = "AssetManager: Loaded Texture '" + filePath.toString() + "' from cache in " + TS( ms ) + "ms";
+                return data;
+            }
+
+            if ( TextureCache::Import( filePath, usage, generateMips, maxResidentSize, &data.image ) )
+            {
+                F64 ms = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+                data.message = "AssetManager: Compressed Texture '" + filePath.toString() + "' in " + TS( ms ) + "ms";
+                return data;
+            }
+
+            data.isCompressed = false;
+            data.isStreamed = false;
+        }
+
         I32 width, height, bpp;
         stbi_info( filePath.c_str(), &width, &height, &bpp );
 
+        I32 channels = bpp == 3 ? 4 : bpp;
         auto pixels = stbi_load( filePath.c_str(), &width, &height, &bpp, bpp == 3 ? 4 : 0 );
         if ( not pixels )
         {
@@ -336,15 +532,132 @@ namespace Assets {
         case 3: texFormat = Graphics::TextureFormat::RGBA32; break;
         }
 
-        auto tex = RESOURCES.createTexture2D( width, height, texFormat, generateMips );
-        tex->setPixels( pixels );
-        tex->apply();
+        data.image.width    = width;
+        data.image.height   = height;
+        data.image.format   = texFormat;
+        data.image.mips.emplace_back( pixels, pixels + width * height * channels );
+        data.generateMips   = generateMips;
 
         stbi_image_free( pixels );
 
+        return data;
+    }
+
+    //----------------------------------------------------------------------
+    Texture2DPtr AssetManager::_CreateTexture2D( const OS::Path& filePath, const TextureData& data )
+    {
+        for (auto& warning : data.image.warnings)
+            LOG_WARN( warning );
+        if ( not data.message.empty() )
+            LOG( data.message, LOG_COLOR );
+
+        // The texture might have been loaded on the main thread while this one was read
+        StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
+        std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+        if ( m_textureCache.find( pathAsID ) != m_textureCache.end() )
+        {
+            auto weakPtr = m_textureCache[pathAsID].texture;
+            if ( not weakPtr.expired() )
+                return Texture2DPtr( weakPtr );
+        }
+
+        Texture2DPtr tex;
+        if (data.isCompressed)
+        {
+            tex = TextureCache::CreateTexture( data.image );
+            if (data.isStreamed)
+                Core::TextureStreamer::Instance().add( tex, filePath );
+        }
+        else
+        {
+            tex = RESOURCES.createTexture2D( data.image.width, data.image.height, data.image.format, data.generateMips );
+            tex->setPixels( data.image.mips[0].data() );
+            tex->apply();
+        }
+
+        TextureAssetInfo texInfo;
+        texInfo.texture     = tex;
+        texInfo.path        = filePath;
+        texInfo.timeAtLoad  = filePath.getLastWrittenFileTime();
+
+        m_textureCache[pathAsID] = texInfo;
+
         return tex;
     }
 
+    //----------------------------------------------------------------------
+    void AssetManager::_PackMesh( const OS::Path& filePath, const MeshPtr& mesh )
+    {
+        // The cache stores the float streams, so the packed formats can change without invalidating it
+        if ( not m_meshVertexPacking )
+            return;
+
+        U32 gpuSize = mesh->getVertexBufferSize();
+        U32 cpuSize = mesh->getVertexStreamSize();
+        if ( mesh->pack( mesh->choosePackedLayout(), m_keepPackedMeshStreams ) )
+            LOG( "AssetManager: Packed vertices of Mesh '" + filePath.toString() + "' from " + TS( gpuSize / 1024 ) + "KB to "
+                 + TS( mesh->getVertexBufferSize() / 1024 ) + "KB on the gpu and from " + TS( cpuSize / 1024 ) + "KB to "
+                 + TS( mesh->getVertexStreamSize() / 1024 ) + "KB on the cpu", LOG_COLOR );
+    }
+
+    //----------------------------------------------------------------------
+    MeshPtr AssetManager::_CreateMesh( const OS::Path& filePath, MeshCacheData& data, MeshMaterialInfo* materials )
+    {
+        for (auto& warning : data.warnings)
+            LOG_WARN( warning );
+
+        if (materials && data.materials.isValid())
+            *materials = std::move( data.materials );
+
+        // The mesh might have been loaded on the main thread while this one was read
+        StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
+        {
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            if ( m_meshCache.find( pathAsID ) != m_meshCache.end() )
+            {
+                auto weakPtr = m_meshCache[pathAsID].mesh;
+                if ( not weakPtr.expired() )
+                    return MeshPtr( weakPtr );
+            }
+        }
+
+        U64 beginTicks = OS::PlatformTimer::getTicks();
+        MeshPtr mesh = MeshCache::CreateMesh( data.mesh );
+        F64 ms = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+        LOG( "AssetManager: Created Mesh '" + filePath.toString() + "' from cache in " + TS( ms ) + "ms (import took " + TS( data.importMilliSeconds ) + "ms)", LOG_COLOR );
+
+        _PackMesh( filePath, mesh );
+
+        MeshAssetInfo meshInfo;
+        meshInfo.mesh        = mesh;
+        meshInfo.path        = filePath;
+        meshInfo.timeAtLoad  = filePath.getLastWrittenFileTime();
+
+        std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+        m_meshCache[pathAsID] = meshInfo;
+
+        return mesh;
+    }
+
+    //----------------------------------------------------------------------
+    AudioClipPtr AssetManager::_CreateAudioClip( const OS::Path& filePath, const Core::Audio::WAVClipPtr& wav )
+    {
+        auto audioClip = RESOURCES.createAudioClip();
+        audioClip->setWAVClip( wav );
+
+        // Cache loaded audio
+        AudioClipAssetInfo info;
+        info.wavClip    = wav;
+        info.path       = filePath;
+        info.timeAtLoad = filePath.getLastWrittenFileTime();
+
+        StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
+        std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+        m_audioCache[pathAsID] = info;
+
+        return audioClip;
+    }
+
     //----------------------------------------------------------------------
     CubemapPtr AssetManager::_LoadCubemap( const OS::Path& posX, const OS::Path& negX,
                                            const OS::Path& posY, const OS::Path& negY,
@@ -370,14 +683,40 @@ namespace Assets {
         }
 
         auto cubemap = RESOURCES.createCubemap();
-        cubemap->create( width, Graphics::TextureFormat::RGBA32, generateMips ? Graphics::Mips::Generate : Graphics::Mips::None );
-      
-        cubemap->setPixels( Graphics::CubemapFace::PositiveX, posXPixels );
-        cubemap->setPixels( Graphics::CubemapFace::NegativeX, negXPixels );
-        cubemap->setPixels( Graphics::CubemapFace::PositiveY, posYPixels );
-        cubemap->setPixels( Graphics::CubemapFace::NegativeY, negYPixels );
-        cubemap->setPixels( Graphics::CubemapFace::PositiveZ, posZPixels );
-        cubemap->setPixels( Graphics::CubemapFace::NegativeZ, negZPixels );
+        if (generateMips)
+        {
+            // Mips are generated on the cpu with gamma correct filtering, one job per face
+            const stbi_uc* faces[NUM_FACES] = { posXPixels, negXPixels, posYPixels, negYPixels, posZPixels, negZPixels };
+            ArrayList<ArrayList<Byte>> faceMips[NUM_FACES];
+
+            Graphics::MipSettings settings;
+            settings.sRGB = true;
+            auto parallelFor = [](U32 count, const std::function<void(U32)>& func) { Locator::getThreadManager().parallelFor( count, func ); };
+            parallelFor( NUM_FACES, [&](U32 face) {
+                faceMips[face] = Graphics::MipGenerator::Generate( faces[face], width, height, Graphics::TextureFormat::RGBA32, settings, parallelFor );
+            } );
+
+            ArrayList<const void*> mips;
+            for (U32 face = 0; face < NUM_FACES; face++)
+            {
+                mips.push_back( faces[face] );
+                for (auto& mip : faceMips[face])
+                    mips.push_back( mip.data() );
+            }
+            cubemap->create( width, Graphics::TextureFormat::RGBA32, mips );
+        }
+        else
+        {
+            cubemap->create( width, Graphics::TextureFormat::RGBA32, Graphics::Mips::None );
+
+            cubemap->setPixels( Graphics::CubemapFace::PositiveX, posXPixels );
+            cubemap->setPixels( Graphics::CubemapFace::NegativeX, negXPixels );
+            cubemap->setPixels( Graphics::CubemapFace::PositiveY, posYPixels );
+            cubemap->setPixels( Graphics::CubemapFace::NegativeY, negYPixels );
+            cubemap->setPixels( Graphics::CubemapFace::PositiveZ, posZPixels );
+            cubemap->setPixels( Graphics::CubemapFace::NegativeZ, negZPixels );
+            cubemap->apply();
+        }
 
         stbi_image_free( posXPixels );
         stbi_image_free( negXPixels );
@@ -386,7 +725,6 @@ namespace Assets {
         stbi_image_free( posZPixels );
         stbi_image_free( negZPixels );
 
-        cubemap->apply();
         return cubemap;
     }
 
@@ -435,6 +773,7 @@ namespace Assets {
     {
         // HOT-RELOADING CALLBACK
         m_hotReloadingCallback = Locator::getEngineClock().setInterval([this]{
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
 
             // Texture reloading
             for ( auto it = m_textureCache.begin(); it != m_textureCache.end(); )
@@ -484,6 +823,59 @@ namespace Assets {
         }, HOT_RELOAD_INTERVAL_MILLIS);
     }
 
+    //----------------------------------------------------------------------
+    void AssetManager::_PrewarmShaders()
+    {
+        OS::Path listPath( SHADER_WARM_UP_LIST );
+        if ( not listPath.exists() )
+            return;
+
+        ArrayList<OS::Path> shaderPaths;
+        try
+        {
+            OS::TextFile file( listPath, OS::EFileMode::READ );
+            while ( not file.eof() )
+            {
+                String line = file.readLine();
+                if ( not line.empty() )
+                    shaderPaths.emplace_back( line );
+            }
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN( "AssetManager: Could not read shader warm-up list. Reason: " + String( e.what() ) );
+            return;
+        }
+
+        // One job per shader. A shader requested before its job ran is compiled by the requesting thread, the
+        // job then finds its bytecode in the cache. Errors are reported once the shader is actually loaded.
+        for (auto& path : shaderPaths)
+        {
+            ASYNC_JOB([path] {
+                try {
+                    ShaderParser::PrecompileShader( path );
+                } catch (const std::runtime_error&) {}
+            });
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void AssetManager::_SaveShaderWarmUpList()
+    {
+        try
+        {
+            OS::TextFile file( SHADER_WARM_UP_LIST, OS::EFileMode::WRITE );
+            std::lock_guard<std::recursive_mutex> lock( m_cacheMutex );
+            for (auto& [id, info] : m_shaderCache)
+                if ( info.path.exists() )
+                    file.write( (info.path.toString() + '\n').c_str() );
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN( "AssetManager: Could not write shader warm-up list. Reason: " + String( e.what() ) );
+        }
+    }
+
     //----------------------------------------------------------------------
     void AssetManager::_CreateDefaultAssets()
     {
@@ -585,7 +977,9 @@ namespace Assets {
     //----------------------------------------------------------------------
     void AssetManager::TextureAssetInfo::ReloadIfNotUpToDate()
     {
-        if ( auto tex = texture.lock() )
+        // Compressed textures are immutable. They were loaded before hot reloading was enabled.
+        auto tex = texture.lock();
+        if ( tex && not tex->isImmutable() )
         {
             try {
                 auto currentFileTime = path.getLastWrittenFileTime();
@@ -6,9 +6,13 @@
     date: April 9, 2018
 
     Manages the loading of assets from disk:
-    - Ensures that every asset is loaded only once.
-    - Async loading functions if desired.
+    - Ensures that every asset is loaded only once. The caches are
+      thread-safe, but objects of the renderer must be created on the
+      main thread.
+    - Batches of assets can be loaded on worker threads (see AssetBatch).
     - Resource reloading if enabled.
+    - Shaders loaded in the last run are compiled into the shader
+      cache on worker threads at startup.
 **********************************************************************/
 
 #include "Common/i_subsystem.hpp"
@@ -20,8 +24,13 @@
 #include "Graphics/i_material.h"
 #include "Graphics/i_mesh.h"
 #include "mesh_material_info.hpp"
+#include "texture_cache.h"
+#include "mesh_cache.h"
 #include "Animation/skeleton.h"
 #include "Animation/animation_clip.h"
+#include "asset_batch.h"
+#include "GameplayLayer/Components/Rendering/lod_group.h"
+#include <mutex>
 
 namespace Assets {
 
@@ -45,6 +54,7 @@ namespace Assets {
         //----------------------------------------------------------------------
         void init() override;
         void shutdown() override;
+        void OnUpdate(Time::Seconds delta) override;
 
         //----------------------------------------------------------------------
         // Creates a new 2d texture from a file. Will be loaded only if not already in memory.
@@ -52,9 +62,18 @@ namespace Assets {
         // @Params:
         //  "path": Path to the texture.
         //  "genMips": If true a complete mipchain will be generated.
+        //  "usage": Chooses the compression format. Compressed textures are immutable and loaded from the texture cache.
+        //           Compressed textures with mips are streamed if enabled (see Core::TextureStreamer).
+        //           Ignored if the texture is already in memory.
         //----------------------------------------------------------------------
-        Texture2DPtr getTexture2D(const OS::Path& filePath, bool genMips = true);
-        void getTexture2DAsync(const OS::Path& filePath, bool genMips, const std::function<void(Texture2DPtr)>& callback);
+        Texture2DPtr getTexture2D(const OS::Path& filePath, bool genMips = true, TextureUsage usage = TextureUsage::Albedo);
+
+        //----------------------------------------------------------------------
+        // Same as getTexture2D(), but the texture is read on a worker thread.
+        // The callback is invoked on the main thread once the texture was created.
+        //----------------------------------------------------------------------
+        void getTexture2DAsync(const OS::Path& filePath, bool genMips, const std::function<void(Texture2DPtr)>& callback, 
+                               TextureUsage usage = TextureUsage::Albedo);
 
         //----------------------------------------------------------------------
         // Creates a new cubemap from a file. Will be loaded only if not already in memory. (Checks only first path)
@@ -107,8 +126,32 @@ namespace Assets {
         //  "skeleton": If not null and the mesh file has skeleton information it will be stored in the given struct.
         //  "animations": If the mesh file contains animations, they will be stored in the given array.
         //----------------------------------------------------------------------
-        MeshPtr getMesh(const OS::Path& path, MeshMaterialInfo* materials = nullptr, Animation::Skeleton* skeleton = nullptr, ArrayList<Animation::AnimationClip>* animations = nullptr);
-        MeshPtr getMesh(const OS::Path& path, Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClip>* animations);
+        MeshPtr getMesh(const OS::Path& path, MeshMaterialInfo* materials = nullptr, Animation::Skeleton* skeleton = nullptr, ArrayList<Animation::AnimationClipPtr>* animations = nullptr);
+        MeshPtr getMesh(const OS::Path& path, Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClipPtr>* animations);
+
+        //----------------------------------------------------------------------
+        // Loads a mesh together with simplified levels of detail for a LODGroup. The levels are generated
+        // once when the mesh is imported and stored in the mesh cache (see MeshGenerator::CreateSimplified()).
+        // @Params:
+        //  "path": Path to the mesh file.
+        //  "screenRelativeHeights": Threshold for each level, the first level is the mesh itself (see LODGroup).
+        //  "reductionPerLevel": Triangle ratio of each level relative to the previous one.
+        // @Return:
+        //  One level per threshold. Empty if the mesh could not be loaded.
+        //----------------------------------------------------------------------
+        ArrayList<Components::LODGroup::LOD> getMeshLODs(const OS::Path& path, const ArrayList<F32>& screenRelativeHeights, F32 reductionPerLevel = 0.5f);
+
+        //----------------------------------------------------------------------
+        // Loads all assets in the given manifest and the assets they reference in parallel. Assets are read
+        // on worker threads and created on the main thread during the following updates (or in AssetBatch::wait()).
+        // Assets already in memory are taken from the cache.
+        // @Params:
+        //  "manifest": The assets to load.
+        //  "callback": Invoked on the main thread whenever assets were created and once the batch is done,
+        //              e.g. to update a loading screen.
+        // Must be called from the main thread.
+        //----------------------------------------------------------------------
+        AssetBatchPtr loadBatch(const AssetManifest& manifest, const AssetBatchCallback& callback = nullptr);
 
         //----------------------------------------------------------------------
         // Enable/Disable hot reloading. The asset manager will periodically check
@@ -116,6 +159,25 @@ namespace Assets {
         //----------------------------------------------------------------------
         void setHotReloading(bool enabled);
 
+        //----------------------------------------------------------------------
+        // Enable/Disable interleaving and quantizing the vertices of loaded meshes (see IMesh::pack()).
+        // The formats are chosen for each mesh individually. Affects only meshes loaded afterwards.
+        //----------------------------------------------------------------------
+        void setMeshVertexPacking(bool enabled) { m_meshVertexPacking = enabled; }
+
+        //----------------------------------------------------------------------
+        // Enable/Disable keeping the float streams of packed meshes on the cpu. Disabled by default, so packing
+        // saves memory on the cpu as well. The positions are always kept. Enable this before loading meshes whose
+        // normals, uvs etc. are read by the application. Affects only meshes loaded afterwards.
+        //----------------------------------------------------------------------
+        void setKeepPackedMeshStreams(bool enabled) { m_keepPackedMeshStreams = enabled; }
+
+        //----------------------------------------------------------------------
+        // Enable/Disable block compression of loaded textures (see TextureCache). Textures are always
+        // loaded uncompressed while hot reloading is enabled, because compressed textures are immutable.
+        //----------------------------------------------------------------------
+        void setTextureCompression(bool enabled) { m_textureCompression = enabled; }
+
         //----------------------------------------------------------------------
         const ShaderPtr&        getColorShader()                const { return m_colorShader; }
         const ShaderPtr&        getErrorShader()                const { return m_errorShader; }
@@ -135,8 +197,13 @@ namespace Assets {
         const MeshPtr&          getDefaultMesh()                const { return m_defaultMesh; }
 
     private:
+        friend class AssetBatch;
+
         CallbackID m_hotReloadingCallback = 0;
         bool m_hotReloading = false;
+        bool m_meshVertexPacking = true;
+        bool m_keepPackedMeshStreams = false;
+        bool m_textureCompression = true;
 
         struct FileInfo
         {
@@ -178,11 +245,25 @@ namespace Assets {
 
         struct MeshAssetInfo : public FileInfo
         {
-            WeakMeshPtr mesh;
+            WeakMeshPtr             mesh;
+            ArrayList<WeakMeshPtr>  lods;   // Simplified levels, only present if requested via getMeshLODs()
+            F32                     lodReductionPerLevel = 0.0f;
             // No reloading supported for meshes
         };
 
+        // Texture read on any thread, which has not been created yet
+        struct TextureData
+        {
+            TextureMips     image;                  // Uncompressed textures have a single mip with the pixels
+            bool            isCompressed = false;
+            bool            isStreamed   = false;
+            bool            generateMips = false;   // Mips of uncompressed textures are generated on the gpu
+            String          message;                // Logged when the texture is created, because reading runs on worker threads
+        };
+
         // Lists of all loaded resources. Stores weak-ptrs, which means that the resource might be already unloaded.
+        // Guarded by the mutex, because assets are looked up from worker threads as well.
+        mutable std::recursive_mutex            m_cacheMutex;
         HashMap<StringID, TextureAssetInfo>     m_textureCache;
         HashMap<StringID, CubemapAssetInfo>     m_cubemapCache;
         HashMap<StringID, AudioClipAssetInfo>   m_audioCache;
@@ -213,14 +294,23 @@ namespace Assets {
 
         MeshPtr         m_defaultMesh;
 
+        // Batches which are still loading
+        ArrayList<AssetBatchPtr> m_batches;
+
         //----------------------------------------------------------------------
-        inline Texture2DPtr _LoadTexture2D(const OS::Path& filePath, bool generateMips);
+        TextureData _ReadTexture2D(const OS::Path& filePath, bool generateMips, TextureUsage usage) const;
+        Texture2DPtr _CreateTexture2D(const OS::Path& filePath, const TextureData& data);
+        MeshPtr _CreateMesh(const OS::Path& filePath, MeshCacheData& data, MeshMaterialInfo* materials);
+        AudioClipPtr _CreateAudioClip(const OS::Path& filePath, const Core::Audio::WAVClipPtr& wav);
+        void _PackMesh(const OS::Path& filePath, const MeshPtr& mesh);
         inline CubemapPtr _LoadCubemap(const OS::Path& posX, const OS::Path& negX, 
                                        const OS::Path& posY, const OS::Path& negY,
                                        const OS::Path& posZ, const OS::Path& negZ, bool generateMips);
         inline CubemapPtr _LoadCubemap(const OS::Path& path, I32 sizePerFace, bool generateMips);
         void _EnableHotReloading();
         void _CreateDefaultAssets();
+        void _PrewarmShaders();
+        void _SaveShaderWarmUpList();
 
         NULL_COPY_AND_ASSIGN(AssetManager)
     };
@@ -8,18 +8,28 @@
 
 #include "Core/locator.h"
 #include "Animation/skeleton.h"
+#include "Animation/compressed_animation_clip.h"
+#include "mesh_optimizer.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/cimport.h>
+#include <numeric>
 
 namespace Assets {
 
+    // Imported animations are resampled to this rate before they are compressed
+    #define ANIMATION_SAMPLE_RATE 30.0f
+
+    // Identical vertices are welded, otherwise every triangle has its own vertices and the vertex cache optimization below has no effect
+    static const U32 IMPORTER_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace
+                                      | aiProcess_FlipUVs | aiProcess_GenUVCoords | aiProcess_FindInvalidData | aiProcess_JoinIdenticalVertices;
+
     //----------------------------------------------------------------------
-    void ExtractVertexBoneWeights(const aiScene* scene, const MeshPtr& mesh, U32 numVertices);
+    void ExtractVertexBoneWeights(const aiMesh* aMesh, U32 baseVertex, const ArrayList<U32>& vertexRemap, Math::Vec4Int* boneIDs, Math::Vec4* boneWeights);
     void ExtractSkeleton(const aiScene* scene, Animation::Skeleton* skeleton);
-    void ExtractAnimation(const aiScene* scene, ArrayList<Animation::AnimationClip>* animationClips);
+    void ExtractAnimation(const aiScene* scene, ArrayList<Animation::AnimationClipPtr>* animationClips);
     void LoadMaterials(const aiScene* scene, const OS::Path& path, MeshMaterialInfo* materials);
 
     //----------------------------------------------------------------------
@@ -35,11 +45,8 @@ namespace Assets {
 
     //----------------------------------------------------------------------
     MeshPtr AssimpLoader::LoadMesh( const OS::Path& path, MeshMaterialInfo* materials, 
-                                    Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClip>* animations )
+                                    Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClipPtr>* animations )
     {
-        static const I32 IMPORTER_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace
-                                          | aiProcess_FlipUVs | aiProcess_GenUVCoords | aiProcess_FindInvalidData;
-
         Assimp::Importer importer;
         const aiScene* scene = importer.ReadFile( path.c_str(), IMPORTER_FLAGS );
 
@@ -53,61 +60,129 @@ namespace Assets {
         // Create new mesh
         MeshPtr mesh = RESOURCES.createMesh();
 
-        ArrayList<Math::Vec3> vertices;
-        ArrayList<Math::Vec2> uvs;
-        ArrayList<Math::Vec3> normals;
-        ArrayList<Math::Vec4> tangents;
-
-        // Create submeshes for each mesh in the aiScene
-        aiVector3D Zero3D( 0.0f, 0.0f, 0.0f );
-        for (U32 m = 0; m < scene->mNumMeshes; m++)
+        // Every submesh owns a contiguous range of vertices, so the ranges can be computed upfront and filled in parallel
+        U32 numMeshes = scene->mNumMeshes;
+        ArrayList<U32> baseVertices( numMeshes );
+        U32 numVertices = 0;
+        for (U32 m = 0; m < numMeshes; m++)
         {
             aiMesh* aMesh = scene->mMeshes[m];
-            bool hasTextureCoords       = aMesh->HasTextureCoords(0);
-            bool hasNormals             = aMesh->HasNormals();
-            bool hasTangentsBitangents  = aMesh->HasTangentsAndBitangents();
-
-            if ( not hasTextureCoords )
+            if ( not aMesh->HasTextureCoords(0) )
                 LOG_WARN( TS( m ) + "th Submesh of mesh '" + path.toString() + "' has no UV-Coordinates. All uvs set to zero." );
-            if ( not hasNormals )
+            if ( not aMesh->HasNormals() )
                 LOG_WARN( TS( m ) + "th Submesh of mesh '" + path.toString() + "' has no Normals. All normals set to zero." );
 
             if (materials)
                 materials->_AddMaterialIndex( aMesh->mMaterialIndex );
 
-            // Save base vertex for this submesh
-            U32 baseVertex = (U32)vertices.size();
+            baseVertices[m] = numVertices;
+            numVertices += aMesh->mNumVertices;
+        }
+
+        ArrayList<Math::Vec3>       vertices( numVertices );
+        ArrayList<Math::Vec2>       uvs( numVertices );
+        ArrayList<Math::Vec3>       normals( numVertices );
+        ArrayList<Math::Vec4>       tangents( numVertices );
+        ArrayList<Math::Vec4Int>    boneIDs( numVertices );
+        ArrayList<Math::Vec4>       boneWeights( numVertices );
+
+        struct SubMeshImport
+        {
+            ArrayList<U32>      indices;
+            VertexCacheStats    before;
+            VertexCacheStats    after;
+            U32                 numSkippedFaces = 0; // Logged afterwards, the logger can't be used from several threads
+        };
+        ArrayList<SubMeshImport> subMeshes( numMeshes );
+
+        // Start with the largest submeshes, so a single big one doesn't end up last on one thread
+        ArrayList<U32> order( numMeshes );
+        std::iota( order.begin(), order.end(), 0 );
+        std::sort( order.begin(), order.end(), [scene](U32 a, U32 b) { return scene->mMeshes[a]->mNumFaces > scene->mMeshes[b]->mNumFaces; } );
+
+        // Each job writes only to the vertex range and the entry of its own submesh
+        Locator::getThreadManager().parallelFor( numMeshes, [&](U32 i) {
+            U32 m = order[i];
+            aiMesh* aMesh = scene->mMeshes[m];
+            U32 baseVertex = baseVertices[m];
+            bool hasTextureCoords       = aMesh->HasTextureCoords(0);
+            bool hasNormals             = aMesh->HasNormals();
+            bool hasTangentsBitangents  = aMesh->HasTangentsAndBitangents();
 
             // Fill vertices
             for (U32 j = 0; j < aMesh->mNumVertices; j++)
             {
-                aiVector3D* pPos        = &(aMesh->mVertices[j]);
-                aiVector3D* pTexCoord   = hasTextureCoords      ? &(aMesh->mTextureCoords[0][j]) : &Zero3D;
-                aiVector3D* pNormal     = hasNormals            ? &(aMesh->mNormals[j])          : &Zero3D;
-                aiVector3D* pTangent    = hasTangentsBitangents ? &(aMesh->mTangents[j])         : &Zero3D;
-
-                vertices.emplace_back( pPos->x, pPos->y, pPos->z );
-                uvs.emplace_back( pTexCoord->x, pTexCoord->y );
-                normals.emplace_back( pNormal->x, pNormal->y, pNormal->z );
-                tangents.emplace_back( pTangent->x, pTangent->y, pTangent->z, 1.0f );
+                const aiVector3D& pos = aMesh->mVertices[j];
+                vertices[baseVertex + j] = { pos.x, pos.y, pos.z };
+                if (hasTextureCoords)
+                    uvs[baseVertex + j] = { aMesh->mTextureCoords[0][j].x, aMesh->mTextureCoords[0][j].y };
+                if (hasNormals)
+                    normals[baseVertex + j] = { aMesh->mNormals[j].x, aMesh->mNormals[j].y, aMesh->mNormals[j].z };
+                if (hasTangentsBitangents)
+                    tangents[baseVertex + j] = { aMesh->mTangents[j].x, aMesh->mTangents[j].y, aMesh->mTangents[j].z, 1.0f };
+                else
+                    tangents[baseVertex + j] = { 0.0f, 0.0f, 0.0f, 1.0f };
             }
 
             // Fill Indices
-            ArrayList<U32> indices;
+            auto& subMesh = subMeshes[m];
+            subMesh.indices.reserve( aMesh->mNumFaces * 3 );
             for (U32 k = 0; k < aMesh->mNumFaces; k++)
             {
                 const aiFace& Face = aMesh->mFaces[k];
                 if (Face.mNumIndices != 3)
                 {
-                    LOG_WARN( "Mesh contains other primitives than triangles, which is not supported" );
+                    subMesh.numSkippedFaces++;
                     continue;
                 }
 
-                indices.push_back( Face.mIndices[0] );
-                indices.push_back( Face.mIndices[1] );
-                indices.push_back( Face.mIndices[2] );
+                subMesh.indices.push_back( Face.mIndices[0] );
+                subMesh.indices.push_back( Face.mIndices[1] );
+                subMesh.indices.push_back( Face.mIndices[2] );
             }
-            mesh->setIndices( indices, m, Graphics::MeshTopology::Triangles, baseVertex );
+
+            // Reorder triangles + vertices for the gpu. Vertex attributes are local to the submesh, so only its range is remapped.
+            auto& indices = subMesh.indices;
+            subMesh.before = MeshOptimizer::AnalyzeVertexCache( indices, aMesh->mNumVertices );
+
+            MeshOptimizer::OptimizeVertexCache( indices, aMesh->mNumVertices );
+            MeshOptimizer::OptimizeOverdraw( indices, vertices.data() + baseVertex, aMesh->mNumVertices );
+            auto remap = MeshOptimizer::OptimizeVertexFetch( indices, aMesh->mNumVertices );
+            MeshOptimizer::RemapVertices( vertices, remap, baseVertex );
+            MeshOptimizer::RemapVertices( uvs, remap, baseVertex );
+            MeshOptimizer::RemapVertices( normals, remap, baseVertex );
+            MeshOptimizer::RemapVertices( tangents, remap, baseVertex );
+
+            subMesh.after = MeshOptimizer::AnalyzeVertexCache( indices, aMesh->mNumVertices );
+
+            ExtractVertexBoneWeights( aMesh, baseVertex, remap, boneIDs.data(), boneWeights.data() );
+        } );
+
+        // Index buffers are created in submesh order on this thread
+        VertexCacheStats statsBefore, statsAfter;
+        U32 numTriangles = 0;
+        for (U32 m = 0; m < numMeshes; m++)
+        {
+            auto& subMesh = subMeshes[m];
+            if (subMesh.numSkippedFaces > 0)
+                LOG_WARN( "Mesh contains other primitives than triangles, which is not supported" );
+
+            U32 numSubMeshVertices = scene->mMeshes[m]->mNumVertices;
+            U32 numSubMeshTriangles = static_cast<U32>( subMesh.indices.size() / 3 );
+            statsBefore.acmr += subMesh.before.acmr * numSubMeshTriangles;
+            statsBefore.atvr += subMesh.before.atvr * numSubMeshVertices;
+            statsAfter.acmr  += subMesh.after.acmr * numSubMeshTriangles;
+            statsAfter.atvr  += subMesh.after.atvr * numSubMeshVertices;
+            numTriangles     += numSubMeshTriangles;
+
+            mesh->setIndices( subMesh.indices, m, Graphics::MeshTopology::Triangles, baseVertices[m] );
+        }
+
+        if (numTriangles > 0)
+        {
+            F32 numVerticesF = static_cast<F32>( numVertices );
+            LOG( "AssimpLoader: Optimized mesh '" + path.toString() + "'. ACMR: " + TS( statsBefore.acmr / numTriangles ) + " -> "
+                 + TS( statsAfter.acmr / numTriangles ) + ", ATVR: " + TS( statsBefore.atvr / numVerticesF ) + " -> " + TS( statsAfter.atvr / numVerticesF ) );
         }
 
         // Apply data to the mesh
@@ -115,8 +190,11 @@ namespace Assets {
         mesh->setUVs( uvs );
         mesh->setNormals( normals );
         mesh->setTangents( tangents );
+        if (not boneIDs.empty())
+            mesh->setBoneIDs( boneIDs );
+        if (not boneWeights.empty())
+            mesh->setBoneWeights( boneWeights );
 
-        ExtractVertexBoneWeights( scene, mesh, static_cast<U32>( vertices.size() ) );
         if (skeleton)
             ExtractSkeleton( scene, skeleton );
         if (animations)
@@ -133,56 +211,58 @@ namespace Assets {
     }
 
     //----------------------------------------------------------------------
-    void ExtractVertexBoneWeights( const aiScene* scene, const MeshPtr& mesh,  U32 numVertices )
+    U32 AssimpLoader::GetImportFlags()
     {
-        // Extract Bone information from Assimps weird format to my own
-        struct BoneWeight
+        return IMPORTER_FLAGS;
+    }
+
+    //----------------------------------------------------------------------
+    // Inserts the weight into the weights of a vertex, which are sorted from max to min. Only the largest MAX_BONE_WEIGHTS are kept.
+    //----------------------------------------------------------------------
+    static void AddBoneWeight( Math::Vec4Int& ids, Math::Vec4& weights, I32 id, F32 weight )
+    {
+        I32 i = Animation::MAX_BONE_WEIGHTS - 1;
+        if (weight <= weights[i])
+            return;
+
+        for (; i > 0 && weights[i - 1] < weight; i--)
         {
-            I32 id = -1;
-            F32 weight = 0.0f;
-        };
-        ArrayList<ArrayList<BoneWeight>> vertexBoneWeights( numVertices ); // Maps to every vertex a list of bone indices + weights
-        for (U32 m = 0; m < scene->mNumMeshes; m++)
+            ids[i] = ids[i - 1];
+            weights[i] = weights[i - 1];
+        }
+        ids[i] = id;
+        weights[i] = weight;
+    }
+
+    //----------------------------------------------------------------------
+    // Extracts the bone weights of one submesh into its vertex range.
+    // @Params:
+    //  "vertexRemap": New index of every vertex of the submesh after the vertex fetch optimization.
+    //----------------------------------------------------------------------
+    void ExtractVertexBoneWeights( const aiMesh* aMesh, U32 baseVertex, const ArrayList<U32>& vertexRemap, Math::Vec4Int* boneIDs, Math::Vec4* boneWeights )
+    {
+        for (U32 b = 0; b < aMesh->mNumBones; b++)
         {
-            aiMesh* aMesh = scene->mMeshes[m];
-            for (U32 b = 0; b < aMesh->mNumBones; b++)
+            auto& bone = aMesh->mBones[b];
+            for (U32 w = 0; w < bone->mNumWeights; w++)
             {
-                auto& bone = aMesh->mBones[b];
-                for (U32 w = 0; w < bone->mNumWeights; w++)
-                {
-                    auto& weight = bone->mWeights[w];
-                    vertexBoneWeights[ weight.mVertexId + mesh->getBaseVertex( m ) ].push_back( { (I32)b, weight.mWeight } );
-                }
+                auto& weight = bone->mWeights[w];
+                U32 vert = baseVertex + vertexRemap[weight.mVertexId];
+                AddBoneWeight( boneIDs[vert], boneWeights[vert], (I32)b, weight.mWeight );
             }
         }
 
-        // Extract data from own format above in two separate arrays suitable for the mesh class
-        ArrayList<Math::Vec4Int> boneIDs( numVertices );
-        ArrayList<Math::Vec4>    boneWeights( numVertices );
-        for (I32 vert = 0; vert < vertexBoneWeights.size(); vert++)
+        // Normalize weights, so they always sum up to 1
+        for (U32 vert = baseVertex; vert < baseVertex + aMesh->mNumVertices; vert++)
         {
-            // Sort weights from max to min
-            std::sort( vertexBoneWeights[vert].begin(), vertexBoneWeights[vert].end(), [](const BoneWeight& a, const BoneWeight& b) {
-                return a.weight > b.weight;
-            } );
-
-            // Get first MAX_BONE_WEIGHTS and add data to the array
             F32 sum = 0;
-            for (I32 i = 0; i < std::min( (I32)vertexBoneWeights[vert].size(), Animation::MAX_BONE_WEIGHTS ); i++)
-            {
-                boneIDs[vert][i] = vertexBoneWeights[vert][i].id;
-                boneWeights[vert][i] = vertexBoneWeights[vert][i].weight;
+            for (I32 i = 0; i < Animation::MAX_BONE_WEIGHTS; i++)
                 sum += boneWeights[vert][i];
-            }
 
-            // Normalize weights, so they always sum up to 1
-            for (I32 i = 0; i < Animation::MAX_BONE_WEIGHTS; i++)
-                boneWeights[vert][i] /= sum;
+            if (sum > 0.0f)
+                for (I32 i = 0; i < Animation::MAX_BONE_WEIGHTS; i++)
+                    boneWeights[vert][i] /= sum;
         }
-        if (not boneIDs.empty())
-            mesh->setBoneIDs( boneIDs );
-        if (not boneWeights.empty())
-            mesh->setBoneWeights( boneWeights );
     }
 
     //----------------------------------------------------------------------
@@ -223,55 +303,77 @@ namespace Assets {
     }
 
     //----------------------------------------------------------------------
-    void ExtractAnimation( const aiScene* scene, ArrayList<Animation::AnimationClip>* animationClips )
+    void ExtractAnimation( const aiScene* scene, ArrayList<Animation::AnimationClipPtr>* animationClips )
     {
-        for (U32 i = 0; i < scene->mNumAnimations; i++)
+        // Names are interned up front, because the string table can't be written from several threads
+        U32 numAnimations = scene->mNumAnimations;
+        ArrayList<Animation::AnimationClip> clips( numAnimations );
+        for (U32 i = 0; i < numAnimations; i++)
         {
             auto& anim = scene->mAnimations[i];
+            clips[i].name = SID( anim->mName.C_Str() );
+            clips[i].jointSamples.resize( anim->mNumChannels );
+            for (U32 ch = 0; ch < anim->mNumChannels; ch++)
+                clips[i].jointSamples[ch].name = SID( anim->mChannels[ch]->mNodeName.C_Str() );
+        }
+
+        ArrayList<Animation::AnimationClipPtr> compressedClips( numAnimations );
+        Locator::getThreadManager().parallelFor( numAnimations, [&](U32 i) {
+            auto& anim = scene->mAnimations[i];
+            auto& clip = clips[i];
 
-            Animation::AnimationClip clip;
-            clip.name = SID( anim->mName.C_Str() );
-            clip.duration = anim->mDuration * anim->mTicksPerSecond;
+            // Key times are given in ticks. Zero ticks per second means the file does not specify it.
+            F64 ticksPerSecond = anim->mTicksPerSecond > 0.0 ? anim->mTicksPerSecond : 25.0;
+            clip.duration = anim->mDuration / ticksPerSecond;
 
-            for (U32 ch = 0; ch < anim->mNumChannels; ch++)
-            {
+            Locator::getThreadManager().parallelFor( anim->mNumChannels, [&](U32 ch) {
                 auto& channel = anim->mChannels[ch];
+                auto& jointSamples = clip.jointSamples[ch];
 
-                Animation::JointSamples jointSamples;
-                jointSamples.name = SID( channel->mNodeName.C_Str() );
+                jointSamples.translationKeys.resize( channel->mNumPositionKeys );
                 for (U32 pos = 0; pos < channel->mNumPositionKeys; pos++)
                 {
                     auto& positionKey = channel->mPositionKeys[pos];
 
-                    Animation::TranslationKey key;
-                    key.time = positionKey.mTime;
+                    auto& key = jointSamples.translationKeys[pos];
+                    key.time = positionKey.mTime / ticksPerSecond;
                     key.translation = Math::Vec3{ positionKey.mValue.x, positionKey.mValue.y, positionKey.mValue.z };
-                    jointSamples.translationKeys.push_back( key );
                 }
 
+                jointSamples.rotationKeys.resize( channel->mNumRotationKeys );
                 for (U32 rot = 0; rot < channel->mNumRotationKeys; rot++)
                 {
-                    auto rotationKey = channel->mRotationKeys[rot];
+                    auto& rotationKey = channel->mRotationKeys[rot];
 
-                    Animation::RotationKey key;
-                    key.time = rotationKey.mTime;
+                    auto& key = jointSamples.rotationKeys[rot];
+                    key.time = rotationKey.mTime / ticksPerSecond;
                     key.rotation = Math::Quat{ rotationKey.mValue.x, rotationKey.mValue.y, rotationKey.mValue.z, rotationKey.mValue.w };
-                    jointSamples.rotationKeys.push_back( key );
                 }
 
+                jointSamples.scalingKeys.resize( channel->mNumScalingKeys );
                 for (U32 sc = 0; sc < channel->mNumScalingKeys; sc++)
                 {
-                    auto scaleKey = channel->mScalingKeys[sc];
+                    auto& scaleKey = channel->mScalingKeys[sc];
 
-                    Animation::ScalingKey key;
-                    key.time = scaleKey.mTime;
+                    auto& key = jointSamples.scalingKeys[sc];
+                    key.time = scaleKey.mTime / ticksPerSecond;
                     key.scale = Math::Vec3{ scaleKey.mValue.x, scaleKey.mValue.y, scaleKey.mValue.z };
-                    jointSamples.scalingKeys.push_back( key );
                 }
-                clip.jointSamples.push_back( jointSamples );
-            }
+            } );
+
+            Animation::CompressionSettings settings;
+            settings.sampleRate = ANIMATION_SAMPLE_RATE;
+            compressedClips[i] = std::make_shared<Animation::CompressedAnimationClip>( clip, settings );
+        } );
+
+        for (U32 i = 0; i < numAnimations; i++)
+        {
+            auto& stats = compressedClips[i]->getStats();
+            LOG( "AssimpLoader: Compressed animation '" + String( scene->mAnimations[i]->mName.C_Str() ) + "' from " + TS( stats.rawBytes / 1024 ) + " KB to "
+                 + TS( stats.compressedBytes / 1024 ) + " KB. Max error: Translation " + TS( stats.maxTranslationError ) + ", Rotation "
+                 + TS( stats.maxRotationError ) + " deg, Scale " + TS( stats.maxScaleError ) );
 
-            animationClips->push_back( clip );
+            animationClips->push_back( compressedClips[i] );
         }
     }
 
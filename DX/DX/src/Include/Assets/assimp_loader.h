@@ -25,7 +25,13 @@ namespace Assets {
         //  "path": The file-path to the mesh file.
         //----------------------------------------------------------------------
         static MeshPtr LoadMesh(const OS::Path& path, MeshMaterialInfo* materials,
-                                Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClip>* animations);
+                                Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClipPtr>* animations);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Postprocess flags passed to assimp. Part of the key of cached meshes.
+        //----------------------------------------------------------------------
+        static U32 GetImportFlags();
 
         AssimpLoader() = delete;
         NULL_COPY_AND_ASSIGN(AssimpLoader)
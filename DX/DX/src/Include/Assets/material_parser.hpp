@@ -10,6 +10,7 @@
 #include "OS/FileSystem/file.h"
 #include "Ext/JSON/json.hpp"
 #include "Core/locator.h"
+#include "texture_cache.h"
 
 using JSON = nlohmann::json;
 
@@ -19,6 +20,13 @@ namespace Assets {
     class MaterialParser
     {
     public:
+        struct TextureDependency
+        {
+            String          property;
+            String          path;
+            TextureUsage    usage;
+        };
+
         //----------------------------------------------------------------------
         // Tries to load a custom shader file format from the given file.
         // @Return:
@@ -126,7 +134,8 @@ namespace Assets {
                     try
                     {
                         String path = it.value();
-                        material->setTexture( propName.c_str(), ASSETS.getTexture2D( path ) );
+                        auto usage = GetTextureUsage( SID( propName.c_str() ) );
+                        material->setTexture( propName.c_str(), ASSETS.getTexture2D( path, true, usage ) );
                     } catch (...) { // Parsing was unsuccessful
                         LOG_WARN( "MaterialParser: Could not parse string for parameter '" + propName + "' (Tex2D) for material '" + filePath.toString() + "'. "
                                   "Please ensure that its a valid string." );
@@ -174,6 +183,57 @@ namespace Assets {
                 _SetPBRParams( material );
         }
 
+        //----------------------------------------------------------------------
+        // Parses the given material file for the assets it references, without creating anything. Thread-safe.
+        // The types of the parameters are known only once the shader is created, so every string which is
+        // not a color in hex format might be a 2d texture. Pass them to GetTextureDependencies() afterwards.
+        // @Params:
+        //  "filePath": Path to the material file
+        //  "shaderPath": Receives the path of the shader, empty if none is specified.
+        //  "textures": Receives every parameter which might be a 2d texture.
+        // @Throws:
+        //  std::runtime_error if something went wrong.
+        //----------------------------------------------------------------------
+        static void GetDependencies( const OS::Path& filePath, String* shaderPath, ArrayList<TextureDependency>* textures )
+        {
+            OS::File file( filePath );
+
+            JSON json;
+            try {
+                json = JSON::parse( file.readAll() );
+            } catch (...) {
+                throw std::runtime_error( "Failed to parse file as JSON. Please ensure that the file contains valid JSON." );
+            }
+
+            for (auto it = json.begin(); it != json.end(); it++)
+            {
+                if ( not it.value().is_string() )
+                    continue;
+
+                String value = it.value();
+                if ( it.key() == "shader" )
+                    *shaderPath = value;
+                else if ( not value.empty() && value[0] != '#' )
+                    textures->push_back( { it.key(), value, GetTextureUsage( SID( it.key().c_str() ) ) } );
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "shader": The shader of the material, which has been created already.
+        //  "candidates": Parameters which might be a 2d texture, see GetDependencies().
+        // @Return:
+        //  The candidates which are 2d textures in the given shader.
+        //----------------------------------------------------------------------
+        static ArrayList<TextureDependency> GetTextureDependencies( const ShaderPtr& shader, const ArrayList<TextureDependency>& candidates )
+        {
+            ArrayList<TextureDependency> textures;
+            for (auto& candidate : candidates)
+                if ( shader->getDataTypeOfMaterialPropertyOrResource( SID( candidate.property.c_str() ) ) == DataType::Texture2D )
+                    textures.push_back( candidate );
+            return textures;
+        }
+
     private:
         //----------------------------------------------------------------------
         static Math::Vec4 _ParseVec4( const JSON& value )
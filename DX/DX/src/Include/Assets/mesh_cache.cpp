@@ -0,0 +1,350 @@
+#include "mesh_cache.h"
+/**********************************************************************
+    class: MeshCache (mesh_cache.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "assimp_loader.h"
+#include "Animation/compressed_animation_clip.h"
+#include "Common/DataStructures/binary_stream.hpp"
+#include "OS/FileSystem/file.h"
+#include "OS/FileSystem/mapped_file.h"
+
+namespace Assets {
+
+    // Increase the version whenever the layout below or the output of the importer changes (e.g. the animation compression)
+    static constexpr U32 MESH_CACHE_MAGIC   = 0x4853454d; // "MESH"
+    static constexpr U32 MESH_CACHE_VERSION = 4;
+    static const char*   MESH_CACHE_EXTENSION = ".meshcache";
+
+    //----------------------------------------------------------------------
+    struct MeshCacheHeader
+    {
+        U32             magic;
+        U32             version;
+        U32             importFlags;
+        OS::SystemTime  sourceTime;
+        F64             importMilliSeconds;
+    };
+
+    //----------------------------------------------------------------------
+    // Vertex streams which are stored in the cache. The order must never change without increasing the version.
+    //----------------------------------------------------------------------
+    enum MeshCacheStream : U32
+    {
+        STREAM_POSITION     = 1 << 0,
+        STREAM_COLOR        = 1 << 1,
+        STREAM_UV           = 1 << 2,
+        STREAM_NORMAL       = 1 << 3,
+        STREAM_TANGENT      = 1 << 4,
+        STREAM_BONEID       = 1 << 5,
+        STREAM_BONEWEIGHT   = 1 << 6
+    };
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    static void WriteStream( Common::BinaryWriter& writer, const MeshPtr& mesh, StringID name )
+    {
+        if ( mesh->hasVertexStream( name ) )
+            writer.writeArray( mesh->getVertexStream<T>( name ).get() );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    static void CreateStream( const MeshPtr& mesh, StringID name, const ArrayList<T>& data )
+    {
+        if ( not data.empty() )
+            mesh->createVertexStream<T>( name, data );
+    }
+
+    //----------------------------------------------------------------------
+    // Vertex streams, bounds and submeshes of one mesh
+    //----------------------------------------------------------------------
+    static void WriteMesh( Common::BinaryWriter& writer, const MeshPtr& mesh )
+    {
+        U32 streamMask = 0;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_POSITION ) )   streamMask |= STREAM_POSITION;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_COLOR ) )      streamMask |= STREAM_COLOR;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_UV ) )         streamMask |= STREAM_UV;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_NORMAL ) )     streamMask |= STREAM_NORMAL;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_TANGENT ) )    streamMask |= STREAM_TANGENT;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_BONEID ) )     streamMask |= STREAM_BONEID;
+        if ( mesh->hasVertexStream( Graphics::SID_VERTEX_BONEWEIGHT ) ) streamMask |= STREAM_BONEWEIGHT;
+        writer.write( streamMask );
+
+        WriteStream<Math::Vec3>( writer, mesh, Graphics::SID_VERTEX_POSITION );
+        WriteStream<Math::Vec4>( writer, mesh, Graphics::SID_VERTEX_COLOR );
+        WriteStream<Math::Vec2>( writer, mesh, Graphics::SID_VERTEX_UV );
+        WriteStream<Math::Vec3>( writer, mesh, Graphics::SID_VERTEX_NORMAL );
+        WriteStream<Math::Vec4>( writer, mesh, Graphics::SID_VERTEX_TANGENT );
+        WriteStream<Math::Vec4Int>( writer, mesh, Graphics::SID_VERTEX_BONEID );
+        WriteStream<Math::Vec4>( writer, mesh, Graphics::SID_VERTEX_BONEWEIGHT );
+
+        writer.write( mesh->getBounds().getMin() );
+        writer.write( mesh->getBounds().getMax() );
+
+        writer.write( static_cast<U32>( mesh->getSubMeshCount() ) );
+        for (U32 i = 0; i < mesh->getSubMeshCount(); i++)
+        {
+            writer.write( mesh->getMeshTopology( i ) );
+            writer.write( mesh->getBaseVertex( i ) );
+            writer.writeArray( mesh->getIndices( i ).data(), mesh->getIndexCount( i ) );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    static void ReadMesh( Common::BinaryReader& reader, MeshData* mesh )
+    {
+        U32 streamMask = reader.read<U32>();
+        if (streamMask & STREAM_POSITION)   mesh->positions   = reader.readArray<Math::Vec3>();
+        if (streamMask & STREAM_COLOR)      mesh->colors      = reader.readArray<Math::Vec4>();
+        if (streamMask & STREAM_UV)         mesh->uvs         = reader.readArray<Math::Vec2>();
+        if (streamMask & STREAM_NORMAL)     mesh->normals     = reader.readArray<Math::Vec3>();
+        if (streamMask & STREAM_TANGENT)    mesh->tangents    = reader.readArray<Math::Vec4>();
+        if (streamMask & STREAM_BONEID)     mesh->boneIDs     = reader.readArray<Math::Vec4Int>();
+        if (streamMask & STREAM_BONEWEIGHT) mesh->boneWeights = reader.readArray<Math::Vec4>();
+
+        // Bounds are stored, so they don't have to be recalculated from the positions
+        auto boundsMin = reader.read<Math::Vec3>();
+        auto boundsMax = reader.read<Math::Vec3>();
+        mesh->bounds = Math::AABB( boundsMin, boundsMax );
+
+        U32 numSubMeshes = reader.read<U32>();
+        for (U32 i = 0; i < numSubMeshes && reader.isValid(); i++)
+        {
+            MeshData::SubMesh subMesh;
+            subMesh.topology    = reader.read<Graphics::MeshTopology>();
+            subMesh.baseVertex  = reader.read<U32>();
+            subMesh.indices     = reader.readArray<U32>();
+            if ( not reader.isValid() )
+                break;
+
+            mesh->subMeshes.push_back( std::move( subMesh ) );
+        }
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    bool MeshCache::Read( const OS::Path& sourcePath, bool readLODs, MeshCacheData* data )
+    {
+        OS::Path cachePath = GetCachePath( sourcePath );
+        if ( not sourcePath.exists() || not cachePath.exists() )
+            return false;
+
+        std::unique_ptr<OS::MappedFile> file;
+        try
+        {
+            file = std::make_unique<OS::MappedFile>( cachePath );
+        }
+        catch (const std::runtime_error& e)
+        {
+            data->warnings.push_back( "MeshCache: Could not map cache file '" + cachePath.toString() + "'. Reason: " + e.what() );
+            return false;
+        }
+        Common::BinaryReader reader( file->data(), file->size() );
+
+        auto header = reader.read<MeshCacheHeader>();
+        if ( header.magic != MESH_CACHE_MAGIC || header.version != MESH_CACHE_VERSION || header.importFlags != AssimpLoader::GetImportFlags()
+             || header.sourceTime != sourcePath.getLastWrittenFileTime() )
+            return false;
+
+        // Vertex streams and submeshes
+        ReadMesh( reader, &data->mesh );
+
+        // Materials
+        data->materials.materialIndices = reader.readArray<U32>();
+        U32 numMaterials = reader.read<U32>();
+        for (U32 i = 0; i < numMaterials && reader.isValid(); i++)
+        {
+            auto& material = data->materials._AddMaterial();
+            material.diffuseColor = reader.read<Color>();
+
+            U32 numTextures = reader.read<U32>();
+            for (U32 t = 0; t < numTextures && reader.isValid(); t++)
+            {
+                auto type       = reader.read<MaterialTextureType>();
+                bool isRelative = reader.read<bool>();
+                String path     = reader.readString();
+                material.textures.push_back({ type, isRelative ? sourcePath.getDirectoryPath() + path : path });
+            }
+        }
+
+        // Skeleton
+        U32 numJoints = reader.read<U32>();
+        for (U32 i = 0; i < numJoints && reader.isValid(); i++)
+        {
+            Animation::SkeletonJoint joint;
+            joint.name          = SID( reader.readString().c_str() );
+            joint.parentIndex   = reader.read<I32>();
+            joint.invBindPose   = reader.read<DirectX::XMMATRIX>();
+            data->skeleton.joints.push_back( joint );
+        }
+
+        // Animations
+        U32 numAnimations = reader.read<U32>();
+        for (U32 i = 0; i < numAnimations && reader.isValid(); i++)
+            data->animations.push_back( Animation::CompressedAnimationClip::Deserialize( reader ) );
+
+        // Levels of detail. They are stored last, so they are only read if requested.
+        if (readLODs)
+        {
+            data->lodReductionPerLevel = reader.read<F32>();
+            U32 numLODs = reader.read<U32>();
+            for (U32 i = 0; i < numLODs && reader.isValid(); i++)
+                ReadMesh( reader, &data->lods.emplace_back() );
+        }
+
+        if ( not reader.isValid() )
+        {
+            data->warnings.push_back( "MeshCache: Cache file '" + cachePath.toString() + "' is truncated and will be ignored." );
+            return false;
+        }
+
+        data->importMilliSeconds = header.importMilliSeconds;
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    MeshPtr MeshCache::CreateMesh( const MeshData& data )
+    {
+        MeshPtr mesh = RESOURCES.createMesh();
+        CreateStream( mesh, Graphics::SID_VERTEX_POSITION,   data.positions );
+        CreateStream( mesh, Graphics::SID_VERTEX_COLOR,      data.colors );
+        CreateStream( mesh, Graphics::SID_VERTEX_UV,         data.uvs );
+        CreateStream( mesh, Graphics::SID_VERTEX_NORMAL,     data.normals );
+        CreateStream( mesh, Graphics::SID_VERTEX_TANGENT,    data.tangents );
+        CreateStream( mesh, Graphics::SID_VERTEX_BONEID,     data.boneIDs );
+        CreateStream( mesh, Graphics::SID_VERTEX_BONEWEIGHT, data.boneWeights );
+        mesh->setBounds( data.bounds );
+
+        for (U32 i = 0; i < data.subMeshes.size(); i++)
+            mesh->setIndices( data.subMeshes[i].indices, i, data.subMeshes[i].topology, data.subMeshes[i].baseVertex );
+
+        return mesh;
+    }
+
+    //----------------------------------------------------------------------
+    MeshPtr MeshCache::Load( const OS::Path& sourcePath, MeshMaterialInfo* materials,
+                             Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClipPtr>* animations, MeshLODs* lods, F64* importMilliSeconds )
+    {
+        MeshCacheData data;
+        bool success = Read( sourcePath, lods != nullptr, &data );
+        for (auto& warning : data.warnings)
+            LOG_WARN( warning );
+        if ( not success )
+            return nullptr;
+
+        MeshPtr mesh = CreateMesh( data.mesh );
+
+        if (materials && data.materials.isValid())
+            *materials = std::move( data.materials );
+        else if (materials)
+            materials->materialIndices = std::move( data.materials.materialIndices );
+        if (skeleton)
+            *skeleton = std::move( data.skeleton );
+        if (animations)
+            animations->insert( animations->end(), data.animations.begin(), data.animations.end() );
+        if (lods)
+        {
+            lods->reductionPerLevel = data.lodReductionPerLevel;
+            lods->meshes.clear();
+            for (auto& lod : data.lods)
+                lods->meshes.push_back( CreateMesh( lod ) );
+        }
+        if (importMilliSeconds)
+            *importMilliSeconds = data.importMilliSeconds;
+
+        return mesh;
+    }
+
+    //----------------------------------------------------------------------
+    void MeshCache::Save( const OS::Path& sourcePath, F64 importMilliSeconds, const MeshPtr& mesh, const MeshMaterialInfo& materials,
+                          const Animation::Skeleton& skeleton, const ArrayList<Animation::AnimationClipPtr>& animations, const MeshLODs& lods )
+    {
+        Common::BinaryWriter writer;
+
+        MeshCacheHeader header;
+        header.magic        = MESH_CACHE_MAGIC;
+        header.version      = MESH_CACHE_VERSION;
+        header.importFlags  = AssimpLoader::GetImportFlags();
+        header.sourceTime   = sourcePath.getLastWrittenFileTime();
+        header.importMilliSeconds = importMilliSeconds;
+        writer.write( header );
+
+        // Vertex streams and submeshes
+        WriteMesh( writer, mesh );
+
+        // Materials. Textures next to the mesh are stored relative to it, so the cache stays valid if the whole folder is moved.
+        String sourceDirectory = sourcePath.getDirectoryPath();
+        writer.writeArray( materials.materialIndices );
+        writer.write( static_cast<U32>( materials.materials.size() ) );
+        for (auto& material : materials.materials)
+        {
+            writer.write( material.diffuseColor );
+            writer.write( static_cast<U32>( material.textures.size() ) );
+            for (auto& texture : material.textures)
+            {
+                const String& path = texture.filePath.toString();
+                bool isRelative = path.compare( 0, sourceDirectory.size(), sourceDirectory ) == 0;
+                writer.write( texture.type );
+                writer.write( isRelative );
+                writer.writeString( isRelative ? path.substr( sourceDirectory.size() ) : path );
+            }
+        }
+
+        // Skeleton
+        writer.write( static_cast<U32>( skeleton.joints.size() ) );
+        for (auto& joint : skeleton.joints)
+        {
+            writer.writeString( joint.name.toString() );
+            writer.write( joint.parentIndex );
+            writer.write( joint.invBindPose );
+        }
+
+        // Animations. The importer only creates compressed clips.
+        ArrayList<const Animation::CompressedAnimationClip*> clips;
+        for (auto& animation : animations)
+        {
+            auto clip = dynamic_cast<const Animation::CompressedAnimationClip*>( animation.get() );
+            if (not clip)
+            {
+                LOG_WARN( "MeshCache: Mesh '" + sourcePath.toString() + "' has an uncompressed animation clip. It will not be cached." );
+                return;
+            }
+            clips.push_back( clip );
+        }
+
+        writer.write( static_cast<U32>( clips.size() ) );
+        for (auto clip : clips)
+            clip->serialize( writer );
+
+        // Levels of detail
+        writer.write( lods.reductionPerLevel );
+        writer.write( static_cast<U32>( lods.meshes.size() ) );
+        for (auto& lod : lods.meshes)
+            WriteMesh( writer, lod );
+
+        try
+        {
+            OS::BinaryFile file( GetCachePath( sourcePath ), OS::EFileMode::WRITE );
+            file.write( writer.getBuffer().data(), writer.size() );
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN( "MeshCache: Could not write cache file for '" + sourcePath.toString() + "'. Reason: " + e.what() );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    OS::Path MeshCache::GetCachePath( const OS::Path& sourcePath )
+    {
+        return OS::Path( sourcePath.toString() + MESH_CACHE_EXTENSION );
+    }
+
+} // End namespaces
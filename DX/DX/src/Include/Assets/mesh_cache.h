@@ -0,0 +1,126 @@
+#pragma once
+/**********************************************************************
+    class: MeshCache (mesh_cache.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Engine-native binary format of imported meshes. Contains everything
+    the assimp loader produces: vertex streams, submeshes, bounds,
+    skeleton, compressed animation clips and material information.
+    The cache file is stored next to the source file and is keyed by
+    the time the source was last written, the import flags and the
+    format version. Simplified levels of detail generated at import
+    are stored after the source mesh. Reading maps the file into memory and copies the
+    streams without any parsing. It touches only the cpu and can run on any thread,
+    the meshes are created from the result on the owning thread.
+    The file also stores how long the import took, so the asset manager
+    can log the import and the cached load time side by side. No load
+    times were measured when the cache was introduced, those log lines
+    are the way to compare both paths on a given machine.
+**********************************************************************/
+
+#include "Graphics/i_mesh.h"
+#include "OS/FileSystem/path.h"
+#include "mesh_material_info.hpp"
+#include "Animation/skeleton.h"
+#include "Animation/animation_clip.h"
+
+namespace Assets {
+
+    //----------------------------------------------------------------------
+    struct MeshLODs
+    {
+        F32                 reductionPerLevel = 0.0f;   // Triangle ratio of each level relative to the previous one
+        ArrayList<MeshPtr>  meshes;                     // Simplified levels, without the source mesh itself
+    };
+
+    //----------------------------------------------------------------------
+    // Vertex streams, bounds and submeshes of a mesh, which has not been created yet.
+    //----------------------------------------------------------------------
+    struct MeshData
+    {
+        struct SubMesh
+        {
+            Graphics::MeshTopology  topology;
+            U32                     baseVertex;
+            ArrayList<U32>          indices;
+        };
+
+        ArrayList<Math::Vec3>       positions;
+        ArrayList<Math::Vec4>       colors;
+        ArrayList<Math::Vec2>       uvs;
+        ArrayList<Math::Vec3>       normals;
+        ArrayList<Math::Vec4>       tangents;
+        ArrayList<Math::Vec4Int>    boneIDs;
+        ArrayList<Math::Vec4>       boneWeights;
+        Math::AABB                  bounds;
+        ArrayList<SubMesh>          subMeshes;
+    };
+
+    //----------------------------------------------------------------------
+    // Content of a cache file, see MeshCache::Read().
+    //----------------------------------------------------------------------
+    struct MeshCacheData
+    {
+        MeshData                                mesh;
+        MeshMaterialInfo                        materials;
+        Animation::Skeleton                     skeleton;
+        ArrayList<Animation::AnimationClipPtr>  animations;
+        F32                                     lodReductionPerLevel = 0.0f;
+        ArrayList<MeshData>                     lods;
+        F64                                     importMilliSeconds = 0.0;
+        ArrayList<String>                       warnings;       // Problems while reading, to be logged by the owning thread
+    };
+
+    //*********************************************************************
+    class MeshCache
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Reads the cached version of the given source file without creating anything. Thread-safe, nothing is logged.
+        // @Params:
+        //  "readLODs": Whether the stored levels of detail are read as well.
+        //  "data": Receives the content of the cache file.
+        // @Return:
+        //  False if no cache file exists or it is outdated. The reason is in "data->warnings" if it is worth logging.
+        //----------------------------------------------------------------------
+        static bool Read(const OS::Path& sourcePath, bool readLODs, MeshCacheData* data);
+
+        //----------------------------------------------------------------------
+        // Creates a mesh from data returned by Read(). Must be called from the thread owning the renderer.
+        //----------------------------------------------------------------------
+        static MeshPtr CreateMesh(const MeshData& data);
+
+        //----------------------------------------------------------------------
+        // Loads the cached version of the given source file (Read() followed by CreateMesh()).
+        // @Params:
+        //  "lods": If not null, receives the stored levels of detail (possibly none).
+        //  "importMilliSeconds": If not null, receives how long importing the source file took.
+        // @Return:
+        //  Nullptr if no cache file exists or it is outdated.
+        //----------------------------------------------------------------------
+        static MeshPtr Load(const OS::Path& sourcePath, MeshMaterialInfo* materials, Animation::Skeleton* skeleton,
+                            ArrayList<Animation::AnimationClipPtr>* animations, MeshLODs* lods = nullptr, F64* importMilliSeconds = nullptr);
+
+        //----------------------------------------------------------------------
+        // Writes the cache file for the given source file. Failures are only logged,
+        // because the mesh can always be imported again.
+        // @Params:
+        //  "importMilliSeconds": How long importing the source file took.
+        //----------------------------------------------------------------------
+        static void Save(const OS::Path& sourcePath, F64 importMilliSeconds, const MeshPtr& mesh, const MeshMaterialInfo& materials,
+                         const Animation::Skeleton& skeleton, const ArrayList<Animation::AnimationClipPtr>& animations,
+                         const MeshLODs& lods = MeshLODs());
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Path of the cache file for the given source file.
+        //----------------------------------------------------------------------
+        static OS::Path GetCachePath(const OS::Path& sourcePath);
+
+        MeshCache() = delete;
+        NULL_COPY_AND_ASSIGN(MeshCache)
+    };
+
+} // End namespaces
@@ -10,6 +10,8 @@
 
 namespace Assets {
 
+    class MeshCache;
+
     //----------------------------------------------------------------------
     enum class MaterialTextureType
     {
@@ -58,6 +60,8 @@ namespace Assets {
         void            _AddMaterialIndex(U32 index) { materialIndices.push_back(index); }
 
     private:
+        friend class MeshCache;
+
         ArrayList<U32> materialIndices; // Index of the array: Submesh, Value: Material (the index into the materials array)
         ArrayList<MaterialInfo> materials;
     };
@@ -0,0 +1,350 @@
+#include "mesh_optimizer.h"
+/**********************************************************************
+    class: MeshOptimizer (mesh_optimizer.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+namespace Assets {
+
+    // Parameters of the vertex scoring from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+    static const U32 FORSYTH_CACHE_SIZE     = 32;
+    static const F32 CACHE_DECAY_POWER      = 1.5f;
+    static const F32 LAST_TRIANGLE_SCORE    = 0.75f;
+    static const F32 VALENCE_BOOST_SCALE    = 2.0f;
+    static const F32 VALENCE_BOOST_POWER    = 0.5f;
+
+    // Size of the FIFO cache used to find cluster boundaries for the overdraw optimization
+    static const U32 OVERDRAW_CACHE_SIZE    = 16;
+
+    //----------------------------------------------------------------------
+    static F32 VertexScore( I32 cachePosition, U32 remainingTriangles )
+    {
+        // Vertices without triangles left never have to be picked again
+        if (remainingTriangles == 0)
+            return -1.0f;
+
+        F32 score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // Vertices of the last triangle get a fixed score, so it does not matter in which order they were added
+            if (cachePosition < 3)
+                score = LAST_TRIANGLE_SCORE;
+            else
+                score = std::pow( 1.0f - (cachePosition - 3) / static_cast<F32>( FORSYTH_CACHE_SIZE - 3 ), CACHE_DECAY_POWER );
+        }
+
+        // Prefer vertices with few triangles left, so lone triangles are not left behind
+        score += VALENCE_BOOST_SCALE * std::pow( static_cast<F32>( remainingTriangles ), -VALENCE_BOOST_POWER );
+        return score;
+    }
+
+    //----------------------------------------------------------------------
+    // Simulates a FIFO cache with timestamps. A vertex is still in the cache if less than "cacheSize" vertices were added after it.
+    //----------------------------------------------------------------------
+    class FIFOCache
+    {
+    public:
+        FIFOCache( U32 numVertices, U32 cacheSize ) : m_timestamps( numVertices, 0 ), m_cacheSize( cacheSize ), m_time( cacheSize + 1 ) {}
+
+        //----------------------------------------------------------------------
+        // @Return: Whether the vertex had to be added to the cache.
+        //----------------------------------------------------------------------
+        bool add( U32 vertex )
+        {
+            if (m_time - m_timestamps[vertex] <= m_cacheSize)
+                return false;
+
+            m_timestamps[vertex] = m_time++;
+            return true;
+        }
+
+    private:
+        ArrayList<U32>  m_timestamps;
+        U32             m_cacheSize;
+        U32             m_time;
+    };
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void MeshOptimizer::OptimizeVertexCache( ArrayList<U32>& indices, U32 numVertices )
+    {
+        U32 numTriangles = static_cast<U32>( indices.size() / 3 );
+        if (numTriangles == 0)
+            return;
+
+        // Triangles adjacent to every vertex. The first "remainingTriangles" entries of a vertex are the ones not emitted yet.
+        ArrayList<U32> remainingTriangles( numVertices, 0 );
+        for (auto index : indices)
+            remainingTriangles[index]++;
+
+        ArrayList<U32> adjacencyOffsets( numVertices );
+        U32 offset = 0;
+        for (U32 v = 0; v < numVertices; v++)
+        {
+            adjacencyOffsets[v] = offset;
+            offset += remainingTriangles[v];
+        }
+
+        ArrayList<U32> adjacentTriangles( indices.size() );
+        std::fill( remainingTriangles.begin(), remainingTriangles.end(), 0 );
+        for (U32 t = 0; t < numTriangles; t++)
+            for (U32 k = 0; k < 3; k++)
+            {
+                U32 v = indices[t * 3 + k];
+                adjacentTriangles[adjacencyOffsets[v] + remainingTriangles[v]++] = t;
+            }
+
+        ArrayList<I32> cachePositions( numVertices, -1 );
+        ArrayList<F32> vertexScores( numVertices );
+        for (U32 v = 0; v < numVertices; v++)
+            vertexScores[v] = VertexScore( -1, remainingTriangles[v] );
+
+        ArrayList<F32>  triangleScores( numTriangles );
+        ArrayList<bool> emitted( numTriangles, false );
+        for (U32 t = 0; t < numTriangles; t++)
+            triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+
+        // Most of the time the next triangle is adjacent to a cached vertex. If not, the first one not emitted yet is used.
+        U32 cache[FORSYTH_CACHE_SIZE + 3];
+        U32 cacheSize = 0;
+        U32 inputCursor = 0;
+        I32 bestTriangle = static_cast<I32>( std::max_element( triangleScores.begin(), triangleScores.end() ) - triangleScores.begin() );
+
+        ArrayList<U32> output;
+        output.reserve( indices.size() );
+        for (U32 n = 0; n < numTriangles; n++)
+        {
+            if (bestTriangle < 0)
+            {
+                while ( emitted[inputCursor] )
+                    inputCursor++;
+                bestTriangle = inputCursor;
+            }
+
+            // Emit triangle and remove it from the adjacency of its vertices
+            const U32* triangle = &indices[bestTriangle * 3];
+            emitted[bestTriangle] = true;
+            for (U32 k = 0; k < 3; k++)
+            {
+                U32 v = triangle[k];
+                output.push_back( v );
+
+                U32* adjacency = &adjacentTriangles[adjacencyOffsets[v]];
+                U32& remaining = remainingTriangles[v];
+                for (U32 i = 0; i < remaining; i++)
+                {
+                    if (adjacency[i] == static_cast<U32>( bestTriangle ))
+                    {
+                        std::swap( adjacency[i], adjacency[remaining - 1] );
+                        remaining--;
+                        break;
+                    }
+                }
+            }
+
+            // Move the vertices of the triangle to the front of the cache. Vertices beyond the cache size drop out.
+            U32 newCache[FORSYTH_CACHE_SIZE + 3];
+            U32 newCacheSize = 0;
+            for (U32 k = 0; k < 3; k++)
+                if ( std::find( newCache, newCache + newCacheSize, triangle[k] ) == newCache + newCacheSize )
+                    newCache[newCacheSize++] = triangle[k];
+            for (U32 i = 0; i < cacheSize; i++)
+                if ( std::find( newCache, newCache + newCacheSize, cache[i] ) == newCache + newCacheSize )
+                    newCache[newCacheSize++] = cache[i];
+
+            // Update scores of all vertices whose cache position changed and propagate the change to their triangles
+            for (U32 i = 0; i < newCacheSize; i++)
+            {
+                U32 v = newCache[i];
+                cachePositions[v] = i < FORSYTH_CACHE_SIZE ? static_cast<I32>( i ) : -1;
+
+                F32 score = VertexScore( cachePositions[v], remainingTriangles[v] );
+                F32 delta = score - vertexScores[v];
+                vertexScores[v] = score;
+
+                const U32* adjacency = &adjacentTriangles[adjacencyOffsets[v]];
+                for (U32 j = 0; j < remainingTriangles[v]; j++)
+                    triangleScores[adjacency[j]] += delta;
+            }
+
+            cacheSize = std::min( newCacheSize, FORSYTH_CACHE_SIZE );
+            std::copy( newCache, newCache + cacheSize, cache );
+
+            // Next triangle is the best one which uses a cached vertex
+            bestTriangle = -1;
+            F32 bestScore = -1.0f;
+            for (U32 i = 0; i < cacheSize; i++)
+            {
+                U32 v = cache[i];
+                const U32* adjacency = &adjacentTriangles[adjacencyOffsets[v]];
+                for (U32 j = 0; j < remainingTriangles[v]; j++)
+                {
+                    if (triangleScores[adjacency[j]] > bestScore)
+                    {
+                        bestScore = triangleScores[adjacency[j]];
+                        bestTriangle = static_cast<I32>( adjacency[j] );
+                    }
+                }
+            }
+        }
+
+        indices.swap( output );
+    }
+
+    //----------------------------------------------------------------------
+    void MeshOptimizer::OptimizeOverdraw( ArrayList<U32>& indices, const Math::Vec3* positions, U32 numVertices, F32 threshold )
+    {
+        U32 numTriangles = static_cast<U32>( indices.size() / 3 );
+        if (numTriangles < 2)
+            return;
+
+        // Cache misses of every triangle in the current order
+        FIFOCache fifo( numVertices, OVERDRAW_CACHE_SIZE );
+        ArrayList<U32> misses( numTriangles );
+        U32 totalMisses = 0;
+        for (U32 t = 0; t < numTriangles; t++)
+        {
+            misses[t] = fifo.add( indices[t * 3] ) + fifo.add( indices[t * 3 + 1] ) + fifo.add( indices[t * 3 + 2] );
+            totalMisses += misses[t];
+        }
+        F32 acmr = static_cast<F32>( totalMisses ) / numTriangles;
+
+        // Split into clusters. A triangle which misses all vertices starts a new cluster anyway. Other splits are only
+        // made if the cluster, drawn with a cold cache, would still have an ACMR below the threshold.
+        ArrayList<U32> clusterStarts{ 0 };
+        U32 clusterMisses = misses[0];
+        for (U32 t = 1; t < numTriangles; t++)
+        {
+            U32 start = clusterStarts.back();
+            U32 coldMisses = clusterMisses + (3 - misses[start]);
+            bool hardBoundary = misses[t] == 3;
+            bool softBoundary = misses[t] >= 2 && coldMisses <= threshold * acmr * (t - start);
+            if (hardBoundary || softBoundary)
+            {
+                clusterStarts.push_back( t );
+                clusterMisses = 0;
+            }
+            clusterMisses += misses[t];
+        }
+        clusterStarts.push_back( numTriangles );
+
+        U32 numClusters = static_cast<U32>( clusterStarts.size() - 1 );
+        if (numClusters < 2)
+            return;
+
+        // Area weighted centroid + normal of every cluster
+        struct Cluster
+        {
+            U32                 first;
+            U32                 last;
+            DirectX::XMVECTOR   centroid;
+            DirectX::XMVECTOR   normal;
+            F32                 area;
+            F32                 sortKey;
+        };
+        ArrayList<Cluster> clusters( numClusters );
+
+        DirectX::XMVECTOR meshCentroid = DirectX::XMVectorZero();
+        F32 meshArea = 0.0f;
+        for (U32 c = 0; c < numClusters; c++)
+        {
+            auto& cluster = clusters[c];
+            cluster.first       = clusterStarts[c];
+            cluster.last        = clusterStarts[c + 1];
+            cluster.centroid    = DirectX::XMVectorZero();
+            cluster.normal      = DirectX::XMVectorZero();
+            cluster.area        = 0.0f;
+
+            for (U32 t = cluster.first; t < cluster.last; t++)
+            {
+                auto p0 = DirectX::XMLoadFloat3( &positions[indices[t * 3]] );
+                auto p1 = DirectX::XMLoadFloat3( &positions[indices[t * 3 + 1]] );
+                auto p2 = DirectX::XMLoadFloat3( &positions[indices[t * 3 + 2]] );
+
+                auto normal = DirectX::XMVector3Cross( DirectX::XMVectorSubtract( p1, p0 ), DirectX::XMVectorSubtract( p2, p0 ) );
+                F32 area = DirectX::XMVectorGetX( DirectX::XMVector3Length( normal ) ) * 0.5f;
+                auto center = DirectX::XMVectorScale( DirectX::XMVectorAdd( DirectX::XMVectorAdd( p0, p1 ), p2 ), 1.0f / 3.0f );
+
+                cluster.centroid = DirectX::XMVectorAdd( cluster.centroid, DirectX::XMVectorScale( center, area ) );
+                cluster.normal   = DirectX::XMVectorAdd( cluster.normal, normal );
+                cluster.area    += area;
+            }
+
+            meshCentroid = DirectX::XMVectorAdd( meshCentroid, cluster.centroid );
+            meshArea += cluster.area;
+
+            if (cluster.area > 0.0f)
+                cluster.centroid = DirectX::XMVectorScale( cluster.centroid, 1.0f / cluster.area );
+        }
+        if (meshArea <= 0.0f)
+            return;
+        meshCentroid = DirectX::XMVectorScale( meshCentroid, 1.0f / meshArea );
+
+        // Clusters facing away from the center are most likely in front of the others, so they are drawn first
+        for (auto& cluster : clusters)
+        {
+            auto toCluster = DirectX::XMVectorSubtract( cluster.centroid, meshCentroid );
+            cluster.sortKey = DirectX::XMVectorGetX( DirectX::XMVector3Dot( toCluster, DirectX::XMVector3Normalize( cluster.normal ) ) );
+        }
+        std::stable_sort( clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; } );
+
+        ArrayList<U32> output;
+        output.reserve( indices.size() );
+        for (auto& cluster : clusters)
+            output.insert( output.end(), indices.begin() + cluster.first * 3, indices.begin() + cluster.last * 3 );
+        indices.swap( output );
+    }
+
+    //----------------------------------------------------------------------
+    ArrayList<U32> MeshOptimizer::OptimizeVertexFetch( ArrayList<U32>& indices, U32 numVertices )
+    {
+        static const U32 UNUSED = std::numeric_limits<U32>::max();
+
+        ArrayList<U32> remap( numVertices, UNUSED );
+        U32 nextVertex = 0;
+        for (auto& index : indices)
+        {
+            if (remap[index] == UNUSED)
+                remap[index] = nextVertex++;
+            index = remap[index];
+        }
+
+        for (auto& newIndex : remap)
+            if (newIndex == UNUSED)
+                newIndex = nextVertex++;
+
+        return remap;
+    }
+
+    //----------------------------------------------------------------------
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache( const ArrayList<U32>& indices, U32 numVertices, U32 cacheSize )
+    {
+        VertexCacheStats stats;
+        if (indices.empty())
+            return stats;
+
+        FIFOCache fifo( numVertices, cacheSize );
+        ArrayList<bool> referenced( numVertices, false );
+        U32 numReferenced = 0;
+        U32 numMisses = 0;
+        for (auto index : indices)
+        {
+            numMisses += fifo.add( index );
+            if (not referenced[index])
+            {
+                referenced[index] = true;
+                numReferenced++;
+            }
+        }
+
+        stats.acmr = static_cast<F32>( numMisses ) / (indices.size() / 3);
+        stats.atvr = static_cast<F32>( numMisses ) / numReferenced;
+        return stats;
+    }
+
+} // End namespaces
@@ -0,0 +1,74 @@
+#pragma once
+/**********************************************************************
+    class: MeshOptimizer (mesh_optimizer.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Reorders triangle lists of imported meshes for faster rendering:
+    - Triangles are reordered to maximize hits in the post transform
+      vertex cache (Forsyth's linear-speed algorithm)
+    - Clusters of triangles which don't share cached vertices are
+      sorted, so triangles facing outwards are drawn first (less overdraw)
+    - Vertices are reordered in the order they are first referenced,
+      so vertex fetches access memory linearly
+    All functions work on the indices of a single submesh.
+**********************************************************************/
+
+namespace Assets {
+
+    //----------------------------------------------------------------------
+    struct VertexCacheStats
+    {
+        F32 acmr = 0.0f;    // Average cache miss ratio: Transformed vertices per triangle. Optimum is ~0.5
+        F32 atvr = 0.0f;    // Average transform to vertex ratio: Transformed vertices per vertex. Optimum is 1.0
+    };
+
+    //*********************************************************************
+    class MeshOptimizer
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Reorders the triangles to reduce the amount of vertices which have to be transformed.
+        //----------------------------------------------------------------------
+        static void OptimizeVertexCache(ArrayList<U32>& indices, U32 numVertices);
+
+        //----------------------------------------------------------------------
+        // Reorders clusters of triangles of a vertex cache optimized index list to reduce overdraw.
+        // @Params:
+        //  "threshold": Clusters are split as long as the ACMR stays below the ACMR of the input times this value.
+        //----------------------------------------------------------------------
+        static void OptimizeOverdraw(ArrayList<U32>& indices, const Math::Vec3* positions, U32 numVertices, F32 threshold = 1.05f);
+
+        //----------------------------------------------------------------------
+        // Renumbers the vertices in the order they are referenced by the indices.
+        // Apply the returned remap to every vertex attribute with RemapVertices().
+        // @Return:
+        //  New index of every vertex. Unreferenced vertices are moved to the end.
+        //----------------------------------------------------------------------
+        static ArrayList<U32> OptimizeVertexFetch(ArrayList<U32>& indices, U32 numVertices);
+
+        //----------------------------------------------------------------------
+        // Reorders the given vertex attribute with a remap produced by OptimizeVertexFetch().
+        // @Params:
+        //  "baseVertex": First vertex of the submesh the remap belongs to.
+        //----------------------------------------------------------------------
+        template <typename T>
+        static void RemapVertices(ArrayList<T>& vertices, const ArrayList<U32>& remap, U32 baseVertex = 0)
+        {
+            ArrayList<T> remapped( remap.size() );
+            for (U32 i = 0; i < remap.size(); i++)
+                remapped[remap[i]] = vertices[baseVertex + i];
+            std::copy( remapped.begin(), remapped.end(), vertices.begin() + baseVertex );
+        }
+
+        //----------------------------------------------------------------------
+        // Simulates a FIFO post transform cache of the given size.
+        //----------------------------------------------------------------------
+        static VertexCacheStats AnalyzeVertexCache(const ArrayList<U32>& indices, U32 numVertices, U32 cacheSize = 16);
+
+        MeshOptimizer() = delete;
+        NULL_COPY_AND_ASSIGN(MeshOptimizer)
+    };
+
+} // End namespaces
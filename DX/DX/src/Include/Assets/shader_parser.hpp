@@ -9,7 +9,9 @@
 #include "Graphics/i_shader.h"
 #include "OS/FileSystem/file.h"
 #include "Common/string_utils.h"
+#include "Core/locator.h"
 #include <sstream>
+#include <exception>
 
 #define SHADER_NAME                     "#shader"
 #define VERTEX_SHADER                   "vertex"
@@ -87,7 +89,25 @@ namespace Assets {
             if (shaderSources[ShaderMapping::Vertex].empty())
                 throw std::runtime_error( "Vertex shader source is empty. Forgot to add #d3d11 or #vulkan?" );
 
-            // Compile each shader
+            // Compile all stages into the shader cache in parallel first. Creating them below only reads the
+            // bytecode, so the shader is left untouched if any stage fails to compile.
+            std::array<std::exception_ptr, NUM_SHADER_TYPES> errors;
+            Locator::getThreadManager().parallelFor( NUM_SHADER_TYPES - 1, [&](U32 index) {
+                I32 i = index + 1;
+                if ( shaderSources[i].empty() )
+                    return;
+
+                try {
+                    RENDERER.precompileShader( _GetShaderType( (ShaderMapping)i ), shaderSources[i], "main" );
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            } );
+            for (auto& error : errors)
+                if (error)
+                    std::rethrow_exception( error );
+
+            // Create each shader
             for (I32 i = 1; i < shaderSources.size(); i++)
             {
                 if ( not shaderSources[i].empty() )
@@ -112,7 +132,36 @@ namespace Assets {
             shader->createPipeline();
         }
 
+        //----------------------------------------------------------------------
+        // Compiles all stages in the given file into the shader cache without creating a shader.
+        // Used to prewarm the cache on worker threads, see AssetManager::init().
+        // @Throws:
+        //  std::runtime_error if something went wrong.
+        //----------------------------------------------------------------------
+        static void PrecompileShader( const OS::Path& filePath )
+        {
+            if ( filePath.getExtension() != "shader" )
+                throw std::runtime_error( "File has wrong extension. Must be '.shader'." );
+
+            std::array<String, NUM_SHADER_TYPES> shaderSources = _SplitShaderFile( filePath );
+            for (I32 i = 1; i < shaderSources.size(); i++)
+                if ( not shaderSources[i].empty() )
+                    RENDERER.precompileShader( _GetShaderType( (ShaderMapping)i ), shaderSources[i], "main" );
+        }
+
     private:
+        static Graphics::ShaderType _GetShaderType(ShaderMapping mapping)
+        {
+            switch (mapping)
+            {
+            case ShaderMapping::Vertex:     return Graphics::ShaderType::Vertex;
+            case ShaderMapping::Fragment:   return Graphics::ShaderType::Fragment;
+            case ShaderMapping::Geometry:   return Graphics::ShaderType::Geometry;
+            }
+            return Graphics::ShaderType::Unknown;
+        }
+
+        //----------------------------------------------------------------------
         static Graphics::Blend _ReadBlend(const String& blend)
         {
             if (blend == "one")                     return Graphics::Blend::One;
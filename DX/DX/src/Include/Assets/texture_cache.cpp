@@ -0,0 +1,315 @@
+#include "texture_cache.h"
+/**********************************************************************
+    class: TextureCache (texture_cache.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "texture_compressor.h"
+#include "Graphics/Utils/mip_generator.h"
+#include "Ext/StbImage/stb_image.h"
+#include "Common/DataStructures/binary_stream.hpp"
+#include "OS/FileSystem/file.h"
+#include "OS/FileSystem/mapped_file.h"
+
+namespace Assets {
+
+    // Increase the version whenever the layout below or the output of the compressor changes
+    static constexpr U32 TEXTURE_CACHE_MAGIC    = 0x43584554; // "TEXC"
+    static constexpr U32 TEXTURE_CACHE_VERSION  = 2;
+    static const char*   TEXTURE_CACHE_EXTENSION = ".texcache";
+
+    // Alpha test threshold of the engine shaders (ALPHA_THRESHOLD)
+    static constexpr F32 ALPHA_TEST_THRESHOLD = 0.1f;
+
+    //----------------------------------------------------------------------
+    struct TextureCacheHeader
+    {
+        U32                     magic;
+        U32                     version;
+        U64                     sourceHash;
+        TextureUsage            usage;
+        Graphics::TextureFormat format;
+        U32                     width;
+        U32                     height;
+        U32                     mipCount;
+    };
+
+    //----------------------------------------------------------------------
+    // FNV-1a over the content of the source file
+    //----------------------------------------------------------------------
+    static U64 HashContent( const Byte* data, Size size )
+    {
+        U64 hash = 0xcbf29ce484222325ull;
+        for (Size i = 0; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    //----------------------------------------------------------------------
+    static Graphics::TextureFormat ChooseFormat( TextureUsage usage, const ArrayList<Byte>& pixels )
+    {
+        switch (usage)
+        {
+        case TextureUsage::HighQuality: return Graphics::TextureFormat::BC7;
+        case TextureUsage::Normal:      return Graphics::TextureFormat::BC5;
+        case TextureUsage::Mask:        return Graphics::TextureFormat::BC4;
+        case TextureUsage::Albedo:
+            for (Size i = 3; i < pixels.size(); i += 4)
+                if (pixels[i] != 255)
+                    return Graphics::TextureFormat::BC3;
+            return Graphics::TextureFormat::BC1;
+        }
+        ASSERT( false && "Usage has no compressed format" );
+        return Graphics::TextureFormat::BC7;
+    }
+
+    //----------------------------------------------------------------------
+    // Filtering of the mipchain for the given usage
+    //----------------------------------------------------------------------
+    static Graphics::MipSettings ChooseMipSettings( TextureUsage usage, Graphics::TextureFormat format )
+    {
+        Graphics::MipSettings settings;
+        settings.filter     = Graphics::MipFilter::Kaiser;
+        settings.sRGB       = (usage == TextureUsage::Albedo || usage == TextureUsage::HighQuality);
+        settings.normalMap  = (usage == TextureUsage::Normal);
+
+        // Textures with alpha might be alpha tested, so they should not fade out in the distance
+        if (format == Graphics::TextureFormat::BC3 || format == Graphics::TextureFormat::BC7)
+            settings.alphaCutoff = ALPHA_TEST_THRESHOLD;
+
+        return settings;
+    }
+
+    //----------------------------------------------------------------------
+    // Reads the mips following the header. The pointers point into the memory of the reader.
+    // @Return:
+    //  False if the file is truncated.
+    //----------------------------------------------------------------------
+    static bool ReadMipPointers( Common::BinaryReader& reader, const TextureCacheHeader& header, ArrayList<const void*>* mips )
+    {
+        for (U32 i = 0; i < header.mipCount && reader.isValid(); i++)
+        {
+            U32 size;
+            mips->push_back( reader.readArray<Byte>( &size ) );
+
+            U32 mipWidth  = std::max( 1u, header.width >> i );
+            U32 mipHeight = std::max( 1u, header.height >> i );
+            if ( size != Graphics::ImageSizeFromTextureFormat( header.format, mipWidth, mipHeight ) )
+                break;
+        }
+
+        return reader.isValid() && mips->size() == header.mipCount;
+    }
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Index of the first mip which is at most "maxResidentSize" large (zero if "maxResidentSize" is zero).
+    //  The smallest mip is always resident.
+    //----------------------------------------------------------------------
+    static U32 FirstResidentMip( const TextureCacheHeader& header, U32 maxResidentSize )
+    {
+        U32 firstMip = 0;
+        if (maxResidentSize > 0)
+            while ( firstMip + 1 < header.mipCount && (std::max( header.width, header.height ) >> firstMip) > maxResidentSize )
+                firstMip++;
+
+        // Sizes which are not a power of two can have mips which are no multiple of 4, so a larger one is kept.
+        // The top mip is always valid, because only such sizes are compressed.
+        while ( firstMip > 0 && not Graphics::CanBeLargestMip( header.format, header.width, header.height, firstMip ) )
+            firstMip--;
+        return firstMip;
+    }
+
+    //----------------------------------------------------------------------
+    static void SetTextureInfo( const TextureCacheHeader& header, U32 firstMip, TextureMips* texture )
+    {
+        texture->width      = header.width;
+        texture->height     = header.height;
+        texture->format     = header.format;
+        texture->firstMip   = firstMip;
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    bool TextureCache::Load( const OS::Path& sourcePath, TextureUsage usage, bool generateMips, U32 maxResidentSize, TextureMips* texture )
+    {
+        OS::Path cachePath = GetCachePath( sourcePath );
+        if ( not sourcePath.exists() || not cachePath.exists() )
+            return false;
+
+        std::unique_ptr<OS::MappedFile> source, file;
+        try
+        {
+            source = std::make_unique<OS::MappedFile>( sourcePath );
+            file = std::make_unique<OS::MappedFile>( cachePath );
+        }
+        catch (const std::runtime_error& e)
+        {
+            texture->warnings.push_back( "TextureCache: Could not map cache file '" + cachePath.toString() + "'. Reason: " + e.what() );
+            return false;
+        }
+        Common::BinaryReader reader( file->data(), file->size() );
+
+        auto header = reader.read<TextureCacheHeader>();
+        if ( header.magic != TEXTURE_CACHE_MAGIC || header.version != TEXTURE_CACHE_VERSION || header.usage != usage
+             || (header.mipCount > 1) != generateMips || header.sourceHash != HashContent( source->data(), source->size() ) )
+            return false;
+
+        ArrayList<const void*> mips;
+        if ( not ReadMipPointers( reader, header, &mips ) )
+        {
+            texture->warnings.push_back( "TextureCache: Cache file '" + cachePath.toString() + "' is truncated and will be ignored." );
+            return false;
+        }
+
+        // Copying touches every page, so the file is read here and not on the thread creating the texture
+        U32 firstMip = FirstResidentMip( header, maxResidentSize );
+        SetTextureInfo( header, firstMip, texture );
+        texture->mips.clear();
+        for (U32 i = firstMip; i < header.mipCount; i++)
+        {
+            auto data = static_cast<const Byte*>( mips[i] );
+            Size size = Graphics::ImageSizeFromTextureFormat( header.format, std::max( 1u, header.width >> i ), std::max( 1u, header.height >> i ) );
+            texture->mips.emplace_back( data, data + size );
+        }
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool TextureCache::Import( const OS::Path& sourcePath, TextureUsage usage, bool generateMips, U32 maxResidentSize, TextureMips* texture )
+    {
+        ASSERT( usage != TextureUsage::Uncompressed );
+
+        // The file is mapped once for both hashing and decoding
+        OS::MappedFile source( sourcePath );
+
+        I32 width, height, bpp;
+        if ( not stbi_info_from_memory( source.data(), static_cast<I32>( source.size() ), &width, &height, &bpp ) )
+            throw std::runtime_error( String( stbi_failure_reason() ) );
+
+        if (width % 4 != 0 || height % 4 != 0)
+        {
+            texture->warnings.push_back( "TextureCache: Size of texture '" + sourcePath.toString() + "' is not a multiple of 4. It can't be compressed." );
+            return false;
+        }
+
+        auto decoded = stbi_load_from_memory( source.data(), static_cast<I32>( source.size() ), &width, &height, &bpp, 4 );
+        if ( not decoded )
+            throw std::runtime_error( String( stbi_failure_reason() ) );
+
+        ArrayList<Byte> pixels( decoded, decoded + width * height * 4 );
+        stbi_image_free( decoded );
+
+        TextureCacheHeader header;
+        header.magic        = TEXTURE_CACHE_MAGIC;
+        header.version      = TEXTURE_CACHE_VERSION;
+        header.sourceHash   = HashContent( source.data(), source.size() );
+        header.usage        = usage;
+        header.format       = ChooseFormat( usage, pixels );
+        header.width        = width;
+        header.height       = height;
+        header.mipCount     = generateMips ? Graphics::MipGenerator::CountMips( width, height ) : 1;
+
+        // Generate the mipchain and compress every mip. Both distribute their rows on the thread pool.
+        auto parallelFor = [](U32 count, const std::function<void(U32)>& func) { Locator::getThreadManager().parallelFor( count, func ); };
+
+        ArrayList<ArrayList<Byte>> uncompressedMips;
+        if (generateMips)
+            uncompressedMips = Graphics::MipGenerator::Generate( pixels.data(), width, height, Graphics::TextureFormat::RGBA32,
+                                                                 ChooseMipSettings( usage, header.format ), parallelFor );
+
+        ArrayList<ArrayList<Byte>> compressedMips( header.mipCount );
+        for (U32 i = 0; i < header.mipCount; i++)
+        {
+            U32 mipWidth  = std::max( 1u, header.width >> i );
+            U32 mipHeight = std::max( 1u, header.height >> i );
+            const Byte* mipPixels = i == 0 ? pixels.data() : uncompressedMips[i - 1].data();
+            compressedMips[i] = TextureCompressor::Compress( mipPixels, mipWidth, mipHeight, header.format );
+        }
+
+        // Write cache file
+        Common::BinaryWriter writer;
+        writer.write( header );
+        for (auto& mip : compressedMips)
+            writer.writeArray( mip );
+
+        try
+        {
+            OS::BinaryFile file( GetCachePath( sourcePath ), OS::EFileMode::WRITE );
+            file.write( writer.getBuffer().data(), writer.size() );
+        }
+        catch (const std::runtime_error& e)
+        {
+            texture->warnings.push_back( "TextureCache: Could not write cache file for '" + sourcePath.toString() + "'. Reason: " + e.what() );
+        }
+
+        U32 firstMip = FirstResidentMip( header, maxResidentSize );
+        SetTextureInfo( header, firstMip, texture );
+        texture->mips.assign( std::make_move_iterator( compressedMips.begin() + firstMip ), std::make_move_iterator( compressedMips.end() ) );
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    Texture2DPtr TextureCache::CreateTexture( const TextureMips& texture )
+    {
+        ArrayList<const void*> mips;
+        for (auto& mip : texture.mips)
+            mips.push_back( mip.data() );
+
+        return RESOURCES.createTexture2D( texture.width, texture.height, texture.format, mips, texture.firstMip );
+    }
+
+    //----------------------------------------------------------------------
+    bool TextureCache::ReadMips( const OS::Path& sourcePath, U32 width, U32 height, Graphics::TextureFormat format,
+                                 U32 firstMip, ArrayList<ArrayList<Byte>>* mips )
+    {
+        std::unique_ptr<OS::MappedFile> file;
+        try
+        {
+            file = std::make_unique<OS::MappedFile>( GetCachePath( sourcePath ) );
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+        Common::BinaryReader reader( file->data(), file->size() );
+
+        auto header = reader.read<TextureCacheHeader>();
+        if ( not reader.isValid() || header.magic != TEXTURE_CACHE_MAGIC || header.version != TEXTURE_CACHE_VERSION
+             || header.width != width || header.height != height || header.format != format || firstMip >= header.mipCount )
+            return false;
+
+        ArrayList<const void*> mipData;
+        if ( not ReadMipPointers( reader, header, &mipData ) )
+            return false;
+
+        // Copying touches every page, so the file is read here and not on the thread uploading the mips
+        mips->clear();
+        for (U32 i = firstMip; i < header.mipCount; i++)
+        {
+            auto data = static_cast<const Byte*>( mipData[i] );
+            Size size = Graphics::ImageSizeFromTextureFormat( format, std::max( 1u, width >> i ), std::max( 1u, height >> i ) );
+            mips->emplace_back( data, data + size );
+        }
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    OS::Path TextureCache::GetCachePath( const OS::Path& sourcePath )
+    {
+        return OS::Path( sourcePath.toString() + TEXTURE_CACHE_EXTENSION );
+    }
+
+} // End namespaces
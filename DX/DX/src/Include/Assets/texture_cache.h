@@ -0,0 +1,120 @@
+#pragma once
+/**********************************************************************
+    class: TextureCache (texture_cache.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Engine-native format of imported textures. Source images are decoded
+    once, a mipchain is generated on the cpu and every mip is block
+    compressed in the format matching the usage of the texture. The
+    cache file is stored next to the source file and is keyed by a hash
+    of the source file content, the usage and the format version.
+    Reading and importing only touch the cpu and can run on any thread,
+    the texture is created from the result on the owning thread.
+    Mips can be read separately, which is used for texture streaming.
+**********************************************************************/
+
+#include "Graphics/i_texture2d.hpp"
+#include "OS/FileSystem/path.h"
+
+namespace Assets {
+
+    //----------------------------------------------------------------------
+    // What a texture is used for. Determines the compression format.
+    //----------------------------------------------------------------------
+    enum class TextureUsage
+    {
+        Albedo,         // BC1, or BC3 if the image has transparent pixels
+        HighQuality,    // BC7, e.g. for albedo textures with smooth gradients
+        Normal,         // BC5, only x + y are stored. Z has to be reconstructed in the shader
+        Mask,           // BC4, only the red channel is stored (e.g. roughness, metallic, ao)
+        Uncompressed    // RGBA32 as in the source file, mips are generated on the gpu
+    };
+
+    //----------------------------------------------------------------------
+    // @Return: Usage of a texture bound to the material property with the given name (e.g. Normal for "normalMap").
+    //----------------------------------------------------------------------
+    inline TextureUsage GetTextureUsage( StringID propertyName )
+    {
+        static const StringID NAME_NORMAL_MAP       = SID( "normalMap" );
+        static const StringID NAME_ROUGHNESS_MAP    = SID( "roughnessMap" );
+        static const StringID NAME_METALLIC_MAP     = SID( "metallicMap" );
+
+        if (propertyName == NAME_NORMAL_MAP)
+            return TextureUsage::Normal;
+        if (propertyName == NAME_ROUGHNESS_MAP || propertyName == NAME_METALLIC_MAP)
+            return TextureUsage::Mask;
+        return TextureUsage::Albedo;
+    }
+
+    //----------------------------------------------------------------------
+    // Compressed mips of a texture, which has not been created yet.
+    //----------------------------------------------------------------------
+    struct TextureMips
+    {
+        U32                         width       = 0;
+        U32                         height      = 0;
+        Graphics::TextureFormat     format      = Graphics::TextureFormat::BC1;
+        U32                         firstMip    = 0;    // Index of the first resident mip, the larger ones are not read
+        ArrayList<ArrayList<Byte>>  mips;               // Resident mips, beginning with the largest one
+        ArrayList<String>           warnings;           // Problems while reading, logged when the texture is created
+    };
+
+    //*********************************************************************
+    class TextureCache
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Reads the cached version of the given source file. Thread-safe, nothing is logged (see TextureMips::warnings).
+        // @Params:
+        //  "maxResidentSize": If not zero, only mips whose width and height are at most this large are read.
+        //                     The larger ones can be streamed in later (see ReadMips()).
+        //  "texture": Receives the resident mips.
+        // @Return:
+        //  False if no cache file exists or it is outdated.
+        //----------------------------------------------------------------------
+        static bool Load(const OS::Path& sourcePath, TextureUsage usage, bool generateMips, U32 maxResidentSize, TextureMips* texture);
+
+        //----------------------------------------------------------------------
+        // Decodes and compresses the given source file and writes the cache file.
+        // Failures writing the cache are only reported as warnings. Thread-safe, nothing is logged.
+        // @Params:
+        //  "maxResidentSize", "texture": Same as in Load().
+        // @Return:
+        //  False if the image can't be block compressed (size not a multiple of 4).
+        // @Throws:
+        //  std::runtime_error if the source file could not be decoded.
+        //----------------------------------------------------------------------
+        static bool Import(const OS::Path& sourcePath, TextureUsage usage, bool generateMips, U32 maxResidentSize, TextureMips* texture);
+
+        //----------------------------------------------------------------------
+        // Creates the texture from the mips returned by Load() or Import(). Must be called from the thread owning the renderer.
+        //----------------------------------------------------------------------
+        static Texture2DPtr CreateTexture(const TextureMips& texture);
+
+        //----------------------------------------------------------------------
+        // Reads mips of a texture loaded before from its cache file. The source file is not
+        // hashed again, so this is cheap enough to be called whenever mips are streamed in.
+        // Thread-safe, so it can be called from a job.
+        // @Params:
+        //  "width", "height", "format": Of the loaded texture. The cache file must still match them.
+        //  "firstMip": Index of the first mip to read. All smaller mips are read as well.
+        //  "mips": Receives the data of each read mip, beginning with the largest one.
+        // @Return:
+        //  False if the cache file is missing, truncated or was replaced by a different texture.
+        //----------------------------------------------------------------------
+        static bool ReadMips(const OS::Path& sourcePath, U32 width, U32 height, Graphics::TextureFormat format,
+                             U32 firstMip, ArrayList<ArrayList<Byte>>* mips);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Path of the cache file for the given source file.
+        //----------------------------------------------------------------------
+        static OS::Path GetCachePath(const OS::Path& sourcePath);
+
+        TextureCache() = delete;
+        NULL_COPY_AND_ASSIGN(TextureCache)
+    };
+
+} // End namespaces
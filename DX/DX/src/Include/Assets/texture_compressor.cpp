@@ -0,0 +1,504 @@
+#include "texture_compressor.h"
+/**********************************************************************
+    class: TextureCompressor (texture_compressor.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+
+namespace Assets {
+
+    // Interpolation weights of BC7 for 4 bit indices (out of 64)
+    static const U32 BC7_WEIGHTS_4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    //----------------------------------------------------------------------
+    // Writes values bit by bit into a zero initialized block, beginning with the least significant bit
+    //----------------------------------------------------------------------
+    struct BitWriter
+    {
+        Byte*   data;
+        U32     pos = 0;
+
+        void write(U32 value, U32 numBits)
+        {
+            for (U32 i = 0; i < numBits; i++, pos++)
+                if ( (value >> i) & 1 )
+                    data[pos >> 3] |= static_cast<Byte>( 1 << (pos & 7) );
+        }
+    };
+
+    //----------------------------------------------------------------------
+    // Computes the mean of the points and the axis along which they vary the most (power iteration on the covariance matrix).
+    //----------------------------------------------------------------------
+    template <U32 N>
+    static void FitPrincipalAxis( const F32 (&points)[16][N], F32 (&mean)[N], F32 (&axis)[N] )
+    {
+        for (U32 c = 0; c < N; c++)
+        {
+            mean[c] = 0.0f;
+            for (U32 i = 0; i < 16; i++)
+                mean[c] += points[i][c];
+            mean[c] /= 16.0f;
+        }
+
+        F32 covariance[N][N] = {};
+        for (U32 i = 0; i < 16; i++)
+            for (U32 a = 0; a < N; a++)
+                for (U32 b = 0; b < N; b++)
+                    covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+
+        for (U32 c = 0; c < N; c++)
+            axis[c] = 1.0f;
+
+        for (U32 iteration = 0; iteration < 8; iteration++)
+        {
+            F32 next[N] = {};
+            for (U32 a = 0; a < N; a++)
+                for (U32 b = 0; b < N; b++)
+                    next[a] += covariance[a][b] * axis[b];
+
+            F32 length = 0.0f;
+            for (U32 c = 0; c < N; c++)
+                length = std::max( length, std::abs( next[c] ) );
+            if (length < 1e-6f)
+                break;
+
+            for (U32 c = 0; c < N; c++)
+                axis[c] = next[c] / length;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // Endpoints at the extremes of the points projected onto their principal axis.
+    //----------------------------------------------------------------------
+    template <U32 N>
+    static void FitEndpoints( const F32 (&points)[16][N], F32 (&e0)[N], F32 (&e1)[N] )
+    {
+        F32 mean[N], axis[N];
+        FitPrincipalAxis( points, mean, axis );
+
+        F32 axisLengthSqr = 0.0f;
+        for (U32 c = 0; c < N; c++)
+            axisLengthSqr += axis[c] * axis[c];
+
+        F32 minT = 0.0f, maxT = 0.0f;
+        if (axisLengthSqr > 1e-6f)
+        {
+            minT = std::numeric_limits<F32>::max();
+            maxT = std::numeric_limits<F32>::lowest();
+            for (U32 i = 0; i < 16; i++)
+            {
+                F32 t = 0.0f;
+                for (U32 c = 0; c < N; c++)
+                    t += (points[i][c] - mean[c]) * axis[c];
+                t /= axisLengthSqr;
+                minT = std::min( minT, t );
+                maxT = std::max( maxT, t );
+            }
+        }
+
+        for (U32 c = 0; c < N; c++)
+        {
+            e0[c] = std::clamp( mean[c] + minT * axis[c], 0.0f, 255.0f );
+            e1[c] = std::clamp( mean[c] + maxT * axis[c], 0.0f, 255.0f );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // Least squares fit of both endpoints for fixed interpolation weights, where weight 0 is e0 and weight 1 is e1.
+    // @Return: False if the weights don't determine the endpoints (e.g. all pixels use the same index).
+    //----------------------------------------------------------------------
+    template <U32 N>
+    static bool RefineEndpoints( const F32 (&points)[16][N], const F32 (&weights)[16], F32 (&e0)[N], F32 (&e1)[N] )
+    {
+        F32 a = 0.0f, b = 0.0f, c = 0.0f;
+        F32 x0[N] = {}, x1[N] = {};
+        for (U32 i = 0; i < 16; i++)
+        {
+            F32 t = weights[i];
+            a += (1.0f - t) * (1.0f - t);
+            b += (1.0f - t) * t;
+            c += t * t;
+            for (U32 ch = 0; ch < N; ch++)
+            {
+                x0[ch] += (1.0f - t) * points[i][ch];
+                x1[ch] += t * points[i][ch];
+            }
+        }
+
+        F32 det = a * c - b * b;
+        if (std::abs( det ) < 1e-6f)
+            return false;
+
+        for (U32 ch = 0; ch < N; ch++)
+        {
+            e0[ch] = std::clamp( (c * x0[ch] - b * x1[ch]) / det, 0.0f, 255.0f );
+            e1[ch] = std::clamp( (a * x1[ch] - b * x0[ch]) / det, 0.0f, 255.0f );
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    // Chooses for every point the closest palette entry.
+    // @Return: The summed squared error.
+    //----------------------------------------------------------------------
+    template <U32 N, U32 P>
+    static F32 SelectIndices( const F32 (&points)[16][N], const F32 (&palette)[P][N], U32 (&indices)[16] )
+    {
+        F32 totalError = 0.0f;
+        for (U32 i = 0; i < 16; i++)
+        {
+            F32 bestError = std::numeric_limits<F32>::max();
+            for (U32 p = 0; p < P; p++)
+            {
+                F32 error = 0.0f;
+                for (U32 c = 0; c < N; c++)
+                {
+                    F32 d = points[i][c] - palette[p][c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    indices[i] = p;
+                }
+            }
+            totalError += bestError;
+        }
+        return totalError;
+    }
+
+    //**********************************************************************
+    // BC1
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    static U16 QuantizeRGB565( const F32 (&color)[3] )
+    {
+        U32 r = static_cast<U32>( std::lround( color[0] * 31.0f / 255.0f ) );
+        U32 g = static_cast<U32>( std::lround( color[1] * 63.0f / 255.0f ) );
+        U32 b = static_cast<U32>( std::lround( color[2] * 31.0f / 255.0f ) );
+        return static_cast<U16>( (r << 11) | (g << 5) | b );
+    }
+
+    //----------------------------------------------------------------------
+    static void ExpandRGB565( U16 color, F32 (&rgb)[3] )
+    {
+        U32 r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+        rgb[0] = static_cast<F32>( (r << 3) | (r >> 2) );
+        rgb[1] = static_cast<F32>( (g << 2) | (g >> 4) );
+        rgb[2] = static_cast<F32>( (b << 3) | (b >> 2) );
+    }
+
+    //----------------------------------------------------------------------
+    struct BC1Result
+    {
+        U16 color0;
+        U16 color1;
+        U32 indices[16];
+        F32 error;
+    };
+
+    //----------------------------------------------------------------------
+    // Quantizes the endpoints and selects the indices in the four color mode (color0 > color1)
+    //----------------------------------------------------------------------
+    static BC1Result EncodeBC1( const F32 (&points)[16][3], const F32 (&e0)[3], const F32 (&e1)[3] )
+    {
+        BC1Result result;
+        result.color0 = QuantizeRGB565( e1 );
+        result.color1 = QuantizeRGB565( e0 );
+        if (result.color0 < result.color1)
+            std::swap( result.color0, result.color1 );
+
+        F32 palette[4][3];
+        ExpandRGB565( result.color0, palette[0] );
+        ExpandRGB565( result.color1, palette[1] );
+        for (U32 c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+            palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+        }
+
+        // Equal endpoints switch the decoder into the three color mode, where only index 0 is safe to use
+        if (result.color0 == result.color1)
+        {
+            result.error = 0.0f;
+            for (U32 i = 0; i < 16; i++)
+            {
+                result.indices[i] = 0;
+                for (U32 c = 0; c < 3; c++)
+                    result.error += (points[i][c] - palette[0][c]) * (points[i][c] - palette[0][c]);
+            }
+            return result;
+        }
+
+        result.error = SelectIndices( points, palette, result.indices );
+        return result;
+    }
+
+    //----------------------------------------------------------------------
+    void TextureCompressor::CompressBlockBC1( const Byte* rgba, Byte* block )
+    {
+        F32 points[16][3];
+        for (U32 i = 0; i < 16; i++)
+            for (U32 c = 0; c < 3; c++)
+                points[i][c] = rgba[i * 4 + c];
+
+        F32 e0[3], e1[3];
+        FitEndpoints( points, e0, e1 );
+        BC1Result best = EncodeBC1( points, e0, e1 );
+
+        // Palette index to interpolation weight towards color1
+        static const F32 INDEX_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        F32 weights[16];
+        for (U32 i = 0; i < 16; i++)
+            weights[i] = INDEX_WEIGHTS[best.indices[i]];
+
+        F32 c0[3], c1[3];
+        if ( RefineEndpoints( points, weights, c0, c1 ) )
+        {
+            BC1Result refined = EncodeBC1( points, c1, c0 );
+            if (refined.error < best.error)
+                best = refined;
+        }
+
+        memset( block, 0, 8 );
+        BitWriter writer{ block };
+        writer.write( best.color0, 16 );
+        writer.write( best.color1, 16 );
+        for (U32 i = 0; i < 16; i++)
+            writer.write( best.indices[i], 2 );
+    }
+
+    //**********************************************************************
+    // BC4
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    // Encodes one channel of the block into 8 bytes. Used by BC3 (alpha), BC4 and BC5.
+    //----------------------------------------------------------------------
+    static void CompressChannel( const Byte* rgba, U32 channel, Byte* block )
+    {
+        F32 points[16][1];
+        Byte minValue = 255, maxValue = 0;
+        for (U32 i = 0; i < 16; i++)
+        {
+            Byte value = rgba[i * 4 + channel];
+            points[i][0] = value;
+            minValue = std::min( minValue, value );
+            maxValue = std::max( maxValue, value );
+        }
+
+        memset( block, 0, 8 );
+        block[0] = maxValue;
+        block[1] = minValue;
+        if (maxValue == minValue)
+            return;
+
+        // Eight value mode: value0 > value1, six interpolated values in between
+        F32 palette[8][1];
+        palette[0][0] = maxValue;
+        palette[1][0] = minValue;
+        for (U32 i = 2; i < 8; i++)
+            palette[i][0] = ((8 - i) * maxValue + (i - 1) * minValue) / 7.0f;
+
+        U32 indices[16];
+        SelectIndices( points, palette, indices );
+
+        BitWriter writer{ block, 16 };
+        for (U32 i = 0; i < 16; i++)
+            writer.write( indices[i], 3 );
+    }
+
+    //----------------------------------------------------------------------
+    void TextureCompressor::CompressBlockBC4( const Byte* rgba, Byte* block )
+    {
+        CompressChannel( rgba, 0, block );
+    }
+
+    //**********************************************************************
+    // BC3 + BC5
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void TextureCompressor::CompressBlockBC3( const Byte* rgba, Byte* block )
+    {
+        CompressChannel( rgba, 3, block );
+        CompressBlockBC1( rgba, block + 8 );
+    }
+
+    //----------------------------------------------------------------------
+    void TextureCompressor::CompressBlockBC5( const Byte* rgba, Byte* block )
+    {
+        CompressChannel( rgba, 0, block );
+        CompressChannel( rgba, 1, block + 8 );
+    }
+
+    //**********************************************************************
+    // BC7
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    struct BC7Result
+    {
+        U32 endpoints[2][4];    // 7 bit per channel
+        U32 pBits[2];
+        U32 indices[16];
+        F32 error;
+    };
+
+    //----------------------------------------------------------------------
+    // Quantizes an endpoint to 7 bits per channel plus a shared lowest bit (the p-bit), whichever p-bit is closer.
+    //----------------------------------------------------------------------
+    static void QuantizeEndpointBC7( const F32 (&endpoint)[4], U32 (&quantized)[4], U32& pBit )
+    {
+        F32 bestError = std::numeric_limits<F32>::max();
+        for (U32 p = 0; p < 2; p++)
+        {
+            U32 candidate[4];
+            F32 error = 0.0f;
+            for (U32 c = 0; c < 4; c++)
+            {
+                candidate[c] = static_cast<U32>( std::clamp( std::lround( (endpoint[c] - p) / 2.0f ), 0l, 127l ) );
+                F32 d = static_cast<F32>( (candidate[c] << 1) | p ) - endpoint[c];
+                error += d * d;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                pBit = p;
+                std::copy( candidate, candidate + 4, quantized );
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    static BC7Result EncodeBC7( const F32 (&points)[16][4], const F32 (&e0)[4], const F32 (&e1)[4] )
+    {
+        BC7Result result;
+        QuantizeEndpointBC7( e0, result.endpoints[0], result.pBits[0] );
+        QuantizeEndpointBC7( e1, result.endpoints[1], result.pBits[1] );
+
+        F32 palette[16][4];
+        for (U32 c = 0; c < 4; c++)
+        {
+            U32 v0 = (result.endpoints[0][c] << 1) | result.pBits[0];
+            U32 v1 = (result.endpoints[1][c] << 1) | result.pBits[1];
+            for (U32 i = 0; i < 16; i++)
+                palette[i][c] = static_cast<F32>( ((64 - BC7_WEIGHTS_4[i]) * v0 + BC7_WEIGHTS_4[i] * v1 + 32) >> 6 );
+        }
+
+        result.error = SelectIndices( points, palette, result.indices );
+        return result;
+    }
+
+    //----------------------------------------------------------------------
+    void TextureCompressor::CompressBlockBC7( const Byte* rgba, Byte* block )
+    {
+        F32 points[16][4];
+        for (U32 i = 0; i < 16; i++)
+            for (U32 c = 0; c < 4; c++)
+                points[i][c] = rgba[i * 4 + c];
+
+        F32 e0[4], e1[4];
+        FitEndpoints( points, e0, e1 );
+        BC7Result best = EncodeBC7( points, e0, e1 );
+
+        F32 weights[16];
+        for (U32 i = 0; i < 16; i++)
+            weights[i] = BC7_WEIGHTS_4[best.indices[i]] / 64.0f;
+
+        if ( RefineEndpoints( points, weights, e0, e1 ) )
+        {
+            BC7Result refined = EncodeBC7( points, e0, e1 );
+            if (refined.error < best.error)
+                best = refined;
+        }
+
+        // The highest bit of the first index is implicitly zero, so the endpoints are swapped if necessary
+        if (best.indices[0] & 8)
+        {
+            std::swap( best.endpoints[0], best.endpoints[1] );
+            std::swap( best.pBits[0], best.pBits[1] );
+            for (U32 i = 0; i < 16; i++)
+                best.indices[i] = 15 - best.indices[i];
+        }
+
+        // Mode 6: 7 mode bits, 8 * 7 bits endpoints (per channel), 2 p-bits, 63 index bits
+        memset( block, 0, 16 );
+        BitWriter writer{ block };
+        writer.write( 1 << 6, 7 );
+        for (U32 c = 0; c < 4; c++)
+        {
+            writer.write( best.endpoints[0][c], 7 );
+            writer.write( best.endpoints[1][c], 7 );
+        }
+        writer.write( best.pBits[0], 1 );
+        writer.write( best.pBits[1], 1 );
+        for (U32 i = 0; i < 16; i++)
+            writer.write( best.indices[i], i == 0 ? 3 : 4 );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ArrayList<Byte> TextureCompressor::Compress( const Byte* pixels, U32 width, U32 height, Graphics::TextureFormat format )
+    {
+        ASSERT( IsSupported( format ) && "Texture format can't be compressed" );
+
+        void (*compressBlock)(const Byte*, Byte*) = nullptr;
+        U32 blockSize = 16;
+        switch (format)
+        {
+        case Graphics::TextureFormat::BC1: compressBlock = CompressBlockBC1; blockSize = 8; break;
+        case Graphics::TextureFormat::BC3: compressBlock = CompressBlockBC3; break;
+        case Graphics::TextureFormat::BC4: compressBlock = CompressBlockBC4; blockSize = 8; break;
+        case Graphics::TextureFormat::BC5: compressBlock = CompressBlockBC5; break;
+        case Graphics::TextureFormat::BC7: compressBlock = CompressBlockBC7; break;
+        }
+
+        U32 numBlocksX = (width + 3) / 4;
+        U32 numBlocksY = (height + 3) / 4;
+        ArrayList<Byte> blocks( numBlocksX * numBlocksY * blockSize );
+
+        // Every job writes only to its own row of blocks
+        Locator::getThreadManager().parallelFor( numBlocksY, [&](U32 by) {
+            Byte rgba[16 * 4];
+            for (U32 bx = 0; bx < numBlocksX; bx++)
+            {
+                for (U32 y = 0; y < 4; y++)
+                {
+                    U32 py = std::min( by * 4 + y, height - 1 );
+                    for (U32 x = 0; x < 4; x++)
+                    {
+                        U32 px = std::min( bx * 4 + x, width - 1 );
+                        memcpy( &rgba[(y * 4 + x) * 4], &pixels[(py * width + px) * 4], 4 );
+                    }
+                }
+                compressBlock( rgba, &blocks[(by * numBlocksX + bx) * blockSize] );
+            }
+        } );
+
+        return blocks;
+    }
+
+    //----------------------------------------------------------------------
+    bool TextureCompressor::IsSupported( Graphics::TextureFormat format )
+    {
+        switch (format)
+        {
+        case Graphics::TextureFormat::BC1:
+        case Graphics::TextureFormat::BC3:
+        case Graphics::TextureFormat::BC4:
+        case Graphics::TextureFormat::BC5:
+        case Graphics::TextureFormat::BC7:
+            return true;
+        }
+        return false;
+    }
+
+} // End namespaces
@@ -0,0 +1,55 @@
+#pragma once
+/**********************************************************************
+    class: TextureCompressor (texture_compressor.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    CPU encoder for block compressed texture formats. Every 4x4 block
+    is fitted along the principal axis of its colors, the endpoints
+    are refined once with a least squares fit and the better of both
+    results is kept. Supported formats:
+     BC1: RGB (alpha is ignored), 4 bits per pixel
+     BC3: RGB + interpolated alpha, 8 bits per pixel
+     BC4: One channel (red), 4 bits per pixel
+     BC5: Two channels (red + green), 8 bits per pixel
+     BC7: RGBA in mode 6 (one subset, 7 bit endpoints), 8 bits per pixel
+**********************************************************************/
+
+#include "Graphics/enums.hpp"
+
+namespace Assets {
+
+    //*********************************************************************
+    class TextureCompressor
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Compresses an RGBA32 image. Rows of blocks are compressed in parallel on the thread pool.
+        // @Params:
+        //  "pixels": Width * height RGBA32 pixels. Sizes which are not a multiple of 4 repeat the last row/column.
+        //  "format": One of the block compressed formats above.
+        // @Return:
+        //  The blocks of the image row by row, as expected by the graphics api.
+        //----------------------------------------------------------------------
+        static ArrayList<Byte> Compress(const Byte* pixels, U32 width, U32 height, Graphics::TextureFormat format);
+
+        //----------------------------------------------------------------------
+        // @Return: Whether the given format can be produced by Compress().
+        //----------------------------------------------------------------------
+        static bool IsSupported(Graphics::TextureFormat format);
+
+        //----------------------------------------------------------------------
+        // Compress a single block of 4x4 RGBA32 pixels.
+        //----------------------------------------------------------------------
+        static void CompressBlockBC1(const Byte* rgba, Byte* block);
+        static void CompressBlockBC3(const Byte* rgba, Byte* block);
+        static void CompressBlockBC4(const Byte* rgba, Byte* block);
+        static void CompressBlockBC5(const Byte* rgba, Byte* block);
+        static void CompressBlockBC7(const Byte* rgba, Byte* block);
+
+        TextureCompressor() = delete;
+        NULL_COPY_AND_ASSIGN(TextureCompressor)
+    };
+
+} // End namespaces
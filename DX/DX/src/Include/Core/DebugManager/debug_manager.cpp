@@ -5,19 +5,46 @@
     author: S. Hau
     date: April 2, 2018
 
-    @Consideration:
-     - Create one mesh for each material and update only mesh data,
-       so everything will be just drawn with one draw-call
+    All debug primitives are appended as lines into a few dynamic
+    meshes, so everything is drawn with at most one draw-call per
+    material and lifetime (per frame or timed).
 **********************************************************************/
 
 #include "Core/locator.h"
 #include "Events/event_dispatcher.h"
 #include "GameplayLayer/i_scene.h"
-#include "Core/mesh_generator.h"
+#include "Math/math_utils.h"
 #include "GameplayLayer/Components/Rendering/camera.h"
 
 namespace Core { namespace Debug {
 
+    // Initial amount of vertices of a batch. Grows by doubling.
+    #define MIN_BATCH_CAPACITY  1024
+
+    // Resolution of the unit sphere
+    #define SPHERE_RINGS        8
+    #define SPHERE_SEGMENTS     16
+
+    // Line list connecting the 8 corners of a box or frustum
+    enum corner {
+        NEAR_TOP_LEFT = 0, NEAR_TOP_RIGHT = 1, NEAR_BOTTOM_LEFT = 2, NEAR_BOTTOM_RIGHT = 3,
+        FAR_TOP_LEFT = 4, FAR_TOP_RIGHT = 5, FAR_BOTTOM_LEFT = 6, FAR_BOTTOM_RIGHT = 7
+    };
+    static const U32 BOX_EDGES[24] = {
+        NEAR_TOP_LEFT, NEAR_TOP_RIGHT,
+        NEAR_BOTTOM_LEFT, NEAR_BOTTOM_RIGHT,
+        NEAR_TOP_LEFT, NEAR_BOTTOM_LEFT,
+        NEAR_TOP_RIGHT, NEAR_BOTTOM_RIGHT,
+        FAR_TOP_LEFT, FAR_TOP_RIGHT,
+        FAR_BOTTOM_LEFT, FAR_BOTTOM_RIGHT,
+        FAR_TOP_LEFT, FAR_BOTTOM_LEFT,
+        FAR_TOP_RIGHT, FAR_BOTTOM_RIGHT,
+        NEAR_TOP_LEFT, FAR_TOP_LEFT,
+        NEAR_TOP_RIGHT, FAR_TOP_RIGHT,
+        NEAR_BOTTOM_LEFT, FAR_BOTTOM_LEFT,
+        NEAR_BOTTOM_RIGHT, FAR_BOTTOM_RIGHT
+    };
+
     //----------------------------------------------------------------------
     void DebugManager::init()
     {
@@ -28,6 +55,9 @@ namespace Core { namespace Debug {
         Events::Event& evt = Events::EventDispatcher::GetEvent( EVENT_SCENE_CHANGED );
         m_sceneSwitchListener = evt.addListener( BIND_THIS_FUNC_0_ARGS( &DebugManager::_OnSceneChanged ) );
 
+        // Upload everything drawn during the tick right before rendering
+        m_frameBeginListener = Events::EventDispatcher::GetEvent( EVENT_FRAME_BEGIN ).addListener( BIND_THIS_FUNC_0_ARGS( &DebugManager::_OnFrameBegin ) );
+
         // Create both shaders with / withot depth-test
         m_colorShaderWireframe = ASSETS.getShader( "/engine/shaders/color_wireframe.shader" );
         if ( m_colorShaderWireframe == ASSETS.getErrorShader() )
@@ -40,36 +70,91 @@ namespace Core { namespace Debug {
         // Create material from both shaders
         m_colorMaterial = RESOURCES.createMaterial( m_colorShaderWireframe );
         m_colorMaterialNoDepthTest = RESOURCES.createMaterial( m_colorShaderWireframeNoDepthTest );
+
+        // Create one dynamic mesh per batch
+        for (auto batches : { m_frameBatches, m_timedBatches })
+        {
+            for (I32 i = 0; i < 2; i++)
+            {
+                batches[i].mesh = RESOURCES.createMesh();
+                batches[i].mesh->setBufferUsage( Graphics::BufferUsage::Frequently );
+            }
+        }
+
+        // Unit sphere as latitude rings and longitude lines
+        auto spherePoint = [](I32 ring, I32 segment) {
+            F32 theta = DirectX::XM_PI * ring / SPHERE_RINGS;
+            F32 phi = DirectX::XM_2PI * segment / SPHERE_SEGMENTS;
+            return Math::Vec3( sinf( theta ) * cosf( phi ), cosf( theta ), sinf( theta ) * sinf( phi ) );
+        };
+        for (I32 ring = 0; ring < SPHERE_RINGS; ring++)
+        {
+            for (I32 segment = 0; segment < SPHERE_SEGMENTS; segment++)
+            {
+                if (ring > 0)
+                {
+                    m_unitSphere.push_back( spherePoint( ring, segment ) );
+                    m_unitSphere.push_back( spherePoint( ring, segment + 1 ) );
+                }
+                m_unitSphere.push_back( spherePoint( ring, segment ) );
+                m_unitSphere.push_back( spherePoint( ring + 1, segment ) );
+            }
+        }
     }
 
     //----------------------------------------------------------------------
     void DebugManager::OnTick( Time::Seconds delta )
     {
-        auto& currentMeshes = m_currentMeshes[&THIS_SCENE];
-        bool erasedMesh = false;
-        for (auto it = currentMeshes.begin(); it != currentMeshes.end();)
+        for (I32 i = 0; i < 2; i++)
         {
-            it->duration -= delta;
-            if (it->duration < 0)
+            // Primitives without a duration were visible for exactly one tick
+            auto& frameBatch = m_frameBatches[i];
+            if ( not frameBatch.positions.empty() )
             {
-                erasedMesh = true;
-                it = currentMeshes.erase( it );
+                frameBatch.positions.clear();
+                frameBatch.colors.clear();
+                frameBatch.dirty = true;
             }
-            else
+
+            // Remove expired primitives and move the vertices of the remaining ones to the front
+            auto& timedBatch = m_timedBatches[i];
+            auto& primitives = m_timedPrimitives[i];
+            U32 numPrimitives = 0;
+            U32 readVertex = 0, writeVertex = 0;
+            for (auto& primitive : primitives)
             {
-                it++;
+                primitive.duration -= delta;
+                if (primitive.duration >= 0)
+                {
+                    if (readVertex != writeVertex)
+                    {
+                        std::copy_n( &timedBatch.positions[readVertex], primitive.numVertices, &timedBatch.positions[writeVertex] );
+                        std::copy_n( &timedBatch.colors[readVertex], primitive.numVertices, &timedBatch.colors[writeVertex] );
+                    }
+                    writeVertex += primitive.numVertices;
+                    primitives[numPrimitives++] = primitive;
+                }
+                readVertex += primitive.numVertices;
             }
-        }
 
-        // If a mesh was removed, update command buffer list
-        if (erasedMesh)
-            _UpdateCommandBuffer();
+            if (numPrimitives != primitives.size())
+            {
+                primitives.resize( numPrimitives );
+                timedBatch.positions.resize( writeVertex );
+                timedBatch.colors.resize( writeVertex );
+                timedBatch.dirty = true;
+            }
+        }
     }
 
     //----------------------------------------------------------------------
     void DebugManager::shutdown()
     {
-        m_currentMeshes.clear();
+        _Clear();
+        m_commandBuffers.clear();
+        for (auto batches : { m_frameBatches, m_timedBatches })
+            for (I32 i = 0; i < 2; i++)
+                batches[i].mesh.reset();
     }
 
     //**********************************************************************
@@ -79,61 +164,31 @@ namespace Core { namespace Debug {
     //----------------------------------------------------------------------
     void DebugManager::drawLine( const Math::Vec3& start, const Math::Vec3& end, Color color, Time::Seconds duration, bool depthTest )
     {
-        auto mesh = RESOURCES.createMesh();
-        mesh->setVertices( { start, end } );
-        mesh->setIndices( { 0, 1 }, 0, Graphics::MeshTopology::Lines );
-        mesh->setColors( { color, color } );
-
-        _AddMesh( mesh, duration, depthTest );
+        auto vertices = _AddLines( 2, color, duration, depthTest );
+        vertices[0] = start;
+        vertices[1] = end;
     }
 
     //----------------------------------------------------------------------
     void DebugManager::drawRay( const Math::Vec3& start, const Math::Vec3& direction, Color color, Time::Seconds duration, bool depthTest )
     {
-        auto mesh = RESOURCES.createMesh();
-        mesh->setVertices( { start, start + direction } );
-        mesh->setIndices( { 0, 1 }, 0, Graphics::MeshTopology::Lines );
-        mesh->setColors( { color, color } );
-
-        _AddMesh( mesh, duration, depthTest );
+        drawLine( start, start + direction, color, duration, depthTest );
     }
 
     //----------------------------------------------------------------------
     void DebugManager::drawCube( const Math::Vec3& min, const Math::Vec3& max, Color color, Time::Seconds duration, bool depthTest )
     {
-        // Line for each edge
-        ArrayList<Math::Vec3> vertices =
-        {
-            min,
-            Math::Vec3( min.x, min.y, max.z ),
-            Math::Vec3( max.x, min.y, min.z ),
-            Math::Vec3( min.x, max.y, min.z ),
-            max,
-            Math::Vec3( max.x, max.y, min.z ),
-            Math::Vec3( min.x, max.y, max.z ),
-            Math::Vec3( max.x, min.y, max.z ),
-        };
-        ArrayList<U32> indices = {
-            0, 1,
-            0, 2,
-            0, 3,
-            4, 5,
-            4, 6,
-            4, 7,
-            1, 6,
-            3, 6,
-            2, 7,
-            2, 5,
-            1, 7,
-            3, 5
-        };
-
-        auto mesh = RESOURCES.createMesh();
-        mesh->setVertices( vertices );
-        mesh->setIndices( indices, 0, Graphics::MeshTopology::Lines );
-        mesh->setColors( ArrayList<Color>( indices.size(), color ) );
-
-        _AddMesh( mesh, duration, depthTest );
+        std::array<Math::Vec3, 8> corners;
+        corners[NEAR_TOP_LEFT]      = Math::Vec3( min.x, max.y, min.z );
+        corners[NEAR_TOP_RIGHT]     = Math::Vec3( max.x, max.y, min.z );
+        corners[NEAR_BOTTOM_LEFT]   = min;
+        corners[NEAR_BOTTOM_RIGHT]  = Math::Vec3( max.x, min.y, min.z );
+        corners[FAR_TOP_LEFT]       = Math::Vec3( min.x, max.y, max.z );
+        corners[FAR_TOP_RIGHT]      = max;
+        corners[FAR_BOTTOM_LEFT]    = Math::Vec3( min.x, min.y, max.z );
+        corners[FAR_BOTTOM_RIGHT]   = Math::Vec3( max.x, min.y, max.z );
+
+        _AddBox( corners, color, duration, depthTest );
     }
 
     //----------------------------------------------------------------------
@@ -145,10 +200,10 @@ namespace Core { namespace Debug {
     //----------------------------------------------------------------------
     void DebugManager::drawSphere( const Math::Vec3& pos, F32 radius, Color color, Time::Seconds duration, bool depthTest )
     {
-        auto mesh = Core::MeshGenerator::CreateUVSphere( pos, radius, 30, 30 );
-        mesh->setColors(  ArrayList<Color>( mesh->getIndexCount( 0 ), color ) );
-
-        _AddMesh( mesh, duration, depthTest );
+        U32 numVertices = static_cast<U32>( m_unitSphere.size() );
+        auto vertices = _AddLines( numVertices, color, duration, depthTest );
+        for (U32 i = 0; i < numVertices; i++)
+            vertices[i] = pos + m_unitSphere[i] * radius;
     }
 
     //----------------------------------------------------------------------
@@ -157,15 +212,27 @@ namespace Core { namespace Debug {
                                     Color color, Time::Seconds duration, bool depthTest )
     {
         auto right = up.cross( forward );
-        auto mesh = Core::MeshGenerator::CreateFrustum( pos, up, right, forward, fovAngleYDeg, zNear, zFar, aspectRatio, color );
-        _AddMesh( mesh, duration, depthTest );
+        _AddBox( Math::CalculateFrustumCorners( pos, up, right, forward, fovAngleYDeg, zNear, zFar, aspectRatio ), color, duration, depthTest );
     }
 
     //----------------------------------------------------------------------
     void DebugManager::drawFrustum( const Math::Vec3& pos, const Math::Vec3& forward, const Math::Vec3& up, F32 left, F32 right, F32 bottom, F32 top, F32 zNear, F32 zFar, Color color, Time::Seconds duration, bool depthTest )
     {
-        auto mesh = Core::MeshGenerator::CreateFrustum( pos, forward, up, left, right, bottom, top, zNear, zFar, color );
-        _AddMesh( mesh, duration, depthTest );
+        auto nearCenter = pos + forward * zNear;
+        auto farCenter = pos + forward * zFar;
+        auto rightVec = up.cross( forward );
+
+        std::array<Math::Vec3, 8> corners;
+        corners[NEAR_TOP_LEFT]     = nearCenter + up * top + rightVec * left;
+        corners[NEAR_TOP_RIGHT]    = nearCenter + up * top + rightVec * right;
+        corners[NEAR_BOTTOM_LEFT]  = nearCenter + up * bottom + rightVec * left;
+        corners[NEAR_BOTTOM_RIGHT] = nearCenter + up * bottom + rightVec * right;
+        corners[FAR_TOP_LEFT]      = farCenter + up * top + rightVec * left;
+        corners[FAR_TOP_RIGHT]     = farCenter + up * top + rightVec * right;
+        corners[FAR_BOTTOM_LEFT]   = farCenter + up * bottom + rightVec * left;
+        corners[FAR_BOTTOM_RIGHT]  = farCenter + up * bottom + rightVec * right;
+
+        _AddBox( corners, color, duration, depthTest );
     }
 
     //----------------------------------------------------------------------
@@ -178,49 +245,21 @@ namespace Core { namespace Debug {
     void DebugManager::drawCross( const Math::Vec3& pos, F32 size, Color color, Time::Seconds duration, bool depthTest )
     {
         F32 halfSize = size * 0.5f;
-        ArrayList<Math::Vec3> vertices = {
-            pos + Math::Vec3( halfSize, 0, 0 ),
-            pos + Math::Vec3( -halfSize, 0, 0 ),
-            pos + Math::Vec3( 0, halfSize, 0),
-            pos + Math::Vec3( 0, -halfSize, 0),
-            pos + Math::Vec3( 0, 0, halfSize ),
-            pos + Math::Vec3( 0, 0, -halfSize)
-        };
-        ArrayList<U32> indices = {
-            0, 1, 2, 3, 4, 5
-        };
-
-        auto mesh = RESOURCES.createMesh();
-        mesh->setVertices( vertices );
-        mesh->setIndices( indices, 0, Graphics::MeshTopology::Lines );
-        mesh->setColors( ArrayList<Color>( indices.size(), color ) );
-
-        _AddMesh( mesh, duration, depthTest );
+        auto vertices = _AddLines( 6, color, duration, depthTest );
+        vertices[0] = pos + Math::Vec3( halfSize, 0, 0 );
+        vertices[1] = pos + Math::Vec3( -halfSize, 0, 0 );
+        vertices[2] = pos + Math::Vec3( 0, halfSize, 0 );
+        vertices[3] = pos + Math::Vec3( 0, -halfSize, 0 );
+        vertices[4] = pos + Math::Vec3( 0, 0, halfSize );
+        vertices[5] = pos + Math::Vec3( 0, 0, -halfSize );
     }
 
     //----------------------------------------------------------------------
     void DebugManager::drawAxes( const Math::Vec3& pos, const Math::Quat& rot, F32 size, Time::Seconds duration, bool depthTest )
     {
-        // Line for each edge
-        ArrayList<Math::Vec3> vertices =
-        {
-            pos, pos + rot.getForward() * size,
-            pos, pos + rot.getRight() * size,
-            pos, pos + rot.getUp() * size,
-        };
-        ArrayList<U32> indices = {
-            0, 1, 2, 3, 4, 5
-        };
-        ArrayList<Color> colors = {
-            Color::BLUE, Color::BLUE, Color::RED, Color::RED, Color::GREEN, Color::GREEN
-        };
-
-        auto mesh = RESOURCES.createMesh();
-        mesh->setVertices( vertices );
-        mesh->setIndices( indices, 0, Graphics::MeshTopology::Lines );
-        mesh->setColors( colors );
-
-        _AddMesh( mesh, duration, depthTest );
+        drawLine( pos, pos + rot.getForward() * size, Color::BLUE, duration, depthTest );
+        drawLine( pos, pos + rot.getRight() * size, Color::RED, duration, depthTest );
+        drawLine( pos, pos + rot.getUp() * size, Color::GREEN, duration, depthTest );
     }
 
     //**********************************************************************
@@ -228,14 +267,92 @@ namespace Core { namespace Debug {
     //**********************************************************************
 
     //----------------------------------------------------------------------
-    void DebugManager::_UpdateCommandBuffer()
+    Math::Vec3* DebugManager::_AddLines( U32 numVertices, Color color, Time::Seconds duration, bool depthTest )
     {
-        // Clear all previous commands
-        m_commandBuffers[&THIS_SCENE].reset();
+        I32 index = depthTest ? 0 : 1;
+        bool isTimed = duration > 0;
+        auto& batch = isTimed ? m_timedBatches[index] : m_frameBatches[index];
+        if (isTimed)
+            m_timedPrimitives[index].push_back({ numVertices, duration });
+
+        U32 firstVertex = static_cast<U32>( batch.positions.size() );
+        batch.positions.resize( firstVertex + numVertices );
+        batch.colors.resize( firstVertex + numVertices, color.normalized() );
+        batch.dirty = true;
+
+        return &batch.positions[firstVertex];
+    }
+
+    //----------------------------------------------------------------------
+    void DebugManager::_AddBox( const std::array<Math::Vec3, 8>& corners, Color color, Time::Seconds duration, bool depthTest )
+    {
+        auto vertices = _AddLines( 24, color, duration, depthTest );
+        for (I32 i = 0; i < 24; i++)
+            vertices[i] = corners[BOX_EDGES[i]];
+    }
+
+    //----------------------------------------------------------------------
+    void DebugManager::_UploadBatch( LineBatch& batch )
+    {
+        if (not batch.dirty)
+            return;
+        batch.dirty = false;
+
+        U32 numVertices = static_cast<U32>( batch.positions.size() );
+        if (numVertices == 0)
+            return;
+
+        // Recreate the vertex buffers only if they are too small
+        auto& mesh = batch.mesh;
+        if (numVertices > batch.capacity)
+        {
+            batch.capacity = std::max( { numVertices, batch.capacity * 2, (U32)MIN_BATCH_CAPACITY } );
+            mesh->createVertexStream<Math::Vec3>( Graphics::SID_VERTEX_POSITION, batch.capacity );
+            mesh->createVertexStream<Math::Vec4>( Graphics::SID_VERTEX_COLOR, batch.capacity );
+        }
+
+        std::copy( batch.positions.begin(), batch.positions.end(), mesh->getPositionStream().map() );
+        std::copy( batch.colors.begin(), batch.colors.end(), mesh->getColorStream().map() );
+
+        // Only the used part of the buffers is drawn
+        U32 numIndices = static_cast<U32>( batch.indices.size() );
+        batch.indices.resize( numVertices );
+        for (U32 i = numIndices; i < numVertices; i++)
+            batch.indices[i] = i;
+        mesh->setIndices( batch.indices, 0, Graphics::MeshTopology::Lines );
+    }
+
+    //----------------------------------------------------------------------
+    void DebugManager::_OnFrameBegin()
+    {
+        auto& cmd = m_commandBuffers[&SCENE];
+        cmd.reset();
 
-        // Record new commands
-        for (auto& meshInfo : m_currentMeshes[&THIS_SCENE])
-            m_commandBuffers[&THIS_SCENE].drawMesh( meshInfo.mesh, meshInfo.depthTest ? m_colorMaterial : m_colorMaterialNoDepthTest, DirectX::XMMatrixIdentity(), 0 );
+        for (I32 i = 0; i < 2; i++)
+        {
+            auto& material = (i == 0) ? m_colorMaterial : m_colorMaterialNoDepthTest;
+            for (auto batch : { &m_timedBatches[i], &m_frameBatches[i] })
+            {
+                _UploadBatch( *batch );
+                if ( not batch->positions.empty() )
+                    cmd.drawMesh( batch->mesh, material, DirectX::XMMatrixIdentity(), 0 );
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void DebugManager::_Clear()
+    {
+        for (I32 i = 0; i < 2; i++)
+        {
+            for (auto batch : { &m_timedBatches[i], &m_frameBatches[i] })
+            {
+                batch->positions.clear();
+                batch->colors.clear();
+                batch->dirty = true;
+            }
+            m_timedPrimitives[i].clear();
+        }
     }
 
     //----------------------------------------------------------------------
@@ -248,21 +365,12 @@ namespace Core { namespace Debug {
                 break;
             }
 
+        // Primitives belong to the scene which has drawn them
+        _Clear();
+
         // Re-Add the command buffer to the new cameras in the scene
         for ( auto& cam : SCENE.getComponentManager().getCameras() )
             cam->addCommandBuffer( &m_commandBuffers[&SCENE], Components::CameraEvent::Geometry );
     }
 
-    //----------------------------------------------------------------------
-    void DebugManager::_AddMesh( MeshPtr mesh, Time::Seconds duration, bool depthTest )
-    {
-        MeshInfo meshInfo;
-        meshInfo.mesh       = mesh;
-        meshInfo.duration   = duration;
-        meshInfo.depthTest  = depthTest;
-        m_currentMeshes[&THIS_SCENE].push_back( meshInfo );
-
-        m_commandBuffers[&THIS_SCENE].drawMesh( mesh, depthTest ? m_colorMaterial : m_colorMaterialNoDepthTest, DirectX::XMMatrixIdentity(), 0 );
-    }
-
 } } // end namespaces
\ No newline at end of file
@@ -79,22 +79,53 @@ namespace Core { namespace Debug {
         MaterialPtr             m_colorMaterial = nullptr;
         MaterialPtr             m_colorMaterialNoDepthTest = nullptr;
 
-        // Creates a new mesh for each new debug drawing request
-        struct MeshInfo
+        //----------------------------------------------------------------------
+        // Line vertices of all primitives drawn with one material, uploaded into one dynamic mesh.
+        // The gpu buffers of the mesh only grow, so they are reused across frames.
+        //----------------------------------------------------------------------
+        struct LineBatch
+        {
+            MeshPtr                 mesh;
+            ArrayList<Math::Vec3>   positions;
+            ArrayList<Math::Vec4>   colors;
+            ArrayList<U32>          indices;
+            U32                     capacity = 0; // Vertices the buffers of the mesh can hold
+            bool                    dirty = false;
+        };
+
+        // Primitive which stays visible for a given duration. Its vertices follow the ones of the previous primitive.
+        struct TimedPrimitive
         {
-            MeshPtr         mesh;
+            U32             numVertices;
             Time::Seconds   duration;
-            bool            depthTest;
         };
-        HashMap<IScene*, ArrayList<MeshInfo>> m_currentMeshes;
 
-        // Scene switch event listener
+        // Indexed by the depth test flag. Primitives without a duration are cleared every tick,
+        // all others are kept in separate batches, which are only uploaded again if they change.
+        LineBatch                   m_frameBatches[2];
+        LineBatch                   m_timedBatches[2];
+        ArrayList<TimedPrimitive>   m_timedPrimitives[2];
+
+        // Unit shapes as line lists, which are scaled and translated into the batches
+        ArrayList<Math::Vec3>       m_unitSphere;
+
+        // Event listeners
         Events::EventListener m_sceneSwitchListener;
+        Events::EventListener m_frameBeginListener;
 
         //----------------------------------------------------------------------
         void _OnSceneChanged();
-        void _UpdateCommandBuffer();
-        inline void _AddMesh(MeshPtr mesh, Time::Seconds duration, bool depthTest);
+        void _OnFrameBegin();
+        void _Clear();
+        void _UploadBatch(LineBatch& batch);
+
+        //----------------------------------------------------------------------
+        // Appends vertices of a line list with the given color to the matching batch.
+        // @Return:
+        //  The positions of the new vertices, which must be written by the caller.
+        //----------------------------------------------------------------------
+        Math::Vec3* _AddLines(U32 numVertices, Color color, Time::Seconds duration, bool depthTest);
+        void _AddBox(const std::array<Math::Vec3, 8>& corners, Color color, Time::Seconds duration, bool depthTest);
 
         NULL_COPY_AND_ASSIGN(DebugManager)
     };
@@ -16,6 +16,10 @@
 #include "OS/PlatformTimer/platform_timer.h"
 #include "GameplayLayer/i_scene.h"
 #include "GameplayLayer/Components/Rendering/camera.h"
+#include "Core/render_system.h"
+#include "Core/animation_system.h"
+#include "Core/particle_manager.h"
+#include "Core/texture_streamer.h"
 
 namespace Core { namespace Profiling {
 
@@ -139,6 +143,62 @@ namespace Core { namespace Profiling {
             str += "Vertices: " + TS( frameInfo.numVertices ) + "\n";
             str += "Triangles: " + TS( frameInfo.numTriangles ) + "\n";
             str += "Lights: " + TS( frameInfo.numLights ) + "\n";
+            str += "Shadow Casters: " + TS( frameInfo.numShadowCasters ) + " (Culled: " + TS( frameInfo.numShadowCastersCulled ) + ")\n";
+            U32 numShadowPasses = frameInfo.numShadowPassesRendered + frameInfo.numShadowPassesCached;
+            if (numShadowPasses > 0)
+                str += "Shadow Passes: " + TS( frameInfo.numShadowPassesRendered ) + " (Cached: " + TS( frameInfo.numShadowPassesCached )
+                     + ", Hit Rate: " + TS( 100 * frameInfo.numShadowPassesCached / numShadowPasses ) + "%)\n";
+        }
+
+        if ( RenderSystem::Instance().isOcclusionCullingEnabled() )
+        {
+            auto& occlusionStats = RenderSystem::Instance().getOcclusionCullingStats();
+            str += "<<< Occlusion Culling >>>\n";
+            str += "Occluders: " + TS( occlusionStats.numOccluders ) + " (" + TS( occlusionStats.numOccluderTriangles ) + " Triangles)\n";
+            str += "Culled: " + TS( occlusionStats.numCulled ) + "/" + TS( occlusionStats.numTested ) + "\n";
+            str += "Rasterize: " + TS( occlusionStats.rasterizeTimeMs ) + "ms Test: " + TS( occlusionStats.testTimeMs ) + "ms\n";
+        }
+
+        auto& animationStats = AnimationSystem::Instance().getStats();
+        if (animationStats.numRenderers > 0)
+        {
+            str += "<<< Animation >>>\n";
+            str += "Updated: " + TS( animationStats.numUpdated ) + "/" + TS( animationStats.numRenderers ) + " (Sampled: " + TS( animationStats.numSampled ) + ")\n";
+            str += "Skipped: " + TS( animationStats.numSkippedInvisible ) + " Invisible, " + TS( animationStats.numSkippedLOD ) + " LOD\n";
+        }
+
+        auto& particleStats = ParticleManager::Instance().getStats();
+        if (particleStats.numSystems > 0)
+        {
+            str += "<<< Particles >>>\n";
+            str += "Simulated: " + TS( particleStats.numSimulated ) + "/" + TS( particleStats.numSystems ) + " (Skipped: " + TS( particleStats.numSkippedInvisible ) + " Invisible)\n";
+            str += "Particles: " + TS( particleStats.numParticles ) + "\n";
+        }
+
+        auto& streamingStats = TextureStreamer::Instance().getStats();
+        if (streamingStats.numTextures > 0)
+        {
+            str += "<<< Texture Streaming >>>\n";
+            str += "Textures: " + TS( streamingStats.numTextures ) + " (Fully Resident: " + TS( streamingStats.numFullyResident ) + ")\n";
+            str += "Resident: " + TS( streamingStats.residentBytes / (1024 * 1024) ) + "MB Wanted: " + TS( streamingStats.wantedBytes / (1024 * 1024) )
+                 + "MB Budget: " + TS( streamingStats.budgetBytes / (1024 * 1024) ) + "MB\n";
+            str += "Pending: " + TS( streamingStats.numPendingRequests ) + " Streamed In: " + TS( streamingStats.numStreamedIn ) + " Evicted: " + TS( streamingStats.numEvicted ) + "\n";
+        }
+
+        if ( auto pipelineStateCache = Locator::getRenderer().getPipelineStateCache() )
+        {
+            auto stats = pipelineStateCache->getStats();
+            str += "<<< Pipeline States >>>\n";
+            str += "States: " + TS( stats.numStates ) + " (Warmed Up: " + TS( stats.numWarmedUp ) + ")\n";
+            str += "Hits: " + TS( stats.numHits ) + " Misses: " + TS( stats.numMisses ) + "\n";
+        }
+
+        if ( auto shaderCache = Locator::getRenderer().getShaderCache() )
+        {
+            auto stats = shaderCache->getStats();
+            str += "<<< Shader Cache >>>\n";
+            str += "Entries: " + TS( stats.numEntries ) + " (" + TS( stats.sizeInBytes / 1024 ) + "KB)\n";
+            str += "Hits: " + TS( stats.numHits ) + " Misses: " + TS( stats.numMisses ) + "\n";
         }
         LOG( str, LOGCOLOR );
     }
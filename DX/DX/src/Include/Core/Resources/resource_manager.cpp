@@ -155,6 +155,17 @@ namespace Core { namespace Resources {
         return Texture2DPtr( texture, BIND_THIS_FUNC_1_ARGS( &ResourceManager::_DeleteTexture) );
     }
 
+    //----------------------------------------------------------------------
+    Texture2DPtr ResourceManager::createTexture2D( U32 width, U32 height, Graphics::TextureFormat format, const ArrayList<const void*>& mips, U32 firstMip )
+    {
+        auto texture = Locator::getRenderer().createTexture2D();
+        texture->create( width, height, format, mips, firstMip );
+
+        m_textures.push_back( texture );
+
+        return Texture2DPtr( texture, BIND_THIS_FUNC_1_ARGS( &ResourceManager::_DeleteTexture ) );
+    }
+
     //----------------------------------------------------------------------
     Texture2DArrayPtr ResourceManager::createTexture2DArray( U32 width, U32 height, U32 depth, Graphics::TextureFormat format, bool generateMips )
     {
@@ -88,6 +88,17 @@ namespace Core { namespace Resources {
         //----------------------------------------------------------------------
         Texture2DPtr createTexture2D(U32 width, U32 height, Graphics::TextureFormat format, const void* pData);
 
+        //----------------------------------------------------------------------
+        // Creates a new immutable texture with a precomputed mipchain
+        // @Params:
+        //  "width": Width of the texture in pixels
+        //  "height": Height of the texture in pixels
+        //  "format": The format of the texture, e.g. a block compressed one
+        //  "mips": Pointer to the data of each mip, beginning with the largest one
+        //  "firstMip": Index of the first given mip. Larger mips can be streamed in later (see ITexture2D::setResidentMips())
+        //----------------------------------------------------------------------
+        Texture2DPtr createTexture2D(U32 width, U32 height, Graphics::TextureFormat format, const ArrayList<const void*>& mips, U32 firstMip = 0);
+
         //----------------------------------------------------------------------
         // Creates a new texture
         // @Params:
@@ -12,6 +12,8 @@
 
 #include "OS/Threading/thread_pool.h"
 #include "Common/i_subsystem.hpp"
+#include <atomic>
+#include <thread>
 
 namespace Core { namespace Threading {
 
@@ -30,10 +32,46 @@ namespace Core { namespace Threading {
         //----------------------------------------------------------------------
         OS::ThreadPool& getThreadPool() { return m_threadPool; }
 
+        //----------------------------------------------------------------------
+        // Calls func(i) for every i in [0, count) on the thread pool and returns when all calls are done.
+        // The calling thread takes part, so this can't deadlock if it is called from a job while all workers are busy.
+        //----------------------------------------------------------------------
+        template <typename Func>
+        void parallelFor(U32 count, const Func& func);
+
     private:
         OS::ThreadPool m_threadPool;
 
         NULL_COPY_AND_ASSIGN(ThreadManager)
     };
 
+    //----------------------------------------------------------------------
+    template <typename Func>
+    void ThreadManager::parallelFor( U32 count, const Func& func )
+    {
+        // Jobs starting after all items were taken return immediately, so they only share the counters with this call
+        struct Counters
+        {
+            std::atomic<U32> next{ 0 };
+            std::atomic<U32> done{ 0 };
+        };
+        auto counters = std::make_shared<Counters>();
+        auto work = [counters, count, &func] {
+            for (U32 i = counters->next++; i < count; i = counters->next++)
+            {
+                func( i );
+                counters->done++;
+            }
+        };
+
+        U32 numJobs = std::min( static_cast<U32>( m_threadPool.numThreads() ), count );
+        for (U32 i = 1; i < numJobs; i++)
+            m_threadPool.addJob( work );
+        work();
+
+        // Wait for the items other threads are still working on
+        while (counters->done < count)
+            std::this_thread::yield();
+    }
+
 } }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "animation_system.h"
+/**********************************************************************
+    class: AnimationSystem (animation_system.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "Graphics/camera.h"
+#include "GameplayLayer/gameobject.h"
+#include "GameplayLayer/Components/transform.h"
+#include "GameplayLayer/Components/Rendering/skinned_mesh_renderer.h"
+
+namespace Core {
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void AnimationSystem::execute( const ArrayList<Components::SkinnedMeshRenderer*>& renderers, const ArrayList<const Graphics::Camera*>& cameras )
+    {
+        m_frame++;
+        m_stats = {};
+        m_stats.numRenderers = static_cast<U32>( renderers.size() );
+
+        // Decide which renderer needs an update and group them by clip + time on the calling thread
+        std::map<std::pair<const Animation::IAnimationClip*, F64>, U32> sampleIndices;
+        U32 numSamples = 0;
+        m_updates.clear();
+
+        for (U32 i = 0; i < renderers.size(); i++)
+        {
+            auto renderer = renderers[i];
+            if ( not renderer->isActive() || not renderer->m_animation || not renderer->m_poseDirty )
+                continue;
+
+            // Bounds are computed from the bind pose, so they are enlarged to contain most animated poses as well
+            Math::AABB bounds;
+            bool hasBounds = renderer->getWorldBounds( &bounds );
+            Math::Vec3 center = hasBounds ? bounds.getCenter() : renderer->getGameObject()->getTransform()->getWorldPosition();
+            if (hasBounds)
+                bounds = Math::AABB( center - bounds.getExtents() * 2.0f, center + bounds.getExtents() * 2.0f );
+
+            // Camera matrices are from the last frame, which is sufficient here
+            bool isVisible = cameras.empty();
+            F32 distance = cameras.empty() ? 0.0f : std::numeric_limits<F32>::max();
+            for (auto camera : cameras)
+            {
+                isVisible = isVisible || not hasBounds || camera->cull( bounds );
+
+                Math::Vec3 cameraPos;
+                DirectX::XMStoreFloat3( &cameraPos, camera->getModelMatrix().r[3] );
+                distance = std::min( distance, (cameraPos - center).magnitude() );
+            }
+
+            if ( not isVisible && not m_updateInvisible )
+            {
+                renderer->m_poseStale = true;
+                m_stats.numSkippedInvisible++;
+                continue;
+            }
+
+            // Renderers whose pose is stale, e.g. because they just became visible, are updated immediately.
+            // Others are spread across the frames of their interval.
+            U32 interval = _GetUpdateInterval( distance );
+            if ( not renderer->m_poseStale && interval > 1 && (m_frame + i) % interval != 0 )
+            {
+                m_stats.numSkippedLOD++;
+                continue;
+            }
+            renderer->m_poseStale = false;
+
+            auto key = std::make_pair( renderer->m_animation.get(), renderer->m_clock.getTime().value );
+            auto it = sampleIndices.find( key );
+            if (it == sampleIndices.end())
+            {
+                if (numSamples == m_samples.size())
+                    m_samples.emplace_back();
+
+                auto& sample = m_samples[numSamples];
+                sample.owner = renderer;
+                sample.localPoses.resize( renderer->m_animation->getJointCount() );
+                it = sampleIndices.insert( { key, numSamples++ } ).first;
+            }
+            m_updates.push_back({ renderer, it->second });
+        }
+
+        // Sample each distinct pose once, then build the matrix palettes of all renderers from them.
+        // Items write only to their own renderer or sample, so no synchronization is required.
+        auto& threadManager = Locator::getThreadManager();
+        threadManager.parallelFor( numSamples, [this](U32 i) {
+            auto& sample = m_samples[i];
+            sample.owner->_SampleLocalPose( sample.localPoses.data() );
+        } );
+
+        threadManager.parallelFor( static_cast<U32>( m_updates.size() ), [this](U32 i) {
+            auto& update = m_updates[i];
+            update.renderer->_UpdateMatrixPalette( m_samples[update.sample].localPoses.data() );
+        } );
+
+        m_stats.numUpdated = static_cast<U32>( m_updates.size() );
+        m_stats.numSampled = numSamples;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    U32 AnimationSystem::_GetUpdateInterval( F32 distance ) const
+    {
+        for (auto& lod : m_lods)
+            if (distance <= lod.maxDistance)
+                return std::max( lod.updateInterval, 1u );
+
+        return m_lods.empty() ? 1 : std::max( m_lods.back().updateInterval, 1u );
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+/**********************************************************************
+    class: AnimationSystem (animation_system.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Updates the poses of all skinned mesh renderers of a scene once per
+    frame on the thread pool. How often a renderer is updated depends on
+    its distance to the nearest camera (animation LOD). Renderers which
+    are not visible by any camera are not updated at all until they
+    become visible again.
+    Renderers playing the same clip at exactly the same time (e.g. a
+    crowd started in the same frame) sample the clip only once.
+**********************************************************************/
+
+namespace Graphics { class Camera; }
+namespace Components { class SkinnedMeshRenderer; }
+
+namespace Core {
+
+    //----------------------------------------------------------------------
+    struct AnimationLOD
+    {
+        F32 maxDistance;    // Up to this distance to the nearest camera the LOD is used
+        U32 updateInterval; // Pose is updated every n-th frame
+    };
+
+    //----------------------------------------------------------------------
+    struct AnimationStats
+    {
+        U32 numRenderers        = 0;
+        U32 numUpdated          = 0;
+        U32 numSkippedInvisible = 0;
+        U32 numSkippedLOD       = 0;
+        U32 numSampled          = 0; // Distinct clip + time pairs sampled. Less than "numUpdated" if poses were shared.
+    };
+
+    //**********************************************************************
+    class AnimationSystem
+    {
+    public:
+        static AnimationSystem& Instance()
+        {
+            static AnimationSystem as;
+            return as;
+        }
+
+        //----------------------------------------------------------------------
+        // Updates the poses of the given renderers as seen from the given cameras.
+        //----------------------------------------------------------------------
+        void execute(const ArrayList<Components::SkinnedMeshRenderer*>& renderers, const ArrayList<const Graphics::Camera*>& cameras);
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "lods": Sorted by ascending distance. Renderers beyond the last distance use the last interval.
+        //          An empty list updates every visible renderer every frame.
+        //----------------------------------------------------------------------
+        void setLODs(const ArrayList<AnimationLOD>& lods)   { m_lods = lods; }
+        void setUpdateInvisible(bool updateInvisible)       { m_updateInvisible = updateInvisible; }
+
+        //----------------------------------------------------------------------
+        const ArrayList<AnimationLOD>&  getLODs()   const { return m_lods; }
+        const AnimationStats&           getStats()  const { return m_stats; }
+
+    private:
+        ArrayList<AnimationLOD> m_lods = { { 15.0f, 1 }, { 40.0f, 2 }, { 80.0f, 4 }, { 150.0f, 8 } };
+        bool                    m_updateInvisible = false;
+        U64                     m_frame = 0;
+        AnimationStats          m_stats;
+
+        // One entry per distinct clip + time pair, reused between frames
+        struct PoseSample
+        {
+            Components::SkinnedMeshRenderer*    owner; // Its cursors are used for sampling
+            ArrayList<DirectX::XMMATRIX>        localPoses;
+        };
+        ArrayList<PoseSample>                   m_samples;
+
+        struct Update
+        {
+            Components::SkinnedMeshRenderer*    renderer;
+            U32                                 sample;
+        };
+        ArrayList<Update>                       m_updates;
+
+        //----------------------------------------------------------------------
+        U32 _GetUpdateInterval(F32 distance) const;
+
+        AnimationSystem() = default;
+        NULL_COPY_AND_ASSIGN(AnimationSystem)
+    };
+
+}
@@ -0,0 +1,244 @@
+#include "light_clusters.h"
+/**********************************************************************
+    class: LightClusters (light_clusters.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "Graphics/camera.h"
+#include "Graphics/command_buffer.h"
+#include "GameplayLayer/Components/Rendering/i_light_component.h"
+
+namespace Core {
+
+    // Width of the cluster texture. It only grows in height when more light indices are required.
+    static constexpr U32 CLUSTER_TEXTURE_WIDTH = 1024;
+
+    //----------------------------------------------------------------------
+    LightClusters::LightClusters( U32 numX, U32 numY, U32 numZ, U32 numJobs )
+        : m_numJobs( std::max( numJobs, 1u ) )
+    {
+        setDimensions( numX, numY, numZ );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void LightClusters::setDimensions( U32 numX, U32 numY, U32 numZ )
+    {
+        ASSERT( numX > 0 && numY > 0 && numZ > 0 );
+        m_numX = numX;
+        m_numY = numY;
+        m_numZ = numZ;
+        m_clusters.assign( getClusterCount(), {} );
+    }
+
+    //----------------------------------------------------------------------
+    U32 LightClusters::getClusterIndex( F32 screenX, F32 screenY, F32 viewDepth ) const
+    {
+        I32 x = std::clamp( static_cast<I32>( screenX * m_numX ), 0, (I32)m_numX - 1 );
+        I32 y = std::clamp( static_cast<I32>( screenY * m_numY ), 0, (I32)m_numY - 1 );
+
+        F32 slice = std::log( std::max( viewDepth, m_zNear ) / m_zNear ) / std::log( m_zFar / m_zNear ) * m_numZ;
+        I32 z = std::clamp( static_cast<I32>( slice ), 0, (I32)m_numZ - 1 );
+
+        return x + y * m_numX + z * m_numX * m_numY;
+    }
+
+    //----------------------------------------------------------------------
+    void LightClusters::build( const Graphics::Camera& camera, const ArrayList<Components::ILightComponent*>& lights )
+    {
+        ASSERT( lights.size() <= std::numeric_limits<U16>::max() );
+
+        m_lights = lights;
+        m_zNear  = camera.getZNear();
+        m_zFar   = camera.getZFar();
+
+        // Bounding spheres of all lights in view space
+        m_spheres.clear();
+        m_globalLights.clear();
+        auto& view = camera.getViewMatrix();
+        for (U16 i = 0; i < lights.size(); i++)
+        {
+            LightSphere sphere;
+            sphere.index = i;
+            if ( not lights[i]->getBoundingSphere( &sphere.center, &sphere.radius ) )
+            {
+                m_globalLights.push_back( i );
+                continue;
+            }
+
+            DirectX::XMStoreFloat3( &sphere.center, DirectX::XMVector3TransformCoord( DirectX::XMLoadFloat3( &sphere.center ), view ) );
+            m_spheres.push_back( sphere );
+        }
+
+        // Rays through the corners of every tile, which works for perspective and orthographic projections
+        auto invProjection = DirectX::XMMatrixInverse( nullptr, camera.getProjectionMatrix() );
+        m_cornerOrigins.resize( (m_numX + 1) * (m_numY + 1) );
+        m_cornerDirections.resize( (m_numX + 1) * (m_numY + 1) );
+        for (U32 y = 0; y <= m_numY; y++)
+        {
+            for (U32 x = 0; x <= m_numX; x++)
+            {
+                F32 ndcX = -1.0f + 2.0f * x / m_numX;
+                F32 ndcY =  1.0f - 2.0f * y / m_numY;
+
+                Math::Vec3 nearPoint, farPoint;
+                DirectX::XMStoreFloat3( &nearPoint, DirectX::XMVector3TransformCoord( DirectX::XMVectorSet( ndcX, ndcY, 0.0f, 1.0f ), invProjection ) );
+                DirectX::XMStoreFloat3( &farPoint,  DirectX::XMVector3TransformCoord( DirectX::XMVectorSet( ndcX, ndcY, 1.0f, 1.0f ), invProjection ) );
+
+                Math::Vec3 direction = (farPoint - nearPoint) / (farPoint.z - nearPoint.z);
+                U32 corner = x + y * (m_numX + 1);
+                m_cornerDirections[corner] = direction;
+                m_cornerOrigins[corner] = nearPoint - direction * nearPoint.z;
+            }
+        }
+
+        // Assign lights to clusters. Each job handles a range of depth slices, so the clusters are written without synchronization.
+        U32 numJobs = std::min( m_numJobs, m_numZ );
+        U32 slicesPerJob = (m_numZ + numJobs - 1) / numJobs;
+        m_jobResults.resize( numJobs );
+
+        if (numJobs == 1 || m_spheres.empty())
+        {
+            _BuildSlices( 0, m_numZ, m_jobResults[0] );
+            for (U32 j = 1; j < m_jobResults.size(); j++)
+                m_jobResults[j].lightIndices.clear();
+        }
+        else
+        {
+            ArrayList<OS::JobPtr> jobs;
+            for (U32 j = 0; j < numJobs; j++)
+            {
+                U32 begin = std::min( j * slicesPerJob, m_numZ );
+                U32 end   = std::min( begin + slicesPerJob, m_numZ );
+                jobs.push_back( ASYNC_JOB( [this, begin, end, j] { _BuildSlices( begin, end, m_jobResults[j] ); } ) );
+            }
+            for (auto& job : jobs)
+                job->wait();
+        }
+
+        // Merge the index lists of all jobs. Clusters of later jobs are shifted by the size of the previous lists.
+        m_lightIndices.clear();
+        U32 clustersPerSlice = m_numX * m_numY;
+        for (U32 j = 0; j < m_jobResults.size(); j++)
+        {
+            U32 base = static_cast<U32>( m_lightIndices.size() );
+            U32 begin = std::min( j * slicesPerJob, m_numZ ) * clustersPerSlice;
+            U32 end   = std::min( (j + 1) * slicesPerJob, m_numZ ) * clustersPerSlice;
+            if (base > 0)
+                for (U32 c = begin; c < end; c++)
+                    m_clusters[c].offset += base;
+
+            auto& indices = m_jobResults[j].lightIndices;
+            m_lightIndices.insert( m_lightIndices.end(), indices.begin(), indices.end() );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void LightClusters::upload( Graphics::CommandBuffer& cmd )
+    {
+        U32 numClusters = getClusterCount();
+        U32 indexBegin  = numClusters + static_cast<U32>( m_globalLights.size() );
+        U32 numTexels   = indexBegin + static_cast<U32>( m_lightIndices.size() );
+        U32 height      = (numTexels + CLUSTER_TEXTURE_WIDTH - 1) / CLUSTER_TEXTURE_WIDTH;
+
+        if ( not m_texture || m_texture->getHeight() < height )
+        {
+            m_texture = RESOURCES.createTexture2D( CLUSTER_TEXTURE_WIDTH, height, Graphics::TextureFormat::RGFloat, false );
+            m_texture->setFilter( Graphics::TextureFilter::Point );
+            m_texture->setClampMode( Graphics::TextureAddressMode::Clamp );
+        }
+
+        // Floats represent every index exactly up to 2^24, which is way more than the texture can hold
+        m_texels.assign( CLUSTER_TEXTURE_WIDTH * m_texture->getHeight(), Math::Vec2( 0.0f, 0.0f ) );
+        for (U32 c = 0; c < numClusters; c++)
+            m_texels[c] = Math::Vec2( static_cast<F32>( indexBegin + m_clusters[c].offset ), static_cast<F32>( m_clusters[c].count ) );
+        for (U32 i = 0; i < m_globalLights.size(); i++)
+            m_texels[numClusters + i].x = m_globalLights[i];
+        for (U32 i = 0; i < m_lightIndices.size(); i++)
+            m_texels[indexBegin + i].x = m_lightIndices[i];
+
+        // Pixels are kept in RAM, so they are not reallocated every frame
+        m_texture->setPixels( m_texels.data() );
+        m_texture->apply( false, true );
+
+        cmd.setLightClusters( m_texture, m_numX, m_numY, m_numZ, static_cast<I32>( m_globalLights.size() ) );
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    F32 LightClusters::_SliceDepth( U32 slice ) const
+    {
+        return m_zNear * std::pow( m_zFar / m_zNear, static_cast<F32>( slice ) / m_numZ );
+    }
+
+    //----------------------------------------------------------------------
+    Math::AABB LightClusters::_ClusterBounds( U32 x, U32 y, F32 depthBegin, F32 depthEnd ) const
+    {
+        Math::Vec3 min( std::numeric_limits<F32>::max() );
+        Math::Vec3 max( -std::numeric_limits<F32>::max() );
+
+        for (U32 cy = y; cy <= y + 1; cy++)
+        {
+            for (U32 cx = x; cx <= x + 1; cx++)
+            {
+                U32 corner = cx + cy * (m_numX + 1);
+                for (F32 depth : { depthBegin, depthEnd })
+                {
+                    Math::Vec3 p = m_cornerOrigins[corner] + m_cornerDirections[corner] * depth;
+                    min = min.minVec( p );
+                    max = max.maxVec( p );
+                }
+            }
+        }
+
+        return Math::AABB( min, max );
+    }
+
+    //----------------------------------------------------------------------
+    void LightClusters::_BuildSlices( U32 sliceBegin, U32 sliceEnd, JobResult& result )
+    {
+        result.lightIndices.clear();
+
+        ArrayList<const LightSphere*> sliceSpheres;
+        for (U32 z = sliceBegin; z < sliceEnd; z++)
+        {
+            F32 depthBegin = _SliceDepth( z );
+            F32 depthEnd   = _SliceDepth( z + 1 );
+
+            // Only lights overlapping this slice in depth have to be tested against the single clusters
+            sliceSpheres.clear();
+            for (auto& sphere : m_spheres)
+                if (sphere.center.z - sphere.radius <= depthEnd && sphere.center.z + sphere.radius >= depthBegin)
+                    sliceSpheres.push_back( &sphere );
+
+            for (U32 y = 0; y < m_numY; y++)
+            {
+                for (U32 x = 0; x < m_numX; x++)
+                {
+                    auto& cluster = m_clusters[x + y * m_numX + z * m_numX * m_numY];
+                    cluster.offset = static_cast<U32>( result.lightIndices.size() );
+
+                    if ( not sliceSpheres.empty() )
+                    {
+                        auto bounds = _ClusterBounds( x, y, depthBegin, depthEnd );
+                        for (auto sphere : sliceSpheres)
+                            if ( bounds.overlaps( sphere->center, sphere->radius ) )
+                                result.lightIndices.push_back( sphere->index );
+                    }
+
+                    cluster.count = static_cast<U32>( result.lightIndices.size() ) - cluster.offset;
+                }
+            }
+        }
+    }
+
+}
\ No newline at end of file
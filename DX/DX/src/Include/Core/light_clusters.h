@@ -0,0 +1,131 @@
+#pragma once
+/**********************************************************************
+    class: LightClusters (light_clusters.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Clustered light assignment on the cpu. The view frustum of a camera
+    is divided into a 3D grid of clusters (froxels), screen space tiles
+    in x/y and exponentially distributed slices in z. Each cluster gets
+    a list of indices of all lights whose range intersect it, so the
+    shading cost of a fragment only depends on the lights near it.
+    Lights without a finite range (directional lights) are stored in a
+    separate list, because they affect every cluster.
+    The depth slices are assigned in parallel by the thread pool.
+    Layout of the result:
+      - Cluster:  offset + count into the light index list
+      - Index:    index into the light list given to build()
+    upload() packs the result into one texture which is read by the
+    lighting of the shaders, see APPLY_LIGHTING in pbr.hlsl.
+**********************************************************************/
+
+#include "Math/aabb.h"
+#include "Graphics/i_texture2d.hpp"
+
+namespace Graphics { class Camera; class CommandBuffer; }
+
+namespace Components { class ILightComponent; }
+
+namespace Core {
+
+    //**********************************************************************
+    class LightClusters
+    {
+    public:
+        struct Cluster
+        {
+            U32 offset  = 0;
+            U32 count   = 0;
+        };
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "numX/numY": Amount of screen space tiles.
+        //  "numZ": Amount of depth slices.
+        //  "numJobs": Amount of jobs the slices are split into. 1 builds on the calling thread.
+        //----------------------------------------------------------------------
+        LightClusters(U32 numX = 16, U32 numY = 9, U32 numZ = 24, U32 numJobs = 4);
+        ~LightClusters() = default;
+
+        //----------------------------------------------------------------------
+        U32                                             getNumX()           const { return m_numX; }
+        U32                                             getNumY()           const { return m_numY; }
+        U32                                             getNumZ()           const { return m_numZ; }
+        U32                                             getClusterCount()   const { return m_numX * m_numY * m_numZ; }
+        const ArrayList<Cluster>&                       getClusters()       const { return m_clusters; }
+        const ArrayList<U16>&                           getLightIndices()   const { return m_lightIndices; }
+        const ArrayList<Components::ILightComponent*>&  getLights()         const { return m_lights; }
+        const ArrayList<U16>&                           getGlobalLights()   const { return m_globalLights; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Index of the cluster at the given normalized screen position [0-1] and view space depth.
+        //----------------------------------------------------------------------
+        U32 getClusterIndex(F32 screenX, F32 screenY, F32 viewDepth) const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Cluster which stores the location of all light indices for the given cluster index.
+        //----------------------------------------------------------------------
+        const Cluster& getCluster(U32 clusterIndex) const { return m_clusters[clusterIndex]; }
+
+        //----------------------------------------------------------------------
+        void setDimensions(U32 numX, U32 numY, U32 numZ);
+        void setJobCount(U32 numJobs) { m_numJobs = std::max( numJobs, 1u ); }
+
+        //----------------------------------------------------------------------
+        // Assigns all given lights to the clusters of the given camera.
+        // Indices stored in the clusters refer to this list.
+        //----------------------------------------------------------------------
+        void build(const Graphics::Camera& camera, const ArrayList<Components::ILightComponent*>& lights);
+
+        //----------------------------------------------------------------------
+        // Uploads the result of the last build() and records a command which makes it available to the shaders.
+        // Texels of the texture: (offset, count) of every cluster, followed by the indices of the global lights
+        // and the light indices of all clusters (index, 0). Must be recorded before the first light is drawn.
+        //----------------------------------------------------------------------
+        void upload(Graphics::CommandBuffer& cmd);
+
+    private:
+        struct LightSphere
+        {
+            Math::Vec3  center; // View space
+            F32         radius;
+            U16         index;
+        };
+
+        struct JobResult
+        {
+            ArrayList<U16> lightIndices;
+        };
+
+        U32                                         m_numX;
+        U32                                         m_numY;
+        U32                                         m_numZ;
+        U32                                         m_numJobs;
+        F32                                         m_zNear = 0.1f;
+        F32                                         m_zFar  = 1000.0f;
+        ArrayList<Cluster>                          m_clusters;
+        ArrayList<U16>                              m_lightIndices;
+        ArrayList<Components::ILightComponent*>     m_lights;
+        ArrayList<U16>                              m_globalLights;
+        ArrayList<LightSphere>                      m_spheres;
+        ArrayList<JobResult>                        m_jobResults;
+
+        // View space ray through each tile corner. Origin at depth 0 + direction per unit depth.
+        ArrayList<Math::Vec3>                       m_cornerOrigins;
+        ArrayList<Math::Vec3>                       m_cornerDirections;
+
+        Texture2DPtr                                m_texture = nullptr;
+        ArrayList<Math::Vec2>                       m_texels;
+
+        //----------------------------------------------------------------------
+        F32         _SliceDepth(U32 slice) const;
+        Math::AABB  _ClusterBounds(U32 x, U32 y, F32 depthBegin, F32 depthEnd) const;
+        void        _BuildSlices(U32 sliceBegin, U32 sliceEnd, JobResult& result);
+
+        NULL_COPY_AND_ASSIGN(LightClusters)
+    };
+
+}
\ No newline at end of file
@@ -11,9 +11,67 @@
 #define _USE_MATH_DEFINES
 #include <math.h> // M_PI
 #include "Math/math_utils.h"
+#include <unordered_set>
 
 namespace Core { 
 
+    //**********************************************************************
+    // Helper for the mesh simplification
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    // Symmetric 4x4 matrix representing the sum of squared distances to a set of planes.
+    //----------------------------------------------------------------------
+    struct Quadric
+    {
+        F64 a2 = 0, ab = 0, ac = 0, ad = 0;
+        F64 b2 = 0, bc = 0, bd = 0;
+        F64 c2 = 0, cd = 0;
+        F64 d2 = 0;
+
+        Quadric() = default;
+        Quadric(F64 a, F64 b, F64 c, F64 d, F64 weight)
+            : a2( a * a * weight ), ab( a * b * weight ), ac( a * c * weight ), ad( a * d * weight ),
+              b2( b * b * weight ), bc( b * c * weight ), bd( b * d * weight ),
+              c2( c * c * weight ), cd( c * d * weight ),
+              d2( d * d * weight ) {}
+
+        Quadric& operator += (const Quadric& q)
+        {
+            a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+            b2 += q.b2; bc += q.bc; bd += q.bd;
+            c2 += q.c2; cd += q.cd;
+            d2 += q.d2;
+            return *this;
+        }
+
+        F64 evaluate(const Math::Vec3& p) const
+        {
+            F64 x = p.x, y = p.y, z = p.z;
+            return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+                 + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+                 + c2 * z * z + 2 * cd * z
+                 + d2;
+        }
+    };
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    static void CopyVertexStream( const MeshPtr& src, const MeshPtr& dst, StringID name, const ArrayList<U32>& vertices )
+    {
+        if ( not src->hasVertexStream( name ) )
+            return;
+
+        auto& data = src->getVertexStream<T>( name ).get();
+
+        ArrayList<T> newData;
+        newData.reserve( vertices.size() );
+        for (auto v : vertices)
+            newData.push_back( data[v] );
+
+        dst->createVertexStream<T>( name, newData );
+    }
+
     //----------------------------------------------------------------------
     MeshPtr MeshGenerator::CreateCube( F32 size )
     {
@@ -500,4 +558,330 @@ namespace Core {
         return mesh;
     }
 
+    //----------------------------------------------------------------------
+    MeshPtr MeshGenerator::CreateSimplified( const MeshPtr& mesh, F32 targetRatio, F32 maxError )
+    {
+        static const F64 BOUNDARY_WEIGHT = 10.0;
+
+        for (U32 i = 0; i < mesh->getSubMeshCount(); i++)
+        {
+            if (mesh->getMeshTopology( i ) != Graphics::MeshTopology::Triangles)
+            {
+                LOG_WARN( "MeshGenerator::CreateSimplified(): Only triangle meshes can be simplified." );
+                return mesh;
+            }
+        }
+
+        auto& positions = mesh->getVertexPositions();
+        U32 vertexCount = static_cast<U32>( positions.size() );
+
+        // Gather triangles of all submeshes with absolute vertex indices
+        struct Triangle
+        {
+            U32     v[3];
+            U32     subMesh;
+            bool    removed = false;
+        };
+        ArrayList<Triangle> triangles;
+        ArrayList<U32> subMeshTriangleCount( mesh->getSubMeshCount(), 0 );
+        for (U32 i = 0; i < mesh->getSubMeshCount(); i++)
+        {
+            auto& indices = mesh->getIndices( i );
+            U32 baseVertex = mesh->getBaseVertex( i );
+            for (U32 j = 0; j + 2 < mesh->getIndexCount( i ); j += 3)
+            {
+                Triangle tri;
+                tri.v[0] = indices[j] + baseVertex; tri.v[1] = indices[j + 1] + baseVertex; tri.v[2] = indices[j + 2] + baseVertex;
+                tri.subMesh = i;
+                triangles.push_back( tri );
+                subMeshTriangleCount[i]++;
+            }
+        }
+
+        // Weld vertices by position. Vertices split because of different attributes (e.g. uv seams) share one
+        // position, every vertex of a position is called a wedge. Collapses move all wedges of a position at once.
+        ArrayList<U32> sortedVertices( vertexCount );
+        for (U32 i = 0; i < vertexCount; i++)
+            sortedVertices[i] = i;
+        std::sort( sortedVertices.begin(), sortedVertices.end(), [&positions](U32 a, U32 b) {
+            return std::tie( positions[a].x, positions[a].y, positions[a].z ) < std::tie( positions[b].x, positions[b].y, positions[b].z );
+        } );
+
+        ArrayList<U32>  canonical( vertexCount );
+        ArrayList<bool> onSeam;
+        U32 canonicalCount = 0;
+        for (U32 i = 0; i < vertexCount; i++)
+        {
+            if (i > 0 && positions[sortedVertices[i]] == positions[sortedVertices[i - 1]])
+            {
+                onSeam.back() = true;
+            }
+            else
+            {
+                canonicalCount++;
+                onSeam.push_back( false );
+            }
+            canonical[sortedVertices[i]] = canonicalCount - 1;
+        }
+
+        ArrayList<Math::Vec3>       canonicalPositions( canonicalCount );
+        ArrayList<Quadric>          quadrics( canonicalCount );
+        ArrayList<ArrayList<U32>>   vertexTriangles( canonicalCount );
+        ArrayList<U32>              versions( canonicalCount, 0 );
+        ArrayList<bool>             collapsed( canonicalCount, false );
+        for (U32 i = 0; i < vertexCount; i++)
+            canonicalPositions[canonical[i]] = positions[i];
+
+        // Plane quadrics weighted by triangle area + count of triangles per edge to detect boundaries
+        HashMap<std::pair<U32, U32>, U32> edgeUseCount;
+        for (U32 t = 0; t < triangles.size(); t++)
+        {
+            auto& tri = triangles[t];
+            U32 c[3] = { canonical[tri.v[0]], canonical[tri.v[1]], canonical[tri.v[2]] };
+
+            auto normal = (canonicalPositions[c[1]] - canonicalPositions[c[0]]).cross( canonicalPositions[c[2]] - canonicalPositions[c[0]] );
+            F32 doubleArea = normal.magnitude();
+            if (doubleArea > 0.0f)
+            {
+                normal /= doubleArea;
+                Quadric q( normal.x, normal.y, normal.z, -normal.dot( canonicalPositions[c[0]] ), doubleArea * 0.5 );
+                for (I32 k = 0; k < 3; k++)
+                    quadrics[c[k]] += q;
+            }
+
+            for (I32 k = 0; k < 3; k++)
+            {
+                vertexTriangles[c[k]].push_back( t );
+                edgeUseCount[std::minmax( c[k], c[(k + 1) % 3] )]++;
+            }
+        }
+
+        // Border edges get an additional plane perpendicular to the triangle, so the outline of open meshes is preserved
+        for (auto& tri : triangles)
+        {
+            U32 c[3] = { canonical[tri.v[0]], canonical[tri.v[1]], canonical[tri.v[2]] };
+            auto faceNormal = (canonicalPositions[c[1]] - canonicalPositions[c[0]]).cross( canonicalPositions[c[2]] - canonicalPositions[c[0]] );
+            for (I32 k = 0; k < 3; k++)
+            {
+                U32 a = c[k], b = c[(k + 1) % 3];
+                if (edgeUseCount[std::minmax( a, b )] != 1)
+                    continue;
+
+                auto edge = canonicalPositions[b] - canonicalPositions[a];
+                auto normal = edge.cross( faceNormal );
+                F32 length = normal.magnitude();
+                if (length <= 0.0f)
+                    continue;
+
+                normal /= length;
+                Quadric q( normal.x, normal.y, normal.z, -normal.dot( canonicalPositions[a] ), BOUNDARY_WEIGHT * edge.dot( edge ) );
+                quadrics[a] += q;
+                quadrics[b] += q;
+            }
+        }
+
+        // Every edge is pushed into a min heap. Entries become stale when one of their vertices changed.
+        struct Collapse
+        {
+            F64 cost;
+            U32 from, to;
+            U32 versionFrom, versionTo;
+            bool operator > (const Collapse& c) const { return cost > c.cost; }
+        };
+        std::priority_queue<Collapse, ArrayList<Collapse>, std::greater<Collapse>> heap;
+
+        auto pushEdge = [&](U32 a, U32 b) {
+            Quadric q = quadrics[a];
+            q += quadrics[b];
+
+            // Vertices are moved onto one of the edge endpoints, so the attributes of that vertex can be kept.
+            // A seam vertex can only move along its seam, so never onto a vertex which is not on a seam.
+            F64 costAtoB = (onSeam[a] && not onSeam[b]) ? std::numeric_limits<F64>::max() : q.evaluate( canonicalPositions[b] );
+            F64 costBtoA = (onSeam[b] && not onSeam[a]) ? std::numeric_limits<F64>::max() : q.evaluate( canonicalPositions[a] );
+            if (costAtoB == std::numeric_limits<F64>::max() && costBtoA == std::numeric_limits<F64>::max())
+                return;
+
+            if (costAtoB <= costBtoA)
+                heap.push( { costAtoB, a, b, versions[a], versions[b] } );
+            else
+                heap.push( { costBtoA, b, a, versions[b], versions[a] } );
+        };
+
+        for (auto& edge : edgeUseCount)
+            pushEdge( edge.first.first, edge.first.second );
+
+        U32 triangleCount = static_cast<U32>( triangles.size() );
+        U32 targetCount = static_cast<U32>( triangleCount * std::clamp( targetRatio, 0.0f, 1.0f ) );
+
+        ArrayList<U32> removedPerSubMesh( mesh->getSubMeshCount() );
+        ArrayList<std::pair<U32, U32>> wedgeMap; // Wedge of "from" -> wedge of "to"
+        auto findWedge = [&wedgeMap](U32 wedge) {
+            return std::find_if( wedgeMap.begin(), wedgeMap.end(), [wedge](const std::pair<U32, U32>& w) { return w.first == wedge; } );
+        };
+
+        while (triangleCount > targetCount && not heap.empty())
+        {
+            Collapse collapse = heap.top();
+            heap.pop();
+
+            U32 from = collapse.from, to = collapse.to;
+            if ( collapsed[from] || collapsed[to] || versions[from] != collapse.versionFrom || versions[to] != collapse.versionTo )
+                continue;
+
+            if (collapse.cost > maxError)
+                break;
+
+            // Every wedge of "from" is replaced by the wedge of "to" it shares a collapsed triangle with.
+            // This fails if a wedge does not touch the collapsed edge (the edge crosses a seam) or touches
+            // several wedges of "to". Distinct wedges must stay distinct, otherwise a seam would be closed.
+            wedgeMap.clear();
+            bool valid = true;
+            for (auto t : vertexTriangles[from])
+            {
+                auto& tri = triangles[t];
+                if (tri.removed)
+                    continue;
+
+                U32 fromWedge = vertexCount, toWedge = vertexCount;
+                for (I32 k = 0; k < 3; k++)
+                {
+                    if (canonical[tri.v[k]] == from) fromWedge = tri.v[k];
+                    if (canonical[tri.v[k]] == to)   toWedge = tri.v[k];
+                }
+                if (toWedge == vertexCount)
+                    continue;
+
+                auto it = findWedge( fromWedge );
+                if (it == wedgeMap.end())
+                    wedgeMap.push_back( { fromWedge, toWedge } );
+                else if (it->second != toWedge)
+                    valid = false;
+            }
+
+            for (U32 i = 0; i < wedgeMap.size() && valid; i++)
+                for (U32 j = i + 1; j < wedgeMap.size(); j++)
+                    if (wedgeMap[i].second == wedgeMap[j].second)
+                        valid = false;
+
+            // Validate the collapse: no triangle is allowed to flip and no submesh is allowed to become empty
+            std::fill( removedPerSubMesh.begin(), removedPerSubMesh.end(), 0 );
+            for (auto t : vertexTriangles[from])
+            {
+                auto& tri = triangles[t];
+                if (tri.removed || not valid)
+                    continue;
+
+                Math::Vec3 p[3];
+                bool containsTo = false;
+                for (I32 k = 0; k < 3; k++)
+                {
+                    U32 c = canonical[tri.v[k]];
+                    p[k] = canonicalPositions[c];
+                    if (c == to)
+                        containsTo = true;
+                    else if (c == from && findWedge( tri.v[k] ) == wedgeMap.end())
+                        valid = false;
+                }
+
+                if (containsTo)
+                {
+                    if (++removedPerSubMesh[tri.subMesh] >= subMeshTriangleCount[tri.subMesh])
+                        valid = false;
+                    continue;
+                }
+
+                auto oldNormal = (p[1] - p[0]).cross( p[2] - p[0] );
+                for (I32 k = 0; k < 3; k++)
+                    if (canonical[tri.v[k]] == from)
+                        p[k] = canonicalPositions[to];
+                auto newNormal = (p[1] - p[0]).cross( p[2] - p[0] );
+
+                if (newNormal.dot( oldNormal ) <= 0.0f)
+                    valid = false;
+            }
+
+            // Vertices without a shared triangle can't be collapsed
+            if ( not valid || wedgeMap.empty() )
+                continue;
+
+            // Collapse "from" into "to"
+            for (auto t : vertexTriangles[from])
+            {
+                auto& tri = triangles[t];
+                if (tri.removed)
+                    continue;
+
+                bool containsTo = canonical[tri.v[0]] == to || canonical[tri.v[1]] == to || canonical[tri.v[2]] == to;
+                if (containsTo)
+                {
+                    tri.removed = true;
+                    subMeshTriangleCount[tri.subMesh]--;
+                    triangleCount--;
+                }
+                else
+                {
+                    for (I32 k = 0; k < 3; k++)
+                        if (canonical[tri.v[k]] == from)
+                            tri.v[k] = findWedge( tri.v[k] )->second;
+                    vertexTriangles[to].push_back( t );
+                }
+            }
+
+            quadrics[to] += quadrics[from];
+            collapsed[from] = true;
+            versions[to]++;
+
+            // Recompute the cost of all edges around the new vertex
+            std::unordered_set<U32> neighbours;
+            for (auto t : vertexTriangles[to])
+            {
+                auto& tri = triangles[t];
+                if (tri.removed)
+                    continue;
+                for (I32 k = 0; k < 3; k++)
+                    if (canonical[tri.v[k]] != to)
+                        neighbours.insert( canonical[tri.v[k]] );
+            }
+            for (auto n : neighbours)
+                pushEdge( to, n );
+        }
+
+        // Build the new mesh only from vertices which are still referenced
+        ArrayList<U32> newIndexOf( vertexCount, vertexCount );
+        ArrayList<U32> usedVertices;
+        ArrayList<ArrayList<U32>> subMeshIndices( mesh->getSubMeshCount() );
+        for (auto& tri : triangles)
+        {
+            if (tri.removed)
+                continue;
+
+            for (I32 k = 0; k < 3; k++)
+            {
+                if (newIndexOf[tri.v[k]] == vertexCount)
+                {
+                    newIndexOf[tri.v[k]] = static_cast<U32>( usedVertices.size() );
+                    usedVertices.push_back( tri.v[k] );
+                }
+                subMeshIndices[tri.subMesh].push_back( newIndexOf[tri.v[k]] );
+            }
+        }
+
+        auto simplifiedMesh = RESOURCES.createMesh();
+        CopyVertexStream<Math::Vec3>( mesh, simplifiedMesh, Graphics::SID_VERTEX_POSITION, usedVertices );
+        CopyVertexStream<Math::Vec4>( mesh, simplifiedMesh, Graphics::SID_VERTEX_COLOR, usedVertices );
+        CopyVertexStream<Math::Vec2>( mesh, simplifiedMesh, Graphics::SID_VERTEX_UV, usedVertices );
+        CopyVertexStream<Math::Vec3>( mesh, simplifiedMesh, Graphics::SID_VERTEX_NORMAL, usedVertices );
+        CopyVertexStream<Math::Vec4>( mesh, simplifiedMesh, Graphics::SID_VERTEX_TANGENT, usedVertices );
+        CopyVertexStream<Math::Vec4Int>( mesh, simplifiedMesh, Graphics::SID_VERTEX_BONEID, usedVertices );
+        CopyVertexStream<Math::Vec4>( mesh, simplifiedMesh, Graphics::SID_VERTEX_BONEWEIGHT, usedVertices );
+
+        // Keep the bounds of the source mesh, so renderer using different lods are culled equally
+        simplifiedMesh->setBounds( mesh->getBounds() );
+
+        for (U32 i = 0; i < subMeshIndices.size(); i++)
+            simplifiedMesh->setIndices( subMeshIndices[i], i );
+
+        return simplifiedMesh;
+    }
+
 } // End namespaces
\ No newline at end of file
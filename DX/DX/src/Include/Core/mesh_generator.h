@@ -87,6 +87,20 @@ namespace Core {
         static MeshPtr CreateFrustum(const Math::Vec3& pos, F32 left, F32 right, F32 bottom, F32 top, F32 zNear, F32 zFar, Color color = Color::WHITE);
         static MeshPtr CreateFrustum(const Math::Vec3& pos, const Math::Vec3& forward, const Math::Vec3& up, F32 left, F32 right, F32 bottom, F32 top, F32 zNear, F32 zFar, Color color = Color::WHITE);
 
+        //----------------------------------------------------------------------
+        // Generates a simplified version of the given mesh by collapsing edges
+        // ordered by their quadric error (Garland & Heckbert). All vertex streams
+        // and submeshes are preserved. Vertices on attribute seams (e.g. uv or normal
+        // seams) are only collapsed along their seam, so the seam stays closed.
+        // @Params:
+        //  "mesh": The source mesh. All submeshes must be triangle lists.
+        //  "targetRatio": Amount of triangles the new mesh should have relative to the source mesh [0-1].
+        //  "maxError": Stops simplifying once the cheapest collapse would exceed this error.
+        // @Return:
+        //  A new mesh. The source mesh if it can't be simplified.
+        //----------------------------------------------------------------------
+        static MeshPtr CreateSimplified(const MeshPtr& mesh, F32 targetRatio, F32 maxError = std::numeric_limits<F32>::max());
+
     private:
         MeshGenerator() = delete;
     };
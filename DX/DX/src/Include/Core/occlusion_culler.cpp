@@ -0,0 +1,341 @@
+#include "occlusion_culler.h"
+/**********************************************************************
+    class: OcclusionCuller (occlusion_culler.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "OS/PlatformTimer/platform_timer.h"
+#include <emmintrin.h>
+
+namespace Core {
+
+    //----------------------------------------------------------------------
+    OcclusionCuller::OcclusionCuller( U32 width, U32 height, U32 numJobs )
+        : m_numJobs( std::max( numJobs, 1u ) ), m_viewProjection( DirectX::XMMatrixIdentity() )
+    {
+        setResolution( width, height );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::setResolution( U32 width, U32 height )
+    {
+        ASSERT( (width % TILE_SIZE == 0) && (height % TILE_SIZE == 0) && "Resolution must be a multiple of the tile size." );
+        m_width  = width;
+        m_height = height;
+        m_depth.assign( m_width * m_height, 1.0f );
+        m_tileMaxDepth.assign( (m_width / TILE_SIZE) * (m_height / TILE_SIZE), 1.0f );
+    }
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::beginFrame( const DirectX::XMMATRIX& viewProjection )
+    {
+        m_viewProjection = viewProjection;
+        m_triangles.clear();
+        m_stats = {};
+    }
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::addOccluder( const ArrayList<Math::Vec3>& positions, const ArrayList<U32>& indices, U32 indexCount, U32 baseVertex, const DirectX::XMMATRIX& modelMatrix )
+    {
+        auto mvp = DirectX::XMMatrixMultiply( modelMatrix, m_viewProjection );
+
+        ASSERT( indexCount <= indices.size() );
+        for (U32 i = 0; i + 2 < indexCount; i += 3)
+        {
+            auto v0 = DirectX::XMVector3Transform( DirectX::XMLoadFloat3( &positions[baseVertex + indices[i]] ), mvp );
+            auto v1 = DirectX::XMVector3Transform( DirectX::XMLoadFloat3( &positions[baseVertex + indices[i + 1]] ), mvp );
+            auto v2 = DirectX::XMVector3Transform( DirectX::XMLoadFloat3( &positions[baseVertex + indices[i + 2]] ), mvp );
+            _AddClipSpaceTriangle( v0, v1, v2 );
+        }
+
+        m_stats.numOccluders++;
+    }
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::addOccluder( const Math::AABB& box, const DirectX::XMMATRIX& modelMatrix )
+    {
+        static const U32 boxIndices[] = {
+            0, 2, 4,  0, 4, 1,  // -Z
+            3, 6, 7,  3, 7, 5,  // +Z
+            0, 3, 5,  0, 5, 2,  // -X
+            1, 4, 7,  1, 7, 6,  // +X
+            0, 1, 6,  0, 6, 3,  // -Y
+            2, 5, 7,  2, 7, 4   // +Y
+        };
+
+        auto mvp = DirectX::XMMatrixMultiply( modelMatrix, m_viewProjection );
+        auto corners = box.getCorners();
+
+        std::array<DirectX::XMVECTOR, 8> cornersClipSpace;
+        for (I32 i = 0; i < cornersClipSpace.size(); i++)
+            cornersClipSpace[i] = DirectX::XMVector3Transform( DirectX::XMLoadFloat3( &corners[i] ), mvp );
+
+        for (I32 i = 0; i < _countof( boxIndices ); i += 3)
+            _AddClipSpaceTriangle( cornersClipSpace[boxIndices[i]], cornersClipSpace[boxIndices[i + 1]], cornersClipSpace[boxIndices[i + 2]] );
+
+        m_stats.numOccluders++;
+    }
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::rasterize()
+    {
+        U64 beginTicks = OS::PlatformTimer::getTicks();
+
+        std::fill( m_depth.begin(), m_depth.end(), 1.0f );
+
+        // Split the tile rows into bands. Bands do not overlap, so no synchronization is required.
+        U32 numTileRows = m_height / TILE_SIZE;
+        U32 numJobs = std::min( m_numJobs, numTileRows );
+        U32 tileRowsPerJob = (numTileRows + numJobs - 1) / numJobs;
+
+        if (numJobs == 1)
+        {
+            _RasterizeBand( 0, numTileRows );
+        }
+        else
+        {
+            ArrayList<OS::JobPtr> jobs;
+            for (U32 begin = 0; begin < numTileRows; begin += tileRowsPerJob)
+            {
+                U32 end = std::min( begin + tileRowsPerJob, numTileRows );
+                jobs.push_back( ASYNC_JOB( [this, begin, end] { _RasterizeBand( begin, end ); } ) );
+            }
+            for (auto& job : jobs)
+                job->wait();
+        }
+
+        m_stats.numOccluderTriangles = static_cast<U32>( m_triangles.size() );
+        m_stats.rasterizeTimeMs = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+    }
+
+    //----------------------------------------------------------------------
+    bool OcclusionCuller::isVisible( const Math::AABB& worldBounds )
+    {
+        U64 beginTicks = OS::PlatformTimer::getTicks();
+        m_stats.numTested++;
+
+        auto isVisibleInternal = [&]() -> bool {
+            auto corners = worldBounds.getCorners();
+
+            F32 minX = std::numeric_limits<F32>::max(), maxX = -std::numeric_limits<F32>::max();
+            F32 minY = std::numeric_limits<F32>::max(), maxY = -std::numeric_limits<F32>::max();
+            F32 minZ = std::numeric_limits<F32>::max();
+            for (auto& corner : corners)
+            {
+                Math::Vec4 clip;
+                DirectX::XMStoreFloat4( &clip, DirectX::XMVector3Transform( DirectX::XMLoadFloat3( &corner ), m_viewProjection ) );
+
+                // Bounds intersect the near plane, can't say anything about them
+                if (clip.w <= 1e-5f || clip.z < 0.0f)
+                    return true;
+
+                F32 invW = 1.0f / clip.w;
+                F32 x = ( clip.x * invW * 0.5f + 0.5f) * m_width;
+                F32 y = (-clip.y * invW * 0.5f + 0.5f) * m_height;
+                minX = std::min( minX, x ); maxX = std::max( maxX, x );
+                minY = std::min( minY, y ); maxY = std::max( maxY, y );
+                minZ = std::min( minZ, clip.z * invW );
+            }
+
+            // Pixel rect which is touched by the bounds
+            I32 x0 = std::max( static_cast<I32>( std::floor( minX ) ), 0 );
+            I32 y0 = std::max( static_cast<I32>( std::floor( minY ) ), 0 );
+            I32 x1 = std::min( static_cast<I32>( std::ceil( maxX ) ), (I32)m_width - 1 );
+            I32 y1 = std::min( static_cast<I32>( std::ceil( maxY ) ), (I32)m_height - 1 );
+            if (x0 > x1 || y0 > y1)
+                return true; // Offscreen, frustum culling is responsible for this
+
+            U32 tilesPerRow = m_width / TILE_SIZE;
+            for (I32 ty = y0 / TILE_SIZE; ty <= y1 / TILE_SIZE; ++ty)
+            {
+                for (I32 tx = x0 / TILE_SIZE; tx <= x1 / TILE_SIZE; ++tx)
+                {
+                    // Everything in this tile is nearer than the bounds
+                    if (minZ > m_tileMaxDepth[ty * tilesPerRow + tx])
+                        continue;
+
+                    I32 px0 = std::max( x0, tx * (I32)TILE_SIZE ), px1 = std::min( x1, tx * (I32)TILE_SIZE + (I32)TILE_SIZE - 1 );
+                    I32 py0 = std::max( y0, ty * (I32)TILE_SIZE ), py1 = std::min( y1, ty * (I32)TILE_SIZE + (I32)TILE_SIZE - 1 );
+                    for (I32 py = py0; py <= py1; ++py)
+                        for (I32 px = px0; px <= px1; ++px)
+                            if (m_depth[py * m_width + px] >= minZ)
+                                return true;
+                }
+            }
+
+            return false;
+        };
+
+        bool visible = isVisibleInternal();
+        if ( not visible )
+            m_stats.numCulled++;
+
+        m_stats.testTimeMs += OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - beginTicks );
+        return visible;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::_AddClipSpaceTriangle( const DirectX::XMVECTOR& v0, const DirectX::XMVECTOR& v1, const DirectX::XMVECTOR& v2 )
+    {
+        // Clip against the near plane (z >= 0), which produces a polygon with up to 4 vertices
+        Math::Vec4 in[3];
+        DirectX::XMStoreFloat4( &in[0], v0 );
+        DirectX::XMStoreFloat4( &in[1], v1 );
+        DirectX::XMStoreFloat4( &in[2], v2 );
+
+        Math::Vec4 out[4];
+        I32 outCount = 0;
+        for (I32 i = 0; i < 3; ++i)
+        {
+            const Math::Vec4& a = in[i];
+            const Math::Vec4& b = in[(i + 1) % 3];
+            bool aInside = a.z >= 0.0f;
+            bool bInside = b.z >= 0.0f;
+
+            if (aInside)
+                out[outCount++] = a;
+
+            if (aInside != bInside)
+            {
+                F32 t = a.z / (a.z - b.z);
+                out[outCount++] = Math::Vec4( a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, 0.0f, a.w + (b.w - a.w) * t );
+            }
+        }
+
+        if (outCount < 3)
+            return;
+
+        // Perspective divide + viewport transform
+        F32 sx[4], sy[4], sz[4];
+        for (I32 i = 0; i < outCount; ++i)
+        {
+            if (out[i].w <= 1e-5f)
+                return;
+
+            F32 invW = 1.0f / out[i].w;
+            sx[i] = ( out[i].x * invW * 0.5f + 0.5f) * m_width;
+            sy[i] = (-out[i].y * invW * 0.5f + 0.5f) * m_height;
+            sz[i] = out[i].z * invW;
+        }
+
+        // Triangulate as a fan
+        for (I32 i = 1; i + 1 < outCount; ++i)
+        {
+            Triangle tri;
+            tri.x[0] = sx[0]; tri.y[0] = sy[0]; tri.z[0] = sz[0];
+            tri.x[1] = sx[i]; tri.y[1] = sy[i]; tri.z[1] = sz[i];
+            tri.x[2] = sx[i + 1]; tri.y[2] = sy[i + 1]; tri.z[2] = sz[i + 1];
+            m_triangles.push_back( tri );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::_RasterizeBand( U32 tileRowBegin, U32 tileRowEnd )
+    {
+        I32 rowBegin = tileRowBegin * TILE_SIZE;
+        I32 rowEnd   = tileRowEnd * TILE_SIZE;
+
+        for (auto& tri : m_triangles)
+            _RasterizeTriangle( tri, rowBegin, rowEnd );
+
+        // Store the farthest depth of every tile in this band
+        U32 tilesPerRow = m_width / TILE_SIZE;
+        for (U32 ty = tileRowBegin; ty < tileRowEnd; ++ty)
+        {
+            for (U32 tx = 0; tx < tilesPerRow; ++tx)
+            {
+                __m128 maxDepth = _mm_setzero_ps();
+                for (U32 y = ty * TILE_SIZE; y < (ty + 1) * TILE_SIZE; ++y)
+                {
+                    const F32* row = &m_depth[y * m_width + tx * TILE_SIZE];
+                    maxDepth = _mm_max_ps( maxDepth, _mm_loadu_ps( row ) );
+                    maxDepth = _mm_max_ps( maxDepth, _mm_loadu_ps( row + 4 ) );
+                }
+                alignas(16) F32 lanes[4];
+                _mm_store_ps( lanes, maxDepth );
+                m_tileMaxDepth[ty * tilesPerRow + tx] = std::max( std::max( lanes[0], lanes[1] ), std::max( lanes[2], lanes[3] ) );
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void OcclusionCuller::_RasterizeTriangle( const Triangle& tri, I32 rowBegin, I32 rowEnd )
+    {
+        F32 x0 = tri.x[0], y0 = tri.y[0], z0 = tri.z[0];
+        F32 x1 = tri.x[1], y1 = tri.y[1], z1 = tri.z[1];
+        F32 x2 = tri.x[2], y2 = tri.y[2], z2 = tri.z[2];
+
+        // Both windings are rasterized, so make it counter clockwise
+        F32 area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+        if (area == 0.0f)
+            return;
+        if (area < 0.0f)
+        {
+            std::swap( x1, x2 ); std::swap( y1, y2 ); std::swap( z1, z2 );
+            area = -area;
+        }
+
+        // Bounding rect clipped to the screen and this band. Columns are aligned to the simd width.
+        I32 minX = std::max( static_cast<I32>( std::floor( std::min( { x0, x1, x2 } ) ) ), 0 ) & ~3;
+        I32 maxX = std::min( static_cast<I32>( std::ceil( std::max( { x0, x1, x2 } ) ) ), (I32)m_width - 1 );
+        I32 minY = std::max( static_cast<I32>( std::floor( std::min( { y0, y1, y2 } ) ) ), rowBegin );
+        I32 maxY = std::min( static_cast<I32>( std::ceil( std::max( { y0, y1, y2 } ) ) ), rowEnd - 1 );
+        if (minX > maxX || minY > maxY)
+            return;
+
+        // Edge functions E(x,y) = a*x + b*y + c, positive inside
+        F32 a0 = y0 - y1, b0 = x1 - x0, c0 = (y1 - y0) * x0 - (x1 - x0) * y0;
+        F32 a1 = y1 - y2, b1 = x2 - x1, c1 = (y2 - y1) * x1 - (x2 - x1) * y1;
+        F32 a2 = y2 - y0, b2 = x0 - x2, c2 = (y0 - y2) * x2 - (x0 - x2) * y2;
+
+        // Depth plane z(x,y) = z0 + dzdx * (x - x0) + dzdy * (y - y0)
+        F32 invArea = 1.0f / area;
+        F32 dzdx = ((z1 - z0) * (y2 - y0) - (y1 - y0) * (z2 - z0)) * invArea;
+        F32 dzdy = ((x1 - x0) * (z2 - z0) - (z1 - z0) * (x2 - x0)) * invArea;
+
+        const __m128 laneOffsets = _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f );
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 va0 = _mm_set1_ps( a0 ), va1 = _mm_set1_ps( a1 ), va2 = _mm_set1_ps( a2 );
+        const __m128 vdzdx = _mm_set1_ps( dzdx );
+
+        for (I32 y = minY; y <= maxY; ++y)
+        {
+            F32 py = y + 0.5f;
+            __m128 rowE0 = _mm_set1_ps( b0 * py + c0 );
+            __m128 rowE1 = _mm_set1_ps( b1 * py + c1 );
+            __m128 rowE2 = _mm_set1_ps( b2 * py + c2 );
+            __m128 rowZ  = _mm_set1_ps( z0 + dzdy * (py - y0) - dzdx * x0 );
+
+            F32* depthRow = &m_depth[y * m_width];
+            for (I32 x = minX; x <= maxX; x += 4)
+            {
+                __m128 px = _mm_add_ps( _mm_set1_ps( (F32)x ), laneOffsets );
+
+                __m128 e0 = _mm_add_ps( _mm_mul_ps( va0, px ), rowE0 );
+                __m128 e1 = _mm_add_ps( _mm_mul_ps( va1, px ), rowE1 );
+                __m128 e2 = _mm_add_ps( _mm_mul_ps( va2, px ), rowE2 );
+
+                __m128 inside = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( e0, zero ), _mm_cmpge_ps( e1, zero ) ), _mm_cmpge_ps( e2, zero ) );
+                if (_mm_movemask_ps( inside ) == 0)
+                    continue;
+
+                __m128 z = _mm_add_ps( _mm_mul_ps( vdzdx, px ), rowZ );
+                __m128 oldDepth = _mm_loadu_ps( depthRow + x );
+                __m128 newDepth = _mm_min_ps( oldDepth, z );
+                _mm_storeu_ps( depthRow + x, _mm_or_ps( _mm_and_ps( inside, newDepth ), _mm_andnot_ps( inside, oldDepth ) ) );
+            }
+        }
+    }
+
+}
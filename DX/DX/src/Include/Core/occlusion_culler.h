@@ -0,0 +1,124 @@
+#pragma once
+/**********************************************************************
+    class: OcclusionCuller (occlusion_culler.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Software occlusion culling on the cpu. Occluders (meshes or boxes)
+    are rasterized with SSE into a low resolution depth buffer, which
+    is split into horizontal bands processed by worker threads.
+    Afterwards the farthest depth per 8x8 tile is stored, so bounds
+    can be rejected against whole tiles before single pixels are tested.
+    The class does not depend on the renderer and can be used headless.
+    @Considerations:
+      - Bin triangles per band before rasterizing, so a band does not
+        have to iterate over all triangles.
+**********************************************************************/
+
+#include "Math/aabb.h"
+
+namespace Core {
+
+    //----------------------------------------------------------------------
+    struct OcclusionCullingStats
+    {
+        U32 numOccluders            = 0;
+        U32 numOccluderTriangles    = 0;
+        U32 numTested               = 0;
+        U32 numCulled               = 0;
+        F64 rasterizeTimeMs         = 0.0;
+        F64 testTimeMs              = 0.0;
+
+        OcclusionCullingStats& operator += (const OcclusionCullingStats& s)
+        {
+            numOccluders += s.numOccluders; numOccluderTriangles += s.numOccluderTriangles;
+            numTested += s.numTested; numCulled += s.numCulled;
+            rasterizeTimeMs += s.rasterizeTimeMs; testTimeMs += s.testTimeMs;
+            return *this;
+        }
+    };
+
+    //**********************************************************************
+    class OcclusionCuller
+    {
+    public:
+        static const U32 TILE_SIZE = 8;
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "width/height": Resolution of the depth buffer. Must be a multiple of the tile size.
+        //  "numJobs": Amount of jobs the depth buffer is split into. 1 rasterizes on the calling thread.
+        //----------------------------------------------------------------------
+        OcclusionCuller(U32 width = 256, U32 height = 128, U32 numJobs = 4);
+        ~OcclusionCuller() = default;
+
+        //----------------------------------------------------------------------
+        U32                             getWidth()  const { return m_width; }
+        U32                             getHeight() const { return m_height; }
+        const OcclusionCullingStats&    getStats()  const { return m_stats; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Depth in [0-1] at the given pixel after rasterize() was called. 1 means nothing was drawn.
+        //----------------------------------------------------------------------
+        F32 getDepth(U32 x, U32 y) const { return m_depth[y * m_width + x]; }
+
+        //----------------------------------------------------------------------
+        void setResolution(U32 width, U32 height);
+        void setJobCount(U32 numJobs) { m_numJobs = std::max( numJobs, 1u ); }
+
+        //----------------------------------------------------------------------
+        // Clears all occluders + stats and sets the view-projection used for all subsequent calls.
+        //----------------------------------------------------------------------
+        void beginFrame(const DirectX::XMMATRIX& viewProjection);
+
+        //----------------------------------------------------------------------
+        // Add a triangle list as an occluder.
+        // @Params:
+        //  "indexCount": Amount of indices used from the given index list.
+        //  "baseVertex": Offset added to every index.
+        //----------------------------------------------------------------------
+        void addOccluder(const ArrayList<Math::Vec3>& positions, const ArrayList<U32>& indices, U32 indexCount, U32 baseVertex, const DirectX::XMMATRIX& modelMatrix);
+
+        //----------------------------------------------------------------------
+        // Add a box as an occluder. The box must lie completely inside the geometry it represents.
+        //----------------------------------------------------------------------
+        void addOccluder(const Math::AABB& box, const DirectX::XMMATRIX& modelMatrix);
+
+        //----------------------------------------------------------------------
+        // Rasterizes all added occluders into the depth buffer. Blocks until all jobs are done.
+        //----------------------------------------------------------------------
+        void rasterize();
+
+        //----------------------------------------------------------------------
+        // Test the given world space bounds against the depth buffer.
+        // @Return:
+        //  False, if the bounds are completely hidden behind the occluders.
+        //----------------------------------------------------------------------
+        bool isVisible(const Math::AABB& worldBounds);
+
+    private:
+        struct Triangle
+        {
+            F32 x[3], y[3], z[3]; // Screen space position + depth
+        };
+
+        U32                     m_width;
+        U32                     m_height;
+        U32                     m_numJobs;
+        DirectX::XMMATRIX       m_viewProjection;
+        ArrayList<F32>          m_depth;
+        ArrayList<F32>          m_tileMaxDepth;
+        ArrayList<Triangle>     m_triangles;
+        OcclusionCullingStats   m_stats;
+
+        //----------------------------------------------------------------------
+        void _AddClipSpaceTriangle(const DirectX::XMVECTOR& v0, const DirectX::XMVECTOR& v1, const DirectX::XMVECTOR& v2);
+        void _RasterizeTriangle(const Triangle& tri, I32 rowBegin, I32 rowEnd);
+        void _RasterizeBand(U32 tileRowBegin, U32 tileRowEnd);
+
+        NULL_COPY_AND_ASSIGN(OcclusionCuller)
+    };
+
+}
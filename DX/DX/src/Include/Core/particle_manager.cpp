@@ -0,0 +1,80 @@
+#include "particle_manager.h"
+/**********************************************************************
+    class: ParticleManager (particle_manager.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "Graphics/camera.h"
+#include "GameplayLayer/Components/Rendering/particle_system.h"
+#include <atomic>
+
+namespace Core {
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ParticleManager::execute( const ArrayList<Components::ParticleSystem*>& particleSystems, const ArrayList<const Graphics::Camera*>& cameras )
+    {
+        m_stats = {};
+        m_stats.numSystems = static_cast<U32>( particleSystems.size() );
+
+        // Decide which systems are simulated and cache everything they read from other components on the calling thread
+        m_simulated.clear();
+        for (auto ps : particleSystems)
+        {
+            if ( not ps->isActive() || ps->m_paused )
+                continue;
+
+            // Bounds are from the last simulation. Camera matrices are from the last frame, which is sufficient here.
+            Math::AABB bounds;
+            bool isVisible = cameras.empty() || not ps->getWorldBounds( &bounds );
+            for (auto camera : cameras)
+                isVisible = isVisible || camera->cull( bounds );
+
+            if ( not ps->_UpdateVisibility( isVisible ) )
+            {
+                m_stats.numSkippedInvisible++;
+                continue;
+            }
+
+            ps->_PrepareSimulation();
+            m_simulated.push_back( ps );
+        }
+
+        // Largest systems first, so they don't end up as the last item of a job and stall the frame
+        std::sort( m_simulated.begin(), m_simulated.end(), [](auto ps1, auto ps2) { return ps1->getMaxParticleCount() > ps2->getMaxParticleCount(); } );
+
+        U32 numSystems = static_cast<U32>( m_simulated.size() );
+        U32 numJobs = std::min( m_numJobs, numSystems );
+        if (numJobs <= 1)
+        {
+            for (auto ps : m_simulated)
+                ps->_Simulate();
+        }
+        else
+        {
+            // Each job takes the next system until all are done. Systems only write to themselves, so no other synchronization is required.
+            std::atomic<U32> nextSystem{ 0 };
+            ArrayList<OS::JobPtr> jobs;
+            for (U32 i = 0; i < numJobs; i++)
+            {
+                jobs.push_back( ASYNC_JOB( [this, &nextSystem, numSystems] {
+                    for (U32 index = nextSystem++; index < numSystems; index = nextSystem++)
+                        m_simulated[index]->_Simulate();
+                } ) );
+            }
+            for (auto& job : jobs)
+                job->wait();
+        }
+
+        m_stats.numSimulated = numSystems;
+        for (auto ps : m_simulated)
+            m_stats.numParticles += ps->getCurrentParticleCount();
+    }
+
+}
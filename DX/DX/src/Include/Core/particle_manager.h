@@ -0,0 +1,59 @@
+#pragma once
+/**********************************************************************
+    class: ParticleManager (particle_manager.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Simulates all particle systems of a scene once per frame in parallel
+    jobs, including the rebuild of their vertex streams. Each particle
+    system draws its random numbers from an own stream, so the result
+    does not depend on which job updated it. Particle systems which are
+    not visible by any camera are skipped, see ParticleSystem::CullingMode.
+**********************************************************************/
+
+namespace Graphics { class Camera; }
+namespace Components { class ParticleSystem; }
+
+namespace Core {
+
+    //----------------------------------------------------------------------
+    struct ParticleStats
+    {
+        U32 numSystems          = 0;
+        U32 numSimulated        = 0;
+        U32 numSkippedInvisible = 0;
+        U32 numParticles        = 0; // Alive particles of all simulated systems
+    };
+
+    //**********************************************************************
+    class ParticleManager
+    {
+    public:
+        static ParticleManager& Instance()
+        {
+            static ParticleManager pm;
+            return pm;
+        }
+
+        //----------------------------------------------------------------------
+        // Simulates the given particle systems as seen from the given cameras.
+        //----------------------------------------------------------------------
+        void execute(const ArrayList<Components::ParticleSystem*>& particleSystems, const ArrayList<const Graphics::Camera*>& cameras);
+
+        //----------------------------------------------------------------------
+        void setJobCount(U32 numJobs) { m_numJobs = std::max( numJobs, 1u ); }
+
+        //----------------------------------------------------------------------
+        const ParticleStats& getStats() const { return m_stats; }
+
+    private:
+        U32                                     m_numJobs = 4;
+        ParticleStats                           m_stats;
+        ArrayList<Components::ParticleSystem*>  m_simulated;
+
+        ParticleManager() = default;
+        NULL_COPY_AND_ASSIGN(ParticleManager)
+    };
+
+}
@@ -7,6 +7,9 @@
 **********************************************************************/
 
 #include "Core/locator.h"
+#include "Core/animation_system.h"
+#include "Core/particle_manager.h"
+#include "Core/texture_streamer.h"
 #include "GameplayLayer/i_scene.h"
 #include "GameplayLayer/Components/Rendering/camera.h"
 #include "GameplayLayer/gameobject.h"
@@ -16,6 +19,24 @@
 
 namespace Core {
 
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Size of one world unit on the screen in pixels at the point of the given bounds nearest to the camera.
+    //----------------------------------------------------------------------
+    static F32 PixelsPerUnit( const Graphics::Camera& camera, const Math::Vec3& camWorldPos, F32 viewportHeight, const Math::AABB& bounds )
+    {
+        // The projection stores 1/tan(fov/2) (perspective) or 2/height (orthographic)
+        auto& projection = camera.getProjectionMatrix();
+        F32 pixelsPerUnit = DirectX::XMVectorGetY( projection.r[1] ) * 0.5f * viewportHeight;
+
+        bool isPerspective = DirectX::XMVectorGetW( projection.r[2] ) != 0.0f;
+        if ( not isPerspective )
+            return pixelsPerUnit;
+
+        Math::Vec3 nearest = camWorldPos.maxVec( bounds.getMin() ).minVec( bounds.getMax() );
+        return pixelsPerUnit / std::max( camWorldPos.distance( nearest ), camera.getZNear() );
+    }
+
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
@@ -29,8 +50,35 @@ namespace Core {
         // a shadowmap rendered from a light multiple times (because more than one camera renders the same light)
         std::unordered_set<Components::ILightComponent*> shadowMapsRendered;
 
-        // Render each camera
+        m_occlusionCullingStats = {};
+
+        // Update world matrices of the whole scene at once, so all reads below hit the caches
         auto& scene = Locator::getSceneManager().getCurrentScene();
+        scene.getComponentManager().getTransformHierarchy().update();
+
+        // Update skinned poses and particles. Cameras still have their matrices from the last frame.
+        ArrayList<const Graphics::Camera*> activeCameras;
+        for (auto& cam : scene.getComponentManager().getCameras())
+            if ( cam->isActive() )
+                activeCameras.push_back( &cam->m_camera );
+        AnimationSystem::Instance().execute( scene.getComponentManager().getSkinnedMeshRenderer(), activeCameras );
+        ParticleManager::Instance().execute( scene.getComponentManager().getParticleSystems(), activeCameras );
+
+        // Refit bounds of all components which moved since the last frame
+        auto& spatialIndex = scene.getComponentManager().getSpatialIndex();
+        spatialIndex.update();
+
+        // Mips of streamed textures are requested by every renderer which is drawn
+        auto& textureStreamer = TextureStreamer::Instance();
+        bool streamTextures = textureStreamer.hasTextures();
+
+        // Reused across cameras to avoid allocations every frame
+        ArrayList<Components::ILightComponent*>  lightCandidates;
+        ArrayList<Components::IRenderComponent*> rendererCandidates;
+        ArrayList<Components::IRenderComponent*> visibleRenderer;
+        ArrayList<std::pair<F32, Components::ILightComponent*>> lightDistances;
+
+        // Render each camera
         for (auto& cam : scene.getComponentManager().getCameras())
         {
             if ( not cam->isActive() )
@@ -47,11 +95,22 @@ namespace Core {
             Graphics::CommandBuffer cmd;
             cmd.setCamera( cam->m_camera );
 
+            // Shadowmaps rendered by this camera are accounted to it
+            auto& frameInfo = cam->m_camera.getFrameInfo();
+            frameInfo.numShadowCasters       = 0;
+            frameInfo.numShadowCastersCulled = 0;
+            frameInfo.numShadowPassesRendered = 0;
+            frameInfo.numShadowPassesCached   = 0;
+
             // Lights
             {
+                // Fetch all lights which might be visible from the spatial index
+                lightCandidates.clear();
+                spatialIndex.queryLights( cam->m_camera, lightCandidates );
+
                 // Record commands for every light component
                 ArrayList<Components::ILightComponent*> visibleLights;
-                for ( auto& light : scene.getComponentManager().getLights() )
+                for ( auto& light : lightCandidates )
                 {
                     if ( not light->isActive() )
                         continue;
@@ -67,15 +126,24 @@ namespace Core {
                         visibleLights.push_back( light );
                 }
 
-                // Sort lights by distance, so lights nearest to camera will be drawn first (or even not culled due to light limit)
-                std::sort( visibleLights.begin(), visibleLights.end(), [camWorldPos](Components::ILightComponent*& l1, Components::ILightComponent*& l2) {
-                    auto pos = l1->getGameObject()->getTransform()->getWorldPosition();
-                    auto pos2 = l2->getGameObject()->getTransform()->getWorldPosition();
-                    return camWorldPos.distance( pos ) < camWorldPos.distance( pos2 );
-                } );
+                // Sort lights by distance, so lights nearest to camera will be drawn first (or even not culled due to light limit).
+                // The distances are computed once up front instead of in every comparison.
+                lightDistances.clear();
+                for (auto& light : visibleLights)
+                    lightDistances.push_back( { camWorldPos.distanceSqrt( light->getGameObject()->getTransform()->getWorldPosition() ), light } );
+                std::sort( lightDistances.begin(), lightDistances.end(), [](const auto& l1, const auto& l2) { return l1.first < l2.first; } );
+                for (I32 i = 0; i < visibleLights.size(); i++)
+                    visibleLights[i] = lightDistances[i].second;
+
+                // The indices in the clusters refer to the light buffer of the renderer, so lights above its limit are dropped beforehand
+                if (visibleLights.size() > renderer.getLimits().maxLights)
+                    visibleLights.resize( renderer.getLimits().maxLights );
+
+                // Assign the lights to the clusters of this camera. Uploaded before the lights are drawn, which keeps the draw commands together.
+                cam->m_lightClusters.build( cam->m_camera, visibleLights );
+                cam->m_lightClusters.upload( cmd );
 
                 // Record commands for a light
-                U32 lightsDrawn = 0;
                 for (auto& light : visibleLights)
                 {
                     // Draw light
@@ -89,18 +157,24 @@ namespace Core {
                         {
                             light->renderShadowMap( scene );
                             shadowMapsRendered.insert( light );
+
+                            auto& shadowStats = light->getShadowCasterStats();
+                            frameInfo.numShadowCasters       += shadowStats.numCasters;
+                            frameInfo.numShadowCastersCulled += shadowStats.numCulled;
+                            frameInfo.numShadowPassesRendered += shadowStats.numPassesRendered;
+                            frameInfo.numShadowPassesCached   += shadowStats.numPassesCached;
                         }
                     }
-
-                    lightsDrawn++;
-                    if (lightsDrawn == renderer.getLimits().maxLights)
-                        break;
                 }
             }
 
             // Rendering components (e.g. mesh-renderer)
             {
-                for ( auto& renderer : scene.getComponentManager().getRenderer() )
+                rendererCandidates.clear();
+                spatialIndex.queryRenderer( cam->m_camera, rendererCandidates );
+
+                visibleRenderer.clear();
+                for ( auto& renderer : rendererCandidates )
                 {
                     if ( not renderer->isActive() )
                         continue;
@@ -113,8 +187,52 @@ namespace Core {
                     // Check if component is visible
                     bool isVisible = renderer->cull( cam->m_camera );
                     if (isVisible)
-                        renderer->recordGraphicsCommands( cmd );
+                        visibleRenderer.push_back( renderer );
+                }
+
+                // Rasterize all visible occluders into the occlusion buffer
+                if (m_occlusionCullingEnabled)
+                {
+                    m_occlusionCuller.beginFrame( cam->m_camera.getViewProjectionMatrix() );
+                    for ( auto& renderer : visibleRenderer )
+                    {
+                        switch ( renderer->getOccluderMode() )
+                        {
+                        case Components::OccluderMode::Mesh:
+                            renderer->addMeshOccluder( m_occlusionCuller );
+                            break;
+                        case Components::OccluderMode::Box:
+                            m_occlusionCuller.addOccluder( renderer->getOccluderBox(), renderer->getGameObject()->getTransform()->getWorldMatrix() );
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                    m_occlusionCuller.rasterize();
                 }
+
+                auto& camera = cam->m_camera;
+                F32 viewportHeight = camera.getRenderTarget()->getHeight() * camera.getViewport().height;
+                for ( auto& renderer : visibleRenderer )
+                {
+                    Math::AABB bounds;
+                    bool hasBounds = (m_occlusionCullingEnabled || streamTextures) && renderer->getWorldBounds( &bounds );
+
+                    // Occluders can't be hidden by themselves, so they are never tested
+                    if ( m_occlusionCullingEnabled && renderer->getOccluderMode() == Components::OccluderMode::None )
+                    {
+                        if ( hasBounds && not m_occlusionCuller.isVisible( bounds ) )
+                            continue;
+                    }
+
+                    if ( streamTextures && hasBounds )
+                        renderer->requestTextureMips( PixelsPerUnit( camera, camWorldPos, viewportHeight, bounds ) );
+
+                    renderer->recordGraphicsCommands( cmd );
+                }
+
+                if (m_occlusionCullingEnabled)
+                    m_occlusionCullingStats += m_occlusionCuller.getStats();
             }
 
             // Merge all geometry commands
@@ -145,6 +263,9 @@ namespace Core {
             // Submit command buffer to render engine
             renderer.dispatch( cmd );
         }
+
+        // Mips requested by all cameras are fitted into the budget and streamed
+        textureStreamer.update();
     }
 
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
     date: June 30, 2018
 **********************************************************************/
 
+#include "occlusion_culler.h"
+
 namespace Core {
 
     //**********************************************************************
@@ -20,7 +22,24 @@ namespace Core {
 
         void execute();
 
+        //----------------------------------------------------------------------
+        // Enables the software occlusion culling. Only renderer marked as an occluder
+        // (see IRenderComponent::setOccluder()) will hide other renderer.
+        //----------------------------------------------------------------------
+        void setOcclusionCulling(bool enabled)  { m_occlusionCullingEnabled = enabled; }
+        bool isOcclusionCullingEnabled() const  { return m_occlusionCullingEnabled; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Occlusion culling stats of all cameras from the last frame.
+        //----------------------------------------------------------------------
+        const OcclusionCullingStats& getOcclusionCullingStats() const { return m_occlusionCullingStats; }
+
     private:
+        OcclusionCuller         m_occlusionCuller;
+        bool                    m_occlusionCullingEnabled = false;
+        OcclusionCullingStats   m_occlusionCullingStats;
+
         RenderSystem() = default;
         NULL_COPY_AND_ASSIGN(RenderSystem)
     };
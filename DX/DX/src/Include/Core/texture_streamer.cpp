@@ -0,0 +1,295 @@
+#include "texture_streamer.h"
+/**********************************************************************
+    class: TextureStreamer (texture_streamer.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Core/locator.h"
+#include "Assets/texture_cache.h"
+#include <queue>
+
+namespace Core {
+
+    // Limits the memory of mips in flight and the uploads per frame
+    static constexpr U32 MAX_PENDING_REQUESTS = 8;
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void TextureStreamer::add( const Texture2DPtr& texture, const OS::Path& sourcePath )
+    {
+        if ( texture->getResidentMip() == 0 )
+            return;
+
+        StreamedTexture tex;
+        tex.texture     = texture;
+        tex.sourcePath  = sourcePath;
+        tex.width       = texture->getWidth();
+        tex.height      = texture->getHeight();
+        tex.format      = texture->getFormat();
+        tex.lowestMip   = texture->getResidentMip();
+        tex.residentMip = texture->getResidentMip();
+
+        U32 mipCount = texture->getMipCount();
+        tex.sizes.resize( mipCount );
+        Size size = 0;
+        for (I32 mip = mipCount - 1; mip >= 0; mip--)
+        {
+            size += Graphics::ImageSizeFromTextureFormat( tex.format, std::max( 1u, tex.width >> mip ), std::max( 1u, tex.height >> mip ) );
+            tex.sizes[mip] = size;
+        }
+
+        std::lock_guard<std::mutex> lock( m_addMutex );
+        m_added.push_back( { texture.get(), std::move( tex ) } );
+    }
+
+    //----------------------------------------------------------------------
+    void TextureStreamer::requestMips( const MeshPtr& mesh, const ArrayList<MaterialPtr>& materials, const DirectX::XMMATRIX& modelMatrix, F32 pixelsPerUnit )
+    {
+        if ( m_textures.empty() || pixelsPerUnit <= 0.0f )
+            return;
+
+        // Largest scale of the model matrix, so the density is never underestimated
+        F32 scale = 0.0f;
+        for (I32 i = 0; i < 3; i++)
+            scale = std::max( scale, DirectX::XMVectorGetX( DirectX::XMVector3Length( modelMatrix.r[i] ) ) );
+
+        U32 subMeshCount = std::min( static_cast<U32>( mesh->getSubMeshCount() ), static_cast<U32>( materials.size() ) );
+        for (U32 i = 0; i < subMeshCount; i++)
+        {
+            // Pixels covered by one unit in uv space
+            F32 pixelsPerUV = mesh->getUVDistributionMetric( i ) * scale * pixelsPerUnit;
+            if (pixelsPerUV <= 0.0f || materials[i] == nullptr)
+                continue;
+
+            for (auto& [name, texture] : materials[i]->getTextures())
+            {
+                auto it = m_textures.find( texture.get() );
+                if ( it == m_textures.end() )
+                    continue;
+
+                // Each mip halves the texels per pixel, the largest mip with at most one texel per pixel is sufficient
+                auto& tex = it->second;
+                F32 texelsPerPixel = std::max( tex.width, tex.height ) / pixelsPerUV;
+                U32 mip = texelsPerPixel > 1.0f ? static_cast<U32>( std::log2( texelsPerPixel ) ) : 0;
+                mip = std::min( mip, tex.lowestMip );
+                while ( mip > 0 && not Graphics::CanBeLargestMip( tex.format, tex.width, tex.height, mip ) )
+                    mip--;
+
+                if (tex.lastSeenFrame != m_frame)
+                {
+                    tex.lastSeenFrame = m_frame;
+                    tex.requestedMip  = mip;
+                }
+                else
+                {
+                    tex.requestedMip = std::min( tex.requestedMip, mip );
+                }
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void TextureStreamer::update()
+    {
+        m_stats = {};
+        m_stats.budgetBytes = m_budget;
+
+        {
+            std::lock_guard<std::mutex> lock( m_addMutex );
+            for (auto& [key, tex] : m_added)
+            {
+                tex.id = m_nextID++;
+                m_textures[key] = std::move( tex );
+            }
+            m_added.clear();
+        }
+
+        _UploadFinishedReads();
+
+        // Textures keep their resident mips if they are not wanted anymore, as long as the budget allows it
+        Size totalBytes = 0;
+        for (auto it = m_textures.begin(); it != m_textures.end();)
+        {
+            auto& tex = it->second;
+            if ( tex.texture.expired() )
+            {
+                it = m_textures.erase( it );
+                continue;
+            }
+
+            if (tex.lastSeenFrame == m_frame)
+                tex.wantedMip = tex.requestedMip;
+            tex.targetMip = tex.failed ? tex.residentMip : std::min( tex.residentMip, tex.wantedMip );
+
+            totalBytes += tex.sizes[tex.targetMip];
+            m_stats.wantedBytes += tex.sizes[tex.wantedMip];
+            it++;
+        }
+
+        if (totalBytes > m_budget)
+            _FitIntoBudget( totalBytes );
+
+        _IssueReads();
+
+        for (auto& [key, tex] : m_textures)
+        {
+            m_stats.residentBytes += tex.sizes[tex.residentMip];
+            if (tex.residentMip == 0)
+                m_stats.numFullyResident++;
+        }
+        m_stats.numTextures         = static_cast<U32>( m_textures.size() );
+        m_stats.numPendingRequests  = m_pendingRequests;
+
+        m_frame++;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void TextureStreamer::_UploadFinishedReads()
+    {
+        ArrayList<MipRead> reads;
+        {
+            std::lock_guard<std::mutex> lock( m_finishedReads->mutex );
+            reads.swap( m_finishedReads->reads );
+        }
+
+        for (auto& read : reads)
+        {
+            m_pendingRequests--;
+
+            // The texture might have been destroyed in the meantime and another one created at the same address
+            auto it = m_textures.find( read.key );
+            if ( it == m_textures.end() || it->second.id != read.id )
+                continue;
+
+            auto& tex = it->second;
+            tex.pendingMip = NO_MIP;
+
+            auto texture = tex.texture.lock();
+            if ( not texture )
+                continue;
+
+            if ( read.mips.empty() )
+            {
+                LOG_WARN( "TextureStreamer: Could not read mips of '" + tex.sourcePath.toString() + "' from the texture cache. It won't be streamed anymore." );
+                tex.failed = true;
+                continue;
+            }
+
+            ArrayList<const void*> mips;
+            for (auto& mip : read.mips)
+                mips.push_back( mip.data() );
+            texture->setResidentMips( read.firstMip, mips );
+
+            if (read.firstMip < tex.residentMip)
+                m_stats.numStreamedIn++;
+            else
+                m_stats.numEvicted++;
+            tex.residentMip = read.firstMip;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void TextureStreamer::_FitIntoBudget( Size totalBytes )
+    {
+        auto reduce = [&](StreamedTexture& tex, U32 mip) {
+            totalBytes -= tex.sizes[tex.targetMip] - tex.sizes[mip];
+            tex.targetMip = mip;
+        };
+
+        // Least recently seen textures first
+        ArrayList<StreamedTexture*> textures;
+        for (auto& [key, tex] : m_textures)
+            textures.push_back( &tex );
+        std::sort( textures.begin(), textures.end(), [](auto a, auto b) { return a->lastSeenFrame < b->lastSeenFrame; } );
+
+        // 1. Drop mips which are resident, but not wanted anymore
+        for (auto tex : textures)
+        {
+            if (totalBytes <= m_budget)
+                return;
+            if (tex->targetMip < tex->wantedMip)
+                reduce( *tex, tex->wantedMip );
+        }
+
+        // 2. Drop all mips of textures which were not visible in this frame
+        for (auto tex : textures)
+        {
+            if (totalBytes <= m_budget)
+                return;
+            if (tex->lastSeenFrame != m_frame && not tex->failed)
+                reduce( *tex, tex->lowestMip );
+        }
+
+        // 3. Reduce visible textures evenly by always halving the largest one
+        auto cmp = [](const StreamedTexture* a, const StreamedTexture* b) { return a->sizes[a->targetMip] < b->sizes[b->targetMip]; };
+        std::priority_queue<StreamedTexture*, ArrayList<StreamedTexture*>, decltype(cmp)> largest( cmp );
+        for (auto tex : textures)
+            if (tex->targetMip < tex->lowestMip && not tex->failed)
+                largest.push( tex );
+
+        while (totalBytes > m_budget && not largest.empty())
+        {
+            auto tex = largest.top();
+            largest.pop();
+
+            // The lowest mip is always a valid largest mip (see TextureCache::Load()), so this ends there at the latest
+            U32 mip = tex->targetMip + 1;
+            while ( not Graphics::CanBeLargestMip( tex->format, tex->width, tex->height, mip ) )
+                mip++;
+
+            reduce( *tex, mip );
+            if (tex->targetMip < tex->lowestMip)
+                largest.push( tex );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void TextureStreamer::_IssueReads()
+    {
+        // Evictions first to free memory, then the most recently seen textures with the largest missing mips
+        ArrayList<std::pair<const Graphics::ITexture*, StreamedTexture*>> candidates;
+        for (auto& [key, tex] : m_textures)
+            if (tex.targetMip != tex.residentMip && tex.pendingMip == NO_MIP && not tex.failed)
+                candidates.push_back( { key, &tex } );
+
+        std::sort( candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            bool evictA = a.second->targetMip > a.second->residentMip;
+            bool evictB = b.second->targetMip > b.second->residentMip;
+            if (evictA != evictB)
+                return evictA;
+            if (a.second->lastSeenFrame != b.second->lastSeenFrame)
+                return a.second->lastSeenFrame > b.second->lastSeenFrame;
+            return a.second->sizes[a.second->targetMip] > b.second->sizes[b.second->targetMip];
+        } );
+
+        for (auto& [key, tex] : candidates)
+        {
+            if (m_pendingRequests >= MAX_PENDING_REQUESTS)
+                break;
+
+            tex->pendingMip = tex->targetMip;
+            m_pendingRequests++;
+
+            // Everything the job needs is copied, because the texture might be destroyed before it runs
+            auto finishedReads = m_finishedReads;
+            ASYNC_JOB([finishedReads, key = key, id = tex->id, path = tex->sourcePath, width = tex->width, height = tex->height, format = tex->format, firstMip = tex->targetMip] {
+                MipRead read{ key, id, firstMip };
+                if ( not Assets::TextureCache::ReadMips( path, width, height, format, firstMip, &read.mips ) )
+                    read.mips.clear();
+
+                std::lock_guard<std::mutex> lock( finishedReads->mutex );
+                finishedReads->reads.push_back( std::move( read ) );
+            });
+        }
+    }
+
+}
@@ -0,0 +1,156 @@
+#pragma once
+/**********************************************************************
+    class: TextureStreamer (texture_streamer.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Streams the mips of textures loaded from the texture cache. Only the
+    smallest mips are uploaded when such a texture is loaded. While
+    culling, the render system requests for every drawn renderer the
+    mip which matches the texel density of its textures on the screen.
+    Once per frame the wanted mips are fitted into a global budget and
+    missing mips are read on the thread pool, then uploaded on the next
+    update. Mips which are not needed anymore stay resident until the
+    budget is exceeded. Then the least recently seen textures lose their
+    mips first and visible ones are reduced evenly, largest first.
+**********************************************************************/
+
+#include "Graphics/i_texture2d.hpp"
+#include "Graphics/i_mesh.h"
+#include "Graphics/i_material.h"
+#include "OS/FileSystem/path.h"
+#include <mutex>
+
+namespace Core {
+
+    //----------------------------------------------------------------------
+    struct TextureStreamingStats
+    {
+        U32     numTextures         = 0;    // Streamed textures which are alive
+        U32     numFullyResident    = 0;    // Streamed textures with all mips on the gpu
+        U32     numPendingRequests  = 0;    // Mips currently read on the thread pool
+        U32     numStreamedIn       = 0;    // Textures which got larger mips in the last update
+        U32     numEvicted          = 0;    // Textures which dropped mips in the last update
+        Size    residentBytes       = 0;    // Gpu memory of all resident mips
+        Size    wantedBytes         = 0;    // Gpu memory if every texture had the mips wanted by the renderer
+        Size    budgetBytes         = 0;
+    };
+
+    //**********************************************************************
+    class TextureStreamer
+    {
+        using WeakTexture2DPtr = std::weak_ptr<Graphics::ITexture2D>;
+
+    public:
+        static TextureStreamer& Instance()
+        {
+            static TextureStreamer ts;
+            return ts;
+        }
+
+        // Width and height of the largest mip, which is uploaded when a streamed texture is loaded
+        static constexpr U32 RESIDENT_SIZE_ON_LOAD = 64;
+
+        //----------------------------------------------------------------------
+        // Enable/Disable streaming. Affects only textures loaded afterwards.
+        //----------------------------------------------------------------------
+        void setEnabled(bool enabled)   { m_enabled = enabled; }
+        bool isEnabled()        const   { return m_enabled; }
+
+        //----------------------------------------------------------------------
+        // Set the gpu memory in bytes, which all streamed textures might use together.
+        // Mips which are always resident count towards the budget, but are never evicted.
+        //----------------------------------------------------------------------
+        void setBudget(Size bytes)      { m_budget = bytes; }
+        Size getBudget()        const   { return m_budget; }
+
+        //----------------------------------------------------------------------
+        // Registers a texture loaded from the texture cache with only its smallest mips (see TextureCache::Load()).
+        // Textures which are fully resident are ignored. Thread-safe, so textures can be loaded asynchronously.
+        //----------------------------------------------------------------------
+        void add(const Texture2DPtr& texture, const OS::Path& sourcePath);
+
+        //----------------------------------------------------------------------
+        // Requests the mips of all streamed textures in the given materials, which are needed to draw the given mesh.
+        // Must be called every frame the mesh is drawn, otherwise the mips are considered as unused.
+        // @Params:
+        //  "materials": Material of each submesh.
+        //  "pixelsPerUnit": Size of one world unit on the screen in pixels at the point of the mesh nearest to the camera.
+        //----------------------------------------------------------------------
+        void requestMips(const MeshPtr& mesh, const ArrayList<MaterialPtr>& materials, const DirectX::XMMATRIX& modelMatrix, F32 pixelsPerUnit);
+
+        //----------------------------------------------------------------------
+        // Uploads finished reads, fits the requested mips into the budget and issues new reads.
+        // Called once per frame after all cameras were culled.
+        //----------------------------------------------------------------------
+        void update();
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Whether at least one texture is streamed. Mips need to be requested only then.
+        //----------------------------------------------------------------------
+        bool hasTextures() const { return not m_textures.empty(); }
+
+        //----------------------------------------------------------------------
+        const TextureStreamingStats& getStats() const { return m_stats; }
+
+    private:
+        static constexpr U32 NO_MIP = ~0u;
+
+        struct StreamedTexture
+        {
+            WeakTexture2DPtr        texture;
+            OS::Path                sourcePath;
+            U64                     id;
+            U32                     width;
+            U32                     height;
+            Graphics::TextureFormat format;
+            U32                     lowestMip;              // Largest mip which is always resident
+            ArrayList<Size>         sizes;                  // Gpu memory of the texture if mip i is the largest resident one
+            U32                     residentMip;
+            U32                     wantedMip       = 0;    // Every mip is wanted until the texture was requested once
+            U32                     requestedMip    = 0;    // Smallest mip requested in the current frame
+            U32                     targetMip       = 0;    // Wanted mip fitted into the budget
+            U32                     pendingMip      = NO_MIP;
+            U64                     lastSeenFrame   = 0;
+            bool                    failed          = false;
+        };
+
+        struct MipRead
+        {
+            const Graphics::ITexture*   key;
+            U64                         id;
+            U32                         firstMip;
+            ArrayList<ArrayList<Byte>>  mips;   // Empty if the read failed
+        };
+
+        // Finished reads are pushed by jobs, which might outlive this object
+        struct FinishedReads
+        {
+            std::mutex          mutex;
+            ArrayList<MipRead>  reads;
+        };
+
+        bool                                                    m_enabled           = true;
+        Size                                                    m_budget            = 512 * 1024 * 1024;
+        U64                                                     m_frame             = 1;
+        U64                                                     m_nextID            = 0;
+        U32                                                     m_pendingRequests   = 0;
+        HashMap<const Graphics::ITexture*, StreamedTexture>     m_textures;
+        TextureStreamingStats                                   m_stats;
+
+        std::mutex                                              m_addMutex;
+        ArrayList<std::pair<const Graphics::ITexture*, StreamedTexture>> m_added;
+        std::shared_ptr<FinishedReads>                          m_finishedReads = std::make_shared<FinishedReads>();
+
+        //----------------------------------------------------------------------
+        void _UploadFinishedReads();
+        void _FitIntoBudget(Size totalBytes);
+        void _IssueReads();
+
+        TextureStreamer() = default;
+        NULL_COPY_AND_ASSIGN(TextureStreamer)
+    };
+
+}
@@ -10,6 +10,7 @@
 #include "Graphics/command_buffer.h"
 #include "Graphics/camera.h"
 #include "GameplayLayer/layers.hpp"
+#include "Core/light_clusters.h"
 
 namespace Core { class RenderSystem; }
 class IScene;
@@ -97,6 +98,12 @@ namespace Components {
         //----------------------------------------------------------------------
         void setRenderTarget(RenderTexturePtr renderTarget, Graphics::CameraFlags flags = Graphics::CameraFlags::None) { m_camera.setRenderTarget(renderTarget, flags); }
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  All visible lights from the last frame assigned to the clusters of this camera.
+        //----------------------------------------------------------------------
+        const Core::LightClusters& getLightClusters() const { return m_lightClusters; }
+
         //----------------------------------------------------------------------
         // Add an additional command buffer to this camera
         //----------------------------------------------------------------------
@@ -112,6 +119,9 @@ namespace Components {
         // Additional attached command buffer
         HashMap<CameraEvent, ArrayList<Graphics::CommandBuffer*>> m_additionalCommandBuffers;
 
+        // Visible lights of this camera assigned to the view frustum clusters
+        Core::LightClusters         m_lightClusters;
+
         friend class Core::RenderSystem;
 
         //----------------------------------------------------------------------
@@ -123,7 +123,7 @@ namespace Components {
         auto transform = getGameObject()->getTransform();
         ASSERT( transform != nullptr );
 
-        m_dirLight->setDirection( transform->rotation.getForward() );
+        m_dirLight->setDirection( transform->getRotation().getForward() );
     }
 
     //----------------------------------------------------------------------
@@ -149,6 +149,8 @@ namespace Components {
         case Graphics::ShadowType::CSMSoft:
         {
             Graphics::CommandBuffer cmd;
+            ArrayList<IRenderComponent*> candidates, shadowCasters;
+            m_shadowCasterStats = {};
 
             auto& splits = m_dirLight->getCSMSplits();
             for (auto cascade = 0; cascade < splits.size(); ++cascade)
@@ -169,24 +171,23 @@ namespace Components {
                 // Set light-view projection for this cascade
                 m_dirLight->setCSMShadowViewProjection( cascade, m_camera->getViewProjectionMatrix() );
 
-                // Set camera and record commands for every rendering component
+                // Cascades whose casters did not change keep their slice from the last time they were rendered
+                candidates.clear();
+                scene.getComponentManager().getSpatialIndex().queryRenderer( *m_camera, candidates );
+                if ( not _CollectShadowCasters( cascade, scene, candidates, shadowCasters ) )
+                    continue;
+
+                // Set camera and record commands for every rendering component within this cascade
                 cmd.setCamera( *m_camera );
-                for ( auto& renderer : scene.getComponentManager().getRenderer() )
-                {
-                    if ( not renderer->isActive() || not renderer->isCastingShadows() )
-                        continue;
-
-                    // Check if component is visible
-                    bool isVisible = renderer->cull( *m_camera );
-                    if (isVisible)
-                        renderer->recordGraphicsCommands( cmd );
-                }
+                _RecordShadowCasters( cmd, shadowCasters );
                 cmd.endCamera();
 
                 // Copy rendering into appropriate array slice
                 cmd.copyTexture( m_camera->getRenderTarget()->getBuffer(), 0, 0, m_dirLight->getShadowMap(), cascade, 0 );
             }
-            Locator::getRenderer().dispatch( cmd );
+
+            if (m_shadowCasterStats.numPassesRendered > 0)
+                Locator::getRenderer().dispatch( cmd );
             break;
         }
         default:
@@ -245,11 +246,11 @@ namespace Components {
 
         if (snapShotTimeCounter > Time::Seconds(0))
         {
-            DEBUG.drawFrustum({}, transform->rotation, m_camera->getLeft(), m_camera->getRight(), 
+            DEBUG.drawFrustum({}, transform->getRotation(), m_camera->getLeft(), m_camera->getRight(), 
                                                         m_camera->getBottom(), m_camera->getTop(), 
                                                         m_camera->getZNear(), m_camera->getZFar(), Color::BLUE, 0);
 
-            DEBUG.drawFrustum(mainCameraTransform->position, mainCameraTransform->rotation.getForward(), mainCameraTransform->rotation.getUp(), 
+            DEBUG.drawFrustum(mainCameraTransform->getPosition(), mainCameraTransform->getRotation().getForward(), mainCameraTransform->getRotation().getUp(), 
                               mainCamera->getFOV(), zNear, zFar, mainCamera->getAspectRatio(), Color::GREEN, 0);
 
             snapShotTimeCounter -= static_cast<Time::Seconds>( PROFILER.getUpdateDelta() );
@@ -259,15 +260,15 @@ namespace Components {
         if (KEYBOARD.wasKeyReleased(KEY_DEBUG_SNAPSHOT))
         {
             snapShotTimeCounter = snapShotTime;
-            DEBUG.drawFrustum( {}, transform->rotation, m_camera->getLeft(), m_camera->getRight(), 
+            DEBUG.drawFrustum( {}, transform->getRotation(), m_camera->getLeft(), m_camera->getRight(), 
                                                        m_camera->getBottom(), m_camera->getTop(), 
                                                        m_camera->getZNear(), m_camera->getZFar(), Color::BLUE, snapShotTime );
 
-            DEBUG.drawFrustum( mainCameraTransform->position, mainCameraTransform->rotation.getForward(), mainCameraTransform->rotation.getUp(), 
+            DEBUG.drawFrustum( mainCameraTransform->getPosition(), mainCameraTransform->getRotation().getForward(), mainCameraTransform->getRotation().getUp(), 
                                mainCamera->getFOV(), zNear, zFar, mainCamera->getAspectRatio(), Color::GREEN, snapShotTime );
 
             //DEBUG.drawSphere( sphereCenter, radius, Color::VIOLET, snapShotTime );
-            //DEBUG.drawLine( mainCameraTransform->position, sphereCenter, Color::GREEN, snapShotTime );
+            //DEBUG.drawLine( mainCameraTransform->getPosition(), sphereCenter, Color::GREEN, snapShotTime );
         }
 #endif
     }
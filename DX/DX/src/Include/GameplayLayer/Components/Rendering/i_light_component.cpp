@@ -79,24 +79,82 @@ namespace Components {
 
         m_light->setShadowViewProjection( m_camera->getViewProjectionMatrix() );
 
-        // Set camera
+        // Collect every rendering component which intersects the light frustum
+        m_shadowCasterStats = {};
+        ArrayList<IRenderComponent*> candidates, shadowCasters;
+        scene.getComponentManager().getSpatialIndex().queryRenderer( *m_camera, candidates );
+        if ( not _CollectShadowCasters( 0, scene, candidates, shadowCasters ) )
+            return;
+
+        // Set camera and record commands
         cmd.setCamera( *m_camera );
+        _RecordShadowCasters( cmd, shadowCasters );
+        cmd.endCamera();
 
-        // Record commands for every rendering component
-        for ( auto& renderer : scene.getComponentManager().getRenderer() )
+        Locator::getRenderer().dispatch( cmd );
+    }
+
+    //----------------------------------------------------------------------
+    bool ILightComponent::_CollectShadowCasters( U32 pass, const IScene& scene, const ArrayList<IRenderComponent*>& candidates, ArrayList<IRenderComponent*>& casters )
+    {
+        casters.clear();
+        bool hasAnimatedCaster = false;
+        for ( auto& renderer : candidates )
         {
             if ( not renderer->isActive() || not renderer->isCastingShadows() )
                 continue;
 
             // Check if component is visible
-            bool isVisible = renderer->cull( *m_camera );
-            if (isVisible)
-                renderer->recordGraphicsCommands( cmd );
+            if ( renderer->cull( *m_camera ) )
+            {
+                casters.push_back( renderer );
+                hasAnimatedCaster |= renderer->hasAnimatedGeometry();
+            }
         }
 
-        cmd.endCamera();
+        // Without culling every renderer in the scene would have been recorded into this pass
+        U32 numCasters = static_cast<U32>( casters.size() );
+        U32 numRenderer = static_cast<U32>( scene.getComponentManager().getRenderer().size() );
+        m_shadowCasterStats.numCasters += numCasters;
+        m_shadowCasterStats.numCulled  += numRenderer - std::min( numCasters, numRenderer );
+
+        // The order of the candidates depends on the spatial index, so sort them to make the comparison independent of it
+        std::sort( casters.begin(), casters.end() );
+
+        if ( pass >= m_shadowPassCaches.size() )
+            m_shadowPassCaches.resize( pass + 1 );
+        auto& cache = m_shadowPassCaches[pass];
+
+        // The pass can be reused if the light camera, the shadowmap and every caster with its transform are the same as last time
+        auto viewProjection = m_camera->getViewProjectionMatrix();
+        const Graphics::Texture* shadowMap = getShadowMap().get();
+        bool isCached = not hasAnimatedCaster && cache.shadowMap == shadowMap && cache.casters.size() == casters.size()
+                     && memcmp( &cache.viewProjection, &viewProjection, sizeof( DirectX::XMMATRIX ) ) == 0;
+        for (I32 i = 0; isCached && i < casters.size(); i++)
+            isCached = cache.casters[i].first == casters[i]
+                    && cache.casters[i].second == casters[i]->getGameObject()->getTransform()->getWorldVersion();
+
+        if (isCached)
+        {
+            m_shadowCasterStats.numPassesCached++;
+            return false;
+        }
 
-        Locator::getRenderer().dispatch( cmd );
+        cache.viewProjection = viewProjection;
+        cache.shadowMap = shadowMap;
+        cache.casters.resize( casters.size() );
+        for (I32 i = 0; i < casters.size(); i++)
+            cache.casters[i] = { casters[i], casters[i]->getGameObject()->getTransform()->getWorldVersion() };
+
+        m_shadowCasterStats.numPassesRendered++;
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    void ILightComponent::_RecordShadowCasters( Graphics::CommandBuffer& cmd, const ArrayList<IRenderComponent*>& casters )
+    {
+        for ( auto& renderer : casters )
+            renderer->recordGraphicsCommands( cmd );
     }
 
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "../i_component.h"
 #include "Graphics/Lighting/lights.h"
+#include "Math/aabb.h"
 
 namespace Core { class RenderSystem; }
 namespace Graphics { class Camera; }
@@ -18,6 +19,16 @@ class IScene;
 namespace Components {
 
     class Camera;
+    class IRenderComponent;
+
+    //----------------------------------------------------------------------
+    struct ShadowCasterStats
+    {
+        U32 numCasters          = 0; // Renderer recorded into all passes of a shadowmap
+        U32 numCulled           = 0; // Renderer of the scene skipped in all passes of a shadowmap
+        U32 numPassesRendered   = 0; // Passes (e.g. cube faces or cascades) which had to be rendered
+        U32 numPassesCached     = 0; // Passes which were reused from the last rendered shadowmap
+    };
 
     //**********************************************************************
     class ILightComponent : public IComponent
@@ -35,6 +46,7 @@ namespace Components {
         Graphics::ShadowMapQuality  getShadowMapQuality()   const { return m_shadowMapQuality; }
         const Graphics::Camera&     getNativeCamera()       const { return *m_camera; }
         Graphics::ShadowType        getShadowType()         const { return m_light->getShadowType(); }
+        const ShadowCasterStats&    getShadowCasterStats()  const { return m_shadowCasterStats; } // From the last rendered shadowmap
 
         //----------------------------------------------------------------------
         void setIntensity           (F32 intensity) { m_light->setIntensity(intensity); }
@@ -43,15 +55,72 @@ namespace Components {
         void setShadowType          (Graphics::ShadowType shadowType);
         void setShadowTypeAndQuality(Graphics::ShadowType shadowType, Graphics::ShadowMapQuality quality);
 
+        //----------------------------------------------------------------------
+        // Shadowmaps are only rendered again if the light, the light camera or one of the casters moved.
+        // Call this if anything else affecting the shadowmap changed, e.g. the mesh of a shadow caster.
+        //----------------------------------------------------------------------
+        void invalidateShadowMap() { m_shadowPassCaches.clear(); }
+
+        //----------------------------------------------------------------------
+        // Computes the world space bounds of the volume this light affects.
+        // @Return:
+        //  False, if the light has an infinite range (e.g. directional light).
+        //----------------------------------------------------------------------
+        virtual bool getWorldBounds(Math::AABB* aabb) const { return false; }
+
+        //----------------------------------------------------------------------
+        // Computes the bounds of the volume this light affects relative to the light position.
+        // The world bounds are only recomputed by the spatial index if these or the transform changed.
+        // @Return:
+        //  False, if the light has an infinite range (e.g. directional light).
+        //----------------------------------------------------------------------
+        virtual bool getLocalBounds(Math::AABB* aabb) const { return false; }
+
+        //----------------------------------------------------------------------
+        // Computes the world space sphere enclosing the volume this light affects.
+        // @Return:
+        //  False, if the light has an infinite range (e.g. directional light).
+        //----------------------------------------------------------------------
+        virtual bool getBoundingSphere(Math::Vec3* center, F32* radius) const { return false; }
+
     protected:
         std::unique_ptr<Graphics::Light>    m_light             = nullptr;
         std::unique_ptr<Graphics::Camera>   m_camera            = nullptr;
         Graphics::ShadowMapQuality          m_shadowMapQuality  = Graphics::ShadowMapQuality::High;
+        ShadowCasterStats                   m_shadowCasterStats;
 
         virtual void renderShadowMap(const IScene& scene);
         virtual void _CreateShadowMap(Graphics::ShadowMapQuality) = 0;
 
+        //----------------------------------------------------------------------
+        // Culls the given candidates against the current light camera and compares the visible casters
+        // with the ones from the last time the given pass was rendered. Updates the shadow caster stats.
+        // @Params:
+        //  "pass": Index of the pass within the shadowmap, e.g. the cube face or cascade.
+        //  "candidates": Renderer which might intersect the light camera, e.g. from a spatial index query.
+        //  "casters": Receives all visible shadow casters.
+        // @Return:
+        //  True, if the pass must be rendered. False, if the shadowmap from the last time is still valid.
+        //----------------------------------------------------------------------
+        bool _CollectShadowCasters(U32 pass, const IScene& scene, const ArrayList<IRenderComponent*>& candidates, ArrayList<IRenderComponent*>& casters);
+
+        //----------------------------------------------------------------------
+        // Records the commands of the given shadow casters (collected by _CollectShadowCasters).
+        //----------------------------------------------------------------------
+        void _RecordShadowCasters(Graphics::CommandBuffer& cmd, const ArrayList<IRenderComponent*>& casters);
+
     private:
+        //----------------------------------------------------------------------
+        // State of a pass the last time it was rendered
+        //----------------------------------------------------------------------
+        struct ShadowPassCache
+        {
+            DirectX::XMMATRIX                               viewProjection;
+            const Graphics::Texture*                        shadowMap = nullptr;
+            ArrayList<std::pair<IRenderComponent*, U64>>    casters; // Renderer + world version of its transform
+        };
+        ArrayList<ShadowPassCache> m_shadowPassCaches;
+
         //----------------------------------------------------------------------
         friend class Core::RenderSystem;
         virtual void recordGraphicsCommands(Graphics::CommandBuffer& cmd) {}
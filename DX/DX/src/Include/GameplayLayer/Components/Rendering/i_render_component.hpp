@@ -9,12 +9,21 @@
 **********************************************************************/
 
 #include "../i_component.h"
+#include "Math/aabb.h"
 
-namespace Core { class RenderSystem; }
+namespace Core { class RenderSystem; class OcclusionCuller; }
 namespace Graphics { class Camera; }
 
 namespace Components {
 
+    //----------------------------------------------------------------------
+    enum class OccluderMode
+    {
+        None,   // Does not occlude anything
+        Mesh,   // The rendered geometry itself is rasterized as an occluder
+        Box     // A user given box in local space, which must lie completely inside the rendered geometry
+    };
+
     //**********************************************************************
     class IRenderComponent : public IComponent
     {
@@ -23,19 +32,62 @@ namespace Components {
         virtual ~IRenderComponent() = default;
 
         //----------------------------------------------------------------------
-        bool isCastingShadows() const { return m_castShadows; }
+        bool                isCastingShadows()  const { return m_castShadows; }
+        OccluderMode        getOccluderMode()   const { return m_occluderMode; }
+        const Math::AABB&   getOccluderBox()    const { return m_occluderBox; }
 
         //----------------------------------------------------------------------
         void setCastShadows(bool castShadows) { m_castShadows = castShadows; }
 
+        //----------------------------------------------------------------------
+        // Marks this component as an occluder for the software occlusion culling.
+        // Occluders should be large objects near the camera, e.g. walls or terrain.
+        // @Params:
+        //  "mode": How this component is rasterized into the occlusion buffer.
+        //  "localBox": Only used with OccluderMode::Box. The box in local space.
+        //----------------------------------------------------------------------
+        void setOccluder(OccluderMode mode, const Math::AABB& localBox = Math::AABB()) { m_occluderMode = mode; m_occluderBox = localBox; }
+
+        //----------------------------------------------------------------------
+        // Computes the bounds of this component in world space.
+        // @Return:
+        //  False, if this component has no finite bounds. It won't be culled by the spatial index then.
+        //----------------------------------------------------------------------
+        virtual bool getWorldBounds(Math::AABB* aabb) const { return false; }
+
+        //----------------------------------------------------------------------
+        // Computes the bounds of this component in local space. The world bounds are only
+        // recomputed by the spatial index if these or the world matrix of the transform changed.
+        // @Return:
+        //  False, if this component has no finite bounds.
+        //----------------------------------------------------------------------
+        virtual bool getLocalBounds(Math::AABB* aabb) const { return false; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  True, if the rendered geometry changes without the transform being changed (e.g. skinning).
+        //  Cached shadowmaps containing this component are rendered again every frame.
+        //----------------------------------------------------------------------
+        virtual bool hasAnimatedGeometry() const { return false; }
+
     private:
-        bool m_castShadows = true;
+        bool            m_castShadows   = true;
+        OccluderMode    m_occluderMode  = OccluderMode::None;
+        Math::AABB      m_occluderBox;
 
         //----------------------------------------------------------------------
         friend class Core::RenderSystem;
         friend class ILightComponent; friend class DirectionalLight; friend class SpotLight; friend class PointLight;
         virtual void recordGraphicsCommands(Graphics::CommandBuffer& cmd) {}
         virtual bool cull(const Graphics::Camera& camera) { return true; }
+        virtual void addMeshOccluder(Core::OcclusionCuller& culler) {}
+
+        //----------------------------------------------------------------------
+        // Requests the mips of streamed textures needed to draw this component (see Core::TextureStreamer).
+        // @Params:
+        //  "pixelsPerUnit": Size of one world unit on the screen in pixels at the point nearest to the camera.
+        //----------------------------------------------------------------------
+        virtual void requestTextureMips(F32 pixelsPerUnit) {}
 
         NULL_COPY_AND_ASSIGN(IRenderComponent)
     };
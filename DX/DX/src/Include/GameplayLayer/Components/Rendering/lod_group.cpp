@@ -0,0 +1,215 @@
+#include "lod_group.h"
+/**********************************************************************
+    class: LODGroup (lod_group.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "GameplayLayer/gameobject.h"
+#include "Graphics/command_buffer.h"
+#include "../transform.h"
+#include "Core/locator.h"
+#include "Core/mesh_generator.h"
+#include "Core/occlusion_culler.h"
+#include "Core/texture_streamer.h"
+#include "camera.h"
+
+namespace Components {
+
+    //----------------------------------------------------------------------
+    LODGroup::LODGroup( const ArrayList<LOD>& lods, const MaterialPtr& material )
+    {
+        setLODs( lods );
+
+        // Apply given material to all submeshes
+        for (I32 i = 0; i < m_materials.size(); i++)
+            setMaterial( material, i );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void LODGroup::setLODs( const ArrayList<LOD>& lods )
+    {
+        m_lods = lods;
+        m_lodPerCamera.clear();
+        if ( m_lods.empty() )
+            return;
+
+        for (I32 i = 1; i < m_lods.size(); i++)
+        {
+            ASSERT( m_lods[i].mesh->getSubMeshCount() == m_lods[0].mesh->getSubMeshCount() && "LODGroup::setLODs(): Submesh count differs between levels." );
+            ASSERT( m_lods[i].screenRelativeHeight <= m_lods[i - 1].screenRelativeHeight && "LODGroup::setLODs(): Levels must be sorted from highest to lowest detail." );
+        }
+
+        m_materials.resize( std::max( (I32)m_lods[0].mesh->getSubMeshCount(), 1 ) );
+        for ( I32 i = 0; i < m_materials.size(); i++ )
+            if (m_materials[i] == nullptr)
+                m_materials[i] = ASSETS.getErrorMaterial();
+    }
+
+    //----------------------------------------------------------------------
+    void LODGroup::setMaterial( const MaterialPtr& m, U32 subMeshIndex )
+    {
+        ASSERT( subMeshIndex < m_materials.size() && "LODGroup::setMaterial(): INVALID INDEX." );
+        m_materials[subMeshIndex] = (m == nullptr ? ASSETS.getErrorMaterial() : m);
+    }
+
+    //----------------------------------------------------------------------
+    I32 LODGroup::getCurrentLOD( const Graphics::Camera& camera ) const
+    {
+        auto it = m_lodPerCamera.find( &camera );
+        return it != m_lodPerCamera.end() ? it->second.lod : -1;
+    }
+
+    //----------------------------------------------------------------------
+    ArrayList<LODGroup::LOD> LODGroup::GenerateLODs( const MeshPtr& mesh, const ArrayList<F32>& screenRelativeHeights, F32 reductionPerLevel )
+    {
+        ArrayList<LOD> lods;
+        F32 ratio = 1.0f;
+        for (I32 i = 0; i < screenRelativeHeights.size(); i++)
+        {
+            // Each level is simplified from the source mesh, so errors do not accumulate
+            auto lodMesh = (i == 0) ? mesh : Core::MeshGenerator::CreateSimplified( mesh, ratio );
+            lods.push_back( { lodMesh, screenRelativeHeights[i] } );
+            ratio *= reductionPerLevel;
+        }
+        return lods;
+    }
+
+    //----------------------------------------------------------------------
+    bool LODGroup::getWorldBounds( Math::AABB* aabb ) const
+    {
+        if ( m_lods.empty() )
+            return false;
+
+        *aabb = m_lods[0].mesh->getBounds().transform( getGameObject()->getTransform()->getWorldMatrix() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool LODGroup::getLocalBounds( Math::AABB* aabb ) const
+    {
+        if ( m_lods.empty() )
+            return false;
+
+        *aabb = m_lods[0].mesh->getBounds();
+        return true;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void LODGroup::recordGraphicsCommands( Graphics::CommandBuffer& cmd )
+    {
+        if (m_selectedLOD < 0)
+            return;
+
+        auto transform = getGameObject()->getTransform();
+        ASSERT( transform != nullptr );
+
+        // Draw submesh with appropriate material
+        auto& mesh = m_lods[m_selectedLOD].mesh;
+        auto modelMatrix = transform->getWorldMatrix();
+        for (I32 i = 0; i < mesh->getSubMeshCount(); i++)
+            cmd.drawMesh( mesh, m_materials[i], modelMatrix, i );
+    }
+
+    //----------------------------------------------------------------------
+    bool LODGroup::cull( const Graphics::Camera& camera )
+    {
+        m_selectedLOD = -1;
+        if ( m_lods.empty() )
+            return false;
+
+        auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        if ( not camera.cull( m_lods[0].mesh->getBounds(), modelMatrix ) )
+            return false;
+
+        F32 screenHeight = _ScreenRelativeHeight( camera );
+        I32 previousLOD = getCurrentLOD( camera );
+
+        // Find the first level whose threshold is satisfied. A threshold between two levels
+        // is made harder to pass for the side which is currently not used.
+        I32 lod = -1;
+        for (I32 i = 0; i < m_lods.size(); i++)
+        {
+            F32 threshold = m_lods[i].screenRelativeHeight;
+            if (previousLOD >= 0)
+                threshold *= (i < previousLOD) ? (1.0f + m_hysteresis) : (1.0f - m_hysteresis);
+
+            if (screenHeight >= threshold)
+            {
+                lod = i;
+                break;
+            }
+        }
+
+        // Cameras which did not see this group in the last frame are forgotten. This removes destroyed cameras,
+        // whose address might otherwise be reused by a new camera inheriting the old level.
+        U64 frame = Locator::getCoreEngine().getFrameCount();
+        if (frame != m_lastPruneFrame)
+        {
+            for (auto it = m_lodPerCamera.begin(); it != m_lodPerCamera.end();)
+                it = (it->second.frame + 1 < frame) ? m_lodPerCamera.erase( it ) : std::next( it );
+            m_lastPruneFrame = frame;
+        }
+
+        m_lodPerCamera[&camera] = { lod, frame };
+        m_selectedLOD = lod;
+
+        return m_selectedLOD >= 0;
+    }
+
+    //----------------------------------------------------------------------
+    void LODGroup::addMeshOccluder( Core::OcclusionCuller& culler )
+    {
+        // Coarser levels might not fully cover the rendered geometry anymore, therefore only the first level occludes
+        if ( m_selectedLOD != 0 )
+            return;
+
+        auto& mesh = m_lods[0].mesh;
+        auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        for (I32 i = 0; i < mesh->getSubMeshCount(); i++)
+        {
+            if (mesh->getMeshTopology( i ) != Graphics::MeshTopology::Triangles)
+                continue;
+
+            culler.addOccluder( mesh->getVertexPositions(), mesh->getIndices( i ), mesh->getIndexCount( i ), mesh->getBaseVertex( i ), modelMatrix );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void LODGroup::requestTextureMips( F32 pixelsPerUnit )
+    {
+        if ( m_selectedLOD < 0 )
+            return;
+
+        auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        Core::TextureStreamer::Instance().requestMips( m_lods[m_selectedLOD].mesh, m_materials, modelMatrix, pixelsPerUnit );
+    }
+
+    //----------------------------------------------------------------------
+    F32 LODGroup::_ScreenRelativeHeight( const Graphics::Camera& camera ) const
+    {
+        Math::AABB bounds;
+        getWorldBounds( &bounds );
+        F32 radius = bounds.getExtents().magnitude();
+
+        // Projected diameter relative to the screen height: The projection stores 1/tan(fov/2) (perspective) or 2/height (orthographic)
+        F32 yScale = DirectX::XMVectorGetY( camera.getProjectionMatrix().r[1] );
+        if ( camera.isOrthographic() )
+            return radius * yScale;
+
+        Math::Vec3 cameraPos;
+        DirectX::XMStoreFloat3( &cameraPos, camera.getModelMatrix().r[3] );
+        F32 distance = std::max( cameraPos.distance( bounds.getCenter() ), radius );
+
+        return radius * yScale / distance;
+    }
+}
\ No newline at end of file
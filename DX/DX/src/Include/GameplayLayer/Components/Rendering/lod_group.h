@@ -0,0 +1,106 @@
+#pragma once
+/**********************************************************************
+    class: LODGroup (lod_group.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Renders one of several meshes depending on how large the object
+    appears on screen. Each level has a threshold in screen relative
+    height [0-1] and is used as long as the object is at least that
+    large. If the object gets smaller than the last threshold, nothing
+    will be drawn. The level is selected per camera in the culling step.
+    To avoid popping when the object hovers around a threshold, the
+    threshold is widened by a hysteresis in the direction of the
+    currently used level.
+**********************************************************************/
+
+#include "i_render_component.hpp"
+#include "Graphics/i_mesh.h"
+#include "Graphics/i_material.h"
+
+namespace Components {
+
+    //**********************************************************************
+    class LODGroup : public IRenderComponent
+    {
+    public:
+        struct LOD
+        {
+            MeshPtr mesh;
+            F32     screenRelativeHeight; // Level is used if the object is at least this large on screen
+        };
+
+        LODGroup() = default;
+        LODGroup(const ArrayList<LOD>& lods, const MaterialPtr& material = nullptr);
+
+        const ArrayList<LOD>&                   getLODs()                   const   { return m_lods; }
+        const MaterialPtr&                      getMaterial(U32 index = 0)  const   { return m_materials[index]; }
+        const ArrayList<MaterialPtr>&           getMaterials()              const   { return m_materials; }
+        F32                                     getHysteresis()             const   { return m_hysteresis; }
+
+        //----------------------------------------------------------------------
+        // Set the levels of this group. Must be sorted from the highest to the lowest detail
+        // and all meshes must have the same amount of submeshes.
+        //----------------------------------------------------------------------
+        void setLODs(const ArrayList<LOD>& lods);
+
+        //----------------------------------------------------------------------
+        // Set a material, which is used for the given submesh in every level.
+        //----------------------------------------------------------------------
+        void setMaterial(const MaterialPtr& m, U32 subMeshIndex = 0);
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "hysteresis": Fraction by which a threshold must be passed before a level changes.
+        //----------------------------------------------------------------------
+        void setHysteresis(F32 hysteresis) { m_hysteresis = hysteresis; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The level selected for the given camera in the last frame. -1 if culled or never seen.
+        //----------------------------------------------------------------------
+        I32 getCurrentLOD(const Graphics::Camera& camera) const;
+
+        //----------------------------------------------------------------------
+        // Generates a chain of levels by simplifying the given mesh.
+        // @Params:
+        //  "mesh": Mesh of the first level.
+        //  "screenRelativeHeights": Threshold for each level. The amount of levels equals the size of this list.
+        //  "reductionPerLevel": Triangle ratio of each level relative to the previous one.
+        //----------------------------------------------------------------------
+        static ArrayList<LOD> GenerateLODs(const MeshPtr& mesh, const ArrayList<F32>& screenRelativeHeights, F32 reductionPerLevel = 0.5f);
+
+        //----------------------------------------------------------------------
+        bool getWorldBounds(Math::AABB* aabb) const override;
+        bool getLocalBounds(Math::AABB* aabb) const override;
+
+    private:
+        struct CameraLOD
+        {
+            I32 lod;
+            U64 frame;  // Frame in which the level was selected
+        };
+
+        ArrayList<LOD>                              m_lods;
+        ArrayList<MaterialPtr>                      m_materials;
+        F32                                         m_hysteresis    = 0.1f;
+        I32                                         m_selectedLOD   = -1;
+        HashMap<const Graphics::Camera*, CameraLOD> m_lodPerCamera;
+        U64                                         m_lastPruneFrame = 0;
+
+        //----------------------------------------------------------------------
+        F32 _ScreenRelativeHeight(const Graphics::Camera& camera) const;
+
+        //----------------------------------------------------------------------
+        // IRendererComponent Interface
+        //----------------------------------------------------------------------
+        void recordGraphicsCommands(Graphics::CommandBuffer& cmd) override;
+        bool cull(const Graphics::Camera& camera) override;
+        void addMeshOccluder(Core::OcclusionCuller& culler) override;
+        void requestTextureMips(F32 pixelsPerUnit) override;
+
+        NULL_COPY_AND_ASSIGN(LODGroup)
+    };
+
+}
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "Graphics/command_buffer.h"
 #include "../transform.h"
 #include "Core/locator.h"
+#include "Core/occlusion_culler.h"
+#include "Core/texture_streamer.h"
 #include "camera.h"
 
 namespace Components {
@@ -48,6 +50,26 @@ namespace Components {
         m_materials[subMeshIndex] = (m == nullptr ? ASSETS.getErrorMaterial() : m);
     }
 
+    //----------------------------------------------------------------------
+    bool MeshRenderer::getWorldBounds( Math::AABB* aabb ) const
+    {
+        if ( m_mesh == nullptr )
+            return false;
+
+        *aabb = m_mesh->getBounds().transform( getGameObject()->getTransform()->getWorldMatrix() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool MeshRenderer::getLocalBounds( Math::AABB* aabb ) const
+    {
+        if ( m_mesh == nullptr )
+            return false;
+
+        *aabb = m_mesh->getBounds();
+        return true;
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -73,4 +95,31 @@ namespace Components {
         auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
         return camera.cull( m_mesh->getBounds(), modelMatrix );
     }
+
+    //----------------------------------------------------------------------
+    void MeshRenderer::addMeshOccluder( Core::OcclusionCuller& culler )
+    {
+        if ( m_mesh == nullptr )
+            return;
+
+        auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        auto& positions = m_mesh->getVertexPositions();
+        for (I32 i = 0; i < m_mesh->getSubMeshCount(); i++)
+        {
+            if (m_mesh->getMeshTopology( i ) != Graphics::MeshTopology::Triangles)
+                continue;
+
+            culler.addOccluder( positions, m_mesh->getIndices( i ), m_mesh->getIndexCount( i ), m_mesh->getBaseVertex( i ), modelMatrix );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void MeshRenderer::requestTextureMips( F32 pixelsPerUnit )
+    {
+        if ( m_mesh == nullptr )
+            return;
+
+        auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        Core::TextureStreamer::Instance().requestMips( m_mesh, m_materials, modelMatrix, pixelsPerUnit );
+    }
 }
\ No newline at end of file
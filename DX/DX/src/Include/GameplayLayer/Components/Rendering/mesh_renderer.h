@@ -42,6 +42,10 @@ namespace Components {
         //----------------------------------------------------------------------
         void setMaterial(const MaterialPtr& m, U32 subMeshIndex = 0);
 
+        //----------------------------------------------------------------------
+        bool getWorldBounds(Math::AABB* aabb) const override;
+        bool getLocalBounds(Math::AABB* aabb) const override;
+
     private:
         MeshPtr                 m_mesh;
         ArrayList<MaterialPtr>  m_materials;
@@ -51,6 +55,8 @@ namespace Components {
         //----------------------------------------------------------------------
         void recordGraphicsCommands(Graphics::CommandBuffer& cmd) override;
         bool cull(const Graphics::Camera& camera) override;
+        void addMeshOccluder(Core::OcclusionCuller& culler) override;
+        void requestTextureMips(F32 pixelsPerUnit) override;
 
         NULL_COPY_AND_ASSIGN(MeshRenderer)
     };
@@ -17,13 +17,27 @@
 #include "camera.h"
 
 #include "Ext/JSON/json.hpp"
+#include <emmintrin.h>
 
 namespace Components {
 
     static const StringID SHADER_NAME_MODEL_MATRIX = SID( "MODEL" );
 
+    // Amount of particles processed by one instruction in the update kernels
+    static constexpr U32 SIMD_WIDTH = 4;
+
+    // Skipped time is simulated in steps of this size once a particle system becomes visible again
+    static const Time::Seconds CATCH_UP_STEP = Time::Seconds( 1.0f / 15.0f );
+
+    // Each particle system gets an own seed in order of creation
+    static U32 s_nextRandomSeed = 0;
+
+    //----------------------------------------------------------------------
+    static U32 AlignToSimdWidth( U32 count ) { return (count + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1); }
+
     //----------------------------------------------------------------------
     ParticleSystem::ParticleSystem( const OS::Path& path )
+        : m_randomSeed{ s_nextRandomSeed++ }
     {
         m_particleMesh = Core::MeshGenerator::CreatePlane();
         _LoadFromFile( path );
@@ -33,7 +47,7 @@ namespace Components {
 
     //----------------------------------------------------------------------
     ParticleSystem::ParticleSystem( const MaterialPtr& material, bool playOnStart )
-        : m_material{ material }
+        : m_material{ material }, m_randomSeed{ s_nextRandomSeed++ }
     {
         m_paused = not playOnStart;
         m_particleMesh = Core::MeshGenerator::CreatePlane();
@@ -46,25 +60,9 @@ namespace Components {
     //----------------------------------------------------------------------
     void ParticleSystem::tick( Time::Seconds delta )
     {
-        if (m_paused)
-            return;
-
-        bool isRunning = m_clock.tick( delta );
-        if (isRunning)
-        {
-            auto clockDelta = m_clock.getDelta();
-            _SpawnParticles( clockDelta );
-            _UpdateParticles( clockDelta );
-        }
-        else
-        {
-            // Clock is has exceeded his duration, but remaining particles must still be updated
-            _UpdateParticles( delta * m_clock.getTickModifier() );
-        }
-
-        _AlignParticles( m_particleAlignment );
-        _SortParticles( m_sortMode );
-        _UpdateMesh();
+        // The simulation itself is done by the particle manager
+        if (not m_paused)
+            m_frameDelta += delta;
     }
 
     //----------------------------------------------------------------------
@@ -99,6 +97,26 @@ namespace Components {
         return true;
     }
 
+    //----------------------------------------------------------------------
+    bool ParticleSystem::getWorldBounds( Math::AABB* aabb ) const
+    {
+        if (m_currentParticleCount == 0)
+            return false;
+
+        *aabb = m_localBounds.expanded( m_maxParticleScale ).transform( getGameObject()->getTransform()->getWorldMatrix() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool ParticleSystem::getLocalBounds( Math::AABB* aabb ) const
+    {
+        if (m_currentParticleCount == 0)
+            return false;
+
+        *aabb = m_localBounds.expanded( m_maxParticleScale );
+        return true;
+    }
+
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
@@ -111,7 +129,10 @@ namespace Components {
         m_accumulatedSpawnTime = 0.0f;
         m_clock.setTickModifier( 1.0f );
         m_clock.setTime( 0_ms );
-        m_particles.resize( m_maxParticleCount );
+        m_frameDelta = 0_s;
+        m_catchUpTime = m_prewarmTime;
+        m_random.seed( m_randomSeed );
+        m_particles.resize( AlignToSimdWidth( m_maxParticleCount ) );
 
         // Make sure the mesh is a dynamic mesh
         if ( m_particleMesh->isImmutable() )
@@ -122,10 +143,103 @@ namespace Components {
         m_particleMesh->createVertexStream<Math::Vec4>( Graphics::SID_VERTEX_COLOR, m_maxParticleCount );
     }
 
+    //----------------------------------------------------------------------
+    void ParticleSystem::setLifetimeColorFnc( const std::function<Color(F32)>& fnc )
+    {
+        if (not fnc)
+        {
+            m_lifeTimeColorCurve.bake( nullptr );
+            return;
+        }
+
+        // Colors are multiplied as normalized floats, which is what the vertex stream expects anyway
+        m_lifeTimeColorCurve.bake( [&fnc](F32 lerp) { return Math::Vec4( fnc( lerp ).normalized() ); } );
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
 
+    //----------------------------------------------------------------------
+    void ParticleSystem::_PrepareSimulation()
+    {
+        // Transforms cache their world rotation on first access, so they must not be read from a job
+        auto transform = getGameObject()->getTransform();
+        m_worldMatrix = transform->getWorldMatrix();
+        m_alignedRotation = Math::Quat::IDENTITY;
+
+        auto mainCamera = SCENE.getMainCamera();
+        if (mainCamera == nullptr)
+            return;
+
+        auto eyeTransform = mainCamera->getGameObject()->getTransform();
+        m_eyePosition = eyeTransform->getWorldPosition();
+
+        switch (m_particleAlignment)
+        {
+        case ParticleAlignment::View:
+        {
+            // 1. Since the view matrix rotates everything "eyeRot" backwards, to negate it we just add the eyeRot itself
+            // 2. To negate the world rotation itself, we just need the conjugate
+            auto worldRot = transform->getWorldRotation();
+            auto& eyeRot = eyeTransform->getWorldRotation();
+            m_alignedRotation = eyeRot * worldRot.conjugate();
+            break;
+        }
+        case ParticleAlignment::None: break;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    bool ParticleSystem::_UpdateVisibility( bool isVisible )
+    {
+        if ( isVisible || m_cullingMode == CullingMode::AlwaysSimulate )
+            return true;
+
+        if (m_cullingMode == CullingMode::CatchUp)
+            m_catchUpTime = std::max( m_catchUpTime, std::min( m_catchUpTime + m_frameDelta, m_catchUpLimit ) );
+
+        m_frameDelta = 0_s;
+        return false;
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleSystem::_Simulate()
+    {
+        Math::Random::ScopedEngine randomScope( m_random );
+
+        // Prewarm or skipped time while not visible
+        while (m_catchUpTime > 0_s)
+        {
+            auto step = std::min( m_catchUpTime, CATCH_UP_STEP );
+            _Step( step );
+            m_catchUpTime -= step;
+        }
+
+        _Step( m_frameDelta );
+        m_frameDelta = 0_s;
+
+        _SortParticles( m_sortMode );
+        _UpdateMesh( m_particleAlignment );
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleSystem::_Step( Time::Seconds delta )
+    {
+        bool isRunning = m_clock.tick( delta );
+        if (isRunning)
+        {
+            auto clockDelta = m_clock.getDelta();
+            _SpawnParticles( clockDelta );
+            _UpdateParticles( clockDelta );
+        }
+        else
+        {
+            // Clock is has exceeded his duration, but remaining particles must still be updated
+            _UpdateParticles( delta * m_clock.getTickModifier() );
+        }
+    }
+
     //----------------------------------------------------------------------
     void ParticleSystem::_SpawnParticles( Time::Seconds delta )
     {
@@ -142,106 +256,190 @@ namespace Components {
     }
 
     //----------------------------------------------------------------------
-    void ParticleSystem::_SpawnParticle( U32 particleIndex )
+    void ParticleSystem::_SpawnParticle( U32 i )
     {
-        m_particles[particleIndex].startLifetime = m_particles[particleIndex].remainingLifetime = m_spawnLifeTimeFnc();
-
-        m_particles[particleIndex].spawnScale    = m_particles[particleIndex].scale = m_spawnScaleFnc();
-        m_particles[particleIndex].spawnRotation = m_particles[particleIndex].rotation = m_spawnRotationFnc();
-        m_particles[particleIndex].position      = m_spawnPositionFnc();
-
-        m_particles[particleIndex].spawnColor    = m_particles[particleIndex].color = m_spawnColorFnc();
-        m_particles[particleIndex].spawnVelocity = m_particles[particleIndex].velocity = m_spawnVelocityFnc();
+        F32 lifetime = m_spawnLifeTimeFnc();
+        m_particles.startLifetime[i] = m_particles.remainingLifetime[i] = lifetime;
+        m_particles.invStartLifetime[i] = 1.0f / lifetime;
+
+        auto position = m_spawnPositionFnc();
+        m_particles.positionX[i] = position.x;
+        m_particles.positionY[i] = position.y;
+        m_particles.positionZ[i] = position.z;
+
+        auto velocity = m_spawnVelocityFnc();
+        m_particles.spawnVelocityX[i] = velocity.x;
+        m_particles.spawnVelocityY[i] = velocity.y;
+        m_particles.spawnVelocityZ[i] = velocity.z;
+
+        m_particles.spawnScale[i]    = m_spawnScaleFnc();
+        m_particles.spawnRotation[i] = m_spawnRotationFnc();
+        m_particles.spawnColor[i]    = m_spawnColorFnc().normalized();
+        m_particles.curveIndex[i]    = 0;
     }
 
     //----------------------------------------------------------------------
     void ParticleSystem::_UpdateParticles( Time::Seconds d )
     {
         F32 delta = (F32)d;
+        const __m128 vDelta = _mm_set1_ps( delta );
+
+        // Age all particles at once. Padding lanes behind the last particle are processed as well, but never read.
+        U32 paddedCount = AlignToSimdWidth( m_currentParticleCount );
+        for (U32 i = 0; i < paddedCount; i += SIMD_WIDTH)
+        {
+            __m128 remaining = _mm_loadu_ps( &m_particles.remainingLifetime[i] );
+            _mm_storeu_ps( &m_particles.remainingLifetime[i], _mm_sub_ps( remaining, vDelta ) );
+        }
+
+        // Move last living particle into the slot of a dead one
         for (U32 i = 0; i < m_currentParticleCount;)
         {
-            m_particles[i].remainingLifetime -= d;
-            if (m_particles[i].remainingLifetime < 0_s)
+            if (m_particles.remainingLifetime[i] < 0.0f)
             {
-                // Move last living particle in this slot
-                m_particles[i] = m_particles[m_currentParticleCount - 1];
+                m_particles.copy( i, m_currentParticleCount - 1 );
                 --m_currentParticleCount;
                 continue;
             }
+            ++i;
+        }
 
-            // From 0 - 1 across the whole lifetime of the particle. 0 means particle just spawned, 1 it's near death.
-            F32 lifeTimeNormalized = 1.0f - (F32)(m_particles[i].remainingLifetime / m_particles[i].startLifetime);
-            lifeTimeNormalized = std::min( lifeTimeNormalized, 1.0f );
+        // Integrate positions. The normalized lifetime is stored as an index into the lifetime curves,
+        // so writing the vertex streams needs no further per-particle math besides the table lookups.
+        const __m128 one        = _mm_set1_ps( 1.0f );
+        const __m128 zero       = _mm_setzero_ps();
+        const __m128 curveScale = _mm_set1_ps( F32( LifetimeCurve<F32>::RESOLUTION - 1 ) );
+        const __m128 half       = _mm_set1_ps( 0.5f );
+        const __m128 gravity    = _mm_set1_ps( m_gravity );
+        const bool hasVelocityCurve = m_lifeTimeVelocityCurve.isEnabled();
+
+        paddedCount = AlignToSimdWidth( m_currentParticleCount );
+        for (U32 i = 0; i < paddedCount; i += SIMD_WIDTH)
+        {
+            __m128 remaining = _mm_loadu_ps( &m_particles.remainingLifetime[i] );
+            __m128 start     = _mm_loadu_ps( &m_particles.startLifetime[i] );
+            __m128 invStart  = _mm_loadu_ps( &m_particles.invStartLifetime[i] );
 
-            m_particles[i].velocity = m_particles[i].spawnVelocity;
-            if (m_lifeTimeVelocityFnc)
-                m_particles[i].velocity += m_lifeTimeVelocityFnc( lifeTimeNormalized );
+            // From 0 - 1 across the whole lifetime of the particle. 0 means particle just spawned, 1 it's near death.
+            __m128 lifetimeNormalized = _mm_sub_ps( one, _mm_mul_ps( remaining, invStart ) );
+            lifetimeNormalized = _mm_min_ps( _mm_max_ps( lifetimeNormalized, zero ), one );
+
+            alignas(16) I32 curveIndex[SIMD_WIDTH];
+            _mm_store_si128( reinterpret_cast<__m128i*>( curveIndex ), _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( lifetimeNormalized, curveScale ), half ) ) );
+            for (U32 lane = 0; lane < SIMD_WIDTH; ++lane)
+                m_particles.curveIndex[i + lane] = static_cast<U8>( curveIndex[lane] );
+
+            __m128 velocityX = _mm_loadu_ps( &m_particles.spawnVelocityX[i] );
+            __m128 velocityY = _mm_loadu_ps( &m_particles.spawnVelocityY[i] );
+            __m128 velocityZ = _mm_loadu_ps( &m_particles.spawnVelocityZ[i] );
+            if (hasVelocityCurve)
+            {
+                auto& v0 = m_lifeTimeVelocityCurve[curveIndex[0]];
+                auto& v1 = m_lifeTimeVelocityCurve[curveIndex[1]];
+                auto& v2 = m_lifeTimeVelocityCurve[curveIndex[2]];
+                auto& v3 = m_lifeTimeVelocityCurve[curveIndex[3]];
+                velocityX = _mm_add_ps( velocityX, _mm_setr_ps( v0.x, v1.x, v2.x, v3.x ) );
+                velocityY = _mm_add_ps( velocityY, _mm_setr_ps( v0.y, v1.y, v2.y, v3.y ) );
+                velocityZ = _mm_add_ps( velocityZ, _mm_setr_ps( v0.z, v1.z, v2.z, v3.z ) );
+            }
 
             // Add gravity
-            m_particles[i].velocity -= Math::Vec3{ 0, m_gravity * (F32)(m_particles[i].startLifetime - m_particles[i].remainingLifetime), 0 };
+            __m128 age = _mm_sub_ps( start, remaining );
+            velocityY = _mm_sub_ps( velocityY, _mm_mul_ps( gravity, age ) );
 
             // Add velocity to position
-            m_particles[i].position += m_particles[i].velocity * delta;
-
-            // Evaluate all lifetime functions
-            m_particles[i].rotation = m_particles[i].spawnRotation; // Set always rotation here, so particles can be aligned later on
-            if (m_lifeTimeRotationFnc)
-                m_particles[i].rotation *= m_lifeTimeRotationFnc( lifeTimeNormalized );
-
-            if (m_lifeTimeScaleFnc)
-                m_particles[i].scale = m_particles[i].spawnScale * m_lifeTimeScaleFnc( lifeTimeNormalized );
-
-            if (m_lifeTimeColorFnc)
-                m_particles[i].color = m_particles[i].spawnColor * m_lifeTimeColorFnc( lifeTimeNormalized );
-
-            ++i;
-        }
-    }
-
-    //----------------------------------------------------------------------
-    void ParticleSystem::_AlignParticles( ParticleAlignment alignment )
-    {
-        switch (alignment)
-        {
-        case ParticleAlignment::View:
-        {
-            // 1. Since the view matrix rotates everything "eyeRot" backwards, to negate it we just add the eyeRot itself
-            // 2. To negate the world rotation itself, we just need the conjugate
-            auto worldRot = getGameObject()->getTransform()->getWorldRotation();
-            auto& eyeRot = SCENE.getMainCamera()->getGameObject()->getTransform()->getWorldRotation();
-            auto alignedRotation = eyeRot * worldRot.conjugate();
-            for (U32 i = 0; i < m_currentParticleCount; ++i)
-                m_particles[i].rotation *= alignedRotation;
-            break;
-        }
-        case ParticleAlignment::None: break;
+            _mm_storeu_ps( &m_particles.positionX[i], _mm_add_ps( _mm_loadu_ps( &m_particles.positionX[i] ), _mm_mul_ps( velocityX, vDelta ) ) );
+            _mm_storeu_ps( &m_particles.positionY[i], _mm_add_ps( _mm_loadu_ps( &m_particles.positionY[i] ), _mm_mul_ps( velocityY, vDelta ) ) );
+            _mm_storeu_ps( &m_particles.positionZ[i], _mm_add_ps( _mm_loadu_ps( &m_particles.positionZ[i] ), _mm_mul_ps( velocityZ, vDelta ) ) );
         }
     }
 
     //----------------------------------------------------------------------
     void ParticleSystem::_SortParticles( SortMode sortMode )
     {
+        m_sortIndices.clear();
+        if (m_currentParticleCount == 0)
+            return;
+
         switch (sortMode)
         {
         case SortMode::ByDistance:
         {
-            auto worldMatrix = getGameObject()->getTransform()->getWorldMatrix();
-            auto eyePos = DirectX::XMLoadFloat3( &SCENE.getMainCamera()->getGameObject()->getTransform()->getWorldPosition() );
+            const auto& worldMatrix = m_worldMatrix;
+            const auto& eyePos = m_eyePosition;
 
             // Sorting particles by distance to camera comes with one caveat:
             // 1.) Floating point precision can cause incorrect ordering when the camera moves around the particle
             //     Solution: Disable Z-Writes
-            std::sort( m_particles.begin(), m_particles.begin() + m_currentParticleCount, [worldMatrix, eyePos](const Particle& p1, const Particle& p2) {
-                auto vPos1 = DirectX::XMLoadFloat3( &p1.position );
-                auto vPos2 = DirectX::XMLoadFloat3( &p2.position );
-                auto pos1 = DirectX::XMVector3Transform( vPos1, worldMatrix );
-                auto pos2 = DirectX::XMVector3Transform( vPos2, worldMatrix );
+            DirectX::XMFLOAT4X4 m;
+            DirectX::XMStoreFloat4x4( &m, worldMatrix );
+
+            // Squared distances are positive, so their bit patterns sort like unsigned integers.
+            // The bits are inverted to draw the farthest particle first.
+            U32 paddedCount = AlignToSimdWidth( m_currentParticleCount );
+            m_sortKeys.resize( paddedCount );
+            for (U32 i = 0; i < paddedCount; i += SIMD_WIDTH)
+            {
+                __m128 x = _mm_loadu_ps( &m_particles.positionX[i] );
+                __m128 y = _mm_loadu_ps( &m_particles.positionY[i] );
+                __m128 z = _mm_loadu_ps( &m_particles.positionZ[i] );
+
+                __m128 dx = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, _mm_set1_ps( m._11 ) ), _mm_mul_ps( y, _mm_set1_ps( m._21 ) ) ),
+                                                    _mm_add_ps( _mm_mul_ps( z, _mm_set1_ps( m._31 ) ), _mm_set1_ps( m._41 ) ) ), _mm_set1_ps( eyePos.x ) );
+                __m128 dy = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, _mm_set1_ps( m._12 ) ), _mm_mul_ps( y, _mm_set1_ps( m._22 ) ) ),
+                                                    _mm_add_ps( _mm_mul_ps( z, _mm_set1_ps( m._32 ) ), _mm_set1_ps( m._42 ) ) ), _mm_set1_ps( eyePos.y ) );
+                __m128 dz = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, _mm_set1_ps( m._13 ) ), _mm_mul_ps( y, _mm_set1_ps( m._23 ) ) ),
+                                                    _mm_add_ps( _mm_mul_ps( z, _mm_set1_ps( m._33 ) ), _mm_set1_ps( m._43 ) ) ), _mm_set1_ps( eyePos.z ) );
+
+                __m128 distanceSq = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) ), _mm_mul_ps( dz, dz ) );
+                __m128i key = _mm_xor_si128( _mm_castps_si128( distanceSq ), _mm_set1_epi32( -1 ) );
+                _mm_storeu_si128( reinterpret_cast<__m128i*>( &m_sortKeys[i] ), key );
+            }
+
+            // Least significant digit radix sort of the particle indices, one byte per pass
+            auto& indices = m_sortTemp[0];
+            auto& sortedIndices = m_sortTemp[1];
+            indices.resize( m_currentParticleCount );
+            sortedIndices.resize( m_currentParticleCount );
+            for (U32 i = 0; i < m_currentParticleCount; ++i)
+                indices[i] = i;
+
+            // Histograms of all passes are built in one sweep over the keys
+            U32 histograms[4][256] = {};
+            for (U32 i = 0; i < m_currentParticleCount; ++i)
+            {
+                U32 key = m_sortKeys[i];
+                histograms[0][key & 0xFF]++;
+                histograms[1][(key >> 8) & 0xFF]++;
+                histograms[2][(key >> 16) & 0xFF]++;
+                histograms[3][key >> 24]++;
+            }
 
-                auto distance1 = DirectX::XMVector3LengthSq( DirectX::XMVectorSubtract( eyePos, pos1 ) );
-                auto distance2 = DirectX::XMVector3LengthSq( DirectX::XMVectorSubtract( eyePos, pos2 ) );
+            for (U32 pass = 0; pass < 4; ++pass)
+            {
+                U32 shift = pass * 8;
 
-                return DirectX::XMVector3Greater( distance1, distance2 );
-            } );
+                // Every key has the same digit, so this pass would not change the order
+                if (histograms[pass][(m_sortKeys[0] >> shift) & 0xFF] == m_currentParticleCount)
+                    continue;
+
+                U32 offset = 0;
+                for (U32 digit = 0; digit < 256; ++digit)
+                {
+                    U32 count = histograms[pass][digit];
+                    histograms[pass][digit] = offset;
+                    offset += count;
+                }
+
+                for (U32 i = 0; i < m_currentParticleCount; ++i)
+                {
+                    U32 index = indices[i];
+                    sortedIndices[histograms[pass][(m_sortKeys[index] >> shift) & 0xFF]++] = index;
+                }
+                indices.swap( sortedIndices );
+            }
+
+            m_sortIndices.swap( indices );
             break;
         }
         case SortMode::None: break;
@@ -249,19 +447,99 @@ namespace Components {
     }
 
     //----------------------------------------------------------------------
-    void ParticleSystem::_UpdateMesh()
+    void ParticleSystem::_UpdateMesh( ParticleAlignment alignment )
     {
         auto& matrixStream = m_particleMesh->getVertexStream<DirectX::XMMATRIX>( SHADER_NAME_MODEL_MATRIX );
         auto& colorStream = m_particleMesh->getVertexStream<Math::Vec4>( Graphics::SID_VERTEX_COLOR );
-        for (U32 i = 0; i < m_currentParticleCount; ++i)
-        {
-            DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &m_particles[i].scale );
-            DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &m_particles[i].rotation );
-            DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &m_particles[i].position );
-            matrixStream[i] = DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
+        DirectX::XMMATRIX* matrices = matrixStream.map();
+        Math::Vec4* colors = colorStream.map();
+
+        const bool isAligned        = (alignment != ParticleAlignment::None);
+        const bool isSorted         = not m_sortIndices.empty();
+        const bool hasScaleCurve    = m_lifeTimeScaleCurve.isEnabled();
+        const bool hasRotationCurve = m_lifeTimeRotationCurve.isEnabled();
+        const bool hasColorCurve    = m_lifeTimeColorCurve.isEnabled();
+        const auto alignedRotation  = DirectX::XMLoadFloat4( &m_alignedRotation );
 
-            colorStream[i] = m_particles[i].color.normalized();
+        auto boundsMin = DirectX::XMVectorReplicate( std::numeric_limits<F32>::max() );
+        auto boundsMax = DirectX::XMVectorReplicate( -std::numeric_limits<F32>::max() );
+        F32 maxScale = 0.0f;
+
+        for (U32 slot = 0; slot < m_currentParticleCount; ++slot)
+        {
+            U32 i = isSorted ? m_sortIndices[slot] : slot;
+            U8 curveIndex = m_particles.curveIndex[i];
+
+            F32 scale = m_particles.spawnScale[i];
+            if (hasScaleCurve)
+                scale *= m_lifeTimeScaleCurve[curveIndex];
+
+            auto rotation = DirectX::XMLoadFloat4( &m_particles.spawnRotation[i] );
+            if (hasRotationCurve)
+                rotation = DirectX::XMQuaternionMultiply( rotation, DirectX::XMLoadFloat4( &m_lifeTimeRotationCurve[curveIndex] ) );
+            if (isAligned)
+                rotation = DirectX::XMQuaternionMultiply( rotation, alignedRotation );
+
+            // Same as XMMatrixAffineTransformation() with an uniform scale and no rotation origin
+            auto vScale = DirectX::XMVectorReplicate( scale );
+            auto matrix = DirectX::XMMatrixRotationQuaternion( rotation );
+            matrix.r[0] = DirectX::XMVectorMultiply( matrix.r[0], vScale );
+            matrix.r[1] = DirectX::XMVectorMultiply( matrix.r[1], vScale );
+            matrix.r[2] = DirectX::XMVectorMultiply( matrix.r[2], vScale );
+            matrix.r[3] = DirectX::XMVectorSet( m_particles.positionX[i], m_particles.positionY[i], m_particles.positionZ[i], 1.0f );
+            matrices[slot] = matrix;
+
+            boundsMin = DirectX::XMVectorMin( boundsMin, matrix.r[3] );
+            boundsMax = DirectX::XMVectorMax( boundsMax, matrix.r[3] );
+            maxScale = std::max( maxScale, scale );
+
+            auto color = DirectX::XMLoadFloat4( &m_particles.spawnColor[i] );
+            if (hasColorCurve)
+                color = DirectX::XMVectorMultiply( color, DirectX::XMLoadFloat4( &m_lifeTimeColorCurve[curveIndex] ) );
+            DirectX::XMStoreFloat4( &colors[slot], color );
         }
+
+        Math::Vec3 min, max;
+        DirectX::XMStoreFloat3( &min, boundsMin );
+        DirectX::XMStoreFloat3( &max, boundsMax );
+        m_localBounds = Math::AABB( min, max );
+        m_maxParticleScale = maxScale;
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleSystem::ParticleData::resize( U32 size )
+    {
+        remainingLifetime.resize( size );
+        startLifetime.resize( size );
+        invStartLifetime.resize( size );
+        positionX.resize( size );
+        positionY.resize( size );
+        positionZ.resize( size );
+        spawnVelocityX.resize( size );
+        spawnVelocityY.resize( size );
+        spawnVelocityZ.resize( size );
+        spawnScale.resize( size );
+        spawnRotation.resize( size );
+        spawnColor.resize( size );
+        curveIndex.resize( size );
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleSystem::ParticleData::copy( U32 dst, U32 src )
+    {
+        remainingLifetime[dst]  = remainingLifetime[src];
+        startLifetime[dst]      = startLifetime[src];
+        invStartLifetime[dst]   = invStartLifetime[src];
+        positionX[dst]          = positionX[src];
+        positionY[dst]          = positionY[src];
+        positionZ[dst]          = positionZ[src];
+        spawnVelocityX[dst]     = spawnVelocityX[src];
+        spawnVelocityY[dst]     = spawnVelocityY[src];
+        spawnVelocityZ[dst]     = spawnVelocityZ[src];
+        spawnScale[dst]         = spawnScale[src];
+        spawnRotation[dst]      = spawnRotation[src];
+        spawnColor[dst]         = spawnColor[src];
+        curveIndex[dst]         = curveIndex[src];
     }
 
     //----------------------------------------------------------------------
@@ -460,7 +738,7 @@ namespace Components {
                                 F32 val = it.value();
                                 m_dataMap[keyAsNum] = val;
                             }
-                            m_lifeTimeScaleFnc = LinearLerpBetweenValues( m_dataMap );
+                            setLifetimeScaleFnc( LinearLerpBetweenValues( m_dataMap ) );
                         }
                     }
                 }
@@ -487,7 +765,7 @@ namespace Components {
                             auto val = ParseVec3( it.value() );
                             m_dataMap[keyAsNum] = Math::Quat::FromEulerAngles( val );
                         }
-                        m_lifeTimeRotationFnc = LinearLerpBetweenValues( m_dataMap );
+                        setLifetimeRotationFnc( LinearLerpBetweenValues( m_dataMap ) );
                     }
                 }
 
@@ -513,7 +791,7 @@ namespace Components {
                             auto val = ParseColor( it.value() );
                             m_dataMap[keyAsNum] = val;
                         }
-                        m_lifeTimeColorFnc = LinearLerpBetweenValues( m_dataMap );
+                        setLifetimeColorFnc( LinearLerpBetweenValues( m_dataMap ) );
                     }
                 }
 
@@ -539,7 +817,7 @@ namespace Components {
                             auto val = ParseVec3( it.value() );
                             m_dataMap[keyAsNum] = val;
                         }
-                        m_lifeTimeVelocityFnc = LinearLerpBetweenValues( m_dataMap );
+                        setLifetimeVelocityFnc( LinearLerpBetweenValues( m_dataMap ) );
                     }
                 }
            }
@@ -12,6 +12,9 @@
 #include "Time/clock.h"
 #include "Math/random.h"
 #include "Math/math_utils.h"
+#include "Math/aabb.h"
+
+namespace Core { class ParticleManager; }
 
 namespace Components {
 
@@ -121,6 +124,16 @@ namespace Components {
             View,
         };
 
+        //----------------------------------------------------------------------
+        // What happens to the simulation while the particle system is not visible by any camera
+        //----------------------------------------------------------------------
+        enum class CullingMode
+        {
+            AlwaysSimulate, // Simulated as if it were visible
+            Pause,          // Simulation stops and continues where it stopped once visible again
+            CatchUp,        // Simulation stops. Once visible again the skipped time (up to the catch-up limit) is simulated in a few coarse steps.
+        };
+
         //----------------------------------------------------------------------
         const MaterialPtr&  getMaterial()               const { return m_material; }
         const MeshPtr&      getMesh()                   const { return m_particleMesh; }
@@ -131,6 +144,10 @@ namespace Components {
         F32                 getGravity()                const { return m_gravity;}
         SortMode            getSortMode()               const { return m_sortMode; }
         ParticleAlignment   getParticleAlignment()      const { return m_particleAlignment; }
+        CullingMode         getCullingMode()            const { return m_cullingMode; }
+        Time::Seconds       getCatchUpLimit()           const { return m_catchUpLimit; }
+        Time::Seconds       getPrewarmTime()            const { return m_prewarmTime; }
+        U32                 getRandomSeed()             const { return m_randomSeed; }
         Time::Clock&        getClock()                        { return m_clock; }
 
         void setMesh                (const MeshPtr& mesh)           { m_particleMesh = mesh; play(); }
@@ -140,6 +157,19 @@ namespace Components {
         void setGravity             (F32 gravity)                   { m_gravity = gravity; }
         void setSortMode            (SortMode sortMode)           { m_sortMode = sortMode; }
         void setParticleAlignment   (ParticleAlignment alignment) { m_particleAlignment = alignment; }
+        void setCullingMode         (CullingMode cullingMode)     { m_cullingMode = cullingMode; }
+        void setCatchUpLimit        (Time::Seconds limit)         { m_catchUpLimit = limit; }
+
+        //----------------------------------------------------------------------
+        // Time simulated at once when the particle system starts playing, so it does not start empty.
+        //----------------------------------------------------------------------
+        void setPrewarmTime         (Time::Seconds prewarmTime)   { m_prewarmTime = prewarmTime; play(); }
+
+        //----------------------------------------------------------------------
+        // All random spawn values are drawn from an own stream with this seed, which restarts on play().
+        // The same seed always produces the same particles, no matter on which thread the system is updated.
+        //----------------------------------------------------------------------
+        void setRandomSeed          (U32 seed)                    { m_randomSeed = seed; play(); }
 
         //----------------------------------------------------------------------
         void setSpawnLifetimeFnc    (const std::function<F32()>& fnc)       { m_spawnLifeTimeFnc = fnc; }
@@ -149,10 +179,13 @@ namespace Components {
         void setSpawnVelocityFunc   (const std::function<Math::Vec3()> fnc) { m_spawnVelocityFnc = fnc; }
         void setSpawnRotationFunc   (const std::function<Math::Quat()> fnc) { m_spawnRotationFnc = fnc; }
 
-        void setLifetimeColorFnc    (const std::function<Color(F32)>& fnc)      { m_lifeTimeColorFnc = fnc; }
-        void setLifetimeScaleFnc    (const std::function<F32(F32)>& fnc)        { m_lifeTimeScaleFnc = fnc; }
-        void setLifetimeRotationFnc (const std::function<Math::Quat(F32)>& fnc) { m_lifeTimeRotationFnc = fnc; }
-        void setLifetimeVelocityFnc (const std::function<Math::Vec3(F32)>& fnc) { m_lifeTimeVelocityFnc = fnc; }
+        //----------------------------------------------------------------------
+        // Lifetime functions are baked into a lookup table when set. Pass nullptr to disable one.
+        //----------------------------------------------------------------------
+        void setLifetimeColorFnc    (const std::function<Color(F32)>& fnc);
+        void setLifetimeScaleFnc    (const std::function<F32(F32)>& fnc)        { m_lifeTimeScaleCurve.bake( fnc ); }
+        void setLifetimeRotationFnc (const std::function<Math::Quat(F32)>& fnc) { m_lifeTimeRotationCurve.bake( fnc ); }
+        void setLifetimeVelocityFnc (const std::function<Math::Vec3(F32)>& fnc) { m_lifeTimeVelocityCurve.bake( fnc ); }
 
         //----------------------------------------------------------------------
         // Begins playing this particle system from the beginning.
@@ -163,6 +196,11 @@ namespace Components {
         void pause() { m_paused = true; }
         void resume() { m_paused = false; }
 
+        //----------------------------------------------------------------------
+        bool hasAnimatedGeometry() const override { return not m_paused; }
+        bool getWorldBounds(Math::AABB* aabb) const override;
+        bool getLocalBounds(Math::AABB* aabb) const override;
+
     private:
         MeshPtr             m_particleMesh;
         MaterialPtr         m_material;
@@ -175,23 +213,81 @@ namespace Components {
         ParticleAlignment   m_particleAlignment = ParticleAlignment::None;
         F32                 m_accumulatedSpawnTime = 0.0f;
         bool                m_paused = false;
+        CullingMode         m_cullingMode = CullingMode::CatchUp;
+        Time::Seconds       m_catchUpLimit = 2_s;
+        Time::Seconds       m_prewarmTime = 0_s;
+
+        // Time which elapsed since the last simulation and time which is simulated in coarse steps before it
+        Time::Seconds       m_frameDelta = 0_s;
+        Time::Seconds       m_catchUpTime = 0_s;
 
+        U32                         m_randomSeed;
+        std::default_random_engine  m_random;
+
+        // Bounds of all particles in local space from the last simulation, without the particle size
+        Math::AABB          m_localBounds;
+        F32                 m_maxParticleScale = 0.0f;
+
+        // Cached on the main thread before the simulation, because it runs in a job
+        DirectX::XMMATRIX   m_worldMatrix;
+        Math::Vec3          m_eyePosition;
+        Math::Quat          m_alignedRotation;
+
+        //**********************************************************************
+        // Particles as structure of arrays. Simulated attributes are stored per component,
+        // so the update kernels process four particles per instruction. Attributes which are
+        // only read when writing the vertex streams are stored as whole vectors.
+        // All arrays are padded to a multiple of the simd width.
+        //**********************************************************************
+        struct ParticleData
+        {
+            ArrayList<F32>          remainingLifetime;
+            ArrayList<F32>          startLifetime;
+            ArrayList<F32>          invStartLifetime;
+            ArrayList<F32>          positionX, positionY, positionZ;
+            ArrayList<F32>          spawnVelocityX, spawnVelocityY, spawnVelocityZ;
+            ArrayList<F32>          spawnScale;
+            ArrayList<Math::Quat>   spawnRotation;
+            ArrayList<Math::Vec4>   spawnColor;
+            ArrayList<U8>           curveIndex; // Normalized lifetime as index into the lifetime curves
+
+            void resize(U32 size);
+            void copy(U32 dst, U32 src);
+        };
+        ParticleData m_particles;
+
+        // Draw order for SortMode::ByDistance, rebuilt every tick with a radix sort
+        ArrayList<U32> m_sortKeys;
+        ArrayList<U32> m_sortIndices;
+        ArrayList<U32> m_sortTemp[2];
+
+        //**********************************************************************
+        // Lifetime function sampled at a fixed resolution across the normalized lifetime.
         //**********************************************************************
-        struct Particle
+        template <typename T>
+        class LifetimeCurve
         {
-            Time::Seconds   startLifetime;
-            Time::Seconds   remainingLifetime;
-            Math::Vec3      position;
-            Math::Vec3      spawnScale;
-            Math::Vec3      scale;
-            Math::Quat      spawnRotation;
-            Math::Quat      rotation;
-            Math::Vec3      spawnVelocity;
-            Math::Vec3      velocity;
-            Color           spawnColor;
-            Color           color;
+        public:
+            static constexpr U32 RESOLUTION = 256;
+
+            void bake(const std::function<T(F32)>& fnc)
+            {
+                m_values.clear();
+                if (not fnc)
+                    return;
+
+                m_values.resize( RESOLUTION );
+                for (U32 i = 0; i < RESOLUTION; ++i)
+                    m_values[i] = fnc( i / F32( RESOLUTION - 1 ) );
+            }
+
+            bool        isEnabled()             const { return not m_values.empty(); }
+            const T&    operator[] (U32 index)  const { return m_values[index]; }
+
+        private:
+            ArrayList<T> m_values;
         };
-        ArrayList<Particle> m_particles;
+        static_assert( LifetimeCurve<F32>::RESOLUTION <= 256, "Curve index is stored in a byte." );
 
         //----------------------------------------------------------------------
         std::function<F32()>        m_spawnLifeTimeFnc  = Constant<F32>{ 4.0f };
@@ -201,18 +297,22 @@ namespace Components {
         std::function<Math::Vec3()> m_spawnPositionFnc  = ShapeBox{ {-1,-1,-1}, {1,1,1} };
         std::function<Math::Vec3()> m_spawnVelocityFnc  = Constant<Math::Vec3>{ {0,0,0} };
 
-        std::function<Color(F32)>       m_lifeTimeColorFnc = nullptr;
-        std::function<F32(F32)>         m_lifeTimeScaleFnc = nullptr;
-        std::function<Math::Quat(F32)>  m_lifeTimeRotationFnc = nullptr;
-        std::function<Math::Vec3(F32)>  m_lifeTimeVelocityFnc = nullptr;
+        LifetimeCurve<Math::Vec4>   m_lifeTimeColorCurve;
+        LifetimeCurve<F32>          m_lifeTimeScaleCurve;
+        LifetimeCurve<Math::Quat>   m_lifeTimeRotationCurve;
+        LifetimeCurve<Math::Vec3>   m_lifeTimeVelocityCurve;
 
         //----------------------------------------------------------------------
+        friend class Core::ParticleManager;
+        void _PrepareSimulation();
+        bool _UpdateVisibility(bool isVisible);
+        void _Simulate();
+        void _Step(Time::Seconds delta);
         void _SpawnParticles(Time::Seconds delta);
         void _SpawnParticle(U32 particleIndex);
         void _UpdateParticles(Time::Seconds delta);
-        void _AlignParticles(ParticleAlignment alignment);
         void _SortParticles(SortMode sortMode);
-        void _UpdateMesh();
+        void _UpdateMesh(ParticleAlignment alignment);
 
         void _LoadFromFile(const OS::Path& path);
 
@@ -60,40 +60,69 @@ namespace Components {
         m_camera->setZFar( getRange() );
 
         auto transform = getGameObject()->getTransform();
-
+        auto lightPos = transform->getWorldPosition();
+
+        // Only renderer within range of the light can cast a shadow into any face. The spatial index
+        // stores enlarged bounds, so the exact bounds are tested once here instead of in every face.
+        m_shadowCasterStats = {};
+        ArrayList<IRenderComponent*> shadowCasters;
+        scene.getComponentManager().getSpatialIndex().queryRenderer( lightPos, getRange(), shadowCasters );
+        shadowCasters.erase( std::remove_if( shadowCasters.begin(), shadowCasters.end(), [&](IRenderComponent* renderer) {
+            if ( not renderer->isActive() || not renderer->isCastingShadows() )
+                return true;
+            Math::AABB bounds;
+            return renderer->getWorldBounds( &bounds ) && not bounds.overlaps( lightPos, getRange() );
+        } ), shadowCasters.end() );
+
+        // Faces whose casters did not change keep their content from the last time they were rendered
+        ArrayList<IRenderComponent*> faceCasters;
         for (I32 face = 0; face < 6; face++)
         {
-            auto worldPos = DirectX::XMLoadFloat3( &transform->getWorldPosition() );
+            auto worldPos = DirectX::XMLoadFloat3( &lightPos );
             auto view = DirectX::XMMatrixLookToLH( worldPos, directions[face], ups[face] );
             m_camera->setViewMatrix( view );
 
-            // Set camera
-            cmd.setCamera( *m_camera );
-
-            // Record commands for every rendering component
-            for ( auto& renderer : scene.getComponentManager().getRenderer() )
-            {
-                if ( not renderer->isActive() || not renderer->isCastingShadows() )
-                    continue;
-
-                // Check if component is visible
-                bool isVisible = renderer->cull( *m_camera );
-                if (isVisible)
-                    renderer->recordGraphicsCommands( cmd );
-            }
+            if ( not _CollectShadowCasters( face, scene, shadowCasters, faceCasters ) )
+                continue;
 
+            // Set camera and record commands for every rendering component visible in this face
+            cmd.setCamera( *m_camera );
+            _RecordShadowCasters( cmd, faceCasters );
             cmd.endCamera();
 
             cmd.copyTexture( m_camera->getRenderTarget()->getDepthBuffer(), 0, 0, m_light->getShadowMap(), face, 0 );
         }
 
-        Locator::getRenderer().dispatch( cmd );
+        if (m_shadowCasterStats.numPassesRendered > 0)
+            Locator::getRenderer().dispatch( cmd );
     }
 
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
 
+    //----------------------------------------------------------------------
+    bool PointLight::getWorldBounds( Math::AABB* aabb ) const
+    {
+        *aabb = Math::AABB::FromSphere( getGameObject()->getTransform()->getWorldPosition(), getRange() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool PointLight::getLocalBounds( Math::AABB* aabb ) const
+    {
+        *aabb = Math::AABB::FromSphere( Math::Vec3( 0, 0, 0 ), getRange() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool PointLight::getBoundingSphere( Math::Vec3* center, F32* radius ) const
+    {
+        *center = getGameObject()->getTransform()->getWorldPosition();
+        *radius = getRange();
+        return true;
+    }
+
 
     //**********************************************************************
     // PRIVATE
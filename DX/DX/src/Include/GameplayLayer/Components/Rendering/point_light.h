@@ -24,6 +24,11 @@ namespace Components {
         //----------------------------------------------------------------------
         F32 getRange() const { return m_pointLight->getRange(); }
 
+        //----------------------------------------------------------------------
+        bool getWorldBounds(Math::AABB* aabb) const override;
+        bool getLocalBounds(Math::AABB* aabb) const override;
+        bool getBoundingSphere(Math::Vec3* center, F32* radius) const override;
+
         //----------------------------------------------------------------------
         void setRange(F32 range) { m_pointLight->setRange(range); }
 
@@ -6,7 +6,11 @@
     date: October 29, 2018
 
     Takes in a skin and an animation and plays the animation for a
-    given mesh and shader.
+    given mesh and shader. The animation clip is shared between all
+    renderers playing it, each renderer only keeps its own playback
+    state (clock + key cursors).
+    The pose itself is not updated in tick(), but by the animation system
+    before the frame is rendered (see Core::AnimationSystem).
 **********************************************************************/
 
 #include "mesh_renderer.h"
@@ -14,6 +18,8 @@
 #include "Animation/skeleton.h"
 #include "Animation/animation_clip.h"
 
+namespace Core { class AnimationSystem; }
+
 namespace Components {
 
     //**********************************************************************
@@ -25,20 +31,24 @@ namespace Components {
         // a given animation and skeleton. Note that the shader from the given material
         // should be suitable for skinning. Component warns if that is not the case.
         //----------------------------------------------------------------------
-        SkinnedMeshRenderer(const MeshPtr& mesh, const Animation::Skeleton& skeleton, const Animation::AnimationClip& animation, const MaterialPtr& material = nullptr);
+        SkinnedMeshRenderer(const MeshPtr& mesh, const Animation::Skeleton& skeleton, const Animation::AnimationClipPtr& animation, const MaterialPtr& material = nullptr);
 
         //----------------------------------------------------------------------
-        // Updates current played animation.
+        // Advances the clock of the current played animation.
         //----------------------------------------------------------------------
         void tick(Time::Seconds delta) override;
 
         //----------------------------------------------------------------------
         // Start playing the given animation
         //----------------------------------------------------------------------
-        void playAnimation(const Animation::AnimationClip& animation);
+        void playAnimation(const Animation::AnimationClipPtr& animation);
+
+        //----------------------------------------------------------------------
+        bool hasAnimatedGeometry() const override { return true; }
 
         //----------------------------------------------------------------------
         Time::Clock& getClock() { return m_clock; }
+        const Animation::AnimationClipPtr&  getAnimation()          const { return m_animation; }
         const ArrayList<DirectX::XMMATRIX>& getMatrixPalette()      const { return m_matrixPalette; }
         const ArrayList<DirectX::XMMATRIX>& getJointWorldMatrices() const { return m_jointWorldMatrices; }
 
@@ -48,11 +58,15 @@ namespace Components {
         ArrayList<DirectX::XMMATRIX>    m_matrixPalette;
         ArrayList<DirectX::XMMATRIX>    m_jointWorldMatrices;
         Animation::Skeleton             m_skeleton;
-        Animation::AnimationClip        m_animation;
+        Animation::AnimationClipPtr     m_animation;
+        ArrayList<Animation::JointCursor> m_jointCursors;
+        bool                            m_poseDirty  = true;  // Clock changed since the last pose update
+        bool                            m_poseStale = true; // Not updated since it was skipped for being invisible
 
-        DirectX::XMVECTOR _GetInterpolatedTranslation(U32 joint, Time::Seconds clockTime);
-        DirectX::XMVECTOR _GetInterpolatedRotation(U32 joint, Time::Seconds clockTime);
-        DirectX::XMVECTOR _GetInterpolatedScale(U32 joint, Time::Seconds clockTime);
+        //----------------------------------------------------------------------
+        friend class Core::AnimationSystem;
+        void _SampleLocalPose(DirectX::XMMATRIX* localPoses);
+        void _UpdateMatrixPalette(const DirectX::XMMATRIX* localPoses);
 
         //----------------------------------------------------------------------
         // IRendererComponent Interface
@@ -44,6 +44,28 @@ namespace Components {
     // PUBLIC
     //**********************************************************************
 
+    //----------------------------------------------------------------------
+    bool SpotLight::getWorldBounds( Math::AABB* aabb ) const
+    {
+        *aabb = Math::AABB::FromSphere( getGameObject()->getTransform()->getWorldPosition(), getRange() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool SpotLight::getLocalBounds( Math::AABB* aabb ) const
+    {
+        *aabb = Math::AABB::FromSphere( Math::Vec3( 0, 0, 0 ), getRange() );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    bool SpotLight::getBoundingSphere( Math::Vec3* center, F32* radius ) const
+    {
+        *center = getGameObject()->getTransform()->getWorldPosition();
+        *radius = getRange();
+        return true;
+    }
+
     //----------------------------------------------------------------------
     F32 SpotLight::getAngle() const
     {
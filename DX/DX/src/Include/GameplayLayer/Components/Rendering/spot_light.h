@@ -25,6 +25,11 @@ namespace Components {
         F32     getRange()      const { return m_spotLight->getRange(); }
         F32     getAngle()      const;
 
+        //----------------------------------------------------------------------
+        bool getWorldBounds(Math::AABB* aabb) const override;
+        bool getLocalBounds(Math::AABB* aabb) const override;
+        bool getBoundingSphere(Math::Vec3* center, F32* radius) const override;
+
         //----------------------------------------------------------------------
         void setRange       (F32 range)     { m_spotLight->setRange(range); }
         void setAngle       (F32 angle);
@@ -48,9 +48,9 @@ namespace Components {
         X3DAUDIO_EMITTER emitter = {};
         emitter.ChannelCount        = INPUTCHANNELS;
         emitter.CurveDistanceScaler = m_innerRadius;
-        emitter.OrientFront         = transform->rotation.getForward();
-        emitter.OrientTop           = transform->rotation.getUp();
-        emitter.Position            = transform->position;
+        emitter.OrientFront         = transform->getRotation().getForward();
+        emitter.OrientTop           = transform->getRotation().getUp();
+        emitter.Position            = transform->getPosition();
 
         // Update 3d-settings from audio-clip
         m_audioClip->update3D( emitter );
@@ -9,6 +9,11 @@
 #include "Rendering/camera.h"
 #include "Rendering/i_render_component.hpp"
 #include "Rendering/i_light_component.h"
+#include "Rendering/skinned_mesh_renderer.h"
+#include "Rendering/particle_system.h"
+#include "spatial_index.h"
+#include "transform_hierarchy.h"
+#include "transform.h"
 
 namespace Components {
 
@@ -23,6 +28,20 @@ namespace Components {
         const ArrayList<Camera*>&           getCameras()    const { return m_pCameras; }
         const ArrayList<IRenderComponent*>& getRenderer()   const { return m_pRenderer; }
         const ArrayList<ILightComponent*>&  getLights()     const { return m_pLights; }
+        const ArrayList<SkinnedMeshRenderer*>& getSkinnedMeshRenderer() const { return m_pSkinnedMeshRenderer; }
+        const ArrayList<ParticleSystem*>&   getParticleSystems() const { return m_pParticleSystems; }
+
+        //----------------------------------------------------------------------
+        // Bounding volume hierarchy of all renderer + lights. Use this for visibility queries.
+        //----------------------------------------------------------------------
+        const SpatialIndex&                 getSpatialIndex() const { return m_spatialIndex; }
+        SpatialIndex&                       getSpatialIndex()       { return m_spatialIndex; }
+
+        //----------------------------------------------------------------------
+        // All transforms sorted by depth. Updates the world matrices of the whole scene at once.
+        //----------------------------------------------------------------------
+        const TransformHierarchy&           getTransformHierarchy() const { return m_transformHierarchy; }
+        TransformHierarchy&                 getTransformHierarchy()       { return m_transformHierarchy; }
 
         //----------------------------------------------------------------------
         // Creates a new component of type T
@@ -44,6 +63,10 @@ namespace Components {
         ArrayList<Camera*>              m_pCameras;
         ArrayList<IRenderComponent*>    m_pRenderer;
         ArrayList<ILightComponent*>     m_pLights;
+        ArrayList<SkinnedMeshRenderer*> m_pSkinnedMeshRenderer;
+        ArrayList<ParticleSystem*>      m_pParticleSystems;
+        SpatialIndex                    m_spatialIndex;
+        TransformHierarchy              m_transformHierarchy;
 
         //----------------------------------------------------------------------
         template <typename T, typename... Args> T*   _Create( Args&&... args );
@@ -66,6 +89,11 @@ namespace Components {
     {
         T* component = new T( std::forward<Args>( args )... );
 
+        if constexpr( std::is_same<Transform, T>::value )
+        {
+            m_transformHierarchy.addTransform( component );
+        }
+
         if constexpr( std::is_same<Camera, T>::value )
         {
             m_pCameras.push_back( component );
@@ -74,11 +102,23 @@ namespace Components {
         if constexpr( std::is_base_of<IRenderComponent, T>::value )
         {
             m_pRenderer.push_back( component );
+            m_spatialIndex.addRenderer( component );
+        }
+
+        if constexpr( std::is_base_of<SkinnedMeshRenderer, T>::value )
+        {
+            m_pSkinnedMeshRenderer.push_back( component );
+        }
+
+        if constexpr( std::is_base_of<ParticleSystem, T>::value )
+        {
+            m_pParticleSystems.push_back( component );
         }
 
         if constexpr( std::is_base_of<ILightComponent, T>::value )
         {
             m_pLights.push_back( component );
+            m_spatialIndex.addLight( component );
         }
 
         return component;
@@ -88,14 +128,29 @@ namespace Components {
     template <typename T>
     void ComponentManager::_Destroy( T* component )
     {
+        if (auto t = dynamic_cast<Transform*>( component ))
+            m_transformHierarchy.removeTransform( t );
+
         if (auto c = dynamic_cast<Camera*>( component ))
             m_pCameras.erase( std::remove( m_pCameras.begin(), m_pCameras.end(), c ) );
 
         if (auto r = dynamic_cast<IRenderComponent*>( component ))
+        {
             m_pRenderer.erase( std::remove( m_pRenderer.begin(), m_pRenderer.end(), r) );
+            m_spatialIndex.removeRenderer( r );
+        }
+
+        if (auto s = dynamic_cast<SkinnedMeshRenderer*>( component ))
+            m_pSkinnedMeshRenderer.erase( std::remove( m_pSkinnedMeshRenderer.begin(), m_pSkinnedMeshRenderer.end(), s ) );
+
+        if (auto p = dynamic_cast<ParticleSystem*>( component ))
+            m_pParticleSystems.erase( std::remove( m_pParticleSystems.begin(), m_pParticleSystems.end(), p ) );
 
         if (auto l = dynamic_cast<ILightComponent*>( component ))
+        {
             m_pLights.erase( std::remove( m_pLights.begin(), m_pLights.end(), l ) );
+            m_spatialIndex.removeLight( l );
+        }
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "spatial_index.h"
+/**********************************************************************
+    class: SpatialIndex (spatial_index.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "Rendering/i_render_component.hpp"
+#include "Rendering/i_light_component.h"
+#include "Graphics/camera.h"
+#include "Physics/ray.h"
+#include "GameplayLayer/gameobject.h"
+
+namespace Components {
+
+    //**********************************************************************
+    // COMPONENT TREE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void SpatialIndex::ComponentTree<T>::add( T* component )
+    {
+        ASSERT( m_entryIndices.count( component ) == 0 );
+
+        // Bounds are not known yet (component is not attached to a gameobject), so the proxy gets created on the next update
+        m_entryIndices[component] = static_cast<U32>( m_entries.size() );
+        m_entries.push_back( { component, Math::DynamicAABBTree::NULL_NODE } );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void SpatialIndex::ComponentTree<T>::remove( T* component )
+    {
+        auto it = m_entryIndices.find( component );
+        if ( it == m_entryIndices.end() )
+            return;
+
+        U32 index = it->second;
+        if (m_entries[index].proxyID != Math::DynamicAABBTree::NULL_NODE)
+            m_tree.destroyProxy( m_entries[index].proxyID );
+
+        // Swap with the last entry to keep the list dense
+        m_entries[index] = m_entries.back();
+        m_entryIndices[m_entries[index].component] = index;
+        m_entries.pop_back();
+        m_entryIndices.erase( it );
+
+        m_unbounded.erase( std::remove( m_unbounded.begin(), m_unbounded.end(), component ), m_unbounded.end() );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void SpatialIndex::ComponentTree<T>::update()
+    {
+        m_unbounded.clear();
+
+        for (auto& entry : m_entries)
+        {
+            // Inactive components keep their old proxy, they are filtered out after each query anyway
+            if ( not entry.component->isActive() )
+                continue;
+
+            Math::AABB localBounds;
+            if ( entry.component->getLocalBounds( &localBounds ) )
+            {
+                // Nothing changed since the last refit, so the proxy is still valid
+                U64 worldVersion = entry.component->getGameObject()->getTransform()->getWorldVersion();
+                if ( entry.proxyID != Math::DynamicAABBTree::NULL_NODE && entry.worldVersion == worldVersion && entry.localBounds == localBounds )
+                    continue;
+
+                entry.worldVersion = worldVersion;
+                entry.localBounds  = localBounds;
+
+                Math::AABB bounds;
+                entry.component->getWorldBounds( &bounds );
+                if (entry.proxyID == Math::DynamicAABBTree::NULL_NODE)
+                    entry.proxyID = m_tree.createProxy( bounds, entry.component );
+                else
+                    m_tree.moveProxy( entry.proxyID, bounds );
+            }
+            else
+            {
+                if (entry.proxyID != Math::DynamicAABBTree::NULL_NODE)
+                {
+                    m_tree.destroyProxy( entry.proxyID );
+                    entry.proxyID = Math::DynamicAABBTree::NULL_NODE;
+                }
+                m_unbounded.push_back( entry.component );
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    template <typename TestFunc>
+    void SpatialIndex::ComponentTree<T>::query( TestFunc test, ArrayList<T*>& result ) const
+    {
+        result.insert( result.end(), m_unbounded.begin(), m_unbounded.end() );
+
+        m_tree.query( test, [&result](I32 proxyID, void* userData) {
+            result.push_back( static_cast<T*>( userData ) );
+            return true;
+        } );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void SpatialIndex::addRenderer( IRenderComponent* renderer )    { m_renderer.add( renderer ); }
+    void SpatialIndex::removeRenderer( IRenderComponent* renderer ) { m_renderer.remove( renderer ); }
+    void SpatialIndex::addLight( ILightComponent* light )           { m_lights.add( light ); }
+    void SpatialIndex::removeLight( ILightComponent* light )        { m_lights.remove( light ); }
+
+    //----------------------------------------------------------------------
+    void SpatialIndex::update()
+    {
+        m_renderer.update();
+        m_lights.update();
+    }
+
+    //----------------------------------------------------------------------
+    void SpatialIndex::queryRenderer( const Graphics::Camera& camera, ArrayList<IRenderComponent*>& result ) const
+    {
+        m_renderer.query( [&camera](const Math::AABB& aabb) { return camera.cull( aabb ); }, result );
+    }
+
+    //----------------------------------------------------------------------
+    void SpatialIndex::queryRenderer( const Math::Vec3& center, F32 radius, ArrayList<IRenderComponent*>& result ) const
+    {
+        m_renderer.query( [&](const Math::AABB& aabb) { return aabb.overlaps( center, radius ); }, result );
+    }
+
+    //----------------------------------------------------------------------
+    void SpatialIndex::queryLights( const Graphics::Camera& camera, ArrayList<ILightComponent*>& result ) const
+    {
+        m_lights.query( [&camera](const Math::AABB& aabb) { return camera.cull( aabb ); }, result );
+    }
+
+    //----------------------------------------------------------------------
+    IRenderComponent* SpatialIndex::raycast( const Physics::Ray& ray, F32* distance ) const
+    {
+        IRenderComponent* nearest = nullptr;
+        F32 nearestDistance = std::numeric_limits<F32>::max();
+
+        // Skip every subtree which is hit further away than the nearest hit so far
+        auto test = [&](const Math::AABB& aabb) {
+            F32 t;
+            return ray.intersects( aabb, &t ) && t < nearestDistance;
+        };
+
+        m_renderer.getTree().query( test, [&](I32 proxyID, void* userData) {
+            auto renderer = static_cast<IRenderComponent*>( userData );
+            if ( not renderer->isActive() )
+                return true;
+
+            // Intersect with the exact bounds, the tree only stores the enlarged bounds
+            Math::AABB bounds;
+            F32 t;
+            if ( renderer->getWorldBounds( &bounds ) && ray.intersects( bounds, &t ) && t < nearestDistance )
+            {
+                nearestDistance = t;
+                nearest = renderer;
+            }
+            return true;
+        } );
+
+        if (nearest && distance)
+            *distance = nearestDistance;
+
+        return nearest;
+    }
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+/**********************************************************************
+    class: SpatialIndex (spatial_index.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Keeps the world space bounds of all renderer and light components
+    of a scene in dynamic aabb trees, so visibility queries do not
+    have to iterate over every component in the scene.
+    Components without finite bounds (e.g. directional lights or
+    particle systems) are reported by every query.
+**********************************************************************/
+
+#include "Math/dynamic_aabb_tree.h"
+
+namespace Graphics { class Camera; }
+namespace Physics { class Ray; }
+
+namespace Components {
+
+    class IRenderComponent;
+    class ILightComponent;
+
+    //**********************************************************************
+    class SpatialIndex
+    {
+    public:
+        SpatialIndex() = default;
+        ~SpatialIndex() = default;
+
+        //----------------------------------------------------------------------
+        void addRenderer    (IRenderComponent* renderer);
+        void removeRenderer (IRenderComponent* renderer);
+        void addLight       (ILightComponent* light);
+        void removeLight    (ILightComponent* light);
+
+        //----------------------------------------------------------------------
+        // Refits the bounds of all active components whose transform or local bounds
+        // changed since the last update. Proxies are only reinserted into the tree
+        // if they moved out of their fat bounds.
+        // Must be called once per frame before any query.
+        //----------------------------------------------------------------------
+        void update();
+
+        //----------------------------------------------------------------------
+        // Collect every renderer whose bounds intersect the frustum of the given camera.
+        // The result is conservative, each renderer should still be culled individually.
+        //----------------------------------------------------------------------
+        void queryRenderer(const Graphics::Camera& camera, ArrayList<IRenderComponent*>& result) const;
+
+        //----------------------------------------------------------------------
+        // Collect every renderer whose bounds intersect the given sphere.
+        //----------------------------------------------------------------------
+        void queryRenderer(const Math::Vec3& center, F32 radius, ArrayList<IRenderComponent*>& result) const;
+
+        //----------------------------------------------------------------------
+        // Collect every light whose range intersects the frustum of the given camera.
+        //----------------------------------------------------------------------
+        void queryLights(const Graphics::Camera& camera, ArrayList<ILightComponent*>& result) const;
+
+        //----------------------------------------------------------------------
+        // Cast the given ray against the world bounds of all active renderer.
+        // @Params:
+        //  "distance": Optional. Stores the distance from the ray origin to the hitpoint.
+        // @Return:
+        //  The hit renderer nearest to the ray origin. Nullptr if nothing was hit.
+        //----------------------------------------------------------------------
+        IRenderComponent* raycast(const Physics::Ray& ray, F32* distance = nullptr) const;
+
+    private:
+        //**********************************************************************
+        // Component list + tree with the bounds of all bounded components
+        //**********************************************************************
+        template <typename T>
+        class ComponentTree
+        {
+        public:
+            ComponentTree() = default;
+
+            void add(T* component);
+            void remove(T* component);
+            void update();
+
+            template <typename TestFunc>
+            void query(TestFunc test, ArrayList<T*>& result) const;
+
+            const Math::DynamicAABBTree& getTree() const { return m_tree; }
+
+        private:
+            struct Entry
+            {
+                T*          component;
+                I32         proxyID;
+                U64         worldVersion = 0;   // World version of the transform at the last refit
+                Math::AABB  localBounds;        // Local bounds at the last refit
+            };
+
+            Math::DynamicAABBTree       m_tree;
+            ArrayList<Entry>            m_entries;
+            HashMap<T*, U32>            m_entryIndices;
+            ArrayList<T*>               m_unbounded;
+
+            NULL_COPY_AND_ASSIGN(ComponentTree)
+        };
+
+        ComponentTree<IRenderComponent> m_renderer;
+        ComponentTree<ILightComponent>  m_lights;
+
+        NULL_COPY_AND_ASSIGN(SpatialIndex)
+    };
+
+}
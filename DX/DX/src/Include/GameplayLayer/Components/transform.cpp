@@ -10,71 +10,69 @@
 
 namespace Components {
 
+    std::atomic<U64> Transform::s_versionCounter{ 0 };
+    std::atomic<U64> Transform::s_parentingVersion{ 0 };
+
+    //----------------------------------------------------------------------
+    Transform::~Transform()
+    {
+        if ( not m_pParent && m_pChildren.empty() )
+            return;
+
+        // Neither the parent nor the children must keep a pointer to this transform
+        if (m_pParent)
+            _RemoveFromParent();
+
+        for (auto child : m_pChildren)
+        {
+            child->m_pParent = nullptr;
+            child->_SetWorldDirty();
+        }
+
+        s_parentingVersion++;
+    }
+
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
 
     //----------------------------------------------------------------------
-    void Transform::getWorldTransform( Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat )
+    void Transform::getWorldTransform( Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat ) const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
-        DirectX::XMStoreFloat3( pos, p );
-        DirectX::XMStoreFloat3( scale, s );
-        DirectX::XMStoreFloat4( quat, r );
+        _UpdateWorldDecomposition();
+        *pos   = getWorldPosition();
+        *scale = m_worldScale;
+        *quat  = m_worldRotation;
     }
 
     //----------------------------------------------------------------------
     Math::Vec3 Transform::getWorldPosition() const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
+        // Translation is stored in the last row, no need to decompose the whole matrix
         Math::Vec3 worldPos;
-        DirectX::XMStoreFloat3( &worldPos, p );
+        DirectX::XMStoreFloat3( &worldPos, getWorldMatrix().r[3] );
         return worldPos;
     }
 
     //----------------------------------------------------------------------
     Math::Vec3 Transform::getWorldScale() const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
-        Math::Vec3 worldScale;
-        DirectX::XMStoreFloat3( &worldScale, s );
-        return worldScale;
+        _UpdateWorldDecomposition();
+        return m_worldScale;
     }
 
     //----------------------------------------------------------------------
     Math::Quat Transform::getWorldRotation() const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
-        Math::Quat worldRotation;
-        DirectX::XMStoreFloat4( &worldRotation, r );
-        return worldRotation;
+        _UpdateWorldDecomposition();
+        return m_worldRotation;
     }
 
     //----------------------------------------------------------------------
     void Transform::lookAt( const Math::Vec3& target )
     {
-        Math::Vec3 forward = (target - position).normalized();
-        rotation = Math::Quat::LookRotation( forward, Math::Vec3::UP );
-    }
-
-    //----------------------------------------------------------------------
-    DirectX::XMMATRIX Transform::getWorldMatrix() const
-    {
-        auto transformationMatrix = _GetLocalTransformationMatrix();
-        if (m_pParent)
-        {
-            auto parentMatrix = m_pParent->getWorldMatrix();
-            return DirectX::XMMatrixMultiply( transformationMatrix, parentMatrix );
-        }
-        return transformationMatrix;
+        Math::Vec3 forward = (target - m_position).normalized();
+        setRotation( Math::Quat::LookRotation( forward, Math::Vec3::UP ) );
     }
 
     //----------------------------------------------------------------------
@@ -92,9 +90,10 @@ namespace Components {
             DirectX::XMVECTOR s, r, p;
             DirectX::XMMatrixDecompose( &s, &r, &p, matrix );
 
-            DirectX::XMStoreFloat3( &position, p );
-            DirectX::XMStoreFloat3( &scale, s );
-            DirectX::XMStoreFloat4( &rotation, r );
+            DirectX::XMStoreFloat3( &m_position, p );
+            DirectX::XMStoreFloat3( &m_scale, s );
+            DirectX::XMStoreFloat4( &m_rotation, r );
+            m_localDirty = true;
         }
 
         // Remove from current parent 
@@ -102,6 +101,10 @@ namespace Components {
             this->_RemoveFromParent();
 
         m_pParent = parent;
+        s_parentingVersion++;
+
+        // The world matrix depends on the new parent now
+        _SetWorldDirty();
 
         // Add to new parent
         if (m_pParent)
@@ -123,17 +126,75 @@ namespace Components {
     void Transform::_RemoveFromParent()
     {
         ASSERT( m_pParent );
-        m_pParent->m_pChildren.erase( std::remove( m_pParent->m_pChildren.begin(), m_pParent->m_pChildren.end(), this ) );
+        auto& siblings = m_pParent->m_pChildren;
+        siblings.erase( std::remove( siblings.begin(), siblings.end(), this ), siblings.end() );
+    }
+
+    //----------------------------------------------------------------------
+    void Transform::_SetLocalDirty()
+    {
+        m_localDirty = true;
+        _SetWorldDirty();
+    }
+
+    //----------------------------------------------------------------------
+    void Transform::_SetWorldDirty()
+    {
+        // Children of a dirty transform are dirty as well, nothing to propagate
+        if (m_worldDirty)
+            return;
+
+        m_worldDirty = true;
+        for (auto child : m_pChildren)
+            child->_SetWorldDirty();
+    }
+
+    //----------------------------------------------------------------------
+    void Transform::_UpdateLocalMatrix() const
+    {
+        if (not m_localDirty)
+            return;
+
+        DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &m_scale );
+        DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &m_rotation );
+        DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &m_position );
+        m_localMatrix = DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
+        m_localDirty  = false;
     }
 
     //----------------------------------------------------------------------
-    DirectX::XMMATRIX Transform::_GetLocalTransformationMatrix() const
+    void Transform::_UpdateWorldMatrix() const
     {
-        DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &scale );
-        DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &rotation );
-        DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &position );
+        if (not m_worldDirty)
+            return;
+
+        _UpdateLocalMatrix();
+        if (m_pParent)
+        {
+            m_pParent->_UpdateWorldMatrix();
+            m_worldMatrix = DirectX::XMMatrixMultiply( m_localMatrix, m_pParent->m_worldMatrix );
+        }
+        else
+        {
+            m_worldMatrix = m_localMatrix;
+        }
 
-        return DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
+        m_worldDirty   = false;
+        m_worldVersion = ++s_versionCounter;
+    }
+
+    //----------------------------------------------------------------------
+    void Transform::_UpdateWorldDecomposition() const
+    {
+        _UpdateWorldMatrix();
+        if (m_decomposedVersion == m_worldVersion)
+            return;
+
+        DirectX::XMVECTOR s, r, p;
+        DirectX::XMMatrixDecompose( &s, &r, &p, m_worldMatrix );
+        DirectX::XMStoreFloat3( &m_worldScale, s );
+        DirectX::XMStoreFloat4( &m_worldRotation, r );
+        m_decomposedVersion = m_worldVersion;
     }
 
 }
\ No newline at end of file
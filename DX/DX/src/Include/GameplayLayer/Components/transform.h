@@ -5,28 +5,53 @@
     author: S. Hau
     date: December 17, 2017
 
+    The local and world matrix are cached. The setters mark the local
+    matrix and the world matrices of this transform and all of its
+    children as dirty, so a read only rebuilds what actually changed.
+    Children of a dirty transform are always dirty as well, which stops
+    the propagation at the first transform which is already dirty.
+    Reads of a clean transform return immediately, without looking at
+    the parents.
+    The caches are filled lazily on read, so a transform must not be
+    read from several threads while it is being changed.
+    Once per frame all transforms of a scene are brought up to date in
+    one batch by the TransformHierarchy, so reads afterwards only hit
+    the caches.
 **********************************************************************/
 
 #include "i_component.h"
+#include <atomic>
 
 namespace Components {
 
     //**********************************************************************
     class Transform : public IComponent
     {
+        friend class TransformHierarchy;
+
     public:
         Transform() {}
+        ~Transform();
+
+        //----------------------------------------------------------------------
+        // Transformation relative to the parent.
+        //----------------------------------------------------------------------
+        const Math::Vec3&   getPosition()   const { return m_position; }
+        const Math::Vec3&   getScale()      const { return m_scale; }
+        const Math::Quat&   getRotation()   const { return m_rotation; }
 
-        Math::Vec3 position = Math::Vec3( 0.0f, 0.0f, 0.0f );
-        Math::Vec3 scale    = Math::Vec3( 1.0f, 1.0f, 1.0f );
-        Math::Quat rotation = Math::Quat( 0.0f, 0.0f, 0.0f, 1.0f );
+        void setPosition(const Math::Vec3& position)    { m_position = position; _SetLocalDirty(); }
+        void setScale(const Math::Vec3& scale)          { m_scale = scale;       _SetLocalDirty(); }
+        void setRotation(const Math::Quat& rotation)    { m_rotation = rotation; _SetLocalDirty(); }
+        void translate(const Math::Vec3& translation)   { setPosition( m_position + translation ); }
+        void rotate(const Math::Quat& rotation)         { setRotation( m_rotation * rotation ); }
 
         const ArrayList<Transform*>&    getChildren()   const { return m_pChildren; }
         const Transform*                getParent()     const { return m_pParent; }
         Math::Vec3                      getWorldPosition() const;
         Math::Vec3                      getWorldScale() const;
         Math::Quat                      getWorldRotation() const;
-        void                            getWorldTransform(Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat);
+        void                            getWorldTransform(Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat) const;
 
         //----------------------------------------------------------------------
         // Rotates this transform to look at the given target. 
@@ -53,14 +78,54 @@ namespace Components {
         //----------------------------------------------------------------------
         // Returns the final composited world transformation matrix.
         //----------------------------------------------------------------------
-        DirectX::XMMATRIX getWorldMatrix() const;
+        const DirectX::XMMATRIX& getWorldMatrix() const { _UpdateWorldMatrix(); return m_worldMatrix; }
+
+        //----------------------------------------------------------------------
+        // Returns the transformation matrix relative to the parent.
+        //----------------------------------------------------------------------
+        const DirectX::XMMATRIX& getLocalMatrix() const { _UpdateLocalMatrix(); return m_localMatrix; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  A number which changes whenever the world transform of this transform changed, e.g. because
+        //  this or a parent transform was moved or reparented. Use this to detect changes across frames.
+        //----------------------------------------------------------------------
+        U64 getWorldVersion() const { _UpdateWorldMatrix(); return m_worldVersion; }
 
     private:
         Transform*            m_pParent = nullptr;
         ArrayList<Transform*> m_pChildren;
 
+        Math::Vec3                  m_position          = Math::Vec3( 0.0f, 0.0f, 0.0f );
+        Math::Vec3                  m_scale             = Math::Vec3( 1.0f, 1.0f, 1.0f );
+        Math::Quat                  m_rotation          = Math::Quat( 0.0f, 0.0f, 0.0f, 1.0f );
+
+        mutable DirectX::XMMATRIX   m_localMatrix       = DirectX::XMMatrixIdentity();
+        mutable DirectX::XMMATRIX   m_worldMatrix       = DirectX::XMMatrixIdentity();
+        mutable bool                m_localDirty        = true;
+        mutable bool                m_worldDirty        = true;
+        mutable U64                 m_worldVersion      = 0; // Zero until the world matrix was built
+
+        // Decomposition of the world matrix, computed on demand
+        mutable Math::Vec3          m_worldScale;
+        mutable Math::Quat          m_worldRotation;
+        mutable U64                 m_decomposedVersion = 0;
+
+        // Versions are drawn from a global counter, so a version is never reused by a different state.
+        // Atomic, because the transform hierarchy updates independent transforms from several threads.
+        static std::atomic<U64>     s_versionCounter;
+
+        U32                         m_hierarchyIndex    = 0; // Index in the registered transforms of the TransformHierarchy
+
+        // Changes whenever any transform gets a new parent
+        static std::atomic<U64>     s_parentingVersion;
+
         inline void _RemoveFromParent();
-        inline DirectX::XMMATRIX _GetLocalTransformationMatrix() const;
+        void        _SetLocalDirty();
+        void        _SetWorldDirty();
+        void        _UpdateLocalMatrix() const;
+        void        _UpdateWorldMatrix() const;
+        inline void _UpdateWorldDecomposition() const;
 
         NULL_COPY_AND_ASSIGN(Transform)
     };
@@ -0,0 +1,222 @@
+#include "transform_hierarchy.h"
+/**********************************************************************
+    class: TransformHierarchy (transform_hierarchy.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "transform.h"
+#include "Core/locator.h"
+#include "Math/math_utils.h"
+
+namespace Components {
+
+    // Levels with less transforms are updated on the calling thread, because starting jobs would cost more
+    #define MIN_TRANSFORMS_PER_JOB  512
+
+    // Amount of local matrices which are built at once
+    static constexpr U32 SIMD_WIDTH = 4;
+
+    //----------------------------------------------------------------------
+    static U32 AlignToSimdWidth( U32 count ) { return (count + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1); }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void TransformHierarchy::addTransform( Transform* transform )
+    {
+        ASSERT( transform != nullptr );
+        transform->m_hierarchyIndex = static_cast<U32>( m_registered.size() );
+        m_registered.push_back( transform );
+        m_dirty = true;
+    }
+
+    //----------------------------------------------------------------------
+    void TransformHierarchy::removeTransform( Transform* transform )
+    {
+        U32 index = transform->m_hierarchyIndex;
+        ASSERT( index < m_registered.size() && m_registered[index] == transform );
+
+        // Move the last transform into the free slot
+        m_registered[index] = m_registered.back();
+        m_registered[index]->m_hierarchyIndex = index;
+        m_registered.pop_back();
+        m_dirty = true;
+    }
+
+    //----------------------------------------------------------------------
+    void TransformHierarchy::update()
+    {
+        if ( m_dirty || m_parentingVersion != Transform::s_parentingVersion )
+            _Sort();
+
+        m_stats.numUpdated = 0;
+        for (U32 level = 0; level + 1 < m_levelOffsets.size(); level++)
+        {
+            U32 levelBegin = m_levelOffsets[level];
+            U32 levelEnd   = m_levelOffsets[level + 1];
+            U32 count      = levelEnd - levelBegin;
+
+            U32 numJobs = std::min( m_numJobs, count / MIN_TRANSFORMS_PER_JOB );
+            if (numJobs <= 1)
+            {
+                m_stats.numUpdated += _UpdateRange( levelBegin, levelEnd );
+                continue;
+            }
+
+            // Transforms of the same level never depend on each other, so the ranges can be updated without synchronization.
+            // The ranges are a multiple of the simd width, so the padding of a batch never overlaps with the range of another job.
+            U32 transformsPerJob = AlignToSimdWidth( (count + numJobs - 1) / numJobs );
+            ArrayList<OS::JobPtr> jobs;
+            ArrayList<U32> numUpdated( numJobs, 0 );
+            for (U32 j = 0; j < numJobs; j++)
+            {
+                U32 begin = std::min( levelBegin + j * transformsPerJob, levelEnd );
+                U32 end   = std::min( begin + transformsPerJob, levelEnd );
+                jobs.push_back( ASYNC_JOB( [this, begin, end, j, &numUpdated] { numUpdated[j] = _UpdateRange( begin, end ); } ) );
+            }
+            for (auto& job : jobs)
+                job->wait();
+
+            for (U32 n : numUpdated)
+                m_stats.numUpdated += n;
+        }
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void TransformHierarchy::_Sort()
+    {
+        m_transforms.clear();
+        m_parents.clear();
+        m_levelOffsets.clear();
+
+        // Breadth first from all roots, so each level is contiguous and parents always come before their children
+        for (auto transform : m_registered)
+        {
+            if ( not transform->getParent() )
+            {
+                m_transforms.push_back( transform );
+                m_parents.push_back( -1 );
+            }
+        }
+
+        U32 levelBegin = 0;
+        while ( levelBegin < m_transforms.size() )
+        {
+            U32 levelEnd = static_cast<U32>( m_transforms.size() );
+            m_levelOffsets.push_back( levelBegin );
+
+            for (U32 i = levelBegin; i < levelEnd; i++)
+            {
+                for (auto child : m_transforms[i]->getChildren())
+                {
+                    m_transforms.push_back( child );
+                    m_parents.push_back( static_cast<I32>( i ) );
+                }
+            }
+
+            levelBegin = levelEnd;
+        }
+        m_levelOffsets.push_back( static_cast<U32>( m_transforms.size() ) );
+
+        // Zero versions force the first update to copy the matrices of the clean transforms
+        m_worldMatrices.assign( m_transforms.size(), DirectX::XMMatrixIdentity() );
+        m_worldVersions.assign( m_transforms.size(), 0 );
+
+        // The last batch of a range may read up to three entries past the range. The padding at the end
+        // is never written by a batch, an identity transformation keeps the unused lanes finite.
+        Size batchSize = m_transforms.size() + SIMD_WIDTH - 1;
+        m_batch.indices.assign( batchSize, 0 );
+        for (auto arr : { &m_batch.positionX, &m_batch.positionY, &m_batch.positionZ, &m_batch.rotationX, &m_batch.rotationY, &m_batch.rotationZ })
+            arr->assign( batchSize, 0.0f );
+        for (auto arr : { &m_batch.rotationW, &m_batch.scaleX, &m_batch.scaleY, &m_batch.scaleZ })
+            arr->assign( batchSize, 1.0f );
+
+        m_dirty = false;
+        m_parentingVersion = Transform::s_parentingVersion;
+
+        m_stats.numTransforms = static_cast<U32>( m_transforms.size() );
+        m_stats.numLevels     = static_cast<U32>( m_levelOffsets.size() - 1 );
+        m_stats.numRebuilds++;
+    }
+
+    //----------------------------------------------------------------------
+    U32 TransformHierarchy::_UpdateRange( U32 begin, U32 end )
+    {
+        // Pack the local transformation of every dirty transform to the front of the range
+        U32 batchEnd = begin;
+        for (U32 i = begin; i < end; i++)
+        {
+            auto transform = m_transforms[i];
+            if (not transform->m_worldDirty)
+            {
+                // The transform might have been updated lazily since the last frame
+                if (m_worldVersions[i] != transform->m_worldVersion)
+                {
+                    m_worldMatrices[i] = transform->m_worldMatrix;
+                    m_worldVersions[i] = transform->m_worldVersion;
+                }
+                continue;
+            }
+
+            auto& p = transform->m_position;
+            auto& r = transform->m_rotation;
+            auto& s = transform->m_scale;
+            m_batch.indices[batchEnd]   = i;
+            m_batch.positionX[batchEnd] = p.x; m_batch.positionY[batchEnd] = p.y; m_batch.positionZ[batchEnd] = p.z;
+            m_batch.rotationX[batchEnd] = r.x; m_batch.rotationY[batchEnd] = r.y; m_batch.rotationZ[batchEnd] = r.z; m_batch.rotationW[batchEnd] = r.w;
+            m_batch.scaleX[batchEnd]    = s.x; m_batch.scaleY[batchEnd]    = s.y; m_batch.scaleZ[batchEnd]    = s.z;
+            batchEnd++;
+        }
+
+        // Build the local matrices four at a time and combine them with the world matrices of the parents, which are up to date already
+        for (U32 b = begin; b < batchEnd; b += SIMD_WIDTH)
+        {
+            DirectX::XMMATRIX localMatrices[SIMD_WIDTH];
+            _ComposeLocalMatrices( b, localMatrices );
+
+            U32 numLanes = std::min( SIMD_WIDTH, batchEnd - b );
+            for (U32 lane = 0; lane < numLanes; lane++)
+            {
+                U32 i = m_batch.indices[b + lane];
+                I32 parent = m_parents[i];
+                m_worldMatrices[i] = parent < 0 ? localMatrices[lane] : DirectX::XMMatrixMultiply( localMatrices[lane], m_worldMatrices[parent] );
+
+                auto transform = m_transforms[i];
+                transform->m_localMatrix    = localMatrices[lane];
+                transform->m_worldMatrix    = m_worldMatrices[i];
+                transform->m_localDirty     = false;
+                transform->m_worldDirty     = false;
+                transform->m_worldVersion   = ++Transform::s_versionCounter;
+                m_worldVersions[i]          = transform->m_worldVersion;
+            }
+        }
+
+        return batchEnd - begin;
+    }
+
+    //----------------------------------------------------------------------
+    void TransformHierarchy::_ComposeLocalMatrices( U32 b, DirectX::XMMATRIX* localMatrices ) const
+    {
+        Math::Transform4 transforms;
+        transforms.positionX = _mm_loadu_ps( &m_batch.positionX[b] );
+        transforms.positionY = _mm_loadu_ps( &m_batch.positionY[b] );
+        transforms.positionZ = _mm_loadu_ps( &m_batch.positionZ[b] );
+        transforms.rotationX = _mm_loadu_ps( &m_batch.rotationX[b] );
+        transforms.rotationY = _mm_loadu_ps( &m_batch.rotationY[b] );
+        transforms.rotationZ = _mm_loadu_ps( &m_batch.rotationZ[b] );
+        transforms.rotationW = _mm_loadu_ps( &m_batch.rotationW[b] );
+        transforms.scaleX    = _mm_loadu_ps( &m_batch.scaleX[b] );
+        transforms.scaleY    = _mm_loadu_ps( &m_batch.scaleY[b] );
+        transforms.scaleZ    = _mm_loadu_ps( &m_batch.scaleZ[b] );
+        Math::ComposeAffineTransformations( transforms, localMatrices );
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+/**********************************************************************
+    class: TransformHierarchy (transform_hierarchy.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Updates the world matrices of all transforms of a scene once per
+    frame. The transforms are sorted by their depth in the hierarchy
+    into contiguous arrays, which hold the parent index and the world
+    matrix of each transform. Every transform of a level only depends
+    on the previous level, so a level is split into jobs which run in
+    parallel. Only transforms which are marked as dirty by their setters
+    are updated, see Transform. Their local position, rotation and scale
+    are packed into one array per component, so the local matrices of
+    four transforms are built at once with SSE.
+    The sorting is redone only if transforms were added, removed or
+    reparented.
+**********************************************************************/
+
+namespace Components {
+
+    class Transform;
+
+    //----------------------------------------------------------------------
+    struct TransformHierarchyStats
+    {
+        U32 numTransforms   = 0;
+        U32 numLevels       = 0;
+        U32 numUpdated      = 0; // World matrices rebuilt in the last update
+        U32 numRebuilds     = 0; // Times the hierarchy was sorted since creation
+    };
+
+    //**********************************************************************
+    class TransformHierarchy
+    {
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "numJobs": Maximum amount of jobs a single level is split into. 1 updates on the calling thread.
+        //----------------------------------------------------------------------
+        TransformHierarchy(U32 numJobs = 4) : m_numJobs( std::max( numJobs, 1u ) ) {}
+        ~TransformHierarchy() = default;
+
+        //----------------------------------------------------------------------
+        void addTransform   (Transform* transform);
+        void removeTransform(Transform* transform);
+
+        //----------------------------------------------------------------------
+        const TransformHierarchyStats&  getStats()      const { return m_stats; }
+        void                            setJobCount(U32 numJobs) { m_numJobs = std::max( numJobs, 1u ); }
+
+        //----------------------------------------------------------------------
+        // Brings the world matrix of every transform up to date. Should be called
+        // once per frame after gameplay code has moved the transforms.
+        //----------------------------------------------------------------------
+        void update();
+
+    private:
+        U32                         m_numJobs;
+        TransformHierarchyStats     m_stats;
+
+        // Every registered transform in no particular order. Each transform knows its index for constant time removal.
+        ArrayList<Transform*>       m_registered;
+        bool                        m_dirty = false;
+        U64                         m_parentingVersion = 0;
+
+        // Sorted by depth. Index "i" refers to the same transform in every array.
+        ArrayList<Transform*>       m_transforms;
+        ArrayList<I32>              m_parents;          // Index of the parent or -1
+        ArrayList<DirectX::XMMATRIX> m_worldMatrices;
+        ArrayList<U64>              m_worldVersions;    // World version of the transform the matrix was copied from
+        ArrayList<U32>              m_levelOffsets;     // First index of each level + total count at the end
+
+        // Dirty transforms of a range, packed to the front of the range. Index "i" refers to the
+        // same transform in every array. Padded, so a range can always be read in steps of four.
+        struct
+        {
+            ArrayList<U32>          indices;            // Index into the sorted arrays
+            ArrayList<F32>          positionX, positionY, positionZ;
+            ArrayList<F32>          rotationX, rotationY, rotationZ, rotationW;
+            ArrayList<F32>          scaleX, scaleY, scaleZ;
+        } m_batch;
+
+        //----------------------------------------------------------------------
+        void _Sort();
+        U32  _UpdateRange(U32 begin, U32 end);
+        void _ComposeLocalMatrices(U32 batchIndex, DirectX::XMMATRIX* localMatrices) const;
+
+        NULL_COPY_AND_ASSIGN(TransformHierarchy)
+    };
+
+}
@@ -29,6 +29,7 @@
 #include "Components/Rendering/particle_system.h"
 #include "Components/Rendering/vr_camera.h"
 #include "Components/Rendering/skinned_mesh_renderer.h"
+#include "Components/Rendering/lod_group.h"
 
 class IGame : public Core::CoreEngine
 {
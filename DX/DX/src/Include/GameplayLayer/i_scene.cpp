@@ -48,8 +48,10 @@ GameObject* IScene::createGameObject( CString name )
 //----------------------------------------------------------------------
 void IScene::destroyGameObject( GameObject* go )
 {
-    for (auto child : go->getTransform()->getChildren())
-        destroyGameObject( child->getGameObject() );
+    // Destroying a child removes it from the children of this gameobject
+    auto& children = go->getTransform()->getChildren();
+    while ( not children.empty() )
+        destroyGameObject( children.back()->getGameObject() );
 
     m_gameObjects.erase( std::remove( m_gameObjects.begin(), m_gameObjects.end(), go ), m_gameObjects.end() );
     SAFE_DELETE( go );
@@ -38,7 +38,7 @@ public:
     void tick( Time::Seconds delta ) override
     {
         auto t = getGameObject()->getComponent<Components::Transform>();
-        t->rotation = Math::Quat::FromEulerAngles( m_curDegrees );
+        t->setRotation( Math::Quat::FromEulerAngles( m_curDegrees ) );
         m_curDegrees += m_speeds * (F32)delta.value;
     }
 };
@@ -56,8 +56,8 @@ public:
     {
         generateMesh();
         auto transform = go->getComponent<Components::Transform>();
-        transform->rotation = Math::Quat(Math::Vec3::RIGHT, 90);
-        transform->position = Math::Vec3(-(width/2.0f), -2.0f, -(height/2.0f));
+        transform->setRotation( Math::Quat(Math::Vec3::RIGHT, 90) );
+        transform->setPosition( Math::Vec3(-(width/2.0f), -2.0f, -(height/2.0f)) );
 
         mr = go->addComponent<Components::MeshRenderer>(mesh, ASSETS.getColorMaterial());
     }
@@ -121,12 +121,11 @@ public:
     {
         auto t = getGameObject()->getComponent<Components::Transform>();
 
-        Math::Vec3 vecXZ = t->position;
+        Math::Vec3 vecXZ = t->getPosition();
         vecXZ.y = 0.0f;
         F32 length = vecXZ.magnitude();
 
-        t->position.x = m_center.x + length * cos( Math::Deg2Rad( m_curDegrees ) );
-        t->position.z = m_center.z + length * sin( Math::Deg2Rad( m_curDegrees ) );
+        t->setPosition( { m_center.x + length * cos( Math::Deg2Rad( m_curDegrees ) ), t->getPosition().y, m_center.z + length * sin( Math::Deg2Rad( m_curDegrees ) ) } );
 
         t->lookAt(m_center);
 
@@ -26,7 +26,7 @@ public:
         go = createGameObject("Camera");
         cam = go->addComponent<Components::Camera>( 45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four );
         cam->setClearColor(Color(175, 181, 191));
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -5) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         go->addComponent<Components::AudioListener>();
 
@@ -94,6 +94,8 @@ public:
         createGameObject("Cube")->addComponent<Components::MeshRenderer>(cubeMesh, ASSETS.getErrorMaterial());
 
         auto guiSceneMenu = gui->addComponent<GUISceneMenu>("Scenes");
+        guiSceneMenu->registerScene<AnimationSamplingBenchmarkScene>("Animation Sampling Benchmark");
+        guiSceneMenu->registerScene<ParticleStressScene>("Particle Stress Test");
         guiSceneMenu->registerScene<AnimationTestScene2>("Animation Test Scene 2");
         guiSceneMenu->registerScene<AnimationTestScene>("Animation Test Scene");
         guiSceneMenu->registerScene<SceneGUIThesisScenesMenu>("Thesis Test Scenes");
@@ -238,7 +240,7 @@ private:
             if (not vrCamGO)
             {
                 vrCamGO = SCENE.createGameObject("VRCamera");
-                vrCamGO->getTransform()->position = go->getTransform()->position;
+                vrCamGO->getTransform()->setPosition( go->getTransform()->getPosition() );
                 bool isHDR = mainCamera->isHDR();
                 auto vrCam = vrCamGO->addComponent<Components::VRCamera>(Components::ScreenDisplay::LeftEye, Graphics::MSAASamples::Four, isHDR);
                 vrCam->setClearColor(mainCamera->getClearColor());
@@ -10,6 +10,10 @@
 
 #include "D3D11.hpp"
 #include "../enums.hpp"
+#include "Pipeline/D3D11PipelineState.h"
+#include "Pipeline/Shaders/D3D11ShaderBase.h"
 
-ID3D11Device*           g_pDevice           = nullptr;
-ID3D11DeviceContext*    g_pImmediateContext = nullptr;
\ No newline at end of file
+ID3D11Device*                           g_pDevice               = nullptr;
+ID3D11DeviceContext*                    g_pImmediateContext     = nullptr;
+Graphics::D3D11::PipelineStateCache*    g_pPipelineStateCache   = nullptr;
+Graphics::ShaderCache*                  g_pShaderCache          = nullptr;
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include "VR/vr.h"
 #include "VR/OculusRift/oculus_rift_dx.h"
 #include "Common/string_utils.h"
+#include "Pipeline/D3D11PipelineState.h"
+#include "Pipeline/Shaders/D3D11ShaderBase.h"
 
 using namespace DirectX;
 
@@ -36,6 +38,7 @@ namespace Graphics {
     #define SHADOW_MAP_2D_SLOT_BEGIN    9
     #define SHADOW_MAP_3D_SLOT_BEGIN    13
     #define SHADOW_MAP_ARRAY_SLOT_BEGIN 14
+    #define LIGHT_CLUSTERS_SLOT         15
 
     static ArrayList<ShaderResourceDeclaration> SHADOW_MAP_2D_RESOURCE_DECLS{
         { ShaderType::Fragment, SHADOW_MAP_2D_SLOT_BEGIN + 0, SID("ShadowMap2D"), DataType::Texture2D },
@@ -49,11 +52,13 @@ namespace Graphics {
     static ArrayList<ShaderResourceDeclaration> SHADOW_MAP_ARRAY_RESOURCE_DECLS{
         { ShaderType::Fragment, SHADOW_MAP_ARRAY_SLOT_BEGIN + 0, SID("ShadowMapArray"), DataType::Texture2D },
     };
+    static ShaderResourceDeclaration LIGHT_CLUSTERS_RESOURCE_DECL{ ShaderType::Fragment, LIGHT_CLUSTERS_SLOT, SID("LightClusters"), DataType::Texture2D };
 
     static constexpr StringID LIGHT_COUNT_NAME              = StringID( "_LightCount" );
     static constexpr StringID LIGHT_BUFFER_NAME             = StringID( "_Lights" );
     static constexpr StringID LIGHT_VIEW_PROJ_NAME          = StringID( "_LightViewProj" );
     static constexpr StringID LIGHT_CSM_SPLITS_NAME         = StringID( "_CSMSplits" );
+    static constexpr StringID LIGHT_CLUSTER_COUNT_NAME      = StringID( "_ClusterCount" );
     static constexpr StringID CAM_POS_NAME                  = StringID( "_CameraPos" );
     static constexpr StringID POST_PROCESS_INPUT_NAME       = StringID( "_MainTex" );
     static constexpr StringID CAM_VIEW_PROJ_NAME            = StringID( "_ViewProj" );
@@ -62,6 +67,16 @@ namespace Graphics {
     static constexpr StringID CAM_VIEW_MATRIX_NAME          = StringID( "_View" );
     static constexpr StringID CAM_PROJ_MATRIX_NAME          = StringID( "_Proj" );
 
+    // States used in the last run, which are created on startup
+    static const char* PIPELINE_STATE_WARM_UP_LIST          = "/engine/shaders/bin/pipeline_states_d3d11.bin";
+
+    // Bytecode of all compiled shaders. Debug builds compile with different flags, so they keep their own file.
+#ifdef _DEBUG
+    static const char* SHADER_CACHE_PATH                    = "/engine/shaders/bin/shaders_d3d11_debug.bin";
+#else
+    static const char* SHADER_CACHE_PATH                    = "/engine/shaders/bin/shaders_d3d11_release.bin";
+#endif
+
     //**********************************************************************
     // INIT STUFF
     //**********************************************************************
@@ -71,6 +86,9 @@ namespace Graphics {
     {
         _SetLimits();
         _InitD3D11();
+        g_pPipelineStateCache = new D3D11::PipelineStateCache( D3D11::PipelineState::Create );
+        g_pPipelineStateCache->loadWarmUpList( PIPELINE_STATE_WARM_UP_LIST );
+        g_pShaderCache = new ShaderCache( SHADER_CACHE_PATH );
         _CreateRequiredUniformBuffersFromFile("/engine/shaders/includes/engineVS.hlsl", "/engine/shaders/includes/enginePS.hlsl");
         _CreateCubeMesh();
         _CreateAndBindFakeShadowmaps();
@@ -96,6 +114,10 @@ namespace Graphics {
         SAFE_DELETE( m_cubeMesh );
         SAFE_DELETE( m_animationBuffer );
         renderContext.Reset();
+        g_pPipelineStateCache->saveWarmUpList( PIPELINE_STATE_WARM_UP_LIST );
+        SAFE_DELETE( g_pPipelineStateCache );
+        g_pShaderCache->save();
+        SAFE_DELETE( g_pShaderCache );
         _DeinitD3D11();
     }
 
@@ -159,6 +181,17 @@ namespace Graphics {
                     }
                     break;
                 }
+                case GPUCommand::SET_LIGHT_CLUSTERS:
+                {
+                    auto& cmd = *reinterpret_cast<GPUC_SetLightClusters*>( command.get() );
+                    renderContext.lightClusters = cmd.clusters;
+                    renderContext.clusterCount[0] = cmd.numX;
+                    renderContext.clusterCount[1] = cmd.numY;
+                    renderContext.clusterCount[2] = cmd.numZ;
+                    renderContext.clusterCount[3] = cmd.numGlobalLights;
+                    renderContext.lightsUpdated = true;
+                    break;
+                }
                 case GPUCommand::SET_RENDER_TARGET:
                 {
                     auto& cmd = *reinterpret_cast<GPUC_SetRenderTarget*>( command.get() );
@@ -268,6 +301,12 @@ namespace Graphics {
     ITexture2DArray*    D3D11Renderer::createTexture2DArray()   { return new D3D11::Texture2DArray(); }
     IRenderBuffer*      D3D11Renderer::createRenderBuffer()     { return new D3D11::RenderBuffer(); }
 
+    //----------------------------------------------------------------------
+    void D3D11Renderer::precompileShader( ShaderType shaderType, const String& source, CString entryPoint )
+    {
+        D3D11::ShaderBase::CompileCached( shaderType, source, entryPoint );
+    }
+
     //----------------------------------------------------------------------
     bool D3D11Renderer::setGlobalFloat( StringID name, F32 value )
     {
@@ -323,6 +362,18 @@ namespace Graphics {
         return true;
     }
 
+    //----------------------------------------------------------------------
+    const IPipelineStateCache* D3D11Renderer::getPipelineStateCache() const
+    {
+        return g_pPipelineStateCache;
+    }
+
+    //----------------------------------------------------------------------
+    const ShaderCache* D3D11Renderer::getShaderCache() const
+    {
+        return g_pShaderCache;
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -522,8 +573,9 @@ namespace Graphics {
         // Update per object buffer
         m_objectBuffer->update( &modelMatrix, sizeof( DirectX::XMMATRIX ) );
 
-        // Bind mesh
+        // Bind mesh. The input layout depends on the vertex format of the mesh, so it has to be set even if the shader is already bound.
         mesh->bind( shader->getVertexLayout(), subMeshIndex );
+        static_cast<D3D11::Shader*>( shader.get() )->bindInputLayout( mesh->getPackedLayout() );
     }
 
     //----------------------------------------------------------------------
@@ -586,7 +638,7 @@ namespace Graphics {
     //----------------------------------------------------------------------
     void D3D11Renderer::_FlushLightBuffer()
     {
-        if ( not renderContext.lightsUpdated )
+        if ( not renderContext.lightsUpdated || not renderContext.getCamera() )
             return;
         renderContext.lightsUpdated = false;
 
@@ -612,6 +664,8 @@ namespace Graphics {
             I32         shadowType;             // 4 bytes
             //----------------------------------- (16 byte boundary)
         } lights[MAX_LIGHTS];
+        static_assert( offsetof( Light, direction ) == 16 && offsetof( Light, color ) == 32 && offsetof( Light, spotAngle ) == 48 && sizeof( Light ) == 64,
+                       "Light struct does not match the packing of the light struct in the shader." );
 
         I32 curShadowMap2DIndex = 0;
         I32 curShadowMap3DIndex = 0;
@@ -728,12 +782,23 @@ namespace Graphics {
             }
         }
 
+        // The cpu structs have to match the layout reflected from the shader, otherwise the lights are garbage
+        ASSERT( m_lightBuffer->getHandle( LIGHT_BUFFER_NAME ).size == sizeof( lights ) );
+        ASSERT( m_lightBuffer->getHandle( LIGHT_VIEW_PROJ_NAME ).size == sizeof( lightViewProjs ) );
+
         if ( not m_lightBuffer->update( LIGHT_BUFFER_NAME, &lights ) )
             LOG_ERROR_RENDERING( "Failed to update light-buffer. Something is horribly broken! Fix this!" );
 
         if ( not m_lightBuffer->update( LIGHT_VIEW_PROJ_NAME, &lightViewProjs ) )
             LOG_ERROR_RENDERING( "Failed to update light-buffer [ViewProjections]. Something is horribly broken! Fix this!" );
 
+        // Light clusters, a count of zero makes the shaders iterate over all lights
+        if ( not m_lightBuffer->update( LIGHT_CLUSTER_COUNT_NAME, renderContext.clusterCount ) )
+            LOG_ERROR_RENDERING( "Failed to update light-buffer [ClusterCount]. Something is horribly broken! Fix this!" );
+
+        if ( renderContext.lightClusters )
+            renderContext.lightClusters->bind( LIGHT_CLUSTERS_RESOURCE_DECL );
+
         // Update gpu buffer
         m_lightBuffer->flush();
     }
@@ -1016,6 +1081,11 @@ namespace Graphics {
         for (auto& res : SHADOW_MAP_ARRAY_RESOURCE_DECLS)
             texArray->bind( res );
         delete texArray;
+
+        auto clusters = createTexture2D();
+        clusters->create(1, 1, Graphics::TextureFormat::RGFloat, false);
+        clusters->bind( LIGHT_CLUSTERS_RESOURCE_DECL );
+        delete clusters;
     }
 
     //**********************************************************************
@@ -1055,7 +1125,9 @@ namespace Graphics {
         m_shader = nullptr;
         m_material = nullptr;
         lightCount = 0;
-        lightsUpdated = false;
+        lightsUpdated = true;
+        lightClusters = nullptr;
+        std::fill( std::begin( clusterCount ), std::end( clusterCount ), 0 );
         m_renderTarget = nullptr;
     }
 
@@ -1076,8 +1148,8 @@ namespace Graphics {
     {
         m_camera = camera;
 
-        // Reset frame info struct
-        m_camera->getFrameInfo() = {};
+        // Reset frame info struct. Stats from the engine (e.g. shadow casters) are already recorded at this point.
+        m_camera->getFrameInfo().resetRenderStats();
     }
 
 } // End namespaces
\ No newline at end of file
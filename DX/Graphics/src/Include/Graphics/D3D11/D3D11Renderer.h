@@ -16,7 +16,7 @@
 namespace Graphics {
 
     //----------------------------------------------------------------------
-    #define MAX_LIGHTS              16
+    #define MAX_LIGHTS              128
     #define MAX_SHADOWMAPS_2D       4
     #define MAX_SHADOWMAPS_3D       1
     #define MAX_SHADOWMAPS_ARRAY    1
@@ -54,12 +54,17 @@ namespace Graphics {
         ITexture2DArray*    createTexture2DArray() override;
         IRenderBuffer*      createRenderBuffer() override;
 
+        void precompileShader(ShaderType shaderType, const String& source, CString entryPoint) override;
+
         bool setGlobalFloat(StringID name, F32 value) override;
         bool setGlobalInt(StringID name, I32 value) override;
         bool setGlobalVector4(StringID name, const Math::Vec4& vec4) override;
         bool setGlobalColor(StringID name, Color color) override;
         bool setGlobalMatrix(StringID name, const DirectX::XMMATRIX& matrix) override;
 
+        const IPipelineStateCache* getPipelineStateCache() const override;
+        const ShaderCache* getShaderCache() const override;
+
     private:
         D3D11::Swapchain*   m_pSwapchain    = nullptr;
         IMesh*              m_cubeMesh      = nullptr;
@@ -110,6 +115,10 @@ namespace Graphics {
             const Light* lights[MAX_LIGHTS];
             bool         lightsUpdated = false; // Set to true whenever a new light has been added
 
+            // Light clusters of the current camera. Shaders iterate over all lights if there are none.
+            Texture2DPtr lightClusters = nullptr;
+            I32          clusterCount[4] = {}; // numX, numY, numZ, numGlobalLights
+
             inline void Reset();
             inline void BindMaterial(const MaterialPtr& material);
             inline void BindShader(const std::shared_ptr<IShader>& shader);
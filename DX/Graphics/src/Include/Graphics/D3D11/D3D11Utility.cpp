@@ -118,6 +118,8 @@ namespace Graphics { namespace D3D11 { namespace Utility {
         case TextureFormat::RGBAFloat:      return DXGI_FORMAT_R32G32B32A32_FLOAT; break;
         case TextureFormat::YUY2:           return DXGI_FORMAT_G8R8_G8B8_UNORM; break;
         case TextureFormat::RGB9e5Float:    return DXGI_FORMAT_R9G9B9E5_SHAREDEXP; break;
+        case TextureFormat::BC1:            return DXGI_FORMAT_BC1_UNORM; break;
+        case TextureFormat::BC3:            return DXGI_FORMAT_BC3_UNORM; break;
         case TextureFormat::BC4:            return DXGI_FORMAT_BC4_UNORM; break;
         case TextureFormat::BC5:            return DXGI_FORMAT_BC5_UNORM; break;
         case TextureFormat::BC6H:           return DXGI_FORMAT_BC6H_UF16; /*DXGI_FORMAT_BC6H_SF16*/ break;
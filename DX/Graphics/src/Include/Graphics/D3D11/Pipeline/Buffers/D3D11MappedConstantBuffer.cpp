@@ -10,31 +10,15 @@ namespace Graphics { namespace D3D11 {
 
     //----------------------------------------------------------------------
     MappedConstantBuffer::MappedConstantBuffer( const ShaderUniformBufferDeclaration& bufferInfo, BufferUsage usage )
-        : m_bufferInfo( bufferInfo )
+        : m_CPUBuffer( std::make_unique<ShaderParameterBlock>( bufferInfo ) )
     {
-        m_CPUBuffer = (Byte*)_aligned_malloc( m_bufferInfo.getSize(), 16 );
-        m_GPUBuffer = new D3D11::ConstantBuffer( m_bufferInfo.getSize(), usage );
+        m_GPUBuffer = new D3D11::ConstantBuffer( bufferInfo.getSize(), usage );
     }
 
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
 
-    //----------------------------------------------------------------------
-    bool MappedConstantBuffer::update( StringID name, const void* data )
-    {
-        for (auto& member : m_bufferInfo.getMembers())
-        {
-            if (member.getName() == name)
-            {
-                memcpy( &m_CPUBuffer[member.getOffset()], data, member.getSize() );
-                m_gpuUpToDate = false;
-                return true;
-            }
-        }
-        return false;
-    }
-
     //----------------------------------------------------------------------
     void MappedConstantBuffer::update( const void* data, Size sizeInBytes )
     {
@@ -44,10 +28,11 @@ namespace Graphics { namespace D3D11 {
     //----------------------------------------------------------------------
     void MappedConstantBuffer::flush()
     {
-        if ( not m_gpuUpToDate )
+        if ( m_CPUBuffer->isDirty() )
         {
-            m_GPUBuffer->update( m_CPUBuffer, m_bufferInfo.getSize() );
-            m_gpuUpToDate = true;
+            // D3D11.0 can't update a part of a constant buffer, so all of it is uploaded if any range is dirty
+            m_GPUBuffer->update( m_CPUBuffer->getData(), m_CPUBuffer->getSize() );
+            m_CPUBuffer->clearDirtyRanges();
         }
     }
 
@@ -58,9 +43,9 @@ namespace Graphics { namespace D3D11 {
 
         switch (shaderType)
         {
-        case ShaderType::Vertex:    m_GPUBuffer->bindToVertexShader( m_bufferInfo.getBindingSlot() ); break;
-        case ShaderType::Fragment:  m_GPUBuffer->bindToPixelShader( m_bufferInfo.getBindingSlot() ); break;
-        case ShaderType::Geometry:  m_GPUBuffer->bindToGeometryShader( m_bufferInfo.getBindingSlot() ); break;
+        case ShaderType::Vertex:    m_GPUBuffer->bindToVertexShader( getBufferInfo().getBindingSlot() ); break;
+        case ShaderType::Fragment:  m_GPUBuffer->bindToPixelShader( getBufferInfo().getBindingSlot() ); break;
+        case ShaderType::Geometry:  m_GPUBuffer->bindToGeometryShader( getBufferInfo().getBindingSlot() ); break;
         default: ASSERT( false );
         }
     }
@@ -69,7 +54,6 @@ namespace Graphics { namespace D3D11 {
     void MappedConstantBuffer::_FreeBuffers()
     {
         SAFE_DELETE( m_GPUBuffer );
-        _aligned_free( m_CPUBuffer );
     }
 
 } } // End namespaces
\ No newline at end of file
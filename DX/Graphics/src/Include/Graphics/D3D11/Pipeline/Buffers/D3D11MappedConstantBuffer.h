@@ -7,7 +7,7 @@
 **********************************************************************/
 
 #include "D3D11Buffers.h"
-#include "../../../shader_resources.hpp"
+#include "../../../Utils/shader_parameter_block.h"
 
 namespace Graphics { namespace D3D11 {
 
@@ -23,15 +23,22 @@ namespace Graphics { namespace D3D11 {
         ~MappedConstantBuffer() { _FreeBuffers(); }
 
         //----------------------------------------------------------------------
-        inline bool                                     gpuIsUpToDate() const { return m_gpuUpToDate; }
-        inline const ShaderUniformBufferDeclaration&    getBufferInfo() const { return m_bufferInfo; }
+        inline bool                                     gpuIsUpToDate() const { return not m_CPUBuffer->isDirty(); }
+        inline const ShaderUniformBufferDeclaration&    getBufferInfo() const { return m_CPUBuffer->getBufferInfo(); }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Handle to the uniform 'name', which can be used for updates without a name lookup.
+        //----------------------------------------------------------------------
+        inline ShaderParameterHandle getHandle(StringID name) const { return m_CPUBuffer->getHandle( name ); }
 
         //----------------------------------------------------------------------
         // Update the given uniform 'name' with the given data. !! ONLY ON THE CPU !!
         // @Return:
         //  False if uniform with the given name does not exist.
         //----------------------------------------------------------------------
-        bool update(StringID name, const void* data);
+        bool update(StringID name, const void* data) { return m_CPUBuffer->set( name, data ); }
+        bool update(ShaderParameterHandle handle, const void* data) { return m_CPUBuffer->set( handle, data ); }
 
         //----------------------------------------------------------------------
         // Update the given uniform 'name' with the given data.
@@ -40,7 +47,7 @@ namespace Graphics { namespace D3D11 {
         void update(const void* data, Size sizeInBytes);
 
         //----------------------------------------------------------------------
-        // Sends the whole buffer on the cpu to the gpu. (This does nothing if gpu data is up to date)
+        // Sends the buffer on the cpu to the gpu. (This does nothing if gpu data is up to date)
         //---------------------------------------------------------------------
         void flush();
 
@@ -53,10 +60,8 @@ namespace Graphics { namespace D3D11 {
         void bind(ShaderType shaderType);
 
     private:
-        ShaderUniformBufferDeclaration  m_bufferInfo;
-        Byte*                           m_CPUBuffer     = nullptr;
-        ConstantBuffer*                 m_GPUBuffer     = nullptr;
-        bool                            m_gpuUpToDate   = false;
+        std::unique_ptr<ShaderParameterBlock>   m_CPUBuffer = nullptr;
+        ConstantBuffer*                         m_GPUBuffer = nullptr;
 
         //----------------------------------------------------------------------
         void _FreeBuffers();
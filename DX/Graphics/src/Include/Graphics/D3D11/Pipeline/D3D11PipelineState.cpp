@@ -0,0 +1,87 @@
+#include "D3D11PipelineState.h"
+/**********************************************************************
+    class: PipelineState (D3D11PipelineState.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "../D3D11Utility.h"
+
+namespace Graphics { namespace D3D11 {
+
+    //----------------------------------------------------------------------
+    void PipelineState::bind( const std::array<F32, 4>& blendFactors )
+    {
+        g_pImmediateContext->OMSetDepthStencilState( depthStencilState, 0 );
+        g_pImmediateContext->RSSetState( rasterizerState );
+        g_pImmediateContext->OMSetBlendState( blendState, blendFactors.data(), 0xffffffff );
+    }
+
+    //----------------------------------------------------------------------
+    std::shared_ptr<PipelineState> PipelineState::Create( const PipelineStateDesc& desc )
+    {
+        auto state = std::make_shared<PipelineState>();
+
+        // Rasterizer state
+        auto& rzState = desc.rasterizationState;
+        D3D11_RASTERIZER_DESC rsDesc = {};
+        switch (rzState.fillMode)
+        {
+        case FillMode::Solid:       rsDesc.FillMode = D3D11_FILL_SOLID;     break;
+        case FillMode::Wireframe:   rsDesc.FillMode = D3D11_FILL_WIREFRAME; break;
+        }
+        switch (rzState.cullMode)
+        {
+        case CullMode::Back:        rsDesc.CullMode = D3D11_CULL_BACK;      break;
+        case CullMode::Front:       rsDesc.CullMode = D3D11_CULL_FRONT;     break;
+        case CullMode::None:        rsDesc.CullMode = D3D11_CULL_NONE;      break;
+        }
+
+        rsDesc.FrontCounterClockwise = rzState.frontCounterClockwise;
+        rsDesc.DepthClipEnable       = rzState.depthClipEnable;
+        rsDesc.MultisampleEnable     = true;
+        rsDesc.ScissorEnable         = rzState.scissorEnable;
+        rsDesc.DepthBias             = (INT)rzState.depthBias;
+        rsDesc.SlopeScaledDepthBias  = rzState.slopeScaledDepthBias;
+        rsDesc.DepthBiasClamp        = rzState.depthBiasClamp;
+
+        HR( g_pDevice->CreateRasterizerState( &rsDesc, &state->rasterizerState.releaseAndGet() ) );
+
+        // Depth stencil state
+        auto& dsState = desc.depthStencilState;
+        D3D11_DEPTH_STENCIL_DESC depthStencilStateDesc = {};
+        depthStencilStateDesc.DepthEnable       = dsState.depthEnable;
+        depthStencilStateDesc.DepthWriteMask    = dsState.depthWrite ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO;
+        depthStencilStateDesc.DepthFunc         = Utility::TranslateComparisonFunc( dsState.depthFunc );
+
+        HR( g_pDevice->CreateDepthStencilState( &depthStencilStateDesc, &state->depthStencilState.releaseAndGet() ) );
+
+        // Blend state
+        if (desc.blendStateEnabled)
+        {
+            auto& bState = desc.blendState;
+            D3D11_BLEND_DESC blendDesc = {};
+            blendDesc.AlphaToCoverageEnable  = bState.alphaToCoverage;
+            blendDesc.IndependentBlendEnable = bState.independentBlending;
+
+            for ( I32 i = 0; i < (bState.independentBlending ? 8 : 1); i++ )
+            {
+                auto& bs = bState.blendStates[i];
+                blendDesc.RenderTarget[i].BlendEnable           = bs.blendEnable;
+                blendDesc.RenderTarget[i].SrcBlend              = Utility::TranslateBlend( bs.srcBlend );
+                blendDesc.RenderTarget[i].DestBlend             = Utility::TranslateBlend( bs.destBlend );
+                blendDesc.RenderTarget[i].BlendOp               = Utility::TranslateBlendOP( bs.blendOp );
+                blendDesc.RenderTarget[i].SrcBlendAlpha         = Utility::TranslateBlend( bs.srcBlendAlpha );
+                blendDesc.RenderTarget[i].DestBlendAlpha        = Utility::TranslateBlend( bs.destBlendAlpha );
+                blendDesc.RenderTarget[i].BlendOpAlpha          = Utility::TranslateBlendOP( bs.blendOpAlpha );
+                blendDesc.RenderTarget[i].RenderTargetWriteMask = bs.writeMask;
+            }
+
+            HR( g_pDevice->CreateBlendState( &blendDesc, &state->blendState.releaseAndGet() ) );
+        }
+
+        return state;
+    }
+
+} } // End namespaces
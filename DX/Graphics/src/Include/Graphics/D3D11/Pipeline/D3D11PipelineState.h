@@ -0,0 +1,41 @@
+#pragma once
+/**********************************************************************
+    class: PipelineState (D3D11PipelineState.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    D3D11 has no single pipeline state object, so a pipeline state is
+    the set of fixed function state objects which are bound together.
+    Shader stages are bound separately and therefore not part of it.
+**********************************************************************/
+
+#include "../D3D11.hpp"
+#include "Utils/pipeline_state_cache.h"
+
+namespace Graphics { namespace D3D11 {
+
+    //**********************************************************************
+    struct PipelineState
+    {
+        ComPtr<ID3D11RasterizerState>   rasterizerState;
+        ComPtr<ID3D11DepthStencilState> depthStencilState;
+        ComPtr<ID3D11BlendState>        blendState; // Nullptr binds the default blend state
+
+        //----------------------------------------------------------------------
+        // Binds all states to the immediate context.
+        //----------------------------------------------------------------------
+        void bind(const std::array<F32, 4>& blendFactors);
+
+        //----------------------------------------------------------------------
+        // Creates all d3d11 state objects from the given description. Used by the pipeline state cache.
+        //----------------------------------------------------------------------
+        static std::shared_ptr<PipelineState> Create(const PipelineStateDesc& desc);
+    };
+
+    using PipelineStateCache = Graphics::PipelineStateCache<PipelineState>;
+
+} } // End namespaces
+
+//----------------------------------------------------------------------
+extern Graphics::D3D11::PipelineStateCache* g_pPipelineStateCache;
@@ -8,8 +8,6 @@
 
 #include "Common/string_utils.h"
 #include "D3D11/D3D11Defines.hpp"
-#include "OS/FileSystem/file_system.h"
-#include "OS/FileSystem/file.h"
 #include "Utils/utils.h"
 
 namespace Graphics { namespace D3D11 {
@@ -51,6 +49,52 @@ namespace Graphics { namespace D3D11 {
         return nullptr;
     }
 
+    //----------------------------------------------------------------------
+    ShaderBlob ShaderBase::CompileCached( ShaderType shaderType, const String& source, CString entryPoint )
+    {
+        String shaderName = GetShaderTypeName( shaderType );
+        String profile = _GetLatestProfile( shaderType );
+        UINT flags = GetCompileFlags();
+
+        // The key covers the source after includes and macros were resolved, so comments and whitespace don't matter.
+        // If preprocessing fails the raw source is hashed instead and the compiler reports the error below.
+        ComPtr<ID3DBlob> preprocessedBlob;
+        const void* keySource = source.c_str();
+        Size keySourceSize = source.size();
+        if ( SUCCEEDED( D3DPreprocess( source.c_str(), source.size(), NULL, NULL, NULL, &preprocessedBlob.get(), NULL ) ) )
+        {
+            keySource = preprocessedBlob->GetBufferPointer();
+            keySourceSize = preprocessedBlob->GetBufferSize();
+        }
+
+        U32 compilerVersion = D3D_COMPILER_VERSION;
+        U64 key = ShaderCache::Hash( keySource, keySourceSize );
+        key = ShaderCache::Hash( entryPoint, strlen( entryPoint ), key );
+        key = ShaderCache::Hash( profile.data(), profile.size(), key );
+        key = ShaderCache::Hash( &flags, sizeof( flags ), key );
+        key = ShaderCache::Hash( &compilerVersion, sizeof( compilerVersion ), key );
+
+        Size size;
+        if ( auto data = g_pShaderCache->find( key, &size ) )
+            return ShaderBlob{ data, size };
+
+        ComPtr<ID3DBlob> d3d11ShaderBlob;
+        ComPtr<ID3DBlob> d3D11ErrorBlob;
+        HRESULT hr = D3DCompile( source.c_str(), source.size(), NULL, NULL, NULL,
+                                 entryPoint, profile.c_str(), flags, 0, &d3d11ShaderBlob.get(), &d3D11ErrorBlob.get() );
+
+        if ( FAILED( hr ) )
+        {
+            if (d3D11ErrorBlob)
+                throw std::runtime_error( "Failed to compile "+ shaderName + " shader from source:\n" + (const char*)d3D11ErrorBlob->GetBufferPointer() );
+            throw std::runtime_error( "Failed to compile " + shaderName + " shader from source." );
+        }
+
+        // The blob is released at the end of this function, so the bytecode is referenced from the cache
+        size = d3d11ShaderBlob->GetBufferSize();
+        return ShaderBlob{ g_pShaderCache->add( key, d3d11ShaderBlob->GetBufferPointer(), size ), size };
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -64,7 +108,7 @@ namespace Graphics { namespace D3D11 {
         ComPtr<ID3DBlob> d3d11ShaderBlob;
         ComPtr<ID3DBlob> d3D11ErrorBlob;
         HRESULT hr = D3DCompileFromFile( ConvertToWString( path.toString() ).c_str(), NULL, D3D_COMPILE_STANDARD_FILE_INCLUDE,
-                                         entryPoint, _GetLatestProfile().c_str(), GetCompileFlags(), 0, &d3d11ShaderBlob.get(), &d3D11ErrorBlob.get() );
+                                         entryPoint, _GetLatestProfile( m_shaderType ).c_str(), GetCompileFlags(), 0, &d3d11ShaderBlob.get(), &d3D11ErrorBlob.get() );
 
         String shaderName = GetShaderTypeName( m_shaderType );
         if ( FAILED( hr ) )
@@ -83,50 +127,9 @@ namespace Graphics { namespace D3D11 {
     //----------------------------------------------------------------------
     void ShaderBase::_CompileFromSource( const String& source, CString entryPoint, std::function<void(const ShaderBlob&)> fn )
     {
-        String shaderName = GetShaderTypeName( m_shaderType );
-
-        StringID hash = SID( source.c_str() );
-
-#ifdef _DEBUG
-        OS::Path binaryShaderPath( "/engine/shaders/bin/debug/" + shaderName + TS( hash.id ) + ".cso" );
-#else
-        OS::Path binaryShaderPath( "/engine/shaders/bin/release/" + shaderName + TS( hash.id ) + ".cso" );
-#endif // DEBUG
-
-        // Precompiled binary file does not exist
-        if ( not OS::FileSystem::exists( binaryShaderPath ) )
-        {
-            ComPtr<ID3DBlob> d3d11ShaderBlob;
-            ComPtr<ID3DBlob> d3D11ErrorBlob;
-            HRESULT hr = D3DCompile( source.c_str(), source.size(), NULL, NULL, NULL,
-                                     entryPoint, _GetLatestProfile().c_str(), GetCompileFlags(), 0, &d3d11ShaderBlob.get(), &d3D11ErrorBlob.get() );
-
-            if ( FAILED( hr ) )
-            {
-                if (d3D11ErrorBlob)
-                    throw std::runtime_error( "Failed to compile "+ shaderName + " shader from source:\n" + (const char*)d3D11ErrorBlob->GetBufferPointer() );
-                throw std::runtime_error( "Failed to compile " + shaderName + " shader from source." );
-            }
-
-            ShaderBlob shaderBlob{ d3d11ShaderBlob->GetBufferPointer(), d3d11ShaderBlob->GetBufferSize() };
-
-            // Store compiled binary data into file
-            OS::BinaryFile binaryShaderFile( binaryShaderPath, OS::EFileMode::WRITE );
-            binaryShaderFile.write( (const Byte*)shaderBlob.data, shaderBlob.size );
-
-            _ShaderReflection( shaderBlob );
-            fn( shaderBlob );
-        }
-        else
-        {
-            // Load compiled binary data from file
-            OS::BinaryFile binaryShaderFile( binaryShaderPath, OS::EFileMode::READ );
-            String content = binaryShaderFile.readAll();
-
-            ShaderBlob shaderBlob{ content.data(), content.size() };
-            _ShaderReflection( shaderBlob );
-            fn( shaderBlob );
-        }
+        ShaderBlob shaderBlob = CompileCached( m_shaderType, source, entryPoint );
+        _ShaderReflection( shaderBlob );
+        fn( shaderBlob );
     }
 
     //----------------------------------------------------------------------
@@ -268,9 +271,9 @@ namespace Graphics { namespace D3D11 {
     }
 
     //----------------------------------------------------------------------
-    String ShaderBase::_GetLatestProfile()
+    String ShaderBase::_GetLatestProfile( ShaderType shaderType )
     {
-        switch (m_shaderType)
+        switch (shaderType)
         {
         case ShaderType::Vertex:    return GetLatestProfile<ID3D11VertexShader>();
         case ShaderType::Fragment:  return GetLatestProfile<ID3D11PixelShader>();
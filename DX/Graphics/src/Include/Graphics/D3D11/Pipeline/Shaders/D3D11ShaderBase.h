@@ -9,9 +9,12 @@
 #include "D3D11/D3D11.hpp"
 #include "OS/FileSystem/path.h"
 #include "shader_resources.hpp"
+#include "Utils/shader_cache.h"
 #include <d3dcompiler.h>
 #include <functional>
 
+extern Graphics::ShaderCache* g_pShaderCache;
+
 namespace Graphics { namespace D3D11 {
 
     // Get the latest profile for the specified Shader type.
@@ -51,6 +54,15 @@ namespace Graphics { namespace D3D11 {
         //----------------------------------------------------------------------
         const ShaderUniformBufferDeclaration* getUniformBufferDeclaration(StringID name) const;
 
+        //----------------------------------------------------------------------
+        // Compiles the given source, unless the shader cache contains it already. Thread-safe.
+        // @Return:
+        //  The bytecode, which lives in the shader cache.
+        // @Throws:
+        //  std::runtime_error if compilation failed.
+        //----------------------------------------------------------------------
+        static ShaderBlob CompileCached(ShaderType shaderType, const String& source, CString entryPoint);
+
     protected:
         ComPtr<ID3D11ShaderReflection>          m_pShaderReflection     = nullptr;
         ShaderType                              m_shaderType            = ShaderType::Unknown;
@@ -70,7 +82,7 @@ namespace Graphics { namespace D3D11 {
         void _ReflectConstantBuffer(ID3D11ShaderReflectionConstantBuffer* cb, U32 bindSlot);
         U32 _GetArraySize(ID3D11ShaderReflectionVariable* var);
         DataType _GetDataType(ID3D11ShaderReflectionVariable* var);
-        String _GetLatestProfile();
+        static String _GetLatestProfile(ShaderType shaderType);
 
         //----------------------------------------------------------------------
         NULL_COPY_AND_ASSIGN(ShaderBase)
@@ -22,6 +22,12 @@ namespace Graphics { namespace D3D11 {
         g_pImmediateContext->VSSetShader( m_pVertexShader.get(), NULL, 0 ); 
     }
 
+    //----------------------------------------------------------------------
+    void VertexShader::bindInputLayout( const PackedVertexLayout& packedLayout )
+    {
+        g_pImmediateContext->IASetInputLayout( _GetInputLayout( packedLayout ) );
+    }
+
     //----------------------------------------------------------------------
     void VertexShader::unbind()
     { 
@@ -65,6 +71,8 @@ namespace Graphics { namespace D3D11 {
     {
         // Clean up old data
         m_vertexLayout.clear();
+        m_inputElements.clear();
+        m_packedInputLayouts.clear();
 
         // Get shader info
         D3D11_SHADER_DESC shaderDesc;
@@ -141,8 +149,13 @@ namespace Graphics { namespace D3D11 {
             _AddToVertexLayout( semanticName.c_str(), paramDesc.SemanticIndex, sizeInBytes, elementDesc.InputSlot, instanced );
 
             inputLayoutDesc.push_back( elementDesc );
+            m_inputElements.push_back( { paramDesc.SemanticName, SID( semanticName.c_str() ), elementDesc } );
         }
 
+        // Input layouts for packed meshes need the bytecode for validation
+        auto byteCode = static_cast<const Byte*>( pShaderByteCode );
+        m_byteCode.assign( byteCode, byteCode + sizeInBytes );
+
         if ( not m_vertexLayout.isEmpty() )
         {
             // Create Input Layout
@@ -151,6 +164,65 @@ namespace Graphics { namespace D3D11 {
         }
     }
 
+    //----------------------------------------------------------------------
+    ID3D11InputLayout* VertexShader::_GetInputLayout( const PackedVertexLayout& packedLayout )
+    {
+        if ( packedLayout.isEmpty() || m_vertexLayout.isEmpty() )
+            return m_pInputLayout.get();
+
+        auto& inputLayout = m_packedInputLayouts[packedLayout.getHash()];
+        if ( inputLayout.get() != nullptr )
+            return inputLayout.get();
+
+        // The interleaved buffer is bound to slot 0, unpacked inputs follow in the order the mesh binds them
+        HashMap<U32, U32> slotMap;
+        for (auto& input : m_vertexLayout.getLayoutDescription())
+        {
+            if ( not input.instanced && packedLayout.find( input.name ) )
+                continue;
+
+            U32 slot = static_cast<U32>( slotMap.size() ) + 1;
+            slotMap[input.binding] = slot;
+        }
+
+        ArrayList<D3D11_INPUT_ELEMENT_DESC> inputLayoutDesc;
+        for (auto& element : m_inputElements)
+        {
+            auto desc = element.desc;
+            desc.SemanticName = element.semanticName.c_str();
+
+            auto attribute = packedLayout.find( element.name );
+            if ( attribute && desc.InputSlotClass == D3D11_INPUT_PER_VERTEX_DATA )
+            {
+                desc.InputSlot          = 0;
+                desc.AlignedByteOffset  = attribute->offset;
+                switch (attribute->format)
+                {
+                case VertexAttributeFormat::Float2:     desc.Format = DXGI_FORMAT_R32G32_FLOAT; break;
+                case VertexAttributeFormat::Float3:     desc.Format = DXGI_FORMAT_R32G32B32_FLOAT; break;
+                case VertexAttributeFormat::Float4:     desc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT; break;
+                case VertexAttributeFormat::Half2:      desc.Format = DXGI_FORMAT_R16G16_FLOAT; break;
+                case VertexAttributeFormat::Half4:      desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT; break;
+                case VertexAttributeFormat::UNorm16x2:  desc.Format = DXGI_FORMAT_R16G16_UNORM; break;
+                case VertexAttributeFormat::SNorm16x4:  desc.Format = DXGI_FORMAT_R16G16B16A16_SNORM; break;
+                case VertexAttributeFormat::UNorm8x4:   desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+                default: LOG_WARN_RENDERING( "VertexShader::_GetInputLayout(): Unknown vertex attribute format." );
+                }
+            }
+            else if ( slotMap.find( desc.InputSlot ) != slotMap.end() )
+            {
+                desc.InputSlot = slotMap[desc.InputSlot];
+            }
+
+            inputLayoutDesc.push_back( desc );
+        }
+
+        HR( g_pDevice->CreateInputLayout( inputLayoutDesc.data(), (U32)inputLayoutDesc.size(),
+                                          m_byteCode.data(), m_byteCode.size(), &inputLayout.releaseAndGet() ) );
+
+        return inputLayout.get();
+    }
+
     //----------------------------------------------------------------------
     void VertexShader::_AddToVertexLayout( const String& semanticName, U32 semanticIndex, U32 sizeInBytes, U32 binding, bool instanced )
     {
@@ -29,14 +29,32 @@ namespace Graphics { namespace D3D11 {
         //----------------------------------------------------------------------
         const VertexLayout& getVertexLayout() const { return m_vertexLayout; }
 
+        //----------------------------------------------------------------------
+        // Binds the input layout which fetches the inputs from a mesh with the given packed vertex layout.
+        // An empty layout binds the default input layout (one buffer per input). Layouts are created once per format.
+        //----------------------------------------------------------------------
+        void bindInputLayout(const PackedVertexLayout& packedLayout);
+
     private:
         ComPtr<ID3D11VertexShader> m_pVertexShader = nullptr;
         ComPtr<ID3D11InputLayout>  m_pInputLayout  = nullptr;
 
         VertexLayout m_vertexLayout;
 
+        // Everything needed to create input layouts for packed meshes later on
+        struct InputElement
+        {
+            String                      semanticName; // Referenced by the desc
+            StringID                    name;         // Name of the input in the vertex layout
+            D3D11_INPUT_ELEMENT_DESC    desc;
+        };
+        ArrayList<InputElement>                     m_inputElements;
+        ArrayList<Byte>                             m_byteCode;
+        HashMap<U64, ComPtr<ID3D11InputLayout>>     m_packedInputLayouts;
+
         //----------------------------------------------------------------------
         void _CreateInputLayout(const void* pShaderByteCode, Size sizeInBytes);
+        ID3D11InputLayout* _GetInputLayout(const PackedVertexLayout& packedLayout);
         void _AddToVertexLayout(const String& semanticName, U32 semanticIndex, U32 sizeInBytes, U32 binding, bool instanced);
         void _CreateD3D11VertexShader(const ShaderBlob& shaderBlob);
 
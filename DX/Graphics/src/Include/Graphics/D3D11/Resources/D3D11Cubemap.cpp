@@ -33,6 +33,21 @@ namespace Graphics { namespace D3D11 {
         _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
     }
 
+    //----------------------------------------------------------------------
+    void Cubemap::create( I32 size, TextureFormat format, const ArrayList<const void*>& mips )
+    {
+        ASSERT( size > 0 && not mips.empty() && mips.size() % NUM_FACES == 0 );
+        ITexture::_Init( TextureDimension::Cube, size, size, format );
+
+        m_generateMips = false;
+        m_mipCount = static_cast<U32>( mips.size() / NUM_FACES );
+        m_hasMips = m_mipCount > 1;
+
+        _CreateTexture( mips );
+        _CreateShaderResourceView( false );
+        _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -61,6 +76,34 @@ namespace Graphics { namespace D3D11 {
         HR( g_pDevice->CreateTexture2D( &texDesc, NULL, &m_pTexture ) );
     }
 
+    //----------------------------------------------------------------------
+    void Cubemap::_CreateTexture( const ArrayList<const void*>& mips )
+    {
+        D3D11_TEXTURE2D_DESC texDesc;
+        texDesc.Height              = getHeight();
+        texDesc.Width               = getWidth();
+        texDesc.MipLevels           = m_mipCount;
+        texDesc.ArraySize           = NUM_FACES;
+        texDesc.Format              = Utility::TranslateTextureFormat( m_format );
+        texDesc.SampleDesc.Count    = 1;
+        texDesc.SampleDesc.Quality  = 0;
+        texDesc.Usage               = D3D11_USAGE_IMMUTABLE;
+        texDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
+        texDesc.CPUAccessFlags      = 0;
+        texDesc.MiscFlags           = D3D11_RESOURCE_MISC_TEXTURECUBE;
+
+        // Subresources are ordered the same way: All mips of the first face, then all mips of the second face etc.
+        ArrayList<D3D11_SUBRESOURCE_DATA> subResourceData( mips.size() );
+        for (U32 i = 0; i < mips.size(); i++)
+        {
+            U32 mipWidth = std::max( 1u, m_width >> (i % m_mipCount) );
+            subResourceData[i].pSysMem            = mips[i];
+            subResourceData[i].SysMemPitch        = RowPitchFromTextureFormat( m_format, mipWidth );
+            subResourceData[i].SysMemSlicePitch   = 0;
+        }
+        HR( g_pDevice->CreateTexture2D( &texDesc, subResourceData.data(), &m_pTexture ) );
+    }
+
     //----------------------------------------------------------------------
     void Cubemap::_CreateShaderResourceView( bool isDepthBuffer )
     {
@@ -23,6 +23,7 @@ namespace Graphics { namespace D3D11 {
         // ICubemap Interface
         //----------------------------------------------------------------------
         void create(I32 size, TextureFormat format, Mips mips) override;
+        void create(I32 size, TextureFormat format, const ArrayList<const void*>& mips) override;
         void apply(bool updateMips, bool keepPixelsInRAM) override { IBindableTexture::apply(updateMips, keepPixelsInRAM); }
 
     private:
@@ -35,6 +36,7 @@ namespace Graphics { namespace D3D11 {
 
         //----------------------------------------------------------------------
         void _CreateTexture(Mips mips, bool isDepthBuffer);
+        void _CreateTexture(const ArrayList<const void*>& mips);
         void _CreateShaderResourceView(bool isDepthBuffer);
 
         //----------------------------------------------------------------------
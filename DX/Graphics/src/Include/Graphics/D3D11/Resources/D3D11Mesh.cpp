@@ -19,6 +19,9 @@ namespace Graphics { namespace D3D11 {
         // Check if an vertex stream has been updated and perform necessary task
         for (auto& [name, vsStream] : m_vertexStreams)
         {
+            if ( _IsPacked( name ) )
+                continue;
+
             if ( vsStream->wasUpdated() )
             {
                 auto bufferSize = vsStream->bufferSize();
@@ -135,6 +138,9 @@ namespace Graphics { namespace D3D11 {
         // Recreate all vertex buffers
         for (auto& [name, vsStream] : m_vertexStreams)
         {
+            if ( _IsPacked( name ) )
+                continue;
+
             _DestroyBuffer( name );
             _CreateBuffer( name, *vsStream );
         }
@@ -170,17 +176,29 @@ namespace Graphics { namespace D3D11 {
         #define MAX_BUFFERS 8
         auto& vertexDescription = vertLayout.getLayoutDescription();
 
-        ASSERT( vertexDescription.size() <= MAX_BUFFERS );
+        ASSERT( vertexDescription.size() + 1 <= MAX_BUFFERS );
 
         ID3D11Buffer* pBuffers[MAX_BUFFERS];
         U32 strides[MAX_BUFFERS];
         U32 offsets[MAX_BUFFERS];
         U32 bufferIndex = 0;
 
+        // The interleaved buffer is always bound to the first slot, followed by all unpacked streams (see VertexShader::getInputLayout())
+        if ( isPacked() )
+        {
+            pBuffers[bufferIndex] = m_pVertexBuffers[SID_VERTEX_PACKED]->getBuffer();
+            strides[bufferIndex] = m_packedLayout.getStride();
+            offsets[bufferIndex] = 0;
+            bufferIndex++;
+        }
+
         for ( auto& binding : vertexDescription )
         {
+            if ( not binding.instanced && _IsPacked( binding.name ) )
+                continue;
+
             auto it = m_pVertexBuffers.find( binding.name );
-            if (it != m_pVertexBuffers.end())
+            if (it != m_pVertexBuffers.end() && it->second)
             {
                 pBuffers[bufferIndex] = it->second->getBuffer();
                 strides[bufferIndex] = binding.sizeInBytes;
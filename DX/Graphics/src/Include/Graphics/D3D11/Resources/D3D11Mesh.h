@@ -37,6 +37,7 @@ namespace Graphics { namespace D3D11 {
 
         void _CreateBuffer(StringID name, const VertexStreamBase& vs) override;
         void _DestroyBuffer(StringID name) override;
+        bool _SupportsPackedVertices() const override { return true; }
 
         //----------------------------------------------------------------------
         // IMesh Interface
@@ -9,17 +9,9 @@
 #include "../Pipeline/Shaders/D3D11VertexShader.h"
 #include "../Pipeline/Shaders/D3D11PixelShader.h"
 #include "../Pipeline/Shaders/D3D11GeometryShader.h"
-#include "../D3D11Utility.h"
 
 namespace Graphics { namespace D3D11 {
 
-    //----------------------------------------------------------------------
-    Shader::Shader()
-    {
-        setDepthStencilState({});
-        setRasterizationState({});
-    }
-
     //----------------------------------------------------------------------
     void Shader::bind()
     {
@@ -37,13 +29,15 @@ namespace Graphics { namespace D3D11 {
         _BindTextures();
 
         // Bind pipeline states
-        g_pImmediateContext->OMSetDepthStencilState( m_pDepthStencilState, 0 );
-        g_pImmediateContext->RSSetState( m_pRSState );
+        if ( not m_pipelineState )
+            m_pipelineState = g_pPipelineStateCache->get( m_pipelineStateDesc );
+        m_pipelineState->bind( m_blendFactors );
+    }
 
-        if (m_pBlendState)
-            g_pImmediateContext->OMSetBlendState( m_pBlendState, m_blendFactors.data(), 0xffffffff );
-        else
-            g_pImmediateContext->OMSetBlendState( NULL, m_blendFactors.data(), 0xffffffff );
+    //----------------------------------------------------------------------
+    void Shader::bindInputLayout( const PackedVertexLayout& packedLayout )
+    {
+        m_pVertexShader->bindInputLayout( packedLayout );
     }
 
     //----------------------------------------------------------------------
@@ -119,63 +113,23 @@ namespace Graphics { namespace D3D11 {
     //----------------------------------------------------------------------
     void Shader::setRasterizationState( const RasterizationState& rzState )
     {
-        D3D11_RASTERIZER_DESC rsDesc = {};
-        switch (rzState.fillMode)
-        {
-        case FillMode::Solid:       rsDesc.FillMode = D3D11_FILL_SOLID;     break;
-        case FillMode::Wireframe:   rsDesc.FillMode = D3D11_FILL_WIREFRAME; break;
-        }
-        switch (rzState.cullMode)
-        {
-        case CullMode::Back:        rsDesc.CullMode = D3D11_CULL_BACK;      break;
-        case CullMode::Front:       rsDesc.CullMode = D3D11_CULL_FRONT;     break;
-        case CullMode::None:        rsDesc.CullMode = D3D11_CULL_NONE;      break;
-        }
-
-        rsDesc.FrontCounterClockwise = rzState.frontCounterClockwise;
-        rsDesc.DepthClipEnable       = rzState.depthClipEnable;
-        rsDesc.MultisampleEnable     = true;
-        rsDesc.ScissorEnable         = rzState.scissorEnable;
-        rsDesc.DepthBias             = (INT)rzState.depthBias;
-        rsDesc.SlopeScaledDepthBias  = rzState.slopeScaledDepthBias;
-        rsDesc.DepthBiasClamp        = rzState.depthBiasClamp;
-
-        HR( g_pDevice->CreateRasterizerState( &rsDesc, &m_pRSState.releaseAndGet() ) );
+        m_pipelineStateDesc.rasterizationState = rzState;
+        m_pipelineState = nullptr;
     }
 
     //----------------------------------------------------------------------
     void Shader::setDepthStencilState( const DepthStencilState& dsState )
     {
-        D3D11_DEPTH_STENCIL_DESC depthStencilStateDesc = {};
-
-        depthStencilStateDesc.DepthEnable       = dsState.depthEnable;
-        depthStencilStateDesc.DepthWriteMask    = dsState.depthWrite ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO;
-        depthStencilStateDesc.DepthFunc         = Utility::TranslateComparisonFunc( dsState.depthFunc );
-
-        HR( g_pDevice->CreateDepthStencilState( &depthStencilStateDesc, &m_pDepthStencilState.releaseAndGet() ) );
+        m_pipelineStateDesc.depthStencilState = dsState;
+        m_pipelineState = nullptr;
     }
 
     //----------------------------------------------------------------------
     void Shader::setBlendState( const BlendState& bState )
     {
-        D3D11_BLEND_DESC blendDesc = {};
-        blendDesc.AlphaToCoverageEnable  = bState.alphaToCoverage;
-        blendDesc.IndependentBlendEnable = bState.independentBlending;
-
-        for ( I32 i = 0; i < (bState.independentBlending ? 8 : 1); i++ )
-        {
-            auto& bs = bState.blendStates[i];
-            blendDesc.RenderTarget[i].BlendEnable           = bs.blendEnable;
-            blendDesc.RenderTarget[i].SrcBlend              = Utility::TranslateBlend( bs.srcBlend );
-            blendDesc.RenderTarget[i].DestBlend             = Utility::TranslateBlend( bs.destBlend );
-            blendDesc.RenderTarget[i].BlendOp               = Utility::TranslateBlendOP( bs.blendOp );
-            blendDesc.RenderTarget[i].SrcBlendAlpha         = Utility::TranslateBlend( bs.srcBlendAlpha );
-            blendDesc.RenderTarget[i].DestBlendAlpha        = Utility::TranslateBlend( bs.destBlendAlpha );
-            blendDesc.RenderTarget[i].BlendOpAlpha          = Utility::TranslateBlendOP( bs.blendOpAlpha );
-            blendDesc.RenderTarget[i].RenderTargetWriteMask = bs.writeMask;
-        }
-
-        HR( g_pDevice->CreateBlendState( &blendDesc, &m_pBlendState.releaseAndGet() ) );
+        m_pipelineStateDesc.blendState = bState;
+        m_pipelineStateDesc.blendStateEnabled = true;
+        m_pipelineState = nullptr;
     }
 
     //----------------------------------------------------------------------
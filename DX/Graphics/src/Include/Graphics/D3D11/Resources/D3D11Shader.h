@@ -9,6 +9,7 @@
 #include "../../i_shader.h"
 #include "../D3D11.hpp"
 #include "D3D11/Pipeline/Buffers/D3D11MappedConstantBuffer.h"
+#include "D3D11/Pipeline/D3D11PipelineState.h"
 
 namespace Graphics { namespace D3D11 {
 
@@ -21,7 +22,7 @@ namespace Graphics { namespace D3D11 {
     class Shader : public IShader
     {
     public:
-        Shader();
+        Shader() = default;
         ~Shader() = default;
 
         //----------------------------------------------------------------------
@@ -52,14 +53,19 @@ namespace Graphics { namespace D3D11 {
         const VertexShader* getVertexShader() const { return m_pVertexShader.get(); }
         const PixelShader*  getPixelShader() const { return m_pPixelShader.get(); }
 
+        //----------------------------------------------------------------------
+        // Binds the input layout matching the vertex format of a mesh. Must be called after this shader was bound.
+        //----------------------------------------------------------------------
+        void bindInputLayout(const PackedVertexLayout& packedLayout);
+
     private:
         std::unique_ptr<VertexShader>   m_pVertexShader = nullptr;
         std::unique_ptr<PixelShader>    m_pPixelShader  = nullptr;
         std::unique_ptr<GeometryShader> m_pGeometryShader = nullptr;
 
-        ComPtr<ID3D11DepthStencilState> m_pDepthStencilState;
-        ComPtr<ID3D11RasterizerState>   m_pRSState;
-        ComPtr<ID3D11BlendState>        m_pBlendState;
+        // States are shared with every other shader using the same states. Fetched from the cache on the next bind after a change.
+        PipelineStateDesc               m_pipelineStateDesc;
+        std::shared_ptr<PipelineState>  m_pipelineState = nullptr;
 
         // Contains the data in a contiguous block of memory. Will be empty if not used for a shader.
         std::unique_ptr<MappedConstantBuffer> m_shaderDataVS = nullptr;
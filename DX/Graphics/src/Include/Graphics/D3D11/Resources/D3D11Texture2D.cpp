@@ -43,6 +43,35 @@ namespace Graphics { namespace D3D11 {
         _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
     }
 
+    //----------------------------------------------------------------------
+    void Texture2D::create( U32 width, U32 height, TextureFormat format, const ArrayList<const void*>& mips, U32 firstMip )
+    {
+        ASSERT( width > 0 && height > 0 && not mips.empty() && m_width == 0 && "Invalid params or texture were already created" );
+        ITexture::_Init( TextureDimension::Tex2D, width, height, format );
+
+        m_generateMips = false;
+        m_isImmutable = true;
+        m_mipCount = firstMip + static_cast<U32>( mips.size() );
+        m_residentMip = firstMip;
+        _CreateTexture( mips );
+        _CreateShaderResourveView();
+        _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
+    }
+
+    //----------------------------------------------------------------------
+    void Texture2D::setResidentMips( U32 firstMip, const ArrayList<const void*>& mips )
+    {
+        ASSERT( isImmutable() && firstMip + mips.size() == m_mipCount && "Texture was not created with a precomputed mipchain or mips are missing" );
+
+        // Bound views keep a reference to the old texture, so it is destroyed after the gpu finished using it
+        SAFE_RELEASE( m_pTextureView );
+        SAFE_RELEASE( m_pTexture );
+
+        m_residentMip = firstMip;
+        _CreateTexture( mips );
+        _CreateShaderResourveView();
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -88,6 +117,38 @@ namespace Graphics { namespace D3D11 {
         HR( g_pDevice->CreateTexture2D( &texDesc, &subResourceData , &m_pTexture ) );
     }
 
+    //----------------------------------------------------------------------
+    void Texture2D::_CreateTexture( const ArrayList<const void*>& mips )
+    {
+        // Only the resident mips are allocated, so the largest one of them is the top level of the gpu texture
+        U32 residentWidth  = std::max( 1u, m_width >> m_residentMip );
+        U32 residentHeight = std::max( 1u, m_height >> m_residentMip );
+        U32 residentMips   = m_mipCount - m_residentMip;
+
+        D3D11_TEXTURE2D_DESC texDesc;
+        texDesc.Height              = residentHeight;
+        texDesc.Width               = residentWidth;
+        texDesc.MipLevels           = residentMips;
+        texDesc.ArraySize           = 1;
+        texDesc.Format              = Utility::TranslateTextureFormat( m_format );
+        texDesc.SampleDesc.Count    = 1;
+        texDesc.SampleDesc.Quality  = 0;
+        texDesc.Usage               = D3D11_USAGE_IMMUTABLE;
+        texDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
+        texDesc.CPUAccessFlags      = 0;
+        texDesc.MiscFlags           = 0;
+
+        ArrayList<D3D11_SUBRESOURCE_DATA> subResourceData( residentMips );
+        for (U32 mip = 0; mip < residentMips; mip++)
+        {
+            U32 mipWidth = std::max( 1u, residentWidth >> mip );
+            subResourceData[mip].pSysMem            = mips[mip];
+            subResourceData[mip].SysMemPitch        = RowPitchFromTextureFormat( m_format, mipWidth );
+            subResourceData[mip].SysMemSlicePitch   = 0;
+        }
+        HR( g_pDevice->CreateTexture2D( &texDesc, subResourceData.data(), &m_pTexture ) );
+    }
+
     //----------------------------------------------------------------------
     void Texture2D::_CreateShaderResourveView()
     {
@@ -66,6 +66,11 @@ namespace Graphics {
         bool hasMatrix(CString name)    const { return hasMatrix(SID(name)); }
         bool hasTexture(CString name)   const { return hasTexture(SID(name)); }
 
+        //----------------------------------------------------------------------
+        // @Return: All textures set on this object, e.g. to request their mips from a texture streamer.
+        //----------------------------------------------------------------------
+        const HashMap<StringID, TexturePtr>& getTextures() const { return m_textureMap; }
+
     protected:
         // Data maps
         HashMap<StringID, I32>                          m_intMap;
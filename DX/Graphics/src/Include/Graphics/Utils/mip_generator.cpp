@@ -0,0 +1,545 @@
+#include "mip_generator.h"
+/**********************************************************************
+    class: MipGenerator (mip_generator.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include <emmintrin.h>
+#include <DirectXPackedVector.h>
+
+namespace Graphics {
+
+    // Amount of rows processed by one call of the parallel for
+    static constexpr U32 ROWS_PER_JOB = 16;
+
+    // Radius of the filter kernels in pixels of the smaller mip
+    static constexpr F32 BOX_RADIUS     = 0.5f;
+    static constexpr F32 KAISER_RADIUS  = 3.0f;
+    static constexpr F32 KAISER_ALPHA   = 4.0f;
+    static constexpr F32 LANCZOS_RADIUS = 3.0f;
+
+    //----------------------------------------------------------------------
+    // Image with four floats per pixel, the working format of all filters
+    //----------------------------------------------------------------------
+    struct FloatImage
+    {
+        U32             width;
+        U32             height;
+        ArrayList<F32>  pixels;
+
+        FloatImage(U32 w, U32 h) : width( w ), height( h ), pixels( w * h * 4 ) {}
+
+        F32*        row(U32 y)       { return &pixels[y * width * 4]; }
+        const F32*  row(U32 y) const { return &pixels[y * width * 4]; }
+    };
+
+    //----------------------------------------------------------------------
+    // Returns row "y" of the source of a downsampling pass. The row is either stored in the given scratch
+    // memory (width * 4 floats) or somewhere else. Lets the top mip be decoded row by row while it is filtered.
+    using RowReader = std::function<const F32*(U32 y, F32* scratch)>;
+
+    //----------------------------------------------------------------------
+    // Weighted source pixels which are summed up for every pixel of the smaller mip in one dimension
+    //----------------------------------------------------------------------
+    struct FilterTaps
+    {
+        ArrayList<U32> first;       // First tap of every destination pixel, plus one past the last tap
+        ArrayList<U32> indices;     // Source pixel of every tap, clamped to the image
+        ArrayList<F32> weights;     // Normalized weight of every tap
+    };
+
+    //**********************************************************************
+    // FILTERS
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    static F32 Sinc( F32 x )
+    {
+        if (std::abs( x ) < 1e-5f)
+            return 1.0f;
+        x *= DirectX::XM_PI;
+        return std::sin( x ) / x;
+    }
+
+    //----------------------------------------------------------------------
+    // Modified bessel function of the first kind (power series)
+    //----------------------------------------------------------------------
+    static F32 BesselI0( F32 x )
+    {
+        F32 sum = 1.0f, term = 1.0f;
+        for (U32 k = 1; k < 16; k++)
+        {
+            F32 f = x / (2.0f * k);
+            term *= f * f;
+            sum += term;
+        }
+        return sum;
+    }
+
+    //----------------------------------------------------------------------
+    static F32 FilterRadius( MipFilter filter )
+    {
+        switch (filter)
+        {
+        case MipFilter::Kaiser:  return KAISER_RADIUS;
+        case MipFilter::Lanczos: return LANCZOS_RADIUS;
+        }
+        return BOX_RADIUS;
+    }
+
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "t": Distance to the center of the destination pixel, in destination pixels.
+    //----------------------------------------------------------------------
+    static F32 EvaluateFilter( MipFilter filter, F32 t )
+    {
+        F32 radius = FilterRadius( filter );
+        if (std::abs( t ) > radius)
+            return 0.0f;
+
+        switch (filter)
+        {
+        case MipFilter::Kaiser:
+        {
+            F32 r = t / radius;
+            return Sinc( t ) * BesselI0( KAISER_ALPHA * std::sqrt( 1.0f - r * r ) ) / BesselI0( KAISER_ALPHA );
+        }
+        case MipFilter::Lanczos:
+            return Sinc( t ) * Sinc( t / radius );
+        }
+        return 1.0f;
+    }
+
+    //----------------------------------------------------------------------
+    // Computes the taps for downsampling "srcSize" pixels to "dstSize" pixels. Works for any ratio, so odd sizes are covered.
+    //----------------------------------------------------------------------
+    static FilterTaps ComputeTaps( MipFilter filter, U32 srcSize, U32 dstSize )
+    {
+        FilterTaps taps;
+        F32 scale = static_cast<F32>( srcSize ) / dstSize;
+        F32 radius = FilterRadius( filter ) * scale;
+
+        for (U32 x = 0; x < dstSize; x++)
+        {
+            taps.first.push_back( static_cast<U32>( taps.indices.size() ) );
+
+            F32 center = (x + 0.5f) * scale;
+            I32 begin = static_cast<I32>( std::floor( center - radius ) );
+            I32 end   = static_cast<I32>( std::ceil( center + radius ) );
+
+            F32 sum = 0.0f;
+            for (I32 s = begin; s <= end; s++)
+            {
+                F32 weight = EvaluateFilter( filter, (s + 0.5f - center) / scale );
+                if (weight == 0.0f)
+                    continue;
+
+                taps.indices.push_back( static_cast<U32>( std::clamp( s, 0, static_cast<I32>( srcSize ) - 1 ) ) );
+                taps.weights.push_back( weight );
+                sum += weight;
+            }
+
+            for (U32 i = taps.first.back(); i < taps.weights.size(); i++)
+                taps.weights[i] /= sum;
+        }
+        taps.first.push_back( static_cast<U32>( taps.indices.size() ) );
+
+        return taps;
+    }
+
+    //**********************************************************************
+    // HELPERS
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    // Calls func(begin, end) for bands of rows, in parallel if possible
+    //----------------------------------------------------------------------
+    static void ForEachRowBand( U32 numRows, const MipGenerator::ParallelFor& parallelFor, const std::function<void(U32, U32)>& func )
+    {
+        U32 numBands = (numRows + ROWS_PER_JOB - 1) / ROWS_PER_JOB;
+        auto band = [&](U32 i) { func( i * ROWS_PER_JOB, std::min( (i + 1) * ROWS_PER_JOB, numRows ) ); };
+
+        if (parallelFor && numBands > 1)
+            parallelFor( numBands, band );
+        else
+            for (U32 i = 0; i < numBands; i++)
+                band( i );
+    }
+
+    //----------------------------------------------------------------------
+    static F32 SRGBToLinear( F32 c )
+    {
+        return c <= 0.04045f ? c / 12.92f : std::pow( (c + 0.055f) / 1.055f, 2.4f );
+    }
+
+    //----------------------------------------------------------------------
+    static F32 LinearToSRGB( F32 c )
+    {
+        return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow( c, 1.0f / 2.4f ) - 0.055f;
+    }
+
+    //----------------------------------------------------------------------
+    // Lookup tables for the sRGB conversion of 8 bit values. Encoding is indexed by the linear value in 16 bit.
+    //----------------------------------------------------------------------
+    static const F32* SRGBDecodeTable()
+    {
+        static const auto table = [] {
+            std::array<F32, 256> values;
+            for (U32 i = 0; i < values.size(); i++)
+                values[i] = SRGBToLinear( i / 255.0f );
+            return values;
+        }();
+        return table.data();
+    }
+
+    static const Byte* SRGBEncodeTable()
+    {
+        static const auto table = [] {
+            ArrayList<Byte> values( 1 << 16 );
+            for (U32 i = 0; i < values.size(); i++)
+                values[i] = static_cast<Byte>( LinearToSRGB( i / 65535.0f ) * 255.0f + 0.5f );
+            return values;
+        }();
+        return table.data();
+    }
+
+    //----------------------------------------------------------------------
+    static bool IsUNorm( TextureFormat format )
+    {
+        return format == TextureFormat::RGBA32 || format == TextureFormat::BGRA32;
+    }
+
+    //**********************************************************************
+    // CONVERSION
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    // Converts one row of the top mip into the working format
+    //----------------------------------------------------------------------
+    static void DecodeRow( const void* pixels, U32 width, U32 y, TextureFormat format, const MipSettings& settings, F32* dst )
+    {
+        U32 rowPitch = width * ByteCountFromTextureFormat( format );
+        const Byte* src = reinterpret_cast<const Byte*>( pixels ) + y * rowPitch;
+
+        switch (format)
+        {
+        case TextureFormat::RGBAFloat:
+            memcpy( dst, src, rowPitch );
+            break;
+        case TextureFormat::RGBAHalf:
+            DirectX::PackedVector::XMConvertHalfToFloatStream( dst, sizeof( F32 ), reinterpret_cast<const DirectX::PackedVector::HALF*>( src ),
+                                                               sizeof( DirectX::PackedVector::HALF ), width * 4 );
+            break;
+        default:
+        {
+            // Widen 4 bytes to 4 floats
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps( 1.0f / 255.0f );
+            for (U32 x = 0; x < width; x++)
+            {
+                I32 packed;
+                memcpy( &packed, src + x * 4, 4 );
+                __m128i bytes = _mm_cvtsi32_si128( packed );
+                __m128i ints = _mm_unpacklo_epi16( _mm_unpacklo_epi8( bytes, zero ), zero );
+                _mm_storeu_ps( dst + x * 4, _mm_mul_ps( _mm_cvtepi32_ps( ints ), scale ) );
+            }
+
+            if (settings.sRGB)
+            {
+                const F32* table = SRGBDecodeTable();
+                for (U32 x = 0; x < width; x++)
+                    for (U32 c = 0; c < 3; c++)
+                        dst[x * 4 + c] = table[src[x * 4 + c]];
+            }
+        }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "alphaScale": Alpha is multiplied by this before it is stored.
+    //----------------------------------------------------------------------
+    static ArrayList<Byte> Encode( const FloatImage& image, TextureFormat format, const MipSettings& settings, F32 alphaScale,
+                                   const MipGenerator::ParallelFor& parallelFor )
+    {
+        U32 rowPitch = image.width * ByteCountFromTextureFormat( format );
+        ArrayList<Byte> result( rowPitch * image.height );
+
+        ForEachRowBand( image.height, parallelFor, [&](U32 begin, U32 end) {
+            // Filters with negative lobes can overshoot, so values are clamped to the range of the format
+            const __m128 scale = _mm_setr_ps( 1.0f, 1.0f, 1.0f, alphaScale );
+            const __m128 minValue = _mm_setzero_ps();
+            const F32 maxFloat = std::numeric_limits<F32>::max();
+            const __m128 maxValue = IsUNorm( format ) ? _mm_set1_ps( 1.0f ) : _mm_setr_ps( maxFloat, maxFloat, maxFloat, settings.alphaCutoff > 0.0f ? 1.0f : maxFloat );
+
+            ArrayList<F32> rowBuffer( image.width * 4 );
+            for (U32 y = begin; y < end; y++)
+            {
+                const F32* src = image.row( y );
+                Byte* dst = &result[y * rowPitch];
+
+                for (U32 x = 0; x < image.width; x++)
+                {
+                    __m128 pixel = _mm_mul_ps( _mm_loadu_ps( src + x * 4 ), scale );
+                    _mm_storeu_ps( &rowBuffer[x * 4], _mm_min_ps( _mm_max_ps( pixel, minValue ), maxValue ) );
+                }
+
+                switch (format)
+                {
+                case TextureFormat::RGBAFloat:
+                    memcpy( dst, rowBuffer.data(), rowPitch );
+                    break;
+                case TextureFormat::RGBAHalf:
+                    DirectX::PackedVector::XMConvertFloatToHalfStream( reinterpret_cast<DirectX::PackedVector::HALF*>( dst ), sizeof( DirectX::PackedVector::HALF ),
+                                                                       rowBuffer.data(), sizeof( F32 ), image.width * 4 );
+                    break;
+                default:
+                {
+                    // Round 4 floats to 4 bytes
+                    const __m128 byteScale = _mm_set1_ps( 255.0f );
+                    for (U32 x = 0; x < image.width; x++)
+                    {
+                        __m128i ints = _mm_cvtps_epi32( _mm_mul_ps( _mm_loadu_ps( &rowBuffer[x * 4] ), byteScale ) );
+                        __m128i shorts = _mm_packs_epi32( ints, ints );
+                        I32 packed = _mm_cvtsi128_si32( _mm_packus_epi16( shorts, shorts ) );
+                        memcpy( dst + x * 4, &packed, 4 );
+                    }
+
+                    if (settings.sRGB)
+                    {
+                        const Byte* table = SRGBEncodeTable();
+                        for (U32 x = 0; x < image.width; x++)
+                            for (U32 c = 0; c < 3; c++)
+                                dst[x * 4 + c] = table[static_cast<U32>( rowBuffer[x * 4 + c] * 65535.0f + 0.5f )];
+                    }
+                }
+                }
+            }
+        } );
+
+        return result;
+    }
+
+    //**********************************************************************
+    // FILTERING
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    // Fast path for the most common case: Box filter on even sizes averages exactly 2x2 pixels
+    //----------------------------------------------------------------------
+    static FloatImage DownsampleBox2x2( U32 width, U32 height, const RowReader& readRow, const MipGenerator::ParallelFor& parallelFor )
+    {
+        FloatImage dst( width / 2, height / 2 );
+        ForEachRowBand( dst.height, parallelFor, [&](U32 begin, U32 end) {
+            const __m128 quarter = _mm_set1_ps( 0.25f );
+            ArrayList<F32> scratch( width * 8 );
+            for (U32 y = begin; y < end; y++)
+            {
+                const F32* row0 = readRow( y * 2, scratch.data() );
+                const F32* row1 = readRow( y * 2 + 1, scratch.data() + width * 4 );
+                F32* dstRow = dst.row( y );
+                for (U32 x = 0; x < dst.width; x++)
+                {
+                    __m128 top    = _mm_add_ps( _mm_loadu_ps( row0 + x * 8 ), _mm_loadu_ps( row0 + x * 8 + 4 ) );
+                    __m128 bottom = _mm_add_ps( _mm_loadu_ps( row1 + x * 8 ), _mm_loadu_ps( row1 + x * 8 + 4 ) );
+                    _mm_storeu_ps( dstRow + x * 4, _mm_mul_ps( _mm_add_ps( top, bottom ), quarter ) );
+                }
+            }
+        } );
+        return dst;
+    }
+
+    //----------------------------------------------------------------------
+    // Separable downsampling: First the rows are shrunk horizontally, then the shrunk rows are summed up vertically.
+    //----------------------------------------------------------------------
+    static FloatImage Downsample( U32 width, U32 height, const RowReader& readRow, MipFilter filter, const MipGenerator::ParallelFor& parallelFor )
+    {
+        if (filter == MipFilter::Box && width % 2 == 0 && height % 2 == 0)
+            return DownsampleBox2x2( width, height, readRow, parallelFor );
+
+        U32 dstWidth  = std::max( 1u, width / 2 );
+        U32 dstHeight = std::max( 1u, height / 2 );
+        FilterTaps horizontalTaps = ComputeTaps( filter, width, dstWidth );
+        FilterTaps verticalTaps   = ComputeTaps( filter, height, dstHeight );
+
+        FloatImage shrunkRows( dstWidth, height );
+        ForEachRowBand( height, parallelFor, [&](U32 begin, U32 end) {
+            ArrayList<F32> scratch( width * 4 );
+            for (U32 y = begin; y < end; y++)
+            {
+                const F32* srcRow = readRow( y, scratch.data() );
+                F32* dstRow = shrunkRows.row( y );
+                for (U32 x = 0; x < dstWidth; x++)
+                {
+                    __m128 sum = _mm_setzero_ps();
+                    for (U32 t = horizontalTaps.first[x]; t < horizontalTaps.first[x + 1]; t++)
+                    {
+                        __m128 pixel = _mm_loadu_ps( srcRow + horizontalTaps.indices[t] * 4 );
+                        sum = _mm_add_ps( sum, _mm_mul_ps( pixel, _mm_set1_ps( horizontalTaps.weights[t] ) ) );
+                    }
+                    _mm_storeu_ps( dstRow + x * 4, sum );
+                }
+            }
+        } );
+
+        // Whole rows are accumulated, so memory is read linearly
+        FloatImage dst( dstWidth, dstHeight );
+        ForEachRowBand( dstHeight, parallelFor, [&](U32 begin, U32 end) {
+            for (U32 y = begin; y < end; y++)
+            {
+                F32* dstRow = dst.row( y );
+                for (U32 t = verticalTaps.first[y]; t < verticalTaps.first[y + 1]; t++)
+                {
+                    const F32* srcRow = shrunkRows.row( verticalTaps.indices[t] );
+                    __m128 weight = _mm_set1_ps( verticalTaps.weights[t] );
+                    for (U32 i = 0; i < dstWidth * 4; i += 4)
+                    {
+                        __m128 sum = _mm_loadu_ps( dstRow + i );
+                        _mm_storeu_ps( dstRow + i, _mm_add_ps( sum, _mm_mul_ps( _mm_loadu_ps( srcRow + i ), weight ) ) );
+                    }
+                }
+            }
+        } );
+
+        return dst;
+    }
+
+    //----------------------------------------------------------------------
+    // Normals shrink when they are averaged, so they are scaled back to unit length
+    //----------------------------------------------------------------------
+    static void Renormalize( FloatImage& image, const MipGenerator::ParallelFor& parallelFor )
+    {
+        ForEachRowBand( image.height, parallelFor, [&](U32 begin, U32 end) {
+            const __m128 two = _mm_set1_ps( 2.0f );
+            const __m128 one = _mm_set1_ps( 1.0f );
+            const __m128 half = _mm_set1_ps( 0.5f );
+            const __m128 xyzMask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+
+            for (U32 y = begin; y < end; y++)
+            {
+                F32* row = image.row( y );
+                for (U32 x = 0; x < image.width; x++)
+                {
+                    __m128 pixel = _mm_loadu_ps( row + x * 4 );
+                    __m128 normal = _mm_and_ps( _mm_sub_ps( _mm_mul_ps( pixel, two ), one ), xyzMask );
+
+                    // Horizontal sum of the squares
+                    __m128 sqr = _mm_mul_ps( normal, normal );
+                    sqr = _mm_add_ps( sqr, _mm_shuffle_ps( sqr, sqr, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+                    sqr = _mm_add_ps( sqr, _mm_shuffle_ps( sqr, sqr, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+                    if (_mm_cvtss_f32( sqr ) < 1e-8f)
+                        continue;
+
+                    normal = _mm_div_ps( normal, _mm_sqrt_ps( sqr ) );
+                    __m128 encoded = _mm_mul_ps( _mm_add_ps( normal, one ), half );
+
+                    // Keep alpha
+                    _mm_storeu_ps( row + x * 4, _mm_or_ps( _mm_and_ps( encoded, xyzMask ), _mm_andnot_ps( xyzMask, pixel ) ) );
+                }
+            }
+        } );
+    }
+
+    //----------------------------------------------------------------------
+    // @Return: Fraction of pixels whose alpha is at least the given cutoff.
+    //----------------------------------------------------------------------
+    static F32 AlphaCoverage( U32 width, U32 height, const RowReader& readRow, F32 cutoff )
+    {
+        ArrayList<F32> scratch( width * 4 );
+        U32 covered = 0;
+        for (U32 y = 0; y < height; y++)
+        {
+            const F32* row = readRow( y, scratch.data() );
+            for (U32 x = 0; x < width; x++)
+                if (row[x * 4 + 3] >= cutoff)
+                    covered++;
+        }
+        return static_cast<F32>( covered ) / (width * height);
+    }
+
+    //----------------------------------------------------------------------
+    // @Return: Scale for the alpha of the given image, so the given fraction of pixels passes the cutoff.
+    //----------------------------------------------------------------------
+    static F32 FindAlphaScale( const FloatImage& image, F32 cutoff, F32 coverage )
+    {
+        U32 numPixels = image.width * image.height;
+        U32 numCovered = static_cast<U32>( std::lround( coverage * numPixels ) );
+        if (numCovered == 0)
+            return 1.0f;
+
+        // The alpha of the last pixel which should pass is scaled onto the cutoff
+        ArrayList<F32> alphas( numPixels );
+        for (U32 i = 0; i < numPixels; i++)
+            alphas[i] = image.pixels[i * 4 + 3];
+        std::nth_element( alphas.begin(), alphas.begin() + (numCovered - 1), alphas.end(), std::greater<F32>() );
+
+        F32 threshold = alphas[numCovered - 1];
+        return threshold > 0.0f ? cutoff / threshold : 1.0f;
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ArrayList<ArrayList<Byte>> MipGenerator::Generate( const void* pixels, U32 width, U32 height, TextureFormat format,
+                                                       const MipSettings& settings, const ParallelFor& parallelFor )
+    {
+        ASSERT( IsSupported( format ) && width > 0 && height > 0 );
+
+        // The top mip is only decoded row by row, the smaller ones are kept in the working format
+        RowReader readTop = [&](U32 y, F32* scratch) {
+            DecodeRow( pixels, width, y, format, settings, scratch );
+            return scratch;
+        };
+        FloatImage image( 0, 0 );
+        RowReader readImage = [&](U32 y, F32*) { return image.row( y ); };
+
+        F32 coverage = settings.alphaCutoff > 0.0f ? AlphaCoverage( width, height, readTop, settings.alphaCutoff ) : 0.0f;
+
+        // Every mip is filtered from the unscaled previous one, so the alpha scale doesn't accumulate
+        ArrayList<ArrayList<Byte>> mips;
+        for (U32 mip = 1; mip < CountMips( width, height ); mip++)
+        {
+            image = mip == 1 ? Downsample( width, height, readTop, settings.filter, parallelFor )
+                             : Downsample( image.width, image.height, readImage, settings.filter, parallelFor );
+            if (settings.normalMap)
+                Renormalize( image, parallelFor );
+
+            F32 alphaScale = settings.alphaCutoff > 0.0f ? FindAlphaScale( image, settings.alphaCutoff, coverage ) : 1.0f;
+            mips.push_back( Encode( image, format, settings, alphaScale, parallelFor ) );
+        }
+
+        return mips;
+    }
+
+    //----------------------------------------------------------------------
+    bool MipGenerator::IsSupported( TextureFormat format )
+    {
+        switch (format)
+        {
+        case TextureFormat::RGBA32:
+        case TextureFormat::BGRA32:
+        case TextureFormat::RGBAHalf:
+        case TextureFormat::RGBAFloat:
+            return true;
+        }
+        return false;
+    }
+
+    //----------------------------------------------------------------------
+    U32 MipGenerator::CountMips( U32 width, U32 height )
+    {
+        U32 count = 1;
+        while (width > 1 || height > 1)
+        {
+            width  = std::max( 1u, width / 2 );
+            height = std::max( 1u, height / 2 );
+            count++;
+        }
+        return count;
+    }
+
+} // End namespaces
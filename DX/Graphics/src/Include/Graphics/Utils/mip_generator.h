@@ -0,0 +1,79 @@
+#pragma once
+/**********************************************************************
+    class: MipGenerator (mip_generator.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Generates mipchains on the cpu, e.g. for the texture cache or for
+    textures which are created immutable. All filtering happens in
+    32 bit float per channel with SSE, one pixel per register:
+    - 8 bit color can be treated as sRGB, so it is averaged in linear space
+    - Box, Kaiser or Lanczos filter (separable, odd sizes are handled)
+    - Alpha is rescaled per mip to preserve the coverage of cutout textures
+    Rows of each mip are filtered in parallel if a ParallelFor is given.
+    Images of cubemaps or arrays are independent and can be generated
+    on separate jobs.
+    Only SSE2 is used, the projects don't enable AVX. Used by the texture
+    cache and immutable cubemaps. Mutable textures and texture arrays
+    still generate their mips on the gpu in apply().
+**********************************************************************/
+
+#include "enums.hpp"
+
+namespace Graphics {
+
+    //----------------------------------------------------------------------
+    enum class MipFilter
+    {
+        Box,        // 2x2 average. Fastest, but blurry and aliases on high frequencies
+        Kaiser,     // Kaiser windowed sinc (radius 3). Sharp with little ringing
+        Lanczos     // Lanczos-3 windowed sinc. Sharpest, but rings on hard edges
+    };
+
+    //----------------------------------------------------------------------
+    struct MipSettings
+    {
+        MipFilter   filter      = MipFilter::Box;
+        bool        sRGB        = false;    // RGB of 8 bit formats is sRGB encoded. Alpha and float formats are always linear.
+        bool        normalMap   = false;    // RGB stores a normal in [0,1], which is renormalized after filtering
+        F32         alphaCutoff = 0.0f;     // If > 0, the alpha test threshold of a cutout texture. Alpha of every mip
+                                            // is scaled, so the same fraction of pixels passes the test as in the top mip.
+    };
+
+    //*********************************************************************
+    class MipGenerator
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Calls func(i) for every i in [0, count) and returns when all calls are done.
+        //----------------------------------------------------------------------
+        using ParallelFor = std::function<void(U32 count, const std::function<void(U32)>& func)>;
+
+        //----------------------------------------------------------------------
+        // Generates the mipchain of the given image down to 1x1.
+        // @Params:
+        //  "pixels": The top mip. Rows must be tightly packed.
+        //  "format": RGBA32, BGRA32, RGBAHalf or RGBAFloat.
+        //  "parallelFor": Distributes the rows of each mip. Everything runs on the calling thread if null.
+        // @Return:
+        //  Every mip except the top one, beginning with the largest one. Same format as the input.
+        //----------------------------------------------------------------------
+        static ArrayList<ArrayList<Byte>> Generate(const void* pixels, U32 width, U32 height, TextureFormat format,
+                                                   const MipSettings& settings, const ParallelFor& parallelFor = nullptr);
+
+        //----------------------------------------------------------------------
+        // @Return: Whether Generate() accepts the given format.
+        //----------------------------------------------------------------------
+        static bool IsSupported(TextureFormat format);
+
+        //----------------------------------------------------------------------
+        // @Return: Amount of mips of a complete mipchain, including the top one.
+        //----------------------------------------------------------------------
+        static U32 CountMips(U32 width, U32 height);
+
+        MipGenerator() = delete;
+        NULL_COPY_AND_ASSIGN(MipGenerator)
+    };
+
+} // End namespaces
@@ -0,0 +1,138 @@
+#include "pipeline_state_cache.h"
+/**********************************************************************
+    class: PipelineStateCache (pipeline_state_cache.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "OS/FileSystem/file.h"
+#include "OS/FileSystem/file_system.h"
+#include "Logging/logging.h"
+
+namespace Graphics {
+
+    // Written at the beginning of a warm-up list. The size of a description detects changes of the state structs.
+    static constexpr U32 WARM_UP_LIST_MAGIC     = 0x50534f43; // "PSOC"
+    static constexpr U32 WARM_UP_LIST_VERSION   = 1;
+
+    //----------------------------------------------------------------------
+    // FNV-1a over the bytes of a single value
+    //----------------------------------------------------------------------
+    template <typename T>
+    static void HashCombine( U64& hash, const T& value )
+    {
+        auto bytes = reinterpret_cast<const Byte*>( &value );
+        for (Size i = 0; i < sizeof( T ); i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+    }
+
+    //**********************************************************************
+    // PipelineStateDesc
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    U64 PipelineStateDesc::hash() const
+    {
+        U64 hash = 0xcbf29ce484222325ull;
+
+        HashCombine( hash, rasterizationState.fillMode );
+        HashCombine( hash, rasterizationState.cullMode );
+        HashCombine( hash, rasterizationState.depthBias );
+        HashCombine( hash, rasterizationState.depthBiasClamp );
+        HashCombine( hash, rasterizationState.slopeScaledDepthBias );
+        HashCombine( hash, rasterizationState.frontCounterClockwise );
+        HashCombine( hash, rasterizationState.scissorEnable );
+        HashCombine( hash, rasterizationState.depthClipEnable );
+
+        HashCombine( hash, depthStencilState.depthEnable );
+        HashCombine( hash, depthStencilState.depthWrite );
+        HashCombine( hash, depthStencilState.depthFunc );
+
+        HashCombine( hash, blendStateEnabled );
+        if (blendStateEnabled)
+        {
+            HashCombine( hash, blendState.alphaToCoverage );
+            HashCombine( hash, blendState.independentBlending );
+
+            // Without independent blending only the first render target is used
+            I32 numBlendStates = blendState.independentBlending ? 8 : 1;
+            for (I32 i = 0; i < numBlendStates; i++)
+            {
+                auto& bs = blendState.blendStates[i];
+                HashCombine( hash, bs.blendEnable );
+                HashCombine( hash, bs.srcBlend );
+                HashCombine( hash, bs.destBlend );
+                HashCombine( hash, bs.blendOp );
+                HashCombine( hash, bs.srcBlendAlpha );
+                HashCombine( hash, bs.destBlendAlpha );
+                HashCombine( hash, bs.blendOpAlpha );
+                HashCombine( hash, bs.writeMask );
+            }
+        }
+
+        return hash;
+    }
+
+    //**********************************************************************
+    // IPipelineStateCache
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    PipelineStateCacheStats IPipelineStateCache::getStats() const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_stats;
+    }
+
+    //----------------------------------------------------------------------
+    bool IPipelineStateCache::loadWarmUpList( const OS::Path& path )
+    {
+        if ( not OS::FileSystem::exists( path ) )
+            return false;
+
+        OS::BinaryFile file( path, OS::EFileMode::READ );
+
+        U32 header[3] = {};
+        file.read( header, sizeof( header ) );
+        if (header[0] != WARM_UP_LIST_MAGIC || header[1] != WARM_UP_LIST_VERSION || header[2] != sizeof( PipelineStateDesc ))
+        {
+            LOG_WARN_RENDERING( "PipelineStateCache: Warm-up list '" + path.toString() + "' is outdated and will be ignored." );
+            return false;
+        }
+
+        U32 count = 0;
+        file.read( &count, sizeof( count ) );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+        for (U32 i = 0; i < count; i++)
+        {
+            PipelineStateDesc desc;
+            if ( file.read( &desc, sizeof( desc ) ) != sizeof( desc ) )
+                break;
+
+            if ( _CreateIfMissing( desc.hash(), desc ) )
+                m_stats.numWarmedUp++;
+        }
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    void IPipelineStateCache::saveWarmUpList( const OS::Path& path ) const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        OS::BinaryFile file( path, OS::EFileMode::WRITE );
+
+        U32 header[4] = { WARM_UP_LIST_MAGIC, WARM_UP_LIST_VERSION, sizeof( PipelineStateDesc ), static_cast<U32>( m_descs.size() ) };
+        file.write( reinterpret_cast<const Byte*>( header ), sizeof( header ) );
+
+        for (auto& pair : m_descs)
+            file.write( reinterpret_cast<const Byte*>( &pair.second ), sizeof( PipelineStateDesc ) );
+    }
+
+} // End namespaces
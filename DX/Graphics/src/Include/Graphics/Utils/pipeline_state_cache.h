@@ -0,0 +1,137 @@
+#pragma once
+/**********************************************************************
+    class: PipelineStateCache (pipeline_state_cache.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Global cache for the fixed function state of a pipeline (rasterizer,
+    depth-stencil and blend state). Each combination of states is hashed
+    into a 64-bit key and the api object for it is created only once,
+    so shaders and materials with identical states share one object.
+    All created states can be written to a warm-up list on disk. Loading
+    this list on the next start creates the states upfront, which avoids
+    the creation in the middle of the first frames. Thread-safe.
+**********************************************************************/
+
+#include "structs.hpp"
+#include <mutex>
+#include <functional>
+
+namespace OS { class Path; }
+
+namespace Graphics {
+
+    //----------------------------------------------------------------------
+    struct PipelineStateDesc
+    {
+        RasterizationState  rasterizationState;
+        DepthStencilState   depthStencilState;
+        BlendState          blendState;
+        bool                blendStateEnabled = false; // Api default blend state if false
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Hash over all members. Computed field by field, so padding bytes don't matter.
+        //----------------------------------------------------------------------
+        U64 hash() const;
+    };
+
+    //----------------------------------------------------------------------
+    struct PipelineStateCacheStats
+    {
+        U32 numHits     = 0; // Requests which returned an existing state
+        U32 numMisses   = 0; // Requests which created a new state
+        U32 numStates   = 0; // Unique states in the cache
+        U32 numWarmedUp = 0; // States created from the warm-up list
+    };
+
+    //**********************************************************************
+    // Api independent part of the cache: Statistics and the warm-up list.
+    //**********************************************************************
+    class IPipelineStateCache
+    {
+    public:
+        IPipelineStateCache() = default;
+        virtual ~IPipelineStateCache() = default;
+
+        //----------------------------------------------------------------------
+        PipelineStateCacheStats getStats() const;
+
+        //----------------------------------------------------------------------
+        // Creates every state stored in the given warm-up list.
+        // @Return:
+        //  False, if the file does not exist or was written by an incompatible version.
+        //----------------------------------------------------------------------
+        bool loadWarmUpList(const OS::Path& path);
+
+        //----------------------------------------------------------------------
+        // Writes the description of every state in the cache into the given file.
+        //----------------------------------------------------------------------
+        void saveWarmUpList(const OS::Path& path) const;
+
+    protected:
+        mutable std::mutex                  m_mutex;
+        PipelineStateCacheStats             m_stats;
+        HashMap<U64, PipelineStateDesc>     m_descs;
+
+        //----------------------------------------------------------------------
+        // Creates the state for the given description if it does not exist yet. Mutex must be locked.
+        // @Return:
+        //  True if the state was created.
+        //----------------------------------------------------------------------
+        virtual bool _CreateIfMissing(U64 key, const PipelineStateDesc& desc) = 0;
+
+    private:
+        NULL_COPY_AND_ASSIGN(IPipelineStateCache)
+    };
+
+    //**********************************************************************
+    // Cache for the api specific state object "T".
+    //**********************************************************************
+    template <typename T>
+    class PipelineStateCache : public IPipelineStateCache
+    {
+    public:
+        using CreateFunc = std::function<std::shared_ptr<T>(const PipelineStateDesc&)>;
+
+        PipelineStateCache(const CreateFunc& createFunc) : m_createFunc( createFunc ) {}
+        ~PipelineStateCache() = default;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The state object for the given description. Created if it does not exist yet.
+        //----------------------------------------------------------------------
+        std::shared_ptr<T> get(const PipelineStateDesc& desc)
+        {
+            U64 key = desc.hash();
+
+            std::lock_guard<std::mutex> lock( m_mutex );
+            if ( _CreateIfMissing( key, desc ) )
+                m_stats.numMisses++;
+            else
+                m_stats.numHits++;
+
+            return m_states[key];
+        }
+
+    private:
+        CreateFunc                          m_createFunc;
+        HashMap<U64, std::shared_ptr<T>>    m_states;
+
+        //----------------------------------------------------------------------
+        bool _CreateIfMissing(U64 key, const PipelineStateDesc& desc) override
+        {
+            if ( m_states.find( key ) != m_states.end() )
+                return false;
+
+            m_states[key] = m_createFunc( desc );
+            m_descs[key] = desc;
+            m_stats.numStates = static_cast<U32>( m_states.size() );
+            return true;
+        }
+
+        NULL_COPY_AND_ASSIGN(PipelineStateCache)
+    };
+
+} // End namespaces
@@ -0,0 +1,213 @@
+#include "shader_cache.h"
+/**********************************************************************
+    class: ShaderCache (shader_cache.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+#include "OS/FileSystem/file.h"
+#include "OS/FileSystem/mapped_file.h"
+#include "Common/DataStructures/binary_stream.hpp"
+#include "Logging/logging.h"
+
+namespace Graphics {
+
+    // Increase the version whenever the layout below changes
+    static constexpr U32 SHADER_CACHE_MAGIC     = 0x43444853; // "SHDC"
+    static constexpr U32 SHADER_CACHE_VERSION   = 1;
+
+    // Entries which were not used for this many saves are dropped
+    static constexpr U32 MAX_UNUSED_SAVES       = 8;
+
+    // SPIR-V is read in words straight from the mapped file
+    static constexpr Size BYTECODE_ALIGNMENT    = 4;
+
+    //----------------------------------------------------------------------
+    struct ShaderCacheHeader
+    {
+        U32 magic;
+        U32 version;
+        U32 numEntries;
+    };
+
+    //----------------------------------------------------------------------
+    // The index follows the header. Offsets are relative to the beginning of the file.
+    //----------------------------------------------------------------------
+    struct ShaderCacheIndexEntry
+    {
+        U64 key;
+        U64 offset;
+        U32 size;
+        U32 unusedSaves;
+    };
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ShaderCache::ShaderCache( const OS::Path& path )
+        : m_path( path )
+    {
+        _Load();
+    }
+
+    //----------------------------------------------------------------------
+    ShaderCache::~ShaderCache() = default;
+
+    //----------------------------------------------------------------------
+    U64 ShaderCache::Hash( const void* data, Size size, U64 hash )
+    {
+        auto bytes = reinterpret_cast<const Byte*>( data );
+        for (Size i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    //----------------------------------------------------------------------
+    const Byte* ShaderCache::find( U64 key, Size* size )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_entries.find( key );
+        if ( it == m_entries.end() )
+        {
+            m_stats.numMisses++;
+            return nullptr;
+        }
+
+        m_stats.numHits++;
+        it->second.used = true;
+        *size = it->second.size;
+        return it->second.data;
+    }
+
+    //----------------------------------------------------------------------
+    const Byte* ShaderCache::add( U64 key, const void* data, Size size )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_entries.find( key );
+        if ( it != m_entries.end() )
+            return it->second.data;
+
+        // Nodes of the map are never moved, so the bytecode can be referenced by the entry
+        auto bytes = reinterpret_cast<const Byte*>( data );
+        auto& bytecode = m_added[key];
+        bytecode.assign( bytes, bytes + size );
+
+        m_entries[key] = { bytecode.data(), size, 0, true };
+        m_stats.numEntries++;
+        m_stats.sizeInBytes += size;
+
+        return bytecode.data();
+    }
+
+    //----------------------------------------------------------------------
+    void ShaderCache::save()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        ArrayList<std::pair<U64, const Entry*>> kept;
+        for (auto& [key, entry] : m_entries)
+            if ( entry.used || entry.unusedSaves + 1 < MAX_UNUSED_SAVES )
+                kept.push_back( { key, &entry } );
+
+        // Bytecode follows the index, each one aligned
+        Size offset = sizeof( ShaderCacheHeader ) + kept.size() * sizeof( ShaderCacheIndexEntry );
+        ArrayList<ShaderCacheIndexEntry> index;
+        for (auto& [key, entry] : kept)
+        {
+            offset = (offset + BYTECODE_ALIGNMENT - 1) / BYTECODE_ALIGNMENT * BYTECODE_ALIGNMENT;
+            index.push_back( { key, offset, static_cast<U32>( entry->size ), entry->used ? 0 : entry->unusedSaves + 1 } );
+            offset += entry->size;
+        }
+
+        Common::BinaryWriter writer;
+        writer.write( ShaderCacheHeader{ SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, static_cast<U32>( kept.size() ) } );
+        for (auto& indexEntry : index)
+            writer.write( indexEntry );
+        for (auto& [key, entry] : kept)
+        {
+            writer.align( BYTECODE_ALIGNMENT );
+            writer.writeBytes( entry->data, entry->size );
+        }
+
+        // The file can't be written while it is mapped
+        m_entries.clear();
+        m_added.clear();
+        m_file.reset();
+
+        try
+        {
+            OS::BinaryFile file( m_path, OS::EFileMode::WRITE );
+            file.write( writer.getBuffer().data(), writer.size() );
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN_RENDERING( "ShaderCache: Could not write cache file '" + m_path.toString() + "'. Reason: " + e.what() );
+        }
+
+        _Load();
+    }
+
+    //----------------------------------------------------------------------
+    ShaderCacheStats ShaderCache::getStats() const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_stats;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ShaderCache::_Load()
+    {
+        m_stats.numEntries  = 0;
+        m_stats.sizeInBytes = 0;
+
+        if ( not m_path.exists() )
+            return;
+
+        try
+        {
+            m_file = std::make_unique<OS::MappedFile>( m_path );
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN_RENDERING( "ShaderCache: Could not map cache file '" + m_path.toString() + "'. Reason: " + e.what() );
+            return;
+        }
+        Common::BinaryReader reader( m_file->data(), m_file->size() );
+
+        auto header = reader.read<ShaderCacheHeader>();
+        if ( not reader.isValid() || header.magic != SHADER_CACHE_MAGIC || header.version != SHADER_CACHE_VERSION )
+        {
+            LOG_WARN_RENDERING( "ShaderCache: Cache file '" + m_path.toString() + "' is outdated and will be ignored." );
+            m_file.reset();
+            return;
+        }
+
+        // Only the index is read here, the bytecode is paged in when a shader is created from it
+        for (U32 i = 0; i < header.numEntries; i++)
+        {
+            auto indexEntry = reader.read<ShaderCacheIndexEntry>();
+            if ( not reader.isValid() || indexEntry.offset + indexEntry.size > m_file->size() )
+            {
+                LOG_WARN_RENDERING( "ShaderCache: Cache file '" + m_path.toString() + "' is truncated. Remaining entries will be ignored." );
+                break;
+            }
+
+            m_entries[indexEntry.key] = { m_file->data() + indexEntry.offset, indexEntry.size, indexEntry.unusedSaves };
+            m_stats.sizeInBytes += indexEntry.size;
+        }
+        m_stats.numEntries = static_cast<U32>( m_entries.size() );
+    }
+
+} // End namespaces
@@ -0,0 +1,96 @@
+#pragma once
+/**********************************************************************
+    class: ShaderCache (shader_cache.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Content addressed cache for compiled shader bytecode. Each entry
+    is keyed by a 64-bit hash over everything which affects the output
+    of the compiler, e.g. the preprocessed source, entry point, profile
+    and flags. All entries live in a single packed file, which is
+    mapped into memory: Opening reads only the index and the bytecode
+    of a shader is paged in on first use. Entries compiled in this run
+    are kept in memory until the cache is saved. Entries not used for
+    several saves are dropped then, so the file does not grow forever.
+    Thread-safe, so stages can be compiled on worker threads.
+**********************************************************************/
+
+#include "OS/FileSystem/path.h"
+#include <mutex>
+
+namespace OS { class MappedFile; }
+
+namespace Graphics {
+
+    //----------------------------------------------------------------------
+    struct ShaderCacheStats
+    {
+        U32     numHits     = 0;    // Lookups which found the bytecode
+        U32     numMisses   = 0;    // Lookups which required a compilation
+        U32     numEntries  = 0;    // Entries on disk + compiled in this run
+        Size    sizeInBytes = 0;    // Bytecode of all entries
+    };
+
+    //**********************************************************************
+    class ShaderCache
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Opens the cache file at the given path. The cache starts empty if the file
+        // does not exist or was written by an incompatible version.
+        //----------------------------------------------------------------------
+        explicit ShaderCache(const OS::Path& path);
+        ~ShaderCache();
+
+        //----------------------------------------------------------------------
+        // FNV-1a over the given bytes. Pass the previous result as "hash" to combine several inputs.
+        //----------------------------------------------------------------------
+        static U64 Hash(const void* data, Size size, U64 hash = 0xcbf29ce484222325ull);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Bytecode for the given key or nullptr if it is not cached. The memory stays valid until save() is called.
+        //----------------------------------------------------------------------
+        const Byte* find(U64 key, Size* size);
+
+        //----------------------------------------------------------------------
+        // Adds a copy of the bytecode for the given key. Ignored if the key exists already,
+        // e.g. because another thread compiled the same shader concurrently.
+        // @Return:
+        //  The cached bytecode for the given key. The memory stays valid until save() is called.
+        //----------------------------------------------------------------------
+        const Byte* add(U64 key, const void* data, Size size);
+
+        //----------------------------------------------------------------------
+        // Writes all entries into the cache file and maps it again.
+        // No pointer returned by find() must be used during or after this call.
+        //----------------------------------------------------------------------
+        void save();
+
+        //----------------------------------------------------------------------
+        ShaderCacheStats getStats() const;
+
+    private:
+        struct Entry
+        {
+            const Byte* data;
+            Size        size;
+            U32         unusedSaves;    // Saves in a row this entry was not used
+            bool        used = false;
+        };
+
+        OS::Path                            m_path;
+        std::unique_ptr<OS::MappedFile>     m_file;
+        HashMap<U64, Entry>                 m_entries;
+        HashMap<U64, ArrayList<Byte>>       m_added;    // Bytecode compiled in this run
+        mutable std::mutex                  m_mutex;
+        ShaderCacheStats                    m_stats;
+
+        //----------------------------------------------------------------------
+        void _Load();
+
+        NULL_COPY_AND_ASSIGN(ShaderCache)
+    };
+
+} // End namespaces
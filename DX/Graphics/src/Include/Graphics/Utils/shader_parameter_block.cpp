@@ -0,0 +1,114 @@
+#include "shader_parameter_block.h"
+/**********************************************************************
+    class: ShaderParameterBlock (shader_parameter_block.cpp)
+
+    author: S. Hau
+    date: October 19, 2026
+**********************************************************************/
+
+namespace Graphics {
+
+    // Ranges closer than one shader register (16 bytes) are merged
+    #define DIRTY_RANGE_MERGE_DISTANCE  16
+
+    // If more ranges are dirty, they are collapsed into one, because uploading a few
+    // unchanged bytes in between is cheaper than issuing many small uploads
+    #define MAX_DIRTY_RANGES            8
+
+    //----------------------------------------------------------------------
+    ShaderParameterBlock::ShaderParameterBlock( const ShaderUniformBufferDeclaration& bufferInfo )
+        : m_bufferInfo( bufferInfo )
+    {
+        m_data = (Byte*)_aligned_malloc( getSize(), 16 );
+        memset( m_data, 0, getSize() );
+
+        // The gpu buffer has never been written, so everything has to be uploaded once
+        _MarkDirty( 0, getSize() );
+    }
+
+    //----------------------------------------------------------------------
+    ShaderParameterBlock::~ShaderParameterBlock()
+    {
+        _aligned_free( m_data );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ShaderParameterHandle ShaderParameterBlock::getHandle( StringID name ) const
+    {
+        ShaderParameterHandle handle;
+        if ( auto member = m_bufferInfo.getMember( name ) )
+        {
+            handle.offset = member->getOffset();
+            handle.size   = member->getSize();
+        }
+        return handle;
+    }
+
+    //----------------------------------------------------------------------
+    bool ShaderParameterBlock::set( ShaderParameterHandle handle, const void* data )
+    {
+        if ( not handle.isValid() )
+            return false;
+
+        ASSERT( handle.offset + handle.size <= getSize() );
+        if ( memcmp( &m_data[handle.offset], data, handle.size ) != 0 )
+        {
+            memcpy( &m_data[handle.offset], data, handle.size );
+            _MarkDirty( handle.offset, handle.offset + handle.size );
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    void ShaderParameterBlock::set( const void* data, U32 sizeInBytes )
+    {
+        ASSERT( sizeInBytes <= getSize() );
+        memcpy( m_data, data, sizeInBytes );
+        _MarkDirty( 0, sizeInBytes );
+    }
+
+    //----------------------------------------------------------------------
+    U32 ShaderParameterBlock::getDirtyByteCount() const
+    {
+        U32 count = 0;
+        for (auto& range : m_dirtyRanges)
+            count += range.end - range.begin;
+        return count;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ShaderParameterBlock::_MarkDirty( U32 begin, U32 end )
+    {
+        // Find first range which ends near or after the new one begins
+        auto it = std::find_if( m_dirtyRanges.begin(), m_dirtyRanges.end(), [=](const ByteRange& range) {
+            return range.end + DIRTY_RANGE_MERGE_DISTANCE >= begin;
+        } );
+
+        // Merge with every range which begins near or before the new one ends
+        auto last = it;
+        while ( last != m_dirtyRanges.end() && last->begin <= end + DIRTY_RANGE_MERGE_DISTANCE )
+        {
+            begin = std::min( begin, last->begin );
+            end   = std::max( end, last->end );
+            last++;
+        }
+
+        it = m_dirtyRanges.erase( it, last );
+        m_dirtyRanges.insert( it, { begin, end } );
+
+        if (m_dirtyRanges.size() > MAX_DIRTY_RANGES)
+        {
+            ByteRange collapsed{ m_dirtyRanges.front().begin, m_dirtyRanges.back().end };
+            m_dirtyRanges.assign( 1, collapsed );
+        }
+    }
+
+} // End namespaces
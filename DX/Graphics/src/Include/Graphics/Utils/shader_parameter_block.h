@@ -0,0 +1,91 @@
+#pragma once
+/**********************************************************************
+    class: ShaderParameterBlock (shader_parameter_block.h)
+
+    author: S. Hau
+    date: October 19, 2026
+
+    Packed cpu copy of a uniform/constant buffer, laid out as reflected
+    from the shader. Parameters are written at their precomputed offset
+    and every write which actually changes data is recorded as a dirty
+    byte range, so a backend knows whether and which part of the buffer
+    has to be uploaded. Resolve a parameter name once to a handle to
+    skip the name lookup on every write.
+    This class does not depend on any graphics api.
+**********************************************************************/
+
+#include "shader_resources.hpp"
+
+namespace Graphics {
+
+    //----------------------------------------------------------------------
+    struct ShaderParameterHandle
+    {
+        U32 offset  = 0;
+        U32 size    = 0;
+
+        bool isValid() const { return size > 0; }
+    };
+
+    //**********************************************************************
+    class ShaderParameterBlock
+    {
+    public:
+        struct ByteRange
+        {
+            U32 begin;
+            U32 end; // Exclusive
+        };
+
+        ShaderParameterBlock(const ShaderUniformBufferDeclaration& bufferInfo);
+        ~ShaderParameterBlock();
+
+        //----------------------------------------------------------------------
+        const ShaderUniformBufferDeclaration&   getBufferInfo()     const { return m_bufferInfo; }
+        const Byte*                             getData()           const { return m_data; }
+        U32                                     getSize()           const { return m_bufferInfo.getSize(); }
+        bool                                    isDirty()           const { return not m_dirtyRanges.empty(); }
+        const ArrayList<ByteRange>&             getDirtyRanges()    const { return m_dirtyRanges; } // Sorted and not overlapping
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Handle to the parameter with the given name. Invalid if the parameter does not exist.
+        //----------------------------------------------------------------------
+        ShaderParameterHandle getHandle(StringID name) const;
+
+        //----------------------------------------------------------------------
+        // Copies the given data into the parameter. Data equal to the current content does not dirty the block.
+        // @Return:
+        //  False if the parameter does not exist.
+        //----------------------------------------------------------------------
+        bool set(StringID name, const void* data) { return set( getHandle( name ), data ); }
+        bool set(ShaderParameterHandle handle, const void* data);
+
+        //----------------------------------------------------------------------
+        // Copies the given data into the whole block.
+        //----------------------------------------------------------------------
+        void set(const void* data, U32 sizeInBytes);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Amount of bytes covered by all dirty ranges.
+        //----------------------------------------------------------------------
+        U32 getDirtyByteCount() const;
+
+        //----------------------------------------------------------------------
+        // Should be called after the dirty data was uploaded.
+        //----------------------------------------------------------------------
+        void clearDirtyRanges() { m_dirtyRanges.clear(); }
+
+    private:
+        ShaderUniformBufferDeclaration  m_bufferInfo;
+        Byte*                           m_data = nullptr;
+        ArrayList<ByteRange>            m_dirtyRanges;
+
+        //----------------------------------------------------------------------
+        void _MarkDirty(U32 begin, U32 end);
+
+        NULL_COPY_AND_ASSIGN(ShaderParameterBlock)
+    };
+
+} // End namespaces
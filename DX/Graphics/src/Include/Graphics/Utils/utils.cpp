@@ -31,6 +31,8 @@ namespace Graphics {
         case TextureFormat::RGB9e5Float:    return 4; break;
         case TextureFormat::RG16:           return 2; break;
         case TextureFormat::R8:             return 1; break;
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
         case TextureFormat::BC4:
         case TextureFormat::BC5:
         case TextureFormat::BC6H:
@@ -70,6 +72,58 @@ namespace Graphics {
         return format == TextureFormat::D32 || format == TextureFormat::D24S8 || format == TextureFormat::D16;
     }
 
+    //----------------------------------------------------------------------
+    bool IsBlockCompressed( TextureFormat format )
+    {
+        switch (format)
+        {
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC6H:
+        case TextureFormat::BC7:
+            return true;
+        }
+        return false;
+    }
+
+    //----------------------------------------------------------------------
+    U32 RowPitchFromTextureFormat( TextureFormat format, U32 width )
+    {
+        U32 numBlocks = (width + 3) / 4;
+        switch (format)
+        {
+        case TextureFormat::BC1:
+        case TextureFormat::BC4:
+            return numBlocks * 8;
+        case TextureFormat::BC3:
+        case TextureFormat::BC5:
+        case TextureFormat::BC6H:
+        case TextureFormat::BC7:
+            return numBlocks * 16;
+        }
+        return width * ByteCountFromTextureFormat( format );
+    }
+
+    //----------------------------------------------------------------------
+    U32 ImageSizeFromTextureFormat( TextureFormat format, U32 width, U32 height )
+    {
+        U32 numRows = IsBlockCompressed( format ) ? (height + 3) / 4 : height;
+        return RowPitchFromTextureFormat( format, width ) * numRows;
+    }
+
+    //----------------------------------------------------------------------
+    bool CanBeLargestMip( TextureFormat format, U32 width, U32 height, U32 mip )
+    {
+        if ( not IsBlockCompressed( format ) )
+            return true;
+
+        U32 mipWidth  = std::max( 1u, width >> mip );
+        U32 mipHeight = std::max( 1u, height >> mip );
+        return mipWidth % 4 == 0 && mipHeight % 4 == 0;
+    }
+
 }
 
 
@@ -33,4 +33,28 @@ namespace Graphics {
     //----------------------------------------------------------------------
     bool IsDepthFormat(TextureFormat format);
 
+    //----------------------------------------------------------------------
+    // @Return: Whether given format is a block compressed format (4x4 pixel blocks)
+    //----------------------------------------------------------------------
+    bool IsBlockCompressed(TextureFormat format);
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Size in bytes of one row of pixels (or one row of blocks for compressed formats) for the given width.
+    //----------------------------------------------------------------------
+    U32 RowPitchFromTextureFormat(TextureFormat format, U32 width);
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Size in bytes of a whole image with the given dimensions, e.g. one mip level.
+    //----------------------------------------------------------------------
+    U32 ImageSizeFromTextureFormat(TextureFormat format, U32 width, U32 height);
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Whether the given mip of a texture with the given size can be the largest mip of a gpu texture.
+    //  The largest mip of a block compressed texture must be a multiple of 4 in both dimensions.
+    //----------------------------------------------------------------------
+    bool CanBeLargestMip(TextureFormat format, U32 width, U32 height, U32 mip);
+
 }
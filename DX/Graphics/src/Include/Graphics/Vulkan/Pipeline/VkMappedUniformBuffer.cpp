@@ -14,46 +14,30 @@ namespace Graphics { namespace Vulkan {
 
     //----------------------------------------------------------------------
     MappedUniformBuffer::MappedUniformBuffer( const ShaderUniformBufferDeclaration& bufferInfo, BufferUsage usage )
-        : m_bufferInfo( bufferInfo )
+        : m_CPUBuffer( bufferInfo )
     {
-        m_CPUBuffer = (Byte*)_aligned_malloc( m_bufferInfo.getSize(), 16 );
-        memset( m_CPUBuffer, 0, m_bufferInfo.getSize() );
-        m_GPUBuffer = std::make_unique<RingBuffer>( m_bufferInfo.getSize(), usage, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 3 );
+        m_GPUBuffer = std::make_unique<RingBuffer>( bufferInfo.getSize(), usage, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 3 );
     }
 
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
 
-    //----------------------------------------------------------------------
-    bool MappedUniformBuffer::update( StringID name, const void* data )
-    {
-        for (auto& member : m_bufferInfo.getMembers())
-        {
-            if (member.getName() == name)
-            {
-                memcpy( &m_CPUBuffer[member.getOffset()], data, member.getSize() );
-                m_gpuUpToDate = false;
-                return true;
-            }
-        }
-        return false;
-    }
-
     //----------------------------------------------------------------------
     void MappedUniformBuffer::update( const void* data, U32 sizeInBytes )
     {
         m_GPUBuffer->update( data, sizeInBytes );
-        m_gpuUpToDate = true;
+        m_CPUBuffer.clearDirtyRanges();
     }
 
     //----------------------------------------------------------------------
     void MappedUniformBuffer::flush()
     {
-        if ( not m_gpuUpToDate )
+        if ( m_CPUBuffer.isDirty() )
         {
-            m_GPUBuffer->update( m_CPUBuffer, m_bufferInfo.getSize() );
-            m_gpuUpToDate = true;
+            // Each update writes the next buffer of the ring, which holds older data, so all of it must be uploaded
+            m_GPUBuffer->update( m_CPUBuffer.getData(), m_CPUBuffer.getSize() );
+            m_CPUBuffer.clearDirtyRanges();
         }
     }
 
@@ -61,7 +45,7 @@ namespace Graphics { namespace Vulkan {
     void MappedUniformBuffer::bind()
     {
         flush();
-        g_vulkan.ctx.SetBuffer( m_GPUBuffer->getBuffer(), m_bufferInfo.getBindingSet(), m_bufferInfo.getBindingSlot() );
+        g_vulkan.ctx.SetBuffer( m_GPUBuffer->getBuffer(), getBufferInfo().getBindingSet(), getBufferInfo().getBindingSlot() );
     }
 
     //**********************************************************************
@@ -7,7 +7,7 @@
 **********************************************************************/
 
 #include "VkBuffer.h"
-#include "../../shader_resources.hpp"
+#include "../../Utils/shader_parameter_block.h"
 
 namespace Graphics { namespace Vulkan {
 
@@ -19,18 +19,25 @@ namespace Graphics { namespace Vulkan {
     {
     public:
         MappedUniformBuffer(const ShaderUniformBufferDeclaration& bufferInfo, BufferUsage usage);
-        ~MappedUniformBuffer() { _aligned_free(m_CPUBuffer); }
+        ~MappedUniformBuffer() = default;
 
         //----------------------------------------------------------------------
-        bool                                  gpuIsUpToDate() const { return m_gpuUpToDate; }
-        const ShaderUniformBufferDeclaration& getBufferInfo() const { return m_bufferInfo; }
+        bool                                  gpuIsUpToDate() const { return not m_CPUBuffer.isDirty(); }
+        const ShaderUniformBufferDeclaration& getBufferInfo() const { return m_CPUBuffer.getBufferInfo(); }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Handle to the uniform 'name', which can be used for updates without a name lookup.
+        //----------------------------------------------------------------------
+        ShaderParameterHandle getHandle(StringID name) const { return m_CPUBuffer.getHandle( name ); }
 
         //----------------------------------------------------------------------
         // Update the given uniform 'name' with the given data. !! ONLY ON THE CPU !!
         // @Return:
         //  False if uniform with the given name does not exist.
         //----------------------------------------------------------------------
-        bool update(StringID name, const void* data);
+        bool update(StringID name, const void* data) { return m_CPUBuffer.set( name, data ); }
+        bool update(ShaderParameterHandle handle, const void* data) { return m_CPUBuffer.set( handle, data ); }
 
         //----------------------------------------------------------------------
         // This updates the gpu uniform buffer directly with the given raw data.
@@ -38,7 +45,7 @@ namespace Graphics { namespace Vulkan {
         void update(const void* data, U32 sizeInBytes);
 
         //----------------------------------------------------------------------
-        // Sends the whole buffer on the cpu to the gpu. (This does nothing if gpu data is up to date)
+        // Sends the buffer on the cpu to the gpu. (This does nothing if gpu data is up to date)
         //---------------------------------------------------------------------
         void flush();
 
@@ -49,10 +56,8 @@ namespace Graphics { namespace Vulkan {
         void bind();
 
     private:
-        ShaderUniformBufferDeclaration  m_bufferInfo;
-        Byte*                           m_CPUBuffer     = nullptr;
+        ShaderParameterBlock            m_CPUBuffer;
         std::unique_ptr<RingBuffer>     m_GPUBuffer;
-        bool                            m_gpuUpToDate   = false;
 
         NULL_COPY_AND_ASSIGN(MappedUniformBuffer)
     };
@@ -79,6 +84,15 @@ namespace Graphics { namespace Vulkan {
         //----------------------------------------------------------------------
         void beginBuffer();
 
+        //----------------------------------------------------------------------
+        const ShaderUniformBufferDeclaration& getBufferInfo() const { return m_bufferDecl; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Handle to the uniform 'name' in the current buffer. Only valid after beginBuffer() was called.
+        //----------------------------------------------------------------------
+        ShaderParameterHandle getHandle(StringID name) const { return m_mappedUBOs[m_bufferIndex - 1]->getHandle( name ); }
+
         //----------------------------------------------------------------------
         // Update the given uniform 'name' with the given data. !! ONLY ON THE CPU !!
         // @Return:
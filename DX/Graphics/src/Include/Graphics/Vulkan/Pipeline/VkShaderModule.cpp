@@ -7,7 +7,6 @@
 **********************************************************************/
 
 #include "Common/string_utils.h"
-#include "OS/FileSystem/file_system.h"
 #include "OS/FileSystem/file.h"
 #include "Utils/utils.h"
 #include "../VkUtility.h"
@@ -72,54 +71,58 @@ namespace Graphics { namespace Vulkan {
     {
         m_entryPoint = entryPoint;
 
-        String shaderName = GetShaderTypeName( m_shaderType );
+        U64 key = _CacheKey( m_shaderType, source, entryPoint );
 
-        StringID hash = SID( source.c_str() );
-
-#ifdef _DEBUG
-        OS::Path binaryShaderPath( "/engine/shaders/bin/debug/" + shaderName + TS( hash.id ) + ".spv" );
-#else
-        OS::Path binaryShaderPath( "/engine/shaders/bin/release/" + shaderName + TS( hash.id ) + ".spv" );
-#endif
-
-        // Precompiled binary file does not exist
-        if ( not OS::FileSystem::exists( binaryShaderPath ) )
-        {
-            _CompileGLSL( source, entryPoint );
-
-            U32 codeSize;
-            vezGetShaderModuleBinary( m_shaderModule, &codeSize, NULL );
-            ArrayList<uint32_t> spv( codeSize );
-            VALIDATE( vezGetShaderModuleBinary( m_shaderModule, &codeSize, spv.data() ) );
-
-            // Store compiled binary data into file
-            OS::BinaryFile binaryShaderFile( binaryShaderPath, OS::EFileMode::WRITE );
-            binaryShaderFile.write( (const Byte*)spv.data(), spv.size() * sizeof(uint32_t) );
-        }
-        else
+        Size codeSize;
+        if ( auto spv = g_vulkan.shaderCache->find( key, &codeSize ) )
         {
-            // Load compiled binary data from file
-            OS::BinaryFile binaryShaderFile( binaryShaderPath, OS::EFileMode::READ );
-            String content = binaryShaderFile.readAll();
-
-            U32 codeSize = (U32)content.size() / sizeof(uint32_t);
-            ArrayList<uint32_t> spv( codeSize );
-            memcpy( spv.data(), content.data(), codeSize );
-
-            // This should always work
+            // This should always work. The cache aligns the code to words.
             VezShaderModuleCreateInfo createInfo = {};
             createInfo.stage        = Utility::TranslateShaderStage( m_shaderType );
             createInfo.codeSize     = codeSize;
-            createInfo.pCode        = spv.data();
+            createInfo.pCode        = reinterpret_cast<const uint32_t*>( spv );
             createInfo.pEntryPoint  = entryPoint;
             VALIDATE( vezCreateShaderModule( g_vulkan.device, &createInfo, &m_shaderModule ) );
+            return;
         }
+
+        m_shaderModule = _CompileGLSL( m_shaderType, source, entryPoint );
+        _AddToCache( key, m_shaderModule );
+    }
+
+    //----------------------------------------------------------------------
+    void ShaderModule::Precompile( ShaderType shaderType, const String& source, CString entryPoint )
+    {
+        U64 key = _CacheKey( shaderType, source, entryPoint );
+
+        Size codeSize;
+        if ( g_vulkan.shaderCache->find( key, &codeSize ) )
+            return;
+
+        auto shaderModule = _CompileGLSL( shaderType, source, entryPoint );
+        _AddToCache( key, shaderModule );
+        vezDestroyShaderModule( g_vulkan.device, shaderModule );
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    U64 ShaderModule::_CacheKey( ShaderType shaderType, const String& source, CString entryPoint )
+    {
+        // V-EZ does not expose the preprocessor of glslang. Includes are resolved by the shader parser
+        // and no defines are passed, so the source already contains everything which affects the output.
+        U64 key = ShaderCache::Hash( source.data(), source.size() );
+        key = ShaderCache::Hash( &shaderType, sizeof( shaderType ), key );
+        key = ShaderCache::Hash( entryPoint, strlen( entryPoint ), key );
+        return key;
     }
 
     //----------------------------------------------------------------------
-    void ShaderModule::_CompileGLSL( const String& source, CString entryPoint )
+    VkShaderModule ShaderModule::_CompileGLSL( ShaderType shaderType, const String& source, CString entryPoint )
     {
-        VkShaderStageFlagBits shaderStage = Utility::TranslateShaderStage( m_shaderType );
+        VkShaderStageFlagBits shaderStage = Utility::TranslateShaderStage( shaderType );
         if (not shaderStage)
             throw std::runtime_error( "VkShaderModule: Unsupported shader type." );
 
@@ -129,18 +132,34 @@ namespace Graphics { namespace Vulkan {
         createInfo.pGLSLSource  = source.c_str();
         createInfo.pEntryPoint  = entryPoint;
 
-        auto result = vezCreateShaderModule( g_vulkan.device, &createInfo, &m_shaderModule );
-        if (result != VK_SUCCESS && m_shaderModule != VK_NULL_HANDLE)
+        VkShaderModule shaderModule = VK_NULL_HANDLE;
+        auto result = vezCreateShaderModule( g_vulkan.device, &createInfo, &shaderModule );
+        if (result != VK_SUCCESS && shaderModule != VK_NULL_HANDLE)
         {
             // If shader module creation failed get the error log.
             U32 infoLogSize = 0;
-            vezGetShaderModuleInfoLog( m_shaderModule, &infoLogSize, nullptr );
+            vezGetShaderModuleInfoLog( shaderModule, &infoLogSize, nullptr );
             String infoLog( infoLogSize, '\0' );
-            vezGetShaderModuleInfoLog( m_shaderModule, &infoLogSize, &infoLog[0] );
+            vezGetShaderModuleInfoLog( shaderModule, &infoLogSize, &infoLog[0] );
 
-            vezDestroyShaderModule( g_vulkan.device, m_shaderModule );
+            vezDestroyShaderModule( g_vulkan.device, shaderModule );
             throw std::runtime_error( infoLog );
         }
+        if (result != VK_SUCCESS)
+            throw std::runtime_error( "VkShaderModule: Failed to compile " + GetShaderTypeName( shaderType ) + " shader." );
+
+        return shaderModule;
+    }
+
+    //----------------------------------------------------------------------
+    void ShaderModule::_AddToCache( U64 key, VkShaderModule shaderModule )
+    {
+        U32 codeSize;
+        vezGetShaderModuleBinary( shaderModule, &codeSize, NULL );
+        ArrayList<uint32_t> spv( (codeSize + sizeof( uint32_t ) - 1) / sizeof( uint32_t ) );
+        VALIDATE( vezGetShaderModuleBinary( shaderModule, &codeSize, spv.data() ) );
+
+        g_vulkan.shaderCache->add( key, spv.data(), codeSize );
     }
 
 } } // End namespaces
\ No newline at end of file
@@ -28,13 +28,22 @@ namespace Graphics { namespace Vulkan {
         const VkShaderModule&   getVkShaderModule() const { return m_shaderModule; }
         CString                 getEntryPoint()     const { return m_entryPoint.c_str(); }
 
+        //----------------------------------------------------------------------
+        // Compiles the given glsl source into the shader cache without keeping a module, unless it is cached already. Thread-safe.
+        // @Throws:
+        //  std::runtime_error if compilation failed.
+        //----------------------------------------------------------------------
+        static void Precompile(ShaderType shaderType, const String& source, CString entryPoint);
+
     private:
         VkShaderModule  m_shaderModule;
         ShaderType      m_shaderType = ShaderType::Unknown;
         OS::Path        m_filePath;
         String          m_entryPoint;
 
-        void _CompileGLSL(const String& source, CString entryPoint);
+        static U64 _CacheKey(ShaderType shaderType, const String& source, CString entryPoint);
+        static VkShaderModule _CompileGLSL(ShaderType shaderType, const String& source, CString entryPoint);
+        static void _AddToCache(U64 key, VkShaderModule shaderModule);
 
         NULL_COPY_AND_ASSIGN(ShaderModule)
     };
@@ -31,6 +31,17 @@ namespace Graphics { namespace Vulkan {
         _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
     }
 
+    //----------------------------------------------------------------------
+    void Cubemap::create( I32 size, TextureFormat format, const ArrayList<const void*>& mips )
+    {
+        ASSERT( size > 0 && not mips.empty() && mips.size() % NUM_FACES == 0 );
+        ITexture::_Init( TextureDimension::Cube, size, size, format );
+
+        m_mipCount = static_cast<U32>( mips.size() / NUM_FACES );
+        _CreateTexture( mips );
+        _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -64,6 +75,23 @@ namespace Graphics { namespace Vulkan {
         VALIDATE( vezCreateImageView( g_vulkan.device, &imageViewCreateInfo, &m_image.view ) );
     }
 
+    //----------------------------------------------------------------------
+    void Cubemap::_CreateTexture( const ArrayList<const void*>& mips )
+    {
+        _CreateTexture( false );
+
+        for (U32 i = 0; i < mips.size(); i++)
+        {
+            U32 mip = i % m_mipCount;
+            VezImageSubDataInfo subDataInfo = {};
+            subDataInfo.imageSubresource.mipLevel       = mip;
+            subDataInfo.imageSubresource.baseArrayLayer = i / m_mipCount;
+            subDataInfo.imageSubresource.layerCount     = 1;
+            subDataInfo.imageExtent                     = { std::max( 1u, m_width >> mip ), std::max( 1u, m_height >> mip ), 1 };
+            vezImageSubData( g_vulkan.device, m_image.img, &subDataInfo, mips[i] );
+        }
+    }
+
     //----------------------------------------------------------------------
     void Cubemap::_PushToGPU()
     {
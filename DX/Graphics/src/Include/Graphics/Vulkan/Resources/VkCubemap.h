@@ -22,6 +22,7 @@ namespace Graphics { namespace Vulkan {
         // ICubemap Interface
         //----------------------------------------------------------------------
         void create(I32 size, TextureFormat format, Mips mips) override;
+        void create(I32 size, TextureFormat format, const ArrayList<const void*>& mips) override;
         void apply(bool updateMips, bool keepPixelsInRAM) override { IBindableTexture::apply(updateMips, keepPixelsInRAM); }
 
     private:
@@ -40,6 +41,7 @@ namespace Graphics { namespace Vulkan {
 
         //----------------------------------------------------------------------
         void _CreateTexture(bool isDepthBuffer);
+        void _CreateTexture(const ArrayList<const void*>& mips);
 
         NULL_COPY_AND_ASSIGN(Cubemap)
     };
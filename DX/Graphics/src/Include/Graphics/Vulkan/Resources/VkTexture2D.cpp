@@ -37,6 +37,33 @@ namespace Graphics { namespace Vulkan {
         _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
     }
 
+    //----------------------------------------------------------------------
+    void Texture2D::create( U32 width, U32 height, TextureFormat format, const ArrayList<const void*>& mips, U32 firstMip )
+    {
+        ASSERT( width > 0 && height > 0 && not mips.empty() && m_width == 0 && "Invalid params or texture were already created" );
+        ITexture::_Init( TextureDimension::Tex2D, width, height, format );
+
+        m_isImmutable = true;
+        m_mipCount = firstMip + static_cast<U32>( mips.size() );
+        m_residentMip = firstMip;
+        _CreateTexture( mips );
+        _CreateSampler( m_anisoLevel, m_filter, m_clampMode );
+    }
+
+    //----------------------------------------------------------------------
+    void Texture2D::setResidentMips( U32 firstMip, const ArrayList<const void*>& mips )
+    {
+        ASSERT( isImmutable() && firstMip + mips.size() == m_mipCount && "Texture was not created with a precomputed mipchain or mips are missing" );
+
+        // The old image might still be used by a frame in flight
+        vezDeviceWaitIdle( g_vulkan.device );
+        vezDestroyImageView( g_vulkan.device, m_image.view );
+        vezDestroyImage( g_vulkan.device, m_image.img );
+
+        m_residentMip = firstMip;
+        _CreateTexture( mips );
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -44,16 +71,19 @@ namespace Graphics { namespace Vulkan {
     //----------------------------------------------------------------------
     void Texture2D::_CreateTexture()
     {
+        // Only the resident mips are allocated, so the largest one of them is the top level of the image
+        U32 residentMips = m_mipCount - m_residentMip;
+
         VezImageCreateInfo imageCreateInfo = {};
         imageCreateInfo.imageType   = VK_IMAGE_TYPE_2D;
         imageCreateInfo.format      = Utility::TranslateTextureFormat( m_format );
-        imageCreateInfo.extent      = { m_width, m_height, 1 };
-        imageCreateInfo.mipLevels   = m_mipCount;
+        imageCreateInfo.extent      = { std::max( 1u, m_width >> m_residentMip ), std::max( 1u, m_height >> m_residentMip ), 1 };
+        imageCreateInfo.mipLevels   = residentMips;
         imageCreateInfo.arrayLayers = 1;
         imageCreateInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
         imageCreateInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
         imageCreateInfo.usage       = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        if (m_mipCount > 1)
+        if (residentMips > 1)
             imageCreateInfo.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
 
         VALIDATE( vezCreateImage( g_vulkan.device, VEZ_MEMORY_GPU_ONLY, &imageCreateInfo, &m_image.img ) );
@@ -64,7 +94,7 @@ namespace Graphics { namespace Vulkan {
         imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
         imageViewCreateInfo.format   = imageCreateInfo.format;
         imageViewCreateInfo.subresourceRange.layerCount = 1;
-        imageViewCreateInfo.subresourceRange.levelCount = m_mipCount;
+        imageViewCreateInfo.subresourceRange.levelCount = residentMips;
         VALIDATE( vezCreateImageView( g_vulkan.device, &imageViewCreateInfo, &m_image.view ) );
     }
 
@@ -80,6 +110,22 @@ namespace Graphics { namespace Vulkan {
         vezImageSubData( g_vulkan.device, m_image.img, &subDataInfo, pData );
     }
 
+    //----------------------------------------------------------------------
+    void Texture2D::_CreateTexture( const ArrayList<const void*>& mips )
+    {
+        _CreateTexture();
+
+        for (U32 mip = 0; mip < m_mipCount - m_residentMip; mip++)
+        {
+            U32 mipInChain = m_residentMip + mip;
+            VezImageSubDataInfo subDataInfo = {};
+            subDataInfo.imageSubresource.mipLevel = mip;
+            subDataInfo.imageSubresource.layerCount = 1;
+            subDataInfo.imageExtent = { std::max( 1u, m_width >> mipInChain ), std::max( 1u, m_height >> mipInChain ), 1 };
+            vezImageSubData( g_vulkan.device, m_image.img, &subDataInfo, mips[mip] );
+        }
+    }
+
     //----------------------------------------------------------------------
     void Texture2D::_PushToGPU()
     {
@@ -23,6 +23,8 @@ namespace Graphics { namespace Vulkan {
         //----------------------------------------------------------------------
         void create(U32 width, U32 height, TextureFormat format, bool generateMips) override;
         void create(U32 width, U32 height, TextureFormat format, const void* pData) override;
+        void create(U32 width, U32 height, TextureFormat format, const ArrayList<const void*>& mips, U32 firstMip) override;
+        void setResidentMips(U32 firstMip, const ArrayList<const void*>& mips) override;
         void apply(bool updateMips, bool keepPixelsInRAM) override { IBindableTexture::apply(updateMips, keepPixelsInRAM); }
         U64* getNativeTexturePtr() const override { return reinterpret_cast<U64*>(m_image.img); }
 
@@ -42,6 +44,7 @@ namespace Graphics { namespace Vulkan {
         //----------------------------------------------------------------------
         void _CreateTexture();
         void _CreateTexture(const void* pData);
+        void _CreateTexture(const ArrayList<const void*>& mips);
 
         NULL_COPY_AND_ASSIGN(Texture2D)
     };
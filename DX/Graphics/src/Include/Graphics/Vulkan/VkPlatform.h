@@ -11,6 +11,7 @@
 #define VK_USE_PLATFORM_WIN32_KHR
 #include "Ext/VEZ.h"
 #include "Logging/logging.h"
+#include "Utils/shader_cache.h"
 #include <functional>
 #include <mutex>
 
@@ -146,6 +147,7 @@ namespace Graphics { namespace Vulkan {
         GPU             gpu;
         VkQueue         graphicsQueue   = VK_NULL_HANDLE;
         Context         ctx;
+        ShaderCache*    shaderCache     = nullptr;
 
     private:
         //----------------------------------------------------------------------
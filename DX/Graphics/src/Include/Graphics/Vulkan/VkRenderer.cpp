@@ -12,6 +12,7 @@
 #include "Lighting/lights.h"
 #include "camera.h"
 #include "Resources/VkShader.h"
+#include "Pipeline/VkShaderModule.h"
 #include "Resources/VkMaterial.h"
 #include "Resources/VkMesh.h"
 #include "Resources/VkTexture2D.h"
@@ -26,6 +27,12 @@
 #define ENGINE_VS_PATH      "/engine/shaders/includes/vulkan/engineVS.glsl"
 #define ENGINE_FS_PATH      "/engine/shaders/includes/vulkan/engineFS.glsl"
 
+#ifdef _DEBUG
+    #define SHADER_CACHE_PATH   "/engine/shaders/bin/shaders_vulkan_debug.bin"
+#else
+    #define SHADER_CACHE_PATH   "/engine/shaders/bin/shaders_vulkan_release.bin"
+#endif
+
 namespace Graphics {
 
     static String CAMERA_UBO_KEYWORD     ( "camera" );
@@ -44,11 +51,13 @@ namespace Graphics {
     static StringID LIGHT_BUFFER_NAME         = SID( "lights" );
     static StringID LIGHT_VIEW_PROJ_NAME      = SID( "viewProj" );
     static StringID LIGHT_CSM_SPLITS_NAME     = SID( "CSMSplits" );
+    static StringID LIGHT_CLUSTER_COUNT_NAME  = SID( "clusterCount" );
 
     #define SHADOW_MAPS_SET                 0
     #define SHADOW_MAP_2D_BINDING_BEGIN     3
     #define SHADOW_MAP_3D_BINDING_BEGIN     7
     #define SHADOW_MAP_ARRAY_BINDING_BEGIN  8
+    #define LIGHT_CLUSTERS_BINDING          9
 
     static ArrayList<ShaderResourceDeclaration> SHADOW_MAP_2D_RESOURCE_DECLS{
         { ShaderType::Fragment, SHADOW_MAPS_SET, SHADOW_MAP_2D_BINDING_BEGIN + 0, SID("ShadowMap2D"), DataType::Texture2D },
@@ -62,6 +71,7 @@ namespace Graphics {
     static ArrayList<ShaderResourceDeclaration> SHADOW_MAP_ARRAY_RESOURCE_DECLS{
         { ShaderType::Fragment, SHADOW_MAPS_SET,SHADOW_MAP_ARRAY_BINDING_BEGIN + 0, SID("ShadowMapArray"), DataType::Texture2D },
     };
+    static ShaderResourceDeclaration LIGHT_CLUSTERS_RESOURCE_DECL{ ShaderType::Fragment, SHADOW_MAPS_SET, LIGHT_CLUSTERS_BINDING, SID("LightClusters"), DataType::Texture2D };
 
     using namespace Vulkan;
 
@@ -121,11 +131,13 @@ namespace Graphics {
         }
 
         g_vulkan.ctx.Init();
+        g_vulkan.shaderCache = new ShaderCache( SHADER_CACHE_PATH );
 
         _SetGPUDescription();
         _CreateRequiredUniformBuffersFromFile( ENGINE_VS_PATH, ENGINE_FS_PATH );
         _CreateCubeMesh();
         _CreateFakeShadowMaps();
+        _CreateFakeLightClusters();
 
         LOG_RENDERING( "Done initializing Vulkan... (Using " + getGPUDescription().name + ")" );
     }
@@ -137,6 +149,7 @@ namespace Graphics {
         for (auto i = 0; i < MAX_SHADOWMAPS_2D; ++i) SAFE_DELETE( m_fakeShadowMaps2D[i] );
         for (auto i = 0; i < MAX_SHADOWMAPS_3D; ++i) SAFE_DELETE( m_fakeShadowMaps3D[i] );
         for (auto i = 0; i < MAX_SHADOWMAPS_ARRAY; ++i) SAFE_DELETE( m_fakeShadowMaps2DArray[i] );
+        SAFE_DELETE( m_fakeLightClusters );
         IRenderer::_Shutdown();
         SAFE_DELETE( m_globalBuffer );
         SAFE_DELETE( m_cameraBuffer );
@@ -146,6 +159,8 @@ namespace Graphics {
         m_swapchain.shutdown( g_vulkan.instance, g_vulkan.device );
         SAFE_DELETE( m_cubeMesh );
         renderContext.Reset();
+        g_vulkan.shaderCache->save();
+        SAFE_DELETE( g_vulkan.shaderCache );
         g_vulkan.Shutdown();
     }
 
@@ -210,6 +225,17 @@ namespace Graphics {
                     }
                     break;
                 }
+                case GPUCommand::SET_LIGHT_CLUSTERS:
+                {
+                    auto& cmd = *reinterpret_cast<GPUC_SetLightClusters*>( command.get() );
+                    renderContext.lightClusters = cmd.clusters;
+                    renderContext.clusterCount[0] = cmd.numX;
+                    renderContext.clusterCount[1] = cmd.numY;
+                    renderContext.clusterCount[2] = cmd.numZ;
+                    renderContext.clusterCount[3] = cmd.numGlobalLights;
+                    renderContext.lightsUpdated = true;
+                    break;
+                }
                 case GPUCommand::SET_RENDER_TARGET:
                 {
                     auto& cmd = *reinterpret_cast<GPUC_SetRenderTarget*>( command.get() );
@@ -358,6 +384,12 @@ namespace Graphics {
     IRenderBuffer*      VkRenderer::createRenderBuffer()   { return new Vulkan::RenderBuffer; }
     ITexture2DArray*    VkRenderer::createTexture2DArray() { return new Vulkan::Texture2DArray; }
 
+    //----------------------------------------------------------------------
+    void VkRenderer::precompileShader( ShaderType shaderType, const String& source, CString entryPoint )
+    {
+        Vulkan::ShaderModule::Precompile( shaderType, source, entryPoint );
+    }
+
     //----------------------------------------------------------------------
     bool VkRenderer::setGlobalFloat( StringID name, F32 value )
     {
@@ -614,6 +646,11 @@ namespace Graphics {
         for (auto i = 0; i < SHADOW_MAP_ARRAY_RESOURCE_DECLS.size(); ++i)
             m_fakeShadowMaps2DArray[i]->bind( SHADOW_MAP_ARRAY_RESOURCE_DECLS[i] );
 
+        if ( renderContext.lightClusters )
+            renderContext.lightClusters->bind( LIGHT_CLUSTERS_RESOURCE_DECL );
+        else
+            m_fakeLightClusters->bind( LIGHT_CLUSTERS_RESOURCE_DECL );
+
         renderContext.getCamera()->getFrameInfo().numLights = renderContext.lightCount;
 
         m_lightBuffer->beginBuffer();
@@ -638,6 +675,8 @@ namespace Graphics {
             I32         shadowType;             // 4 bytes
             //----------------------------------- (16 byte boundary)
         } lights[MAX_LIGHTS];
+        static_assert( offsetof( Light, direction ) == 16 && offsetof( Light, color ) == 32 && offsetof( Light, spotAngle ) == 48 && sizeof( Light ) == 64,
+                       "Light struct does not match the packing of the light struct in the shader." );
 
         I32 curShadowMap2DIndex = 0;
         I32 curShadowMap3DIndex = 0;
@@ -754,12 +793,20 @@ namespace Graphics {
             }
         }
 
+        // The cpu structs have to match the layout reflected from the shader, otherwise the lights are garbage
+        ASSERT( m_lightBuffer->getHandle( LIGHT_BUFFER_NAME ).size == sizeof( lights ) );
+        ASSERT( m_lightBuffer->getHandle( LIGHT_VIEW_PROJ_NAME ).size == sizeof( lightViewProjs ) );
+
         if ( not m_lightBuffer->update( LIGHT_BUFFER_NAME, &lights ) )
             LOG_ERROR_RENDERING( "Failed to update light-buffer. Something is horribly broken! Fix this!" );
 
         if ( not m_lightBuffer->update( LIGHT_VIEW_PROJ_NAME, &lightViewProjs ) )
             LOG_ERROR_RENDERING( "Failed to update light-buffer [ViewProjections]. Something is horribly broken! Fix this!" );
 
+        // Light clusters, a count of zero makes the shaders iterate over all lights
+        if ( not m_lightBuffer->update( LIGHT_CLUSTER_COUNT_NAME, renderContext.clusterCount ) )
+            LOG_ERROR_RENDERING( "Failed to update light-buffer [ClusterCount]. Something is horribly broken! Fix this!" );
+
         // Update gpu buffer
         m_lightBuffer->bind();
     }
@@ -1028,6 +1075,14 @@ namespace Graphics {
         }
     }
 
+    //----------------------------------------------------------------------
+    void VkRenderer::_CreateFakeLightClusters()
+    {
+        // Bound while no light clusters are set, otherwise validation will complain
+        m_fakeLightClusters = createTexture2D();
+        m_fakeLightClusters->create( 1, 1, Graphics::TextureFormat::RGFloat, false );
+    }
+
     //**********************************************************************
     // RENDER CONTEXT
     //**********************************************************************
@@ -1066,6 +1121,8 @@ namespace Graphics {
         m_material = nullptr;
         lightCount = 0;
         lightsUpdated = true;
+        lightClusters = nullptr;
+        std::fill( std::begin( clusterCount ), std::end( clusterCount ), 0 );
         m_renderTarget = nullptr;
     }
 
@@ -1082,8 +1139,8 @@ namespace Graphics {
     {
         m_camera = camera;
 
-        // Reset frame info struct
-        m_camera->getFrameInfo() = {};
+        // Reset frame info struct. Stats from the engine (e.g. shadow casters) are already recorded at this point.
+        m_camera->getFrameInfo().resetRenderStats();
     }
 
 } // End namespaces
\ No newline at end of file
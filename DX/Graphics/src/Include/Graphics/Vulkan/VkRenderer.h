@@ -14,7 +14,7 @@
 namespace Graphics {
 
     //----------------------------------------------------------------------
-    #define MAX_LIGHTS              16
+    #define MAX_LIGHTS              128
     #define MAX_SHADOWMAPS_2D       4
     #define MAX_SHADOWMAPS_3D       1
     #define MAX_SHADOWMAPS_ARRAY    1
@@ -52,12 +52,16 @@ namespace Graphics {
         ITexture2DArray*    createTexture2DArray() override;
         IRenderBuffer*      createRenderBuffer() override;
 
+        void precompileShader(ShaderType shaderType, const String& source, CString entryPoint) override;
+
         bool setGlobalFloat(StringID name, F32 value) override;
         bool setGlobalInt(StringID name, I32 value) override;
         bool setGlobalVector4(StringID name, const Math::Vec4& vec4) override;
         bool setGlobalColor(StringID name, Color color) override;
         bool setGlobalMatrix(StringID name, const DirectX::XMMATRIX& matrix) override;
 
+        const ShaderCache* getShaderCache() const override { return g_vulkan.shaderCache; }
+
     private:
         Vulkan::Swapchain   m_swapchain;
         IMesh*              m_cubeMesh      = nullptr;
@@ -70,6 +74,7 @@ namespace Graphics {
         ITexture2D*         m_fakeShadowMaps2D[MAX_SHADOWMAPS_2D];
         ICubemap*           m_fakeShadowMaps3D[MAX_SHADOWMAPS_3D];
         ITexture2DArray*    m_fakeShadowMaps2DArray[MAX_SHADOWMAPS_ARRAY];
+        ITexture2D*         m_fakeLightClusters = nullptr;
 
         //----------------------------------------------------------------------
         inline void _SetCamera(Camera* camera);
@@ -88,6 +93,7 @@ namespace Graphics {
         void _CreateCubeMesh();
         void _SetLimits();
         void _CreateFakeShadowMaps();
+        void _CreateFakeLightClusters();
 
         void _FlushLightBuffer();
         void _ExecuteCommandBuffer(const CommandBuffer& cmd);
@@ -106,6 +112,10 @@ namespace Graphics {
             const Light* lights[MAX_LIGHTS];
             bool         lightsUpdated = false; // Set to true whenever a new light has been added
 
+            // Light clusters of the current camera. Shaders iterate over all lights if there are none.
+            Texture2DPtr lightClusters = nullptr;
+            I32          clusterCount[4] = {}; // numX, numY, numZ, numGlobalLights
+
             inline void Reset();
             inline void BindMaterial(const MaterialPtr& material);
             inline void BindShader(const std::shared_ptr<IShader>& shader);
@@ -150,6 +150,8 @@ namespace Graphics { namespace Vulkan { namespace Utility {
         case TextureFormat::RGBAFloat:      return VK_FORMAT_R32G32B32A32_SFLOAT; break;
         case TextureFormat::YUY2:           return VK_FORMAT_G8B8G8R8_422_UNORM; break;
         case TextureFormat::RGB9e5Float:    return VK_FORMAT_UNDEFINED; break;
+        case TextureFormat::BC1:            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK; break;
+        case TextureFormat::BC3:            return VK_FORMAT_BC3_UNORM_BLOCK; break;
         case TextureFormat::BC4:            return VK_FORMAT_BC4_UNORM_BLOCK; break;
         case TextureFormat::BC5:            return VK_FORMAT_BC5_UNORM_BLOCK; break;
         case TextureFormat::BC6H:           return VK_FORMAT_BC6H_UFLOAT_BLOCK; break;
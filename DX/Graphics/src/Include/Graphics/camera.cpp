@@ -123,6 +123,23 @@ namespace Graphics {
         return true;
     }
 
+    //----------------------------------------------------------------------
+    bool Camera::cull( const Math::AABB& aabb ) const
+    {
+        // Test the corner of the box which lies furthest along each plane normal (p-vertex)
+        auto& min = aabb.getMin();
+        auto& max = aabb.getMax();
+        for ( U32 i = 0; i < m_planes.size(); i++ )
+        {
+            F32 px = m_planes[i].x >= 0.0f ? max.x : min.x;
+            F32 py = m_planes[i].y >= 0.0f ? max.y : min.y;
+            F32 pz = m_planes[i].z >= 0.0f ? max.z : min.z;
+            if ( (m_planes[i].x * px) + (m_planes[i].y * py) + (m_planes[i].z * pz) + m_planes[i].w < 0.0f )
+                return false;
+        }
+        return true;
+    }
+
     //**********************************************************************
     // PRIVATE
     //**********************************************************************
@@ -157,6 +157,14 @@ namespace Graphics {
         //----------------------------------------------------------------------
         bool cull(const Math::Vec3& pos, F32 radius) const;
 
+        //----------------------------------------------------------------------
+        // Cull the given aabb, which must already be in world space, against this camera frustum.
+        // This is the test used for traversing spatial hierarchies.
+        // @Return:
+        //  True, when visible (or intersecting).
+        //----------------------------------------------------------------------
+        bool cull(const Math::AABB& aabbWorldSpace) const;
+
         //----------------------------------------------------------------------
         // Set the replacement shader with a given tag
         //----------------------------------------------------------------------
@@ -172,6 +172,13 @@ namespace Graphics {
         m_gpuCommands.push_back( std::make_unique<GPUC_DrawLight>( light ) );
     }
 
+    //----------------------------------------------------------------------
+    void CommandBuffer::setLightClusters( const Texture2DPtr& clusters, I32 numX, I32 numY, I32 numZ, I32 numGlobalLights )
+    {
+        ASSERT( clusters && "Light cluster texture is null, which is not allowed!" );
+        m_gpuCommands.push_back( std::make_unique<GPUC_SetLightClusters>( clusters, numX, numY, numZ, numGlobalLights ) );
+    }
+
     //----------------------------------------------------------------------
     void CommandBuffer::setRenderTarget( const RenderTexturePtr& target )
     {
@@ -57,6 +57,7 @@ namespace Graphics {
         void copyTexture(const TexturePtr& srcTex, const TexturePtr& dstTex);
         void copyTexture(const TexturePtr& srcTex, I32 srcElement, I32 srcMip, const TexturePtr& dstTex, I32 dstElement, I32 dstMip);
         void drawLight(const Light* light);
+        void setLightClusters(const Texture2DPtr& clusters, I32 numX, I32 numY, I32 numZ, I32 numGlobalLights);
         void setRenderTarget(const RenderTexturePtr& target);
         void drawFullscreenQuad(const MaterialPtr& material);
         void renderCubemap(const CubemapPtr& cubemap, const MaterialPtr& material, I32 dstMip = 0);
@@ -144,6 +144,8 @@ namespace Graphics {
         RGBAFloat,          // RGB color and alpha texture format, 32 - bit floats per channel.
         YUY2,               // A format that uses the YUV color space and is often used for video encoding or playback.
         RGB9e5Float,        // RGB HDR format, with 9 bit mantissa per channel and a 5 bit shared exponent.
+        BC1,                // Compressed color texture format with 1 bit alpha.
+        BC3,                // Compressed color texture format with interpolated alpha.
         BC4,                // Compressed one channel(R) texture format.
         BC5,                // Compressed two - channel(RG) texture format.
         BC6H,               // HDR compressed color texture format.
@@ -27,6 +27,7 @@ namespace Graphics {
         SET_SCISSOR,
         SET_CAMERA_MATRIX,
         SET_RENDER_TARGET,
+        SET_LIGHT_CLUSTERS,
         DRAW_LIGHT,
         DRAW_MESH,
         DRAW_MESH_INSTANCED,
@@ -131,6 +132,17 @@ namespace Graphics {
         const Light* light;
     };
 
+    //**********************************************************************
+    struct GPUC_SetLightClusters : public GPUCommandBase
+    {
+        GPUC_SetLightClusters( const Texture2DPtr& clusters, I32 numX, I32 numY, I32 numZ, I32 numGlobalLights )
+            : GPUCommandBase( GPUCommand::SET_LIGHT_CLUSTERS ),
+            clusters( clusters ), numX( numX ), numY( numY ), numZ( numZ ), numGlobalLights( numGlobalLights ) {}
+
+        const Texture2DPtr  clusters;
+        I32                 numX, numY, numZ, numGlobalLights;
+    };
+
     //**********************************************************************
     struct GPUC_SetRenderTarget : public GPUCommandBase
     {
@@ -51,6 +51,15 @@ namespace Graphics
         //----------------------------------------------------------------------
         virtual void create(I32 size, TextureFormat format, Mips mips = Mips::None) = 0;
 
+        //----------------------------------------------------------------------
+        // Create a new immutable cubemap with a precomputed mipchain, e.g. from the MipGenerator.
+        // @Params:
+        //  "size": Width/Height of each face in pixels
+        //  "format": Format for each pixel
+        //  "mips": Data of every mip of every face. Face by face (in CubemapFace order), each beginning with the largest mip.
+        //----------------------------------------------------------------------
+        virtual void create(I32 size, TextureFormat format, const ArrayList<const void*>& mips) = 0;
+
         //----------------------------------------------------------------------
         // Apply all previous setPixel() changes
         // @Params:
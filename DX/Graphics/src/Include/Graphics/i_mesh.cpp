@@ -7,6 +7,7 @@
 **********************************************************************/
 
 #include "Logging/logging.h"
+#include <DirectXPackedVector.h>
 
 namespace Graphics {
 
@@ -17,6 +18,59 @@ namespace Graphics {
     const StringID SID_VERTEX_TANGENT    = SID("TANGENT");
     const StringID SID_VERTEX_BONEID     = SID("BONEID");
     const StringID SID_VERTEX_BONEWEIGHT = SID("BONEWEIGHT");
+    const StringID SID_VERTEX_PACKED     = SID("PACKED");
+
+    // Largest absolute uv which is still stored as half float when packing, see IMesh::choosePackedLayout()
+    static const F32 MAX_HALF_UV = 4.0f;
+
+    //----------------------------------------------------------------------
+    // @Return: Whether every float of the given stream is inside [min,max].
+    //----------------------------------------------------------------------
+    static bool AllComponentsInRange( const VertexStreamBase* stream, F32 min, F32 max )
+    {
+        auto data = static_cast<const F32*>( stream->data() );
+        U32 numComponents = stream->bufferSize() / sizeof( F32 );
+        for (U32 i = 0; i < numComponents; i++)
+            if (data[i] < min || data[i] > max)
+                return false;
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    // Writes "numComponents" floats in the given format to "dst". Missing components are written as zero.
+    //----------------------------------------------------------------------
+    static void EncodeVertexAttribute( VertexAttributeFormat format, const F32* src, U32 numComponents, Byte* dst )
+    {
+        auto component = [=](U32 i) { return i < numComponents ? src[i] : 0.0f; };
+        switch (format)
+        {
+        case VertexAttributeFormat::Float2:
+        case VertexAttributeFormat::Float3:
+        case VertexAttributeFormat::Float4:
+            for (U32 i = 0; i < GetVertexAttributeFormatSize( format ) / sizeof( F32 ); i++)
+                reinterpret_cast<F32*>( dst )[i] = component( i );
+            break;
+        case VertexAttributeFormat::Half2:
+        case VertexAttributeFormat::Half4:
+            for (U32 i = 0; i < GetVertexAttributeFormatSize( format ) / sizeof( U16 ); i++)
+                reinterpret_cast<U16*>( dst )[i] = DirectX::PackedVector::XMConvertFloatToHalf( component( i ) );
+            break;
+        case VertexAttributeFormat::UNorm16x2:
+            for (U32 i = 0; i < 2; i++)
+                reinterpret_cast<U16*>( dst )[i] = (U16)std::lround( std::clamp( component( i ), 0.0f, 1.0f ) * 65535.0f );
+            break;
+        case VertexAttributeFormat::SNorm16x4:
+            for (U32 i = 0; i < 4; i++)
+                reinterpret_cast<I16*>( dst )[i] = (I16)std::lround( std::clamp( component( i ), -1.0f, 1.0f ) * 32767.0f );
+            break;
+        case VertexAttributeFormat::UNorm8x4:
+            for (U32 i = 0; i < 4; i++)
+                dst[i] = (Byte)std::lround( std::clamp( component( i ), 0.0f, 1.0f ) * 255.0f );
+            break;
+        default:
+            ASSERT( false && "Unknown vertex attribute format" );
+        }
+    }
 
     //----------------------------------------------------------------------
     IMesh::~IMesh()
@@ -36,14 +90,18 @@ namespace Graphics {
             SAFE_DELETE( vsStream );
         m_vertexStreams.clear();
         m_subMeshes.clear();
+        m_packedLayout.clear();
+        m_uvDistributionMetrics.clear();
         _Clear();
     }
 
     //----------------------------------------------------------------------
     void IMesh::_SetVertexStream( StringID name, VertexStreamBase* vs )
     {
+        ASSERT( not _IsPacked( name ) && "Stream is part of the packed vertex buffer and can't be replaced. Call clear() to reset the whole mesh." );
         SAFE_DELETE( m_vertexStreams[name] );
         m_vertexStreams[name] = vs;
+        m_uvDistributionMetrics.clear();
         _DestroyBuffer( name );
         _CreateBuffer( name, *vs );
     }
@@ -112,6 +170,7 @@ namespace Graphics {
     void IMesh::setIndices( const ArrayList<U32>& indices, U32 subMeshIndex, MeshTopology topology, U32 baseVertex )
     {
         bool hasBuffer = hasSubMesh( subMeshIndex );
+        m_uvDistributionMetrics.clear();
 
         if ( not hasBuffer )
         {
@@ -133,10 +192,15 @@ namespace Graphics {
             subMesh.topology    = topology;
             subMesh.indexCount  = (U32)indices.size();
 
+            // 16 bit buffers are only replaced if the new indices don't fit anymore, so they don't switch back and forth
+            bool needsU32 = subMesh.indexFormat == IndexFormat::U16 && _GetIndexFormat( indices ) == IndexFormat::U32;
             bool enoughCapacity = indices.size() <= subMesh.indices.size();
-            if (not enoughCapacity)
+            if (not enoughCapacity || needsU32)
             {
-                subMesh.indices.resize( indices.size() );
+                if (needsU32)
+                    subMesh.indexFormat = IndexFormat::U32;
+                if (not enoughCapacity)
+                    subMesh.indices.resize( indices.size() );
 
                 _DestroyIndexBuffer( subMeshIndex );
                 _CreateIndexBuffer( subMesh, subMeshIndex );
@@ -316,6 +380,158 @@ namespace Graphics {
         setTangents( tangentsVec4 );
     }
 
+    //----------------------------------------------------------------------
+    PackedVertexLayout IMesh::choosePackedLayout() const
+    {
+        PackedVertexLayout layout;
+        if ( hasVertexStream( SID_VERTEX_POSITION ) )
+            layout.add( SID_VERTEX_POSITION, VertexAttributeFormat::Float3 );
+
+        // Directions are quantized to 16 bit per component, which is invisible for shading
+        if ( hasVertexStream( SID_VERTEX_NORMAL ) )
+        {
+            bool normalized = AllComponentsInRange( m_vertexStreams.at( SID_VERTEX_NORMAL ), -1.0f, 1.0f );
+            layout.add( SID_VERTEX_NORMAL, normalized ? VertexAttributeFormat::SNorm16x4 : VertexAttributeFormat::Float3 );
+        }
+        if ( hasVertexStream( SID_VERTEX_TANGENT ) )
+        {
+            bool normalized = AllComponentsInRange( m_vertexStreams.at( SID_VERTEX_TANGENT ), -1.0f, 1.0f );
+            layout.add( SID_VERTEX_TANGENT, normalized ? VertexAttributeFormat::SNorm16x4 : VertexAttributeFormat::Float4 );
+        }
+
+        // Unorm16 is more precise than half floats, but can't represent wrapping uvs. Half floats have a 10 bit mantissa,
+        // so beyond the range below two neighboring values are more than 1/512 apart (two texels of a 1024 texture).
+        if ( hasVertexStream( SID_VERTEX_UV ) )
+        {
+            auto uvs = m_vertexStreams.at( SID_VERTEX_UV );
+            if ( AllComponentsInRange( uvs, 0.0f, 1.0f ) )
+                layout.add( SID_VERTEX_UV, VertexAttributeFormat::UNorm16x2 );
+            else if ( AllComponentsInRange( uvs, -MAX_HALF_UV, MAX_HALF_UV ) )
+                layout.add( SID_VERTEX_UV, VertexAttributeFormat::Half2 );
+            else
+                layout.add( SID_VERTEX_UV, VertexAttributeFormat::Float2 );
+        }
+
+        if ( hasVertexStream( SID_VERTEX_COLOR ) )
+        {
+            bool normalized = AllComponentsInRange( m_vertexStreams.at( SID_VERTEX_COLOR ), 0.0f, 1.0f );
+            layout.add( SID_VERTEX_COLOR, normalized ? VertexAttributeFormat::UNorm8x4 : VertexAttributeFormat::Half4 );
+        }
+
+        return layout;
+    }
+
+    //----------------------------------------------------------------------
+    bool IMesh::pack( const PackedVertexLayout& layout, bool keepStreams )
+    {
+        ASSERT( isImmutable() && "Only immutable meshes can be packed, because packed streams can't be updated." );
+        ASSERT( not isPacked() && "Mesh is already packed. Call clear() to reset the whole mesh." );
+
+        if ( not _SupportsPackedVertices() || layout.isEmpty() || getVertexCount() == 0 )
+            return false;
+
+        U32 numVertices = getVertexCount();
+        U32 stride = layout.getStride();
+        ArrayList<Byte> vertices( numVertices * stride );
+        for (auto& attribute : layout.getAttributes())
+        {
+            ASSERT( hasVertexStream( attribute.name ) && "Mesh hasn't this stream." );
+            auto stream = m_vertexStreams[attribute.name];
+            ASSERT( stream->size() == numVertices && "Every packed stream needs exactly one element per vertex." );
+
+            // Only streams consisting of floats (positions, uvs etc.) can be packed
+            auto src = static_cast<const F32*>( stream->data() );
+            U32 numComponents = stream->bufferSize() / (numVertices * sizeof( F32 ));
+            for (U32 i = 0; i < numVertices; i++)
+                EncodeVertexAttribute( attribute.format, src + i * numComponents, numComponents, &vertices[i * stride + attribute.offset] );
+
+            _DestroyBuffer( attribute.name );
+        }
+
+        // The uv metric needs the float uvs, so it is computed (for every submesh) before they might be freed
+        if ( getSubMeshCount() > 0 )
+            getUVDistributionMetric( 0 );
+
+        if ( not keepStreams )
+        {
+            for (auto& attribute : layout.getAttributes())
+            {
+                if (attribute.name == SID_VERTEX_POSITION)
+                    continue;
+
+                SAFE_DELETE( m_vertexStreams[attribute.name] );
+                m_vertexStreams.erase( attribute.name );
+            }
+        }
+
+        m_packedLayout = layout;
+
+        // The stream is created directly, because creating a stream through createVertexStream() clears the uv metric
+        auto packed = new VertexStream<Byte>( vertices );
+        m_vertexStreams[SID_VERTEX_PACKED] = packed;
+        _CreateBuffer( SID_VERTEX_PACKED, *packed );
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    U32 IMesh::getVertexBufferSize() const
+    {
+        U32 size = 0;
+        for (auto& [name, vsStream] : m_vertexStreams)
+            if ( not _IsPacked( name ) )
+                size += vsStream->bufferSize();
+        return size;
+    }
+
+    //----------------------------------------------------------------------
+    U32 IMesh::getVertexStreamSize() const
+    {
+        U32 size = 0;
+        for (auto& [name, vsStream] : m_vertexStreams)
+            size += vsStream->bufferSize();
+        return size;
+    }
+
+    //----------------------------------------------------------------------
+    F32 IMesh::getUVDistributionMetric( U32 subMesh ) const
+    {
+        if ( m_uvDistributionMetrics.size() != m_subMeshes.size() )
+        {
+            m_uvDistributionMetrics.assign( m_subMeshes.size(), 0.0f );
+            if ( not hasVertexStream( SID_VERTEX_POSITION ) || not hasVertexStream( SID_VERTEX_UV ) )
+                return 0.0f;
+
+            const auto& vertices = getVertexPositions();
+            const auto& uvs = getUVs();
+            for (U32 i = 0; i < m_subMeshes.size(); i++)
+            {
+                auto& sm = m_subMeshes[i];
+                if (sm.topology != MeshTopology::Triangles)
+                    continue;
+
+                F32 area = 0.0f, uvArea = 0.0f;
+                for (U32 j = 0; j + 2 < sm.indexCount; j += 3)
+                {
+                    U32 i0 = sm.baseVertex + sm.indices[j];
+                    U32 i1 = sm.baseVertex + sm.indices[j + 1];
+                    U32 i2 = sm.baseVertex + sm.indices[j + 2];
+
+                    area += (vertices[i1] - vertices[i0]).cross( vertices[i2] - vertices[i0] ).magnitude();
+
+                    Math::Vec2 uv0 = uvs[i1] - uvs[i0];
+                    Math::Vec2 uv1 = uvs[i2] - uvs[i0];
+                    uvArea += std::abs( uv0.x * uv1.y - uv0.y * uv1.x );
+                }
+
+                // Both areas are doubled, which cancels out
+                if (uvArea > 0.0f)
+                    m_uvDistributionMetrics[i] = std::sqrt( area / uvArea );
+            }
+        }
+
+        return m_uvDistributionMetrics[subMesh];
+    }
+
     //----------------------------------------------------------------------
     // PROTECTED
     //----------------------------------------------------------------------
@@ -332,14 +548,22 @@ namespace Graphics {
         sm.baseVertex   = baseVertex;
         sm.topology     = topology;
         sm.indexCount   = (U32)indices.size();
-
-        if ( indices.size() > 65535 )
-            sm.indexFormat = IndexFormat::U32;
+        sm.indexFormat  = _GetIndexFormat( indices );
 
         m_subMeshes.push_back( sm );
         return m_subMeshes.back();
     }
 
+    //----------------------------------------------------------------------
+    IndexFormat IMesh::_GetIndexFormat( const ArrayList<U32>& indices )
+    {
+        // 0xFFFF is reserved as the strip cut value, so it can't be used as a regular index
+        for (auto index : indices)
+            if (index >= 0xFFFF)
+                return IndexFormat::U32;
+        return IndexFormat::U16;
+    }
+
     //----------------------------------------------------------------------
     void IMesh::_RecalculateBounds( const ArrayList<Math::Vec3>& vertexPositions )
     {
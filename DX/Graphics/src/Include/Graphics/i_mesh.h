@@ -26,6 +26,7 @@ namespace Graphics {
     extern const StringID SID_VERTEX_TANGENT;
     extern const StringID SID_VERTEX_BONEID;
     extern const StringID SID_VERTEX_BONEWEIGHT;
+    extern const StringID SID_VERTEX_PACKED;
 
     //**********************************************************************
     // Base class for different vertex streams.
@@ -64,6 +65,7 @@ namespace Graphics {
     public:
         VertexStream(U32 maxObjects) : m_data(maxObjects) {}
         VertexStream(const ArrayList<T>& data) : m_data{ data } {}
+        VertexStream(const T* data, U32 count) : m_data( data, data + count ) {}
 
         T&          operator[] (I32 i)          { _SetWasUpdated(); return m_data[i]; }
         const T&    operator[] (I32 i) const    { return m_data[i]; }
@@ -73,6 +75,12 @@ namespace Graphics {
         //----------------------------------------------------------------------
         const ArrayList<T>& get() const { return m_data; }
 
+        //----------------------------------------------------------------------
+        // Direct write access to the underlying data for filling the whole stream at once.
+        // Marks the stream as updated, so it is uploaded before the next draw.
+        //----------------------------------------------------------------------
+        T* map() { _SetWasUpdated(); return m_data.data(); }
+
         //----------------------------------------------------------------------
         // Resizes the underlying data container to fit the given amount.
         //----------------------------------------------------------------------
@@ -184,6 +192,42 @@ namespace Graphics {
         //----------------------------------------------------------------------
         void setBounds(const Math::AABB& bounds) { m_bounds = bounds; }
 
+        //----------------------------------------------------------------------
+        // Chooses the smallest formats which represent the position, uv, normal, tangent and color
+        // streams of this mesh without visible error, e.g. uvs are stored as unorm16 if all of them are inside [0,1].
+        //----------------------------------------------------------------------
+        PackedVertexLayout choosePackedLayout() const;
+
+        //----------------------------------------------------------------------
+        // Interleaves all streams of the given layout into a single vertex buffer with the formats of the layout.
+        // Packed streams don't have their own buffer on the gpu anymore. Streams not part of the layout
+        // (e.g. bone ids) are bound as before. Only immutable meshes can be packed.
+        // @Params:
+        //  "keepStreams": If false, the float data of the packed streams is freed on the cpu as well, except for the
+        //                 positions, which are needed for culling and picking. Reading a freed stream afterwards asserts.
+        // @Return:
+        //  False if the backend does not support packed vertices. The mesh is unchanged in that case.
+        //----------------------------------------------------------------------
+        bool pack(const PackedVertexLayout& layout, bool keepStreams = true);
+
+        //----------------------------------------------------------------------
+        // @Return: Size of all vertex buffers of this mesh on the gpu in bytes.
+        //----------------------------------------------------------------------
+        U32 getVertexBufferSize() const;
+
+        //----------------------------------------------------------------------
+        // @Return: Size of all vertex streams kept on the cpu in bytes, including the interleaved vertices of a packed mesh.
+        //----------------------------------------------------------------------
+        U32 getVertexStreamSize() const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Average length in model space covered by one unit in uv space of the given submesh (square root of
+        //  the triangle area divided by the uv area). Used to estimate the texel density on the screen, e.g. for
+        //  texture streaming. Zero if the submesh has no uvs or no triangles. Computed once and then cached.
+        //----------------------------------------------------------------------
+        F32 getUVDistributionMetric(U32 subMesh) const;
+
         //----------------------------------------------------------------------
         // Creates a new vertex stream, returns a reference to it and deletes the old one if present.
         // @Params:
@@ -212,6 +256,20 @@ namespace Graphics {
             return *vs;
         }
 
+        //----------------------------------------------------------------------
+        // Creates a new vertex stream directly from the given memory, e.g. a memory mapped file.
+        // @Params:
+        //  "name": The name of the vertex stream
+        //  "data": Pointer to the first of "count" objects, which are copied into the stream.
+        //----------------------------------------------------------------------
+        template<typename T>
+        VertexStream<T>& createVertexStream(StringID name, const T* data, U32 count)
+        {
+            auto vs = new VertexStream<T>(data, count);
+            _SetVertexStream(name, vs);
+            return *vs;
+        }
+
         //----------------------------------------------------------------------
         // @Return: Vertex-Stream with the given name. Nullptr if not present.
         //----------------------------------------------------------------------
@@ -239,6 +297,8 @@ namespace Graphics {
         const ArrayList<Math::Vec3>&    getNormals() const;
         const ArrayList<Math::Vec4>&    getTangents() const;
         bool                            hasVertexStream(StringID name) const { return m_vertexStreams.find(name) != m_vertexStreams.end(); }
+        bool                            isPacked()                   const { return not m_packedLayout.isEmpty(); }
+        const PackedVertexLayout&       getPackedLayout()            const { return m_packedLayout; }
         VertexStream<Math::Vec3>&       getPositionStream() { return getVertexStream<Math::Vec3>(SID_VERTEX_POSITION); }
         VertexStream<Math::Vec4>&       getColorStream()    { return getVertexStream<Math::Vec4>(SID_VERTEX_COLOR); }
         VertexStream<Math::Vec2>&       getUVStream()       { return getVertexStream<Math::Vec2>(SID_VERTEX_UV); }
@@ -250,6 +310,8 @@ namespace Graphics {
         HashMap<StringID, VertexStreamBase*>    m_vertexStreams;
         BufferUsage                             m_bufferUsage = BufferUsage::Immutable;
         Math::AABB                              m_bounds;
+        PackedVertexLayout                      m_packedLayout; // Empty if every stream has its own buffer
+        mutable ArrayList<F32>                  m_uvDistributionMetrics; // Cleared whenever the vertices or indices change
 
         struct SubMesh
         {
@@ -280,6 +342,16 @@ namespace Graphics {
         virtual void _CreateIndexBuffer(const SubMesh& subMesh, I32 index) = 0;
         virtual void _DestroyIndexBuffer(I32 index) = 0;
 
+        //----------------------------------------------------------------------
+        // Whether the backend can bind an interleaved vertex buffer described by a PackedVertexLayout.
+        //----------------------------------------------------------------------
+        virtual bool _SupportsPackedVertices() const { return false; }
+
+        //----------------------------------------------------------------------
+        // @Return: Whether the given stream is part of the packed vertex buffer and has no buffer on its own.
+        //----------------------------------------------------------------------
+        bool _IsPacked(StringID name) const { return m_packedLayout.find( name ) != nullptr; }
+
     private:
         void _SetVertexStream(StringID name, VertexStreamBase* vs);
 
@@ -292,12 +364,17 @@ namespace Graphics {
 
         //----------------------------------------------------------------------
         // Add a new submesh to the list of submeshes. The appropriate index-
-        // format is automatically determined, based on the number of indices.
+        // format is automatically determined, based on the largest index.
         // @Return:
         // The newly created submesh struct.
         //----------------------------------------------------------------------
         SubMesh& _AddSubMesh( const ArrayList<U32>& indices, MeshTopology topology, U32 baseVertex );
 
+        //----------------------------------------------------------------------
+        // @Return: U16 if every index fits into 16 bit, otherwise U32.
+        //----------------------------------------------------------------------
+        static IndexFormat _GetIndexFormat( const ArrayList<U32>& indices );
+
         //----------------------------------------------------------------------
         // Recalculate the AABB for this mesh
         //----------------------------------------------------------------------
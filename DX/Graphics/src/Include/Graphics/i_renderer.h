@@ -13,6 +13,8 @@
 #include "OS/Window/window.h"
 #include "Events/event.h"
 #include "structs.hpp"
+#include "Utils/pipeline_state_cache.h"
+#include "Utils/shader_cache.h"
 
 namespace Graphics {
 
@@ -45,6 +47,18 @@ namespace Graphics {
         //----------------------------------------------------------------------
         void setVSync(bool enabled) { m_vsync = enabled; _VSyncChanged(m_vsync); }
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The cache for the fixed function pipeline states. Nullptr if the api manages them itself.
+        //----------------------------------------------------------------------
+        virtual const IPipelineStateCache* getPipelineStateCache() const { return nullptr; }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The cache for compiled shader bytecode. Nullptr if shaders are always compiled.
+        //----------------------------------------------------------------------
+        virtual const ShaderCache* getShaderCache() const { return nullptr; }
+
         //----------------------------------------------------------------------
         // Dispatches the given command buffer for execution on the gpu.
         // @Params:
@@ -84,6 +98,14 @@ namespace Graphics {
         virtual ITexture2DArray*    createTexture2DArray() = 0;
         virtual IRenderBuffer*      createRenderBuffer() = 0;
 
+        //----------------------------------------------------------------------
+        // Compiles one shader stage into the shader cache without creating any api object, unless it is cached already.
+        // Used to prewarm the cache on worker threads, so shaders created later only read their bytecode. Thread-safe.
+        // @Throws:
+        //  std::runtime_error if compilation failed.
+        //----------------------------------------------------------------------
+        virtual void precompileShader(ShaderType shaderType, const String& source, CString entryPoint) = 0;
+
         //----------------------------------------------------------------------
         // Update the global buffer.
         // @Return:
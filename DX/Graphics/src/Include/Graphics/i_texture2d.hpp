@@ -39,6 +39,27 @@ namespace Graphics
         //----------------------------------------------------------------------
         virtual void create(U32 width, U32 height, TextureFormat format, const void* pData = nullptr) = 0;
 
+        //----------------------------------------------------------------------
+        // Creates a new immutable 2d-texture with a precomputed mipchain, e.g. from block compressed data.
+        // @Params:
+        //  "width": Width in pixels.
+        //  "height": Height in pixels.
+        //  "format": The texture format.
+        //  "mips": Pointer to the data of each mip, beginning with the largest one. Rows must be tightly packed.
+        //  "firstMip": Index of the first given mip in the complete mipchain. Larger mips are not resident on the gpu
+        //              until they are uploaded with setResidentMips(), e.g. by a texture streamer.
+        //----------------------------------------------------------------------
+        virtual void create(U32 width, U32 height, TextureFormat format, const ArrayList<const void*>& mips, U32 firstMip = 0) = 0;
+
+        //----------------------------------------------------------------------
+        // Replaces the mips on the gpu of a texture created with a precomputed mipchain. The size of the
+        // texture does not change, so materials using it are not affected. The previous mips are released.
+        // @Params:
+        //  "firstMip": Index of the first given mip in the complete mipchain.
+        //  "mips": Pointer to the data of mip "firstMip" down to the smallest one.
+        //----------------------------------------------------------------------
+        virtual void setResidentMips(U32 firstMip, const ArrayList<const void*>& mips) = 0;
+
         //----------------------------------------------------------------------
         // Apply all previous pixels changes to the texture.
         // @Params:
@@ -53,6 +74,12 @@ namespace Graphics
         //----------------------------------------------------------------------
         bool isImmutable() const { return m_isImmutable; }
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Index of the largest mip which is resident on the gpu. Zero unless the texture is streamed.
+        //----------------------------------------------------------------------
+        U32 getResidentMip() const { return m_residentMip; }
+
         //----------------------------------------------------------------------
         // Change one pixel. This function is only supported for the formats RGBA32 and BGRA32.
         //----------------------------------------------------------------------
@@ -106,6 +133,7 @@ namespace Graphics
 
     protected:
         bool                m_isImmutable = true;
+        U32                 m_residentMip = 0;
 
         // Heap allocated mem for pixels. How large it is depends on width/height and the format
         ArrayList<Byte>     m_pixels;
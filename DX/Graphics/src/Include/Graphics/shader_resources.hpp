@@ -92,19 +92,11 @@ namespace Graphics {
 
         inline const ShaderUniformDeclaration* getMember(StringID name) const 
         {
-            for (auto& member : m_members)
-                if (member.getName() == name)
-                    return &member;
-            return nullptr;
+            auto it = m_memberIndices.find( name );
+            return it != m_memberIndices.end() ? &m_members[it->second] : nullptr;
         }
 
-        inline bool hasMember(StringID name) const
-        {
-            for (auto& member : m_members)
-                if (member.getName() == name)
-                    return true;
-            return false;
-        }
+        inline bool hasMember(StringID name) const { return m_memberIndices.find( name ) != m_memberIndices.end(); }
 
         // Used to check if two buffers are equal
         bool operator==(const ShaderUniformBufferDeclaration& c) const
@@ -119,7 +111,7 @@ namespace Graphics {
         }
         bool operator!=(const ShaderUniformBufferDeclaration& c) const { return !(*this == c); }
 
-        void _AddUniformDecl(const ShaderUniformDeclaration& uniform) { m_members.push_back( uniform ); }
+        void _AddUniformDecl(const ShaderUniformDeclaration& uniform) { m_memberIndices[uniform.getName()] = (U32)m_members.size(); m_members.push_back( uniform ); }
         void _AddShaderStage(ShaderType shaderStage) { m_shaderStages |= shaderStage; }
 
     private:
@@ -129,6 +121,7 @@ namespace Graphics {
         U32                                 m_sizeInBytes;
         ShaderType                          m_shaderStages;
         ArrayList<ShaderUniformDeclaration> m_members;
+        HashMap<StringID, U32>              m_memberIndices; // Name -> Index into m_members, filled once by the reflection
     };
 
 }
\ No newline at end of file
@@ -23,10 +23,20 @@ namespace Graphics {
     // Collected render information (per camera)
     struct FrameInfo
     {
-        U32 drawCalls;
-        U32 numVertices;
-        U32 numTriangles;
-        U32 numLights;
+        // Collected by the renderer while executing the commands of a camera
+        U32 drawCalls       = 0;
+        U32 numVertices     = 0;
+        U32 numTriangles    = 0;
+        U32 numLights       = 0;
+
+        // Collected by the engine while recording the shadowmaps triggered by a camera
+        U32 numShadowCasters        = 0;
+        U32 numShadowCastersCulled  = 0;
+        U32 numShadowPassesRendered = 0;
+        U32 numShadowPassesCached   = 0;
+
+        // Resets only the values collected by the renderer
+        void resetRenderStats() { drawCalls = 0; numVertices = 0; numTriangles = 0; numLights = 0; }
     };
 
     // Coordinates specified in [0-1] Range
@@ -7,6 +7,8 @@
 
     Stores information about the vertex-layout for an shader.
     The mesh class needs this to know what buffers to bind.
+    The packed vertex layout describes the interleaved and quantized
+    vertex format of a mesh.
 **********************************************************************/
 
 namespace Graphics {
@@ -53,4 +55,101 @@ namespace Graphics {
         NULL_COPY_AND_ASSIGN(VertexLayout)
     };
 
+    //----------------------------------------------------------------------
+    // Storage format of one attribute in a packed vertex. Every format is expanded
+    // to floats by the input assembler, so shaders don't have to know about it.
+    //----------------------------------------------------------------------
+    enum class VertexAttributeFormat
+    {
+        Float2,
+        Float3,
+        Float4,
+        Half2,      // e.g. uvs outside of [0,1]
+        Half4,      // e.g. hdr colors
+        UNorm16x2,  // e.g. uvs inside of [0,1]
+        SNorm16x4,  // e.g. normals and tangents
+        UNorm8x4    // e.g. colors
+    };
+
+    //----------------------------------------------------------------------
+    inline U32 GetVertexAttributeFormatSize( VertexAttributeFormat format )
+    {
+        switch (format)
+        {
+        case VertexAttributeFormat::Float2:     return 8;
+        case VertexAttributeFormat::Float3:     return 12;
+        case VertexAttributeFormat::Float4:     return 16;
+        case VertexAttributeFormat::Half2:      return 4;
+        case VertexAttributeFormat::Half4:      return 8;
+        case VertexAttributeFormat::UNorm16x2:  return 4;
+        case VertexAttributeFormat::SNorm16x4:  return 8;
+        case VertexAttributeFormat::UNorm8x4:   return 4;
+        }
+        ASSERT( false && "Unknown vertex attribute format" );
+        return 0;
+    }
+
+    // Description for one attribute in an interleaved vertex
+    struct PackedVertexAttribute
+    {
+        StringID                name;
+        VertexAttributeFormat   format = VertexAttributeFormat::Float4;
+        U32                     offset = 0;
+    };
+
+    //**********************************************************************
+    // Layout of an interleaved vertex buffer, in which every vertex stores
+    // its attributes one after another in a (possibly) quantized format.
+    // The mesh class fills the buffer, the backends use this to map the
+    // shader inputs to the right offset and format.
+    //**********************************************************************
+    class PackedVertexLayout
+    {
+    public:
+        PackedVertexLayout() = default;
+        ~PackedVertexLayout() = default;
+
+        //----------------------------------------------------------------------
+        const ArrayList<PackedVertexAttribute>& getAttributes() const { return m_attributes; }
+        U32 getStride() const { return m_stride; }
+        bool isEmpty() const { return m_attributes.empty(); }
+
+        //----------------------------------------------------------------------
+        // Appends a new attribute to the end of a vertex
+        //----------------------------------------------------------------------
+        void add(StringID name, VertexAttributeFormat format)
+        {
+            ASSERT( find( name ) == nullptr && "Attribute was already added" );
+            m_attributes.push_back( { name, format, m_stride } );
+            m_stride += GetVertexAttributeFormatSize( format );
+            m_hash = m_hash * 31 + ((U64)name.id << 8 | (U64)format);
+        }
+
+        //----------------------------------------------------------------------
+        // @Return: The attribute with the given name. Nullptr if not part of this layout.
+        //----------------------------------------------------------------------
+        const PackedVertexAttribute* find(StringID name) const
+        {
+            for (auto& attribute : m_attributes)
+                if (attribute.name == name)
+                    return &attribute;
+            return nullptr;
+        }
+
+        //----------------------------------------------------------------------
+        // @Return: Hash of names and formats. Can be used to cache objects per layout.
+        //----------------------------------------------------------------------
+        U64 getHash() const { return m_hash; }
+
+        //----------------------------------------------------------------------
+        // Clear this vertex layout
+        //----------------------------------------------------------------------
+        void clear() { m_attributes.clear(); m_stride = 0; m_hash = 0; }
+
+    private:
+        ArrayList<PackedVertexAttribute>    m_attributes;
+        U32                                 m_stride = 0;
+        U64                                 m_hash = 0;
+    };
+
 } // End namespaces
\ No newline at end of file
@@ -4,7 +4,7 @@
 // "camera": Per camera constant buffer.
 // "light": Per light constant buffer.
 
-#define MAX_LIGHTS 					16
+#define MAX_LIGHTS 					128
 #define MAX_SHADOWMAPS_2D			4
 #define MAX_SHADOWMAPS_3D 			1
 #define DIRECTIONAL_LIGHT 			0
@@ -64,11 +64,12 @@ struct CSMSplit
 
 cbuffer cbBufferLights : register(b3)
 {
-	Light 		_Lights[MAX_LIGHTS]; // 16 * 80 = 1280 bytes (somehow 1024 bytes?!)
+	Light 		_Lights[MAX_LIGHTS]; // 128 * 64 = 8192 bytes
 	float4x4 	_LightViewProj[MAX_SHADOWMAPS_2D]; // 4 * 64 = 256 bytes
 	//float4x4 	_CSMLightViewProj[MAX_CSM_SPLITS]; // 4 * 64 = 256 bytes
 	CSMSplit	_CSMSplits[MAX_CSM_SPLITS];
 	int 		_LightCount; // 4 bytes
+	int4		_ClusterCount; // Light clusters, not used by these shaders
 };
 
 Texture2D shadowMap0 : register(t9);
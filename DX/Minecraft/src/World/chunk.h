@@ -21,7 +21,7 @@ public:
         bounds.getMax() = bounds.getMin() + Math::Vec3( CHUNK_SIZE, 2 * CHUNK_HEIGHT, CHUNK_SIZE );
 
         go = SCENE.createGameObject("CHUNK");
-        go->getTransform()->position = posV3;
+        go->getTransform()->setPosition( posV3 );
         go->addComponent<Components::MeshRenderer>();
     }
 
@@ -177,8 +177,8 @@ void World::_CalculateChunkVisibility()
     // Calculate which chunks are visible
     auto transform = m_viewer->getGameObject()->getComponent<Components::Transform>();
 
-    I32 currentChunkCoordX = static_cast<I32>( std::floorf( transform->position.x / CHUNK_SIZE ) );
-    I32 currentChunkCoordY = static_cast<I32>( std::floorf( transform->position.z / CHUNK_SIZE) );
+    I32 currentChunkCoordX = static_cast<I32>( std::floorf( transform->getPosition().x / CHUNK_SIZE ) );
+    I32 currentChunkCoordY = static_cast<I32>( std::floorf( transform->getPosition().z / CHUNK_SIZE) );
 
     for (I32 ring = 0; ring < CHUNK_VIEW_DISTANCE; ring++)
     {
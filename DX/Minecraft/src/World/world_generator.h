@@ -49,14 +49,15 @@ private:
         {
             auto& blockInfo = pair.second;
 
+            // Uncompressed, because the pixels are copied into the texture array below
             blockInfo.texIndices = (F32)textureIndex++;
-            m_blockTextures.push_back( ASSETS.getTexture2D( blockInfo.topBottom ) );
+            m_blockTextures.push_back( ASSETS.getTexture2D( blockInfo.topBottom, true, Assets::TextureUsage::Uncompressed ) );
 
             // Add sideblock if the block looks different on the side
             if (blockInfo.topBottom != blockInfo.side)
             {
                 blockInfo.texIndices.y = (F32)textureIndex++;
-                m_blockTextures.push_back( ASSETS.getTexture2D( blockInfo.side ) );
+                m_blockTextures.push_back( ASSETS.getTexture2D( blockInfo.side, true, Assets::TextureUsage::Uncompressed ) );
             }
         }
 
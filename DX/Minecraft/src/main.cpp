@@ -58,14 +58,14 @@ public:
 
         transform = go->getComponent<Components::Transform>();
         minimapCamTransform = minimapCamGo->getComponent<Components::Transform>();
-        minimapCamTransform->position.y = m_heightOffset;
-        minimapCamTransform->rotation = Math::Quat::LookRotation(Math::Vec3::DOWN, Math::Vec3::FORWARD);
+        minimapCamTransform->setPosition( { 0, m_heightOffset, 0 } );
+        minimapCamTransform->setRotation( Math::Quat::LookRotation(Math::Vec3::DOWN, Math::Vec3::FORWARD) );
     }
 
     void tick(Time::Seconds delta) override
     {
-        minimapCamTransform->position.x = transform->position.x;
-        minimapCamTransform->position.z = transform->position.z;
+        auto& pos = transform->getPosition();
+        minimapCamTransform->setPosition( { pos.x, minimapCamTransform->getPosition().y, pos.z } );
     }
 };
 
@@ -171,8 +171,8 @@ public:
         shader->setDepthStencilState({ true, true });
 #else
         // Adjust transform
-        transform->rotation = Math::Quat::FromEulerAngles( 45.0f, 45.0f, 0.0f );
-        transform->position = { 0.35f, -0.3f, 1.0f };
+        transform->setRotation( Math::Quat::FromEulerAngles( 45.0f, 45.0f, 0.0f ) );
+        transform->setPosition( { 0.35f, -0.3f, 1.0f } );
 
         renderer->setCastShadows(false);
 #endif
@@ -349,14 +349,14 @@ public:
         inventory = getGameObject()->getComponent<PlayerInventory>();
         ASSERT(inventory && "Inventory Component is NULL!");
 
-        auto eulers = transform->rotation.toEulerAngles();
+        auto eulers = transform->getRotation().toEulerAngles();
         mousePitchDeg = eulers.x;
         mouseYawDeg = eulers.y;
     }
 
     void onActive() override
     {
-        auto eulers = transform->rotation.toEulerAngles();
+        auto eulers = transform->getRotation().toEulerAngles();
         mousePitchDeg = eulers.x;
         mouseYawDeg = eulers.y;
     }
@@ -369,8 +369,8 @@ public:
         auto dir = prevBlockTransform->getWorldRotation().getForward();
         auto pos = prevBlockTransform->getWorldPosition();
 #else
-        auto dir = transform->rotation.getForward();
-        auto pos = transform->position;
+        auto dir = transform->getRotation().getForward();
+        auto pos = transform->getPosition();
 #endif
         Physics::Ray ray(pos, dir * rayDistance);
 
@@ -392,7 +392,7 @@ public:
 
                 digClips[Math::Random::Int(3)]->play();
                 //DEBUG.drawSphere(result.hitPoint, 0.1f, Color::RED, 10);
-                //DEBUG.drawRay(transform->position, ray.getDirection(), Color::BLUE, 10);
+                //DEBUG.drawRay(transform->getPosition(), ray.getDirection(), Color::BLUE, 10);
             });
         }
 
@@ -415,7 +415,7 @@ public:
                 Math::Vec3 newBlockPos = result.blockCenter + axis.normalized();
 
                 // If the block is too close dont allow to place it
-                F32 distanceToPlayer = (newBlockPos - transform->position).magnitude();
+                F32 distanceToPlayer = (newBlockPos - transform->getPosition()).magnitude();
                 if (distanceToPlayer < 4.0f*playerSize)
                     return;
 
@@ -450,7 +450,7 @@ public:
 
         // Smoothly lerp to desired rotation
         Math::Quat desiredRotation = Math::Quat::FromEulerAngles(mousePitchDeg, mouseYawDeg, 0.0f);
-        transform->rotation = Math::Quat::Slerp(transform->rotation, desiredRotation, 0.3f);
+        transform->setRotation( Math::Quat::Slerp(transform->getRotation(), desiredRotation, 0.3f) );
 
         // JUMPING
         bool isOnGround = (playerVelocity.y == 0.0f);
@@ -466,8 +466,8 @@ public:
         if (ACTION_MAPPER.isKeyDown(ACTION_NAME_RUN))
             realSpeed *= 2.0f;
 
-        Math::Vec3 forward  = transform->rotation.getForward();
-        Math::Vec3 left     = transform->rotation.getLeft();
+        Math::Vec3 forward  = transform->getRotation().getForward();
+        Math::Vec3 left     = transform->getRotation().getLeft();
 
         Math::Vec3 mov = left * (F32)AXIS_MAPPER.getAxisValue("Horizontal") * realSpeed + 
                          forward * (F32)AXIS_MAPPER.getAxisValue("Vertical") * realSpeed;
@@ -475,22 +475,22 @@ public:
         playerVelocity.z = mov.z;
 
         // APPLY VELOCITY
-        Math::Vec3 prevPos = transform->position;
-        transform->position += playerVelocity;
+        Math::Vec3 prevPos = transform->getPosition();
+        transform->translate( playerVelocity );
 
         // COLLISION CHECK (X+Z AXIS) - Shoot ray from feet into movement direction
         Math::Vec3 xzVel(playerVelocity.x, 0.0f, playerVelocity.z);
-        Physics::Ray rayXZ(transform->position + Math::Vec3::DOWN * playerHeight + 0.1f, xzVel.normalized() * playerSize);
+        Physics::Ray rayXZ(transform->getPosition() + Math::Vec3::DOWN * playerHeight + 0.1f, xzVel.normalized() * playerSize);
         World::Get().RayCast(rayXZ, [=](const ChunkRayCastResult& result) {
-            transform->position.x = prevPos.x;
-            transform->position.z = prevPos.z;
+            transform->setPosition( { prevPos.x, transform->getPosition().y, prevPos.z } );
             //DEBUG.drawSphere(result.hitPoint, 0.1f, Color::RED, 0, false);
         });
 
         // COLLISION CHECK (Y-AXIS)
-        Physics::Ray rayDown(transform->position, Math::Vec3::DOWN * playerHeight);
+        Physics::Ray rayDown(transform->getPosition(), Math::Vec3::DOWN * playerHeight);
         World::Get().RayCast(rayDown, [=](const ChunkRayCastResult& result) {
-            transform->position.y = result.hitPoint.y - rayDown.getDirection().y;
+            auto& pos = transform->getPosition();
+            transform->setPosition( { pos.x, result.hitPoint.y - rayDown.getDirection().y, pos.z } );
             playerVelocity.y = 0.0f;
         });
     }
@@ -520,12 +520,12 @@ public:
             rotated = false;
         else if (rightThumb.x > 0.5f && not rotated)
         {
-            transform->rotation *= Math::Quat({ 0, 1, 0 }, 20.0f);
+            transform->rotate( Math::Quat({ 0, 1, 0 }, 20.0f) );
             rotated = true;
         }
         else if (rightThumb.x < -0.5f && not rotated)
         {
-            transform->rotation *= Math::Quat({ 0, 1, 0 }, -20.0f);
+            transform->rotate( Math::Quat({ 0, 1, 0 }, -20.0f) );
             rotated = true;
         }
 
@@ -538,22 +538,22 @@ public:
         playerVelocity.z = mov.z;
 
         // APPLY VELOCITY
-        Math::Vec3 prevPos = transform->position;
-        transform->position += playerVelocity;
+        Math::Vec3 prevPos = transform->getPosition();
+        transform->translate( playerVelocity );
 
         // COLLISION CHECK (X+Z AXIS) - Shoot ray from feet into movement direction
         Math::Vec3 xzVel(playerVelocity.x, 0.0f, playerVelocity.z);
-        Physics::Ray rayXZ(transform->position + Math::Vec3::DOWN * playerHeight + 0.1f, xzVel.normalized() * playerSize);
+        Physics::Ray rayXZ(transform->getPosition() + Math::Vec3::DOWN * playerHeight + 0.1f, xzVel.normalized() * playerSize);
         World::Get().RayCast(rayXZ, [=](const ChunkRayCastResult& result) {
-            transform->position.x = prevPos.x;
-            transform->position.z = prevPos.z;
+            transform->setPosition( { prevPos.x, transform->getPosition().y, prevPos.z } );
             //DEBUG.drawSphere(result.hitPoint, 0.1f, Color::RED, 0, false);
         });
 
         // COLLISION CHECK (Y-AXIS)
-        Physics::Ray rayDown(transform->position, Math::Vec3::DOWN * playerHeight);
+        Physics::Ray rayDown(transform->getPosition(), Math::Vec3::DOWN * playerHeight);
         World::Get().RayCast(rayDown, [=](const ChunkRayCastResult& result) {
-            transform->position.y = result.hitPoint.y - rayDown.getDirection().y;
+            auto& pos = transform->getPosition();
+            transform->setPosition( { pos.x, result.hitPoint.y - rayDown.getDirection().y, pos.z } );
             playerVelocity.y = 0.0f;
         });
     }
@@ -579,16 +579,15 @@ public:
         auto mr = water->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(1000.0f), mat);
         mr->setCastShadows(false);
         transform = water->getTransform();
-        transform->rotation *= Math::Quat(Math::Vec3::RIGHT, 90);
+        transform->rotate( Math::Quat(Math::Vec3::RIGHT, 90) );
     }
 
     void tick(Time::Seconds delta) override
     {
         // Plane moves with the viewer in the X-Z plane.
         auto viewer = SCENE.getMainCamera()->getGameObject()->getTransform();
-        transform->position = viewer->position;
-
-        transform->position.y = m_waterLevel + sinf((F32)TIME.getTime().value) * 0.2f;
+        auto& viewerPos = viewer->getPosition();
+        transform->setPosition( { viewerPos.x, m_waterLevel + sinf((F32)TIME.getTime().value) * 0.2f, viewerPos.z } );
     }
 };
 
@@ -608,7 +607,7 @@ public:
         dirLight->setShadowMapQuality(Graphics::ShadowMapQuality::Insane);
         dirLight->setShadowRange(50.0f);
 
-        go->getTransform()->rotation = Math::Quat::LookRotation( Math::Vec3{ 0, -1, 0 }, Math::Vec3::RIGHT );
+        go->getTransform()->setRotation( Math::Quat::LookRotation( Math::Vec3{ 0, -1, 0 }, Math::Vec3::RIGHT ) );
     }
 
     Components::DirectionalLight* getDirLight() { return dirLight; }
@@ -617,9 +616,9 @@ public:
     {
         F32 speed = 1.0f;
         if (KEYBOARD.isKeyDown(Key::E))
-            getGameObject()->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, speed * (F32)delta);
+            getGameObject()->getTransform()->rotate( Math::Quat(Math::Vec3::RIGHT, speed * (F32)delta) );
         if (KEYBOARD.isKeyDown(Key::Q))
-            getGameObject()->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, -speed * (F32)delta);
+            getGameObject()->getTransform()->rotate( Math::Quat(Math::Vec3::RIGHT, -speed * (F32)delta) );
     }
 };
 
@@ -643,7 +642,7 @@ public:
 
         // PLAYER
         auto player = createGameObject("player");
-        player->getComponent<Components::Transform>()->position = Math::Vec3(0, 100, -5);
+        player->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 100, -5) );
 
 #if USE_VR
         player->addComponent<Components::VRCamera>(Components::ScreenDisplay::LeftEye, Graphics::MSAASamples::Four);
@@ -676,11 +675,11 @@ public:
 
                 static F32 animateSpeed = 0.0f;
                 ImGui::SliderFloat("Speed", &animateSpeed, -20.0f, 20.0f);
-                dl->getGameObject()->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, animateSpeed * (F32)PROFILER.getDelta());
+                dl->getGameObject()->getTransform()->rotate( Math::Quat(Math::Vec3::RIGHT, animateSpeed * (F32)PROFILER.getDelta()) );
 
                 static Math::Vec3 deg{ 45.0f, 0.0f, 0.0f };
                 if (ImGui::SliderFloat2("Rotation", &deg.x, 0.0f, 360.0f))
-                    sun->getTransform()->rotation = Math::Quat::FromEulerAngles(deg);
+                    sun->getTransform()->setRotation( Math::Quat::FromEulerAngles(deg) );
 
                 static F32 color[4] = { 1,1,1,1 };
                 if (ImGui::ColorEdit4("Color", color))
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/occlusion_culler.h"
+
+//----------------------------------------------------------------------
+// Rasterizes one quad in front of the camera and checks that a box behind
+// it is culled, while a box beside it is kept. Runs without a renderer.
+//----------------------------------------------------------------------
+bool TestOcclusionCulling()
+{
+    OcclusionCuller culler( 256, 128, 1 );
+
+    // Camera at the origin looking down +Z
+    auto view = DirectX::XMMatrixLookToLH( DirectX::XMVectorZero(), DirectX::XMVectorSet( 0, 0, 1, 0 ), DirectX::XMVectorSet( 0, 1, 0, 0 ) );
+    auto proj = DirectX::XMMatrixPerspectiveFovLH( DirectX::XM_PIDIV2, 2.0f, 0.1f, 100.0f );
+    culler.beginFrame( view * proj );
+
+    // 4x4 quad at z = 5
+    ArrayList<Math::Vec3> positions = { { -2.0f, -2.0f, 5.0f }, { -2.0f, 2.0f, 5.0f }, { 2.0f, 2.0f, 5.0f }, { 2.0f, -2.0f, 5.0f } };
+    ArrayList<U32> indices = { 0, 1, 2, 0, 2, 3 };
+    culler.addOccluder( positions, indices, (U32)indices.size(), 0, DirectX::XMMatrixIdentity() );
+    culler.rasterize();
+
+    bool success = true;
+
+    Math::AABB hiddenBox( { -0.5f, -0.5f, 9.5f }, { 0.5f, 0.5f, 10.5f } );
+    if ( culler.isVisible( hiddenBox ) )
+    {
+        LOG_WARN( "TestOcclusionCulling(): Box behind the occluder was not culled." );
+        success = false;
+    }
+
+    Math::AABB visibleBox( { 7.5f, -0.5f, 9.5f }, { 8.5f, 0.5f, 10.5f } );
+    if ( not culler.isVisible( visibleBox ) )
+    {
+        LOG_WARN( "TestOcclusionCulling(): Box beside the occluder was culled." );
+        success = false;
+    }
+
+    if (success)
+        LOG( "TestOcclusionCulling(): Passed." );
+
+    return success;
+}
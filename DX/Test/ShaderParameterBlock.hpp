@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Graphics/Utils/shader_parameter_block.h"
+
+//----------------------------------------------------------------------
+// Cpu side mirror of a constant buffer, packed like the shader would do it.
+//----------------------------------------------------------------------
+struct TestParameters
+{
+    DirectX::XMMATRIX   transform;      // 64 bytes
+    //----------------------------------- (16 byte boundary)
+    Math::Vec4          color;          // 16 bytes
+    //----------------------------------- (16 byte boundary)
+    Math::Vec3          direction;      // 12 bytes
+    F32                 intensity;      // 4 bytes
+    //----------------------------------- (16 byte boundary)
+};
+
+//----------------------------------------------------------------------
+// Checks that the parameters of a ShaderParameterBlock land at the offsets
+// of the cpu struct and that only changed parameters dirty the block.
+//----------------------------------------------------------------------
+bool TestShaderParameterBlock()
+{
+    using namespace Graphics;
+
+    // Built by hand the same way the shader reflection does it
+    ShaderUniformBufferDeclaration bufferInfo( ShaderType::Fragment, SID( "TestBuffer" ), 0, sizeof( TestParameters ) );
+    bufferInfo._AddUniformDecl( { SID( "transform" ), offsetof( TestParameters, transform ), sizeof( DirectX::XMMATRIX ), DataType::Matrix } );
+    bufferInfo._AddUniformDecl( { SID( "color" ),     offsetof( TestParameters, color ),     sizeof( Math::Vec4 ),        DataType::Vec4 } );
+    bufferInfo._AddUniformDecl( { SID( "direction" ), offsetof( TestParameters, direction ), sizeof( Math::Vec3 ),        DataType::Vec3 } );
+    bufferInfo._AddUniformDecl( { SID( "intensity" ), offsetof( TestParameters, intensity ), sizeof( F32 ),               DataType::Float } );
+
+    ShaderParameterBlock block( bufferInfo );
+
+    bool success = true;
+    auto check = [&](bool condition, const String& message) {
+        if ( not condition )
+        {
+            LOG_WARN( "TestShaderParameterBlock(): " + message );
+            success = false;
+        }
+    };
+
+    // Offsets and sizes of the handles match the cpu struct
+    for (auto& member : bufferInfo.getMembers())
+    {
+        auto handle = block.getHandle( member.getName() );
+        check( handle.offset == member.getOffset() && handle.size == member.getSize(), "Handle does not match the layout of '" + member.getName().toString() + "'." );
+    }
+    check( not block.getHandle( SID( "unknown" ) ).isValid(), "Handle to an unknown parameter is valid." );
+    check( not block.set( SID( "unknown" ), &success ), "Setting an unknown parameter succeeded." );
+
+    // A new block has to be uploaded completely once
+    check( block.getDirtyByteCount() == sizeof( TestParameters ), "New block is not completely dirty." );
+    block.clearDirtyRanges();
+
+    // Writing every parameter produces the same bytes as the cpu struct
+    TestParameters params;
+    params.transform    = DirectX::XMMatrixTranslation( 1.0f, 2.0f, 3.0f );
+    params.color        = Math::Vec4( 1.0f, 0.5f, 0.25f, 1.0f );
+    params.direction    = Math::Vec3( 0.0f, -1.0f, 0.0f );
+    params.intensity    = 2.0f;
+
+    block.set( SID( "transform" ), &params.transform );
+    block.set( SID( "color" ), &params.color );
+    block.set( SID( "direction" ), &params.direction );
+    block.set( SID( "intensity" ), &params.intensity );
+    check( memcmp( block.getData(), &params, sizeof( TestParameters ) ) == 0, "Block data does not match the cpu struct." );
+    block.clearDirtyRanges();
+
+    // Writing the same data again does not dirty the block
+    block.set( SID( "color" ), &params.color );
+    check( not block.isDirty(), "Writing unchanged data dirtied the block." );
+
+    // Only the changed parameter is dirty
+    params.intensity = 4.0f;
+    block.set( SID( "intensity" ), &params.intensity );
+    auto& ranges = block.getDirtyRanges();
+    check( ranges.size() == 1 && ranges[0].begin == offsetof( TestParameters, intensity ) && ranges[0].end == sizeof( TestParameters ),
+           "Dirty range does not cover exactly the changed parameter." );
+
+    // Neighbouring writes are merged into one range
+    params.color.x = 0.0f;
+    block.set( SID( "color" ), &params.color );
+    check( ranges.size() == 1 && ranges[0].begin == offsetof( TestParameters, color ), "Neighbouring dirty ranges were not merged." );
+
+    if (success)
+        LOG( "TestShaderParameterBlock(): Passed." );
+
+    return success;
+}
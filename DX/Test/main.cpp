@@ -3,6 +3,8 @@
 #include "MemoryManagement.hpp"
 #include "FileStuff.hpp"
 #include "Threading.hpp"
+#include "OcclusionCulling.hpp"
+#include "ShaderParameterBlock.hpp"
 
 #include "Common/enum_class_operators.hpp"
 
@@ -11,6 +13,8 @@
 
 int main()
 {
+    TestOcclusionCulling();
+    TestShaderParameterBlock();
 
 
 